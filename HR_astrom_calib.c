@@ -199,11 +199,8 @@ int *index_obj, nobj, tabular_only;
 char infile_name[80];
 FILE *fp_in;
 
-if((obj = (OBJECT *)malloc(NOBJ_MAX * sizeof(OBJECT))) == NULL) {
-  printf("Fatal error allocating memory space for OBJECT: nobj_max=%d\n", 
-          NOBJ_MAX);
-  exit(-1);
-  }
+obj = astrom_alloc_objects(NOBJ_MAX);
+
 if((index_obj = (int *)malloc((NOBJ_MAX) * sizeof(int))) == NULL) {
   printf("Fatal error allocating memory space for index_obj: nobj_max=%d\n", 
           NOBJ_MAX);
@@ -260,6 +257,6 @@ astrom_write_publi_table(fp_out, comments_wanted, obj, index_obj, nobj,
 astrom_compute_statistics(fp_out, obj, nobj, infile_name);
 
 free(index_obj);
-free(obj);
+astrom_free_objects(obj);
 return(0);
 }
@@ -16,17 +16,26 @@ EP=2004.1323 (epoch)
 Q=2         (Quadrant with restricted triple-correplation)
 LQ=3        (Quadrant with long integration)
 *
+* The epochs are kept in a cache file (fits_epoch_cache.txt by default,
+* or "-" for no cache), so that the FITS files are only read again
+* if they have been modified.
+* The FITS headers are read with N threads with "-j N".
+*
 * JLP
-* Version 19/04/2010
+* Version 17/10/2026
 *************************************************************************/
 #include "astrom_utils1.h" 
 #include "astrom_utils2.h" 
+#include "jlp_threads.h"        // jlp_threads_from_args()
 
 int main(int argc, char *argv[])
 {
-char filein[60], fileout[60], fits_directory[100];
+char filein[60], fileout[60], fits_directory[100], epoch_cache_fname[128];
+int nthreads;
 FILE *fp_in, *fp_out;
 
+nthreads = jlp_threads_from_args(&argc, argv);
+
 /* If command line with "runs" */
 if(argc == 7){
  if(*argv[4]) argc = 5;
@@ -37,10 +46,12 @@ if(argc == 7){
  }
 
 
-if(argc != 4)
+if(argc != 4 && argc != 5)
   {
-  printf(" Syntax: astrom_add_epoch in_file out_file fits_directory\n");
+  printf(" Syntax: astrom_add_epoch in_file out_file fits_directory [epoch_cache] [-j N]\n");
   printf(" Example: runs astrom_add_epoch astrom05a.tex astrom05aa.tex /home/data/pisco_merate/2004-2008/ \n");
+  printf(" (epoch_cache: %s by default, - for no cache)\n", 
+         ASTROM_EPOCH_CACHE_DEFAULT);
   exit(-1);
   }
 else
@@ -48,10 +59,16 @@ else
   strcpy(filein,argv[1]);
   strcpy(fileout,argv[2]);
   strcpy(fits_directory,argv[3]);
+  strcpy(epoch_cache_fname, ASTROM_EPOCH_CACHE_DEFAULT);
+  if(argc == 5) {
+    if(!strcmp(argv[4], "-")) epoch_cache_fname[0] = '\0';
+    else strcpy(epoch_cache_fname, argv[4]);
+    }
   }
 
 printf(" OK: filein=%s fileout=%s \n", filein, fileout);
-printf(" OK: fits_directory=%s\n", fits_directory);
+printf(" OK: fits_directory=%s epoch_cache=%s nthreads=%d\n", fits_directory,
+       epoch_cache_fname, nthreads);
 
 if((fp_in = fopen(filein,"r")) == NULL)
 {
@@ -73,7 +90,8 @@ fprintf(fp_out,"%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 /* Scan the file and add epoch from FITS autocorrelation files:
 * (in "astrom_utils2.c")
 */ 
-  astrom_add_epoch_from_fits_file(fp_in, fp_out, fits_directory); 
+  astrom_add_epoch_from_fits_file(fp_in, fp_out, fits_directory, 
+                                  epoch_cache_fname, nthreads); 
 
 fclose(fp_in);
 fclose(fp_out);
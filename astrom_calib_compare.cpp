@@ -173,16 +173,10 @@ static int astrom_compare_files(FILE *fp_in1, FILE *fp_out,
 {
 OBJECT *obj1;
 int *index_obj1, tabular_only;
-int i, nobj1 = 0, with_wds_data;
+int nobj1 = 0, with_wds_data;
 int quadrant_correction;
 
-if((obj1 = (OBJECT *)malloc(NOBJ_MAX * sizeof(OBJECT))) == NULL) {
-  printf("astrom_compare_files/Fatal error allocating memory space for OBJECT: nobj_max=%d\n",
-          NOBJ_MAX);
-  exit(-1);
-  }
-// Initialize the number of measurements to zero
-for(i = 0; i < NOBJ_MAX; i++) (obj1[i]).nmeas = 0;
+obj1 = astrom_alloc_objects(NOBJ_MAX);
 
 if((index_obj1 = (int *)malloc((NOBJ_MAX) * sizeof(int))) == NULL) {
   printf("astrom_compare_files/Fatal error allocating memory space for index_obj: nobj_max=%d\n",
@@ -222,7 +216,7 @@ astrom_write_cmpfile(filein1, filein2, cmp_fileout, obj1, nobj1);
 astrom_write_unrescmpfile(filein1, filein2, unres_cmp_fileout, obj1, nobj1);
 
 free(index_obj1);
-free(obj1);
+astrom_free_objects(obj1);
 return(0);
 }
 /*****************************************************************************
@@ -758,13 +752,7 @@ int *index_obj2, tabular_only, nm1;
 int i, j, k, nobj2 = 0;
 int quadrant_correction;
 
-if((obj2 = (OBJECT *)malloc(NOBJ_MAX * sizeof(OBJECT))) == NULL) {
-  printf("astrom_compare_files/Fatal error allocating memory space for OBJECT: nobj_max=%d\n",
-          NOBJ_MAX);
-  exit(-1);
-  }
-// Initialize the number of measurements to zero
-for(i = 0; i < NOBJ_MAX; i++) (obj2[i]).nmeas = 0;
+obj2 = astrom_alloc_objects(NOBJ_MAX);
 
 if((index_obj2 = (int *)malloc((NOBJ_MAX) * sizeof(int))) == NULL) {
   printf("astrom_compare_files/Fatal error allocating memory space for index_obj: nobj_max=%d\n",
@@ -793,11 +781,8 @@ for(i = 0; i < nobj1; i++) {
                (obj1[i]).discov_name, me1->rho, me1->theta,
                ABS(me1->rho - cmp_me1->rho),
                ABS(me1->theta - cmp_me1->theta));
-             strcpy((obj2[k]).wds, (obj1[i]).wds);
              strcpy((obj2[k]).discov_name, (obj1[i]).discov_name);
-             (obj2[k]).nmeas = (obj1[i]).nmeas;
-             (obj2[k]).WR = (obj1[i]).WR;
-             (obj2[k]).WY= (obj1[i]).WY;
+             astrom_copy_object_for_cmp(&obj2[k], &obj1[i]);
              me2 = &(obj2[k]).meas[j];
              cmp_me2 = &(obj2[k]).cmp_meas[j];
              strcpy(me2->filename, me1->filename); 
@@ -856,7 +841,7 @@ astrom_write_publi_cmp_table_gili(fp_cmp_out, obj2, index_obj2, nobj2,
 
 fclose(fp_cmp_out);
 free(index_obj2);
-free(obj2);
+astrom_free_objects(obj2);
 return(0);
 }
 /****************************************************************
@@ -875,13 +860,7 @@ int *index_obj2, tabular_only, nm1;
 int i, j, k, nobj2 = 0;
 int quadrant_correction;
 
-if((obj2 = (OBJECT *)malloc(NOBJ_MAX * sizeof(OBJECT))) == NULL) {
-  printf("astrom_compare_files/Fatal error allocating memory space for OBJECT: nobj_max=%d\n",
-          NOBJ_MAX);
-  exit(-1);
-  }
-// Initialize the number of measurements to zero
-for(i = 0; i < NOBJ_MAX; i++) (obj2[i]).nmeas = 0;
+obj2 = astrom_alloc_objects(NOBJ_MAX);
 
 if((index_obj2 = (int *)malloc((NOBJ_MAX) * sizeof(int))) == NULL) {
   printf("astrom_compare_files/Fatal error allocating memory space for index_obj: nobj_max=%d\n",
@@ -906,11 +885,8 @@ for(i = 0; i < nobj1; i++) {
          if((cmp_me1->rho != NO_DATA) && (cmp_me1->theta != NO_DATA)) {
              printf("discov_name=%s rho=%.2f theta=%.2f\n",
                (obj1[i]).discov_name, me1->rho, me1->theta);
-             strcpy((obj2[k]).wds, (obj1[i]).wds);
              strcpy((obj2[k]).discov_name, (obj1[i]).discov_name);
-             (obj2[k]).nmeas = (obj1[i]).nmeas;
-             (obj2[k]).WR = (obj1[i]).WR;
-             (obj2[k]).WY= (obj1[i]).WY;
+             astrom_copy_object_for_cmp(&obj2[k], &obj1[i]);
              me2 = &(obj2[k]).meas[j];
              cmp_me2 = &(obj2[k]).cmp_meas[j];
              strcpy(me2->filename, me1->filename); 
@@ -969,7 +945,7 @@ astrom_write_publi_cmp_table_gili(fp_cmp_out, obj2, index_obj2, nobj2,
 
 fclose(fp_cmp_out);
 free(index_obj2);
-free(obj2);
+astrom_free_objects(obj2);
 return(0);
 }
 /**************************************************************************
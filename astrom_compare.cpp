@@ -199,7 +199,7 @@ char b_in[NMAX], str_uscore[64], *pc_uscore, filename2[64], object_name[64];
 double epoch2, rho2, delta_m;
 char *pc, str_simple[64], str_comments[64];
 int i_filename, i_date, i_filter, i_eyepiece, i_rho, i_drho, i_theta, i_dtheta;
-int i_notes, nobj1, i, i_obj1, i_obj2, comments_wanted, status, status1;
+int i_notes, nobj1, i_obj1, i_obj2, comments_wanted, status, status1;
 int is_discrepant, quadrt, dquadrt, is_simple;
 FILE *fp_in2, *fp_out;
 time_t t0 = time(NULL);
@@ -207,21 +207,9 @@ OBJECT *obj1, *obj2;
 
 strcpy(str_simple, "Simple");
 
-if((obj1 = (OBJECT *)malloc(NOBJ_MAX * sizeof(OBJECT))) == NULL) {
-  printf("astrom_compare2/Fatal error allocating memory space for OBJECT: nobj_max=%d\n",
-          NOBJ_MAX);
-  exit(-1);
-  }
-
-// Initialize the number of measurements to zero
-for(i = 0; i < NOBJ_MAX; i++) (obj1[i]).nmeas = 0;
+obj1 = astrom_alloc_objects(NOBJ_MAX);
 
-if((obj2 = (OBJECT *)malloc(2 * sizeof(OBJECT))) == NULL) {
-  printf("astrom_compare2/Fatal error allocating memory space for OBJECT obj2\n");
-  exit(-1);
-  }
-// Initialize the number of measurements to zero
-for(i = 0; i < 2; i++) (obj2[i]).nmeas = 0;
+obj2 = astrom_alloc_objects(2);
 
 /* Open input file: */
 if((fp_in2 = fopen(in_file2, "r")) == NULL) {
@@ -858,13 +846,7 @@ int *index_obj1, tabular_only;
 int i, nobj1 = 0, with_wds_data;
 int quadrant_correction;
 
-if((obj1 = (OBJECT *)malloc(NOBJ_MAX * sizeof(OBJECT))) == NULL) {
-  printf("astrom_compare_files/Fatal error allocating memory space for OBJECT: nobj_max=%d\n",
-          NOBJ_MAX);
-  exit(-1);
-  }
-// Initialize the number of measurements to zero
-for(i = 0; i < NOBJ_MAX; i++) (obj1[i]).nmeas = 0;
+obj1 = astrom_alloc_objects(NOBJ_MAX);
 
 if((index_obj1 = (int *)malloc((NOBJ_MAX) * sizeof(int))) == NULL) {
   printf("astrom_compare_files/Fatal error allocating memory space for index_obj: nobj_max=%d\n",
@@ -904,7 +886,7 @@ astrom_write_cmpfile(filein1, filein2, cmp_fileout, obj1, nobj1);
 astrom_write_unrescmpfile(filein1, filein2, unres_cmp_fileout, obj1, nobj1);
 
 free(index_obj1);
-free(obj1);
+astrom_free_objects(obj1);
 return(0);
 }
 /*****************************************************************************
@@ -1363,13 +1345,7 @@ int *index_obj2, tabular_only, nm1;
 int i, j, k, nobj2 = 0;
 int quadrant_correction;
 
-if((obj2 = (OBJECT *)malloc(NOBJ_MAX * sizeof(OBJECT))) == NULL) {
-  printf("astrom_compare_files/Fatal error allocating memory space for OBJECT: nobj_max=%d\n",
-          NOBJ_MAX);
-  exit(-1);
-  }
-// Initialize the number of measurements to zero
-for(i = 0; i < NOBJ_MAX; i++) (obj2[i]).nmeas = 0;
+obj2 = astrom_alloc_objects(NOBJ_MAX);
 
 if((index_obj2 = (int *)malloc((NOBJ_MAX) * sizeof(int))) == NULL) {
   printf("astrom_compare_files/Fatal error allocating memory space for index_obj: nobj_max=%d\n",
@@ -1398,11 +1374,8 @@ for(i = 0; i < nobj1; i++) {
                (obj1[i]).discov_name, me1->rho, me1->theta,
                ABS(me1->rho - cmp_me1->rho),
                ABS(me1->theta - cmp_me1->theta));
-             strcpy((obj2[k]).wds, (obj1[i]).wds);
              strcpy((obj2[k]).discov_name, (obj1[i]).discov_name);
-             (obj2[k]).nmeas = (obj1[i]).nmeas;
-             (obj2[k]).WR = (obj1[i]).WR;
-             (obj2[k]).WY= (obj1[i]).WY;
+             astrom_copy_object_for_cmp(&obj2[k], &obj1[i]);
              me2 = &(obj2[k]).meas[j];
              cmp_me2 = &(obj2[k]).cmp_meas[j];
              strcpy(me2->filename, me1->filename); 
@@ -1461,7 +1434,7 @@ astrom_write_publi_cmp_table_gili(fp_cmp_out, obj2, index_obj2, nobj2,
 
 fclose(fp_cmp_out);
 free(index_obj2);
-free(obj2);
+astrom_free_objects(obj2);
 return(0);
 }
 /****************************************************************
@@ -1480,13 +1453,7 @@ int *index_obj2, tabular_only, nm1;
 int i, j, k, nobj2 = 0;
 int quadrant_correction;
 
-if((obj2 = (OBJECT *)malloc(NOBJ_MAX * sizeof(OBJECT))) == NULL) {
-  printf("astrom_compare_files/Fatal error allocating memory space for OBJECT: nobj_max=%d\n",
-          NOBJ_MAX);
-  exit(-1);
-  }
-// Initialize the number of measurements to zero
-for(i = 0; i < NOBJ_MAX; i++) (obj2[i]).nmeas = 0;
+obj2 = astrom_alloc_objects(NOBJ_MAX);
 
 if((index_obj2 = (int *)malloc((NOBJ_MAX) * sizeof(int))) == NULL) {
   printf("astrom_compare_files/Fatal error allocating memory space for index_obj: nobj_max=%d\n",
@@ -1511,11 +1478,8 @@ for(i = 0; i < nobj1; i++) {
          if((cmp_me1->rho != NO_DATA) && (cmp_me1->theta != NO_DATA)) {
              printf("discov_name=%s rho=%.2f theta=%.2f\n",
                (obj1[i]).discov_name, me1->rho, me1->theta);
-             strcpy((obj2[k]).wds, (obj1[i]).wds);
              strcpy((obj2[k]).discov_name, (obj1[i]).discov_name);
-             (obj2[k]).nmeas = (obj1[i]).nmeas;
-             (obj2[k]).WR = (obj1[i]).WR;
-             (obj2[k]).WY= (obj1[i]).WY;
+             astrom_copy_object_for_cmp(&obj2[k], &obj1[i]);
              me2 = &(obj2[k]).meas[j];
              cmp_me2 = &(obj2[k]).cmp_meas[j];
              strcpy(me2->filename, me1->filename); 
@@ -1574,7 +1538,7 @@ astrom_write_publi_cmp_table_gili(fp_cmp_out, obj2, index_obj2, nobj2,
 
 fclose(fp_cmp_out);
 free(index_obj2);
-free(obj2);
+astrom_free_objects(obj2);
 return(0);
 }
 /**************************************************************************
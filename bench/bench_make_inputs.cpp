@@ -0,0 +1,425 @@
+/************************************************************************
+* "bench_make_inputs.cpp"
+* Generate the synthetic input files used by the benchmarks, with the
+* same format as the real files, at a configurable scale:
+*  - WDS summary catalog ("wdsweb_summ.txt"),
+*  - Sixth Orbit Catalog ("orb6orbits.txt", non-master format),
+*  - PISCO catalog ("zeiss_doppie.cat"),
+*  - calibrated LaTeX table ("tab_calib.tex"),
+*  - LaTeX table of the residuals ("tab_resid.tex", as created by
+*    residuals_1).
+*
+* Syntax:
+* bench_make_inputs out_dir nobjects [nmeas_per_object] [seed]
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench_utils.h"
+
+/* Length of the lines of the WDS summary and of the OC6 catalog: */
+#define WDS_LINE_LENGTH 130
+#define OC6_LINE_LENGTH 264
+
+static int write_WDS_catalog(char *fname, int nobjects);
+static int write_OC6_catalog(char *fname, int nobjects);
+static int write_PISCO_catalog(char *fname, int nobjects);
+static int write_calib_table(char *fname, int nobjects, int nmeas,
+                             unsigned long long seed);
+static int write_resid_table(char *fname, int nobjects, int nmeas,
+                             unsigned long long seed);
+static void put_field(char *line, int istart, int ilen, const char *value);
+static void coordinates_to_string(double alpha, double delta, char *str0);
+static void object_name(BENCH_OBJECT *obj, char *name0);
+static void orbit_author(int k, int iorb, char *author0);
+
+int main(int argc, char *argv[])
+{
+char out_dir[128], fname[256];
+int nobjects, nmeas = 3;
+unsigned long long seed = 1;
+double time0;
+
+if(argc < 3 || argc > 5) {
+  printf("Syntax: bench_make_inputs out_dir nobjects [nmeas_per_object] [seed]\n");
+  printf("Example: bench_make_inputs /tmp/bench 100000 3 1\n");
+  return(-1);
+  }
+strcpy(out_dir, argv[1]);
+if(sscanf(argv[2], "%d", &nobjects) != 1 || nobjects <= 0) {
+  fprintf(stderr, "bench_make_inputs/Fatal error: bad number of objects: %s\n",
+          argv[2]);
+  return(-1);
+  }
+if(argc > 3) sscanf(argv[3], "%d", &nmeas);
+if(argc > 4) sscanf(argv[4], "%llu", &seed);
+if(nmeas < 1) nmeas = 1;
+
+printf("OK: out_dir=%s nobjects=%d nmeas_per_object=%d seed=%llu\n",
+       out_dir, nobjects, nmeas, seed);
+
+time0 = bench_wall_time();
+
+sprintf(fname, "%s/%s", out_dir, BENCH_WDS_FNAME);
+if(write_WDS_catalog(fname, nobjects)) return(-1);
+
+sprintf(fname, "%s/%s", out_dir, BENCH_OC6_FNAME);
+if(write_OC6_catalog(fname, nobjects)) return(-1);
+
+sprintf(fname, "%s/%s", out_dir, BENCH_PISCO_FNAME);
+if(write_PISCO_catalog(fname, nobjects)) return(-1);
+
+sprintf(fname, "%s/%s", out_dir, BENCH_CALIB_FNAME);
+if(write_calib_table(fname, nobjects, nmeas, seed)) return(-1);
+
+sprintf(fname, "%s/%s", out_dir, BENCH_RESID_FNAME);
+if(write_resid_table(fname, nobjects, nmeas, seed)) return(-1);
+
+printf("OK: files written in %s in %.2f s\n", out_dir,
+       bench_wall_time() - time0);
+
+return(0);
+}
+/*************************************************************************
+* Copy a value to a fixed-format line (truncated to ilen characters)
+*************************************************************************/
+static void put_field(char *line, int istart, int ilen, const char *value)
+{
+int i;
+
+for(i = 0; i < ilen && value[i] != '\0'; i++) line[istart + i] = value[i];
+}
+/*************************************************************************
+* Coordinates in the format of the WDS and OC6 catalogs:
+* "hhmmss.ss+ddmmss.s" (e.g. "092059.40+381117.9")
+*************************************************************************/
+static void coordinates_to_string(double alpha, double delta, char *str0)
+{
+int ra_h, ra_m, dec_d, dec_m;
+double ra_s, dec_s, dec_abs;
+
+ra_h = (int)alpha;
+ra_m = (int)((alpha - ra_h) * 60.);
+ra_s = ((alpha - ra_h) * 60. - ra_m) * 60.;
+if(ra_s > 59.99) ra_s = 59.99;
+dec_abs = (delta < 0.) ? -delta : delta;
+dec_d = (int)dec_abs;
+dec_m = (int)((dec_abs - dec_d) * 60.);
+dec_s = ((dec_abs - dec_d) * 60. - dec_m) * 60.;
+if(dec_s > 59.9) dec_s = 59.9;
+
+sprintf(str0, "%02d%02d%05.2f%c%02d%02d%04.1f", ra_h, ra_m, ra_s,
+        (delta < 0.) ? '-' : '+', dec_d, dec_m, dec_s);
+}
+/*************************************************************************
+* Object name used in the calibrated and residual tables
+* (ADS name if any, discoverer's name otherwise), e.g. "ADS 7307"
+* or "STF 1338"
+*************************************************************************/
+static void object_name(BENCH_OBJECT *obj, char *name0)
+{
+if(obj->ADS_number > 0)
+  strcpy(name0, obj->ADS_name);
+else
+  sprintf(name0, "%s %d", obj->discov_code, obj->discov_number);
+}
+/*************************************************************************
+* Reference of the orbit #iorb of object #k (e.g. "Hei1997")
+*************************************************************************/
+static void orbit_author(int k, int iorb, char *author0)
+{
+static const char *authors[] = {"Hei", "Sca", "Doc", "Msn", "Izm", "Tok"};
+
+sprintf(author0, "%s%04d", authors[(k + iorb) % 6], 1990 + 15 * iorb + k % 10);
+}
+/*************************************************************************
+* WDS summary catalog (fixed format, see "WDS_catalog.cpp"):
+* 00014+3937HLD  60       1893 2015   31 173 167   1.5   1.5  9.11  9.77 K0
+*************************************************************************/
+static int write_WDS_catalog(char *fname, int nobjects)
+{
+char line[WDS_LINE_LENGTH + 1], buffer[64];
+BENCH_OBJECT obj;
+unsigned long long state;
+int k;
+FILE *fp_out;
+
+if((fp_out = fopen(fname, "w")) == NULL) {
+  fprintf(stderr, "write_WDS_catalog/Fatal error opening %s\n", fname);
+  return(-1);
+  }
+
+fprintf(fp_out, "%% Synthetic WDS summary catalog created by bench_make_inputs (%d objects)\n",
+        nobjects);
+
+for(k = 0; k < nobjects; k++) {
+  bench_object(k, nobjects, &obj);
+  state = 4242ULL + (unsigned long long)k;
+  memset(line, ' ', WDS_LINE_LENGTH);
+  line[WDS_LINE_LENGTH] = '\0';
+  put_field(line, 0, 10, obj.WDS_name);
+  put_field(line, 10, 7, obj.discov_name);
+  put_field(line, 17, 5, obj.comp_name);
+  sprintf(buffer, "%4d", 1830 + k % 150);
+  put_field(line, 23, 4, buffer);
+  sprintf(buffer, "%4d", 2005 + k % 15);
+  put_field(line, 28, 4, buffer);
+  sprintf(buffer, "%4d", 2 + k % 90);
+  put_field(line, 33, 4, buffer);
+  sprintf(buffer, "%3d", (int)bench_uniform(&state, 0., 360.));
+  put_field(line, 38, 3, buffer);
+  sprintf(buffer, "%3d", (int)bench_uniform(&state, 0., 360.));
+  put_field(line, 42, 3, buffer);
+  sprintf(buffer, "%5.1f", bench_uniform(&state, 0.1, 9.));
+  put_field(line, 46, 5, buffer);
+  sprintf(buffer, "%5.1f", bench_uniform(&state, 0.1, 9.));
+  put_field(line, 52, 5, buffer);
+  sprintf(buffer, "%5.2f", bench_uniform(&state, 4., 10.));
+  put_field(line, 58, 5, buffer);
+  sprintf(buffer, "%5.2f", bench_uniform(&state, 5., 12.));
+  put_field(line, 64, 5, buffer);
+  put_field(line, 70, 9, (k % 2) ? "G5V" : "K0III");
+  coordinates_to_string(obj.alpha, obj.delta, buffer);
+  put_field(line, 112, 18, buffer);
+  fprintf(fp_out, "%s\n", line);
+  }
+
+fclose(fp_out);
+return(0);
+}
+/*************************************************************************
+* Sixth Orbit Catalog ("orb6orbits.txt" format, see "OC6_catalog_utils.cpp")
+* with 8 lines of header, and a blank line after the orbits of each object
+*************************************************************************/
+static int write_OC6_catalog(char *fname, int nobjects)
+{
+char line[OC6_LINE_LENGTH + 1], buffer[64];
+BENCH_OBJECT obj;
+double Omega_node, omega_peri, i_incl, e_eccent, T_periastron, Period;
+double a_smaxis;
+int k, iorb, i;
+FILE *fp_out;
+
+if((fp_out = fopen(fname, "w")) == NULL) {
+  fprintf(stderr, "write_OC6_catalog/Fatal error opening %s\n", fname);
+  return(-1);
+  }
+
+/* Header (8 lines): */
+fprintf(fp_out, "SIXTH CATALOG OF ORBITS OF VISUAL BINARY STARS (synthetic, %d objects)\n",
+        nobjects);
+for(i = 1; i < 8; i++)
+  fprintf(fp_out, "HEADER line #%d created by bench_make_inputs\n", i + 1);
+
+for(k = 0; k < nobjects; k++) {
+  bench_object(k, nobjects, &obj);
+  if(obj.norbits == 0) continue;
+  for(iorb = 0; iorb < obj.norbits; iorb++) {
+    bench_orbit(k, iorb, &Omega_node, &omega_peri, &i_incl, &e_eccent,
+                &T_periastron, &Period, &a_smaxis);
+    memset(line, ' ', OC6_LINE_LENGTH);
+    line[OC6_LINE_LENGTH] = '\0';
+    coordinates_to_string(obj.alpha, obj.delta, buffer);
+    put_field(line, 0, 18, buffer);
+    put_field(line, 19, 10, obj.WDS_name);
+    put_field(line, 30, 7, obj.discov_name);
+    put_field(line, 37, 7, obj.comp_name);
+    if(obj.ADS_number > 0)
+      sprintf(buffer, "%5d", obj.ADS_number);
+    else
+      strcpy(buffer, "    .");
+    put_field(line, 45, 5, buffer);
+    sprintf(buffer, "%6d", 1000 + k % 200000);
+    put_field(line, 51, 6, buffer);
+    sprintf(buffer, "%6d", 100 + k % 110000);
+    put_field(line, 58, 6, buffer);
+    sprintf(buffer, "%11.4f", Period);
+    put_field(line, 80, 11, buffer);
+    line[92] = 'y';
+    sprintf(buffer, "%9.4f", a_smaxis);
+    put_field(line, 105, 9, buffer);
+    line[114] = 'a';
+    sprintf(buffer, "%8.3f", i_incl);
+    put_field(line, 125, 8, buffer);
+    sprintf(buffer, "%8.3f", Omega_node);
+    put_field(line, 143, 8, buffer);
+    sprintf(buffer, "%12.4f", T_periastron);
+    put_field(line, 162, 12, buffer);
+    line[174] = 'y';
+    sprintf(buffer, "%8.4f", e_eccent);
+    put_field(line, 187, 8, buffer);
+    sprintf(buffer, "%8.3f", omega_peri);
+    put_field(line, 205, 8, buffer);
+    put_field(line, 223, 4, "2000");
+    sprintf(buffer, "%d", 1 + (k + iorb) % 5);
+    put_field(line, 233, 1, buffer);
+    orbit_author(k, iorb, buffer);
+    put_field(line, 237, 8, buffer);
+    fprintf(fp_out, "%s\n", line);
+    }
+/* Blank line at the end of each object: */
+  fprintf(fp_out, "    \n");
+  }
+
+fclose(fp_out);
+return(0);
+}
+/*************************************************************************
+* PISCO catalog (two lines per object, see "PISCO_catalog_utils.cpp"):
+* ADS 326AB (3.40, 340) &  0 23 59.8 &-03 28 31 & 2000.0
+* & A: 9.1, B: 9.8 K0   & HLD   60, orbit & WDS00014+3937 HIP110 V=8.61 B-V=0.79 PI=20.42(1.91) \cr
+*************************************************************************/
+static int write_PISCO_catalog(char *fname, int nobjects)
+{
+char name[40];
+BENCH_OBJECT obj;
+unsigned long long state;
+int k, ra_h, ra_m, dec_d, dec_m, dec_s;
+double ra_s, dec_abs;
+FILE *fp_out;
+
+if((fp_out = fopen(fname, "w")) == NULL) {
+  fprintf(stderr, "write_PISCO_catalog/Fatal error opening %s\n", fname);
+  return(-1);
+  }
+
+fprintf(fp_out, "%% Synthetic PISCO catalog created by bench_make_inputs (%d objects)\n",
+        nobjects);
+
+for(k = 0; k < nobjects; k++) {
+  bench_object(k, nobjects, &obj);
+  state = 9191ULL + (unsigned long long)k;
+  ra_h = (int)obj.alpha;
+  ra_m = (int)((obj.alpha - ra_h) * 60.);
+  ra_s = ((obj.alpha - ra_h) * 60. - ra_m) * 60.;
+  if(ra_s > 59.9) ra_s = 59.9;
+  dec_abs = (obj.delta < 0.) ? -obj.delta : obj.delta;
+  dec_d = (int)dec_abs;
+  dec_m = (int)((dec_abs - dec_d) * 60.);
+  dec_s = (int)(((dec_abs - dec_d) * 60. - dec_m) * 60.);
+  object_name(&obj, name);
+  fprintf(fp_out, "%s%s (%.2f, %3d) & %2d %02d %04.1f &%c%02d %02d %02d & 2000.0\n",
+          name, obj.comp_name, bench_uniform(&state, 0.1, 9.),
+          (int)bench_uniform(&state, 0., 360.), ra_h, ra_m, ra_s,
+          (obj.delta < 0.) ? '-' : '+', dec_d, dec_m, dec_s);
+  fprintf(fp_out, "& A: %.1f, B: %.1f %s   & %-3s %4d, %s & WDS%s HIP%d V=%.2f B-V=%.2f PI=%.2f(%.2f) \\cr\n",
+          bench_uniform(&state, 4., 10.), bench_uniform(&state, 5., 12.),
+          (k % 2) ? "G5" : "K0", obj.discov_code, obj.discov_number,
+          (obj.norbits > 0) ? "orbit" : "     ", obj.WDS_name,
+          100 + k % 110000, bench_uniform(&state, 4., 10.),
+          bench_uniform(&state, -0.2, 1.5), bench_uniform(&state, 1., 100.),
+          bench_uniform(&state, 0.5, 3.));
+  }
+
+fclose(fp_out);
+return(0);
+}
+/*************************************************************************
+* Calibrated LaTeX table (12 columns):
+* WDS & Name & ADS & Epoch & rho & sigma_rho & theta & sigma_theta
+*     & Dm & Eyep. & Orbit & Notes \\
+* with one line per measurement ("\idem" in the first 3 columns for the
+* following measurements of the same object)
+*************************************************************************/
+static int write_calib_table(char *fname, int nobjects, int nmeas,
+                             unsigned long long seed)
+{
+char name[40], ads_column[20];
+BENCH_OBJECT obj;
+double epoch, rho, theta;
+int k, imeas;
+FILE *fp_out;
+
+if((fp_out = fopen(fname, "w")) == NULL) {
+  fprintf(stderr, "write_calib_table/Fatal error opening %s\n", fname);
+  return(-1);
+  }
+
+fprintf(fp_out, "%% Synthetic calibrated table created by bench_make_inputs (%d objects)\n",
+        nobjects);
+fprintf(fp_out, "\\begin{tabular*}{\\textwidth}{cllccccccccl}\n");
+fprintf(fp_out, "\\hline\n");
+fprintf(fp_out, "WDS & Name & ADS & Epoch & $\\rho$ & $\\sigma_\\rho$ & $\\theta$ & $\\sigma_\\theta$ & $\\Delta m$ & Eyep. & Orbit & Notes \\\\\n");
+fprintf(fp_out, "& & & & & & & & & & & \\\\\n");
+fprintf(fp_out, "\\hline\n");
+
+for(k = 0; k < nobjects; k++) {
+  bench_object(k, nobjects, &obj);
+  object_name(&obj, name);
+  if(obj.ADS_number > 0)
+    sprintf(ads_column, "%d", obj.ADS_number);
+  else
+    strcpy(ads_column, "\\nodata");
+  for(imeas = 0; imeas < nmeas; imeas++) {
+    bench_measure(k, imeas, seed, &epoch, &rho, &theta);
+    if(imeas == 0)
+      fprintf(fp_out, "%.5s$%c$%s & %s %d%s & %s ", obj.WDS_name,
+              obj.WDS_name[5], &obj.WDS_name[6], obj.discov_code,
+              obj.discov_number, obj.comp_name, ads_column);
+    else
+      fprintf(fp_out, "\\idem & \\idem & \\idem ");
+    fprintf(fp_out, "& %.3f & %.3f & %.3f & %.1f & %.1f & %.2f & %d & %d & \\\\\n",
+            epoch, rho, 0.01 * rho + 0.005, theta, 0.4, 0.5 + 0.1 * (k % 30),
+            20 + 12 * (imeas % 2), (obj.norbits > 0) ? 1 : 0);
+    }
+  }
+
+fprintf(fp_out, "\\hline\n");
+fprintf(fp_out, "\\end{tabular*}\n");
+
+fclose(fp_out);
+return(0);
+}
+/*************************************************************************
+* LaTeX table of the residuals (as created by residuals_1):
+* Name & Orbit & Epoch & rho & theta & Drho(O-C) & Dtheta(O-C) & Grade \\
+* with one line per measurement and per orbit
+*************************************************************************/
+static int write_resid_table(char *fname, int nobjects, int nmeas,
+                             unsigned long long seed)
+{
+char name[40], author[40];
+BENCH_OBJECT obj;
+unsigned long long state;
+double epoch, rho, theta;
+int k, imeas, iorb;
+FILE *fp_out;
+
+if((fp_out = fopen(fname, "w")) == NULL) {
+  fprintf(stderr, "write_resid_table/Fatal error opening %s\n", fname);
+  return(-1);
+  }
+
+fprintf(fp_out, "%% Synthetic table of residuals created by bench_make_inputs (%d objects)\n",
+        nobjects);
+fprintf(fp_out, "\\begin{tabular}{llcccrrc}\n");
+fprintf(fp_out, "\\hline\n");
+fprintf(fp_out, "& Orbit & Epoch & $\\rho$ & $\\theta$ & $\\Delta \\rho$ & $\\Delta \\theta$ & Grade \\\\\n");
+fprintf(fp_out, "\\hline\n");
+
+for(k = 0; k < nobjects; k++) {
+  bench_object(k, nobjects, &obj);
+  if(obj.norbits == 0) continue;
+  object_name(&obj, name);
+  state = 5151ULL + (unsigned long long)k;
+  for(imeas = 0; imeas < nmeas; imeas++) {
+    bench_measure(k, imeas, seed, &epoch, &rho, &theta);
+    for(iorb = 0; iorb < obj.norbits; iorb++) {
+      orbit_author(k, iorb, author);
+      fprintf(fp_out, "%s %s & %s & %.3f & %.3f & %.1f & %.3f & %.1f & %d \\\\\n",
+              name, obj.comp_name, author, epoch, rho, theta,
+              bench_uniform(&state, -0.05, 0.05),
+              bench_uniform(&state, -3., 3.), 1 + (k + iorb) % 5);
+      }
+    }
+  }
+
+fprintf(fp_out, "\\hline\n");
+fprintf(fp_out, "\\end{tabular}\n");
+
+fclose(fp_out);
+return(0);
+}
@@ -0,0 +1,465 @@
+/************************************************************************
+* "bench_pscplib.cpp"
+* Benchmark of the routines of pscplib that are called for each
+* object or measurement by the programs of pisco_papers,
+* on the synthetic files created by bench_make_inputs:
+*  get_data_from_WDS_catalog(), line_extraction_from_OC6_catalog(),
+*  get_values_from_RESID_table(), get_coordinates_from_PISCO_catalog(),
+*  get_data_from_PISCO_catalog(), compute_ephemerid(),
+*  compute_ephemerides(), compute_ephemerid_of_multiple_system(),
+*  compute_multiple_system_ephemerides(), OrbitModel::Ephemerid()
+*  and latex_get_column_item()
+*
+* For the routines that read a catalog only once, the first call
+* (with the loading of the catalog) is reported separately ("load").
+* About 10% of the queried objects are not in the catalogs.
+* The results are written as JSON lines (see bench_report()).
+*
+* Syntax:
+* bench_pscplib bench_dir nobjects nmeas_per_object seed nqueries [results_file]
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include <string>
+#include "bench_utils.h"
+#include "jlp_catalog_utils.h"   // get_values_from_RESID_table()
+#include "WDS_catalog_utils.h"   // get_data_from_WDS_catalog()
+#include "OC6_catalog_utils.h"   // line_extraction_from_OC6_catalog()
+#include "PISCO_catalog_utils.h" // get_coordinates_from_PISCO_catalog()
+#include "residuals_utils.h"     // compute_ephemerid(), compute_ephemerides()
+#include "orbit_model.h"         // OrbitModel
+#include "latex_utils.h"         // latex_get_column_item()
+
+/* Number of epochs per orbit for compute_ephemerides(): */
+#define BENCH_NEPOCHS 64
+/* Number of ephemerides computed per query: */
+#define BENCH_EPHEM_PER_QUERY 10
+
+static int bench_WDS(char *bench_dir, int nobjects, int nqueries, FILE *fp_res);
+static int bench_OC6(char *bench_dir, int nobjects, int nqueries, FILE *fp_res);
+static int bench_RESID(char *bench_dir, int nobjects, int nmeas,
+                       unsigned long long seed, int nqueries, FILE *fp_res);
+static int bench_PISCO(char *bench_dir, int nobjects, int nqueries,
+                       FILE *fp_res);
+static int bench_ephemerides(int nobjects, int nqueries, FILE *fp_res);
+static int bench_multiple_ephemerides(int nobjects, int nqueries, FILE *fp_res);
+static int bench_latex(char *bench_dir, FILE *fp_res);
+static int random_object(unsigned long long *state, int nobjects);
+
+int main(int argc, char *argv[])
+{
+char bench_dir[128];
+int nobjects, nmeas, nqueries;
+unsigned long long seed;
+FILE *fp_res;
+
+if(argc != 6 && argc != 7) {
+  printf("Syntax: bench_pscplib bench_dir nobjects nmeas_per_object seed nqueries [results_file]\n");
+  printf("(same nobjects, nmeas_per_object and seed as for bench_make_inputs)\n");
+  return(-1);
+  }
+strcpy(bench_dir, argv[1]);
+if(sscanf(argv[2], "%d", &nobjects) != 1 || nobjects <= 0
+   || sscanf(argv[3], "%d", &nmeas) != 1 || nmeas <= 0
+   || sscanf(argv[4], "%llu", &seed) != 1
+   || sscanf(argv[5], "%d", &nqueries) != 1 || nqueries <= 0) {
+  fprintf(stderr, "bench_pscplib/Fatal error: bad arguments\n");
+  return(-1);
+  }
+
+/* The results are appended to the results file (or written to stdout): */
+fp_res = stdout;
+if(argc == 7 && (fp_res = fopen(argv[6], "a")) == NULL) {
+  fprintf(stderr, "bench_pscplib/Fatal error opening %s\n", argv[6]);
+  return(-1);
+  }
+
+bench_WDS(bench_dir, nobjects, nqueries, fp_res);
+bench_OC6(bench_dir, nobjects, nqueries, fp_res);
+bench_RESID(bench_dir, nobjects, nmeas, seed, nqueries, fp_res);
+bench_PISCO(bench_dir, nobjects, nqueries, fp_res);
+bench_ephemerides(nobjects, nqueries, fp_res);
+bench_multiple_ephemerides(nobjects, nqueries, fp_res);
+bench_latex(bench_dir, fp_res);
+
+if(fp_res != stdout) fclose(fp_res);
+return(0);
+}
+/*************************************************************************
+* Index of a random object (10% of the indices are larger than nobjects,
+* i.e., correspond to objects that are not in the catalogs)
+*************************************************************************/
+static int random_object(unsigned long long *state, int nobjects)
+{
+return((int)(bench_random(state) % (unsigned long long)(nobjects + nobjects / 10 + 1)));
+}
+/*************************************************************************
+* get_data_from_WDS_catalog()
+*************************************************************************/
+static int bench_WDS(char *bench_dir, int nobjects, int nqueries, FILE *fp_res)
+{
+char WDS_catalog[256], wds_name[64], spectral[64];
+double time0, year, rho, theta, magA, magB;
+BENCH_OBJECT obj;
+unsigned long long state = 1;
+int k, i, found, nfound;
+
+sprintf(WDS_catalog, "%s/%s", bench_dir, BENCH_WDS_FNAME);
+
+/* First call (loading of the catalog): */
+bench_object(0, nobjects, &obj);
+time0 = bench_wall_time();
+get_data_from_WDS_catalog(WDS_catalog, obj.discov_name, obj.comp_name,
+                          wds_name, &year, &rho, &theta, &magA, &magB,
+                          spectral, &found);
+bench_report(fp_res, "get_data_from_WDS_catalog", "load", nobjects,
+             bench_wall_time() - time0, bench_peak_rss_kb());
+
+nfound = 0;
+time0 = bench_wall_time();
+for(i = 0; i < nqueries; i++) {
+  k = random_object(&state, nobjects);
+  bench_object(k, nobjects, &obj);
+  get_data_from_WDS_catalog(WDS_catalog, obj.discov_name, obj.comp_name,
+                            wds_name, &year, &rho, &theta, &magA, &magB,
+                            spectral, &found);
+  if(found) nfound++;
+  }
+bench_report(fp_res, "get_data_from_WDS_catalog", "function", nqueries,
+             bench_wall_time() - time0, bench_peak_rss_kb());
+printf("bench_WDS: %d objects found out of %d\n", nfound, nqueries);
+
+return(0);
+}
+/*************************************************************************
+* line_extraction_from_OC6_catalog() (the lines are written to /dev/null)
+*************************************************************************/
+static int bench_OC6(char *bench_dir, int nobjects, int nqueries, FILE *fp_res)
+{
+char OC6_fname[256], discov_name[64];
+double time0;
+BENCH_OBJECT obj;
+unsigned long long state = 2;
+int k, i, found, candidate_found, nfound;
+FILE *fp_null;
+
+sprintf(OC6_fname, "%s/%s", bench_dir, BENCH_OC6_FNAME);
+if((fp_null = fopen("/dev/null", "w")) == NULL) {
+  fprintf(stderr, "bench_OC6/Error opening /dev/null\n");
+  return(-1);
+  }
+
+/* First call (loading of the catalog): */
+bench_object(0, nobjects, &obj);
+sprintf(discov_name, "%s%d", obj.discov_code, obj.discov_number);
+time0 = bench_wall_time();
+line_extraction_from_OC6_catalog(OC6_fname, 0, obj.ADS_name, discov_name,
+                                 obj.comp_name, fp_null, &found,
+                                 &candidate_found, 0);
+bench_report(fp_res, "line_extraction_from_OC6_catalog", "load", nobjects,
+             bench_wall_time() - time0, bench_peak_rss_kb());
+
+nfound = 0;
+time0 = bench_wall_time();
+for(i = 0; i < nqueries; i++) {
+  k = random_object(&state, nobjects);
+  bench_object(k, nobjects, &obj);
+  sprintf(discov_name, "%s%d", obj.discov_code, obj.discov_number);
+  line_extraction_from_OC6_catalog(OC6_fname, 0, obj.ADS_name, discov_name,
+                                   obj.comp_name, fp_null, &found,
+                                   &candidate_found, 0);
+  if(found) nfound++;
+  }
+bench_report(fp_res, "line_extraction_from_OC6_catalog", "function", nqueries,
+             bench_wall_time() - time0, bench_peak_rss_kb());
+printf("bench_OC6: %d objects with orbits found out of %d\n", nfound, nqueries);
+
+fclose(fp_null);
+return(0);
+}
+/*************************************************************************
+* get_values_from_RESID_table()
+* (queries on the measurements of the objects with orbits)
+*************************************************************************/
+static int bench_RESID(char *bench_dir, int nobjects, int nmeas,
+                       unsigned long long seed, int nqueries, FILE *fp_res)
+{
+char resid_fname[256], object_name[64], orbit_ref[60*50], quadrant[20];
+double time0, epoch, rho, theta, rho_o_c[50], theta_o_c[50];
+BENCH_OBJECT obj;
+unsigned long long state = 3;
+int k, i, imeas, orbit_grade, norbits_found, nfound;
+
+sprintf(resid_fname, "%s/%s", bench_dir, BENCH_RESID_FNAME);
+
+/* First call (loading of the table): */
+bench_object(0, nobjects, &obj);
+bench_measure(0, 0, seed, &epoch, &rho, &theta);
+strcpy(object_name, obj.ADS_name);
+time0 = bench_wall_time();
+get_values_from_RESID_table(resid_fname, object_name, obj.comp_name, epoch,
+                            rho, orbit_ref, &orbit_grade, 60, rho_o_c,
+                            theta_o_c, quadrant, &norbits_found, 50);
+bench_report(fp_res, "get_values_from_RESID_table", "load", nobjects,
+             bench_wall_time() - time0, bench_peak_rss_kb());
+
+nfound = 0;
+time0 = bench_wall_time();
+for(i = 0; i < nqueries; i++) {
+/* One object out of four has an orbit (see bench_object()): */
+  k = 4 * (random_object(&state, nobjects) / 4);
+  imeas = (int)(bench_random(&state) % (unsigned long long)nmeas);
+  bench_object(k, nobjects, &obj);
+  bench_measure(k, imeas, seed, &epoch, &rho, &theta);
+  if(obj.ADS_number > 0)
+    strcpy(object_name, obj.ADS_name);
+  else
+    sprintf(object_name, "%s%d", obj.discov_code, obj.discov_number);
+  get_values_from_RESID_table(resid_fname, object_name, obj.comp_name, epoch,
+                              rho, orbit_ref, &orbit_grade, 60, rho_o_c,
+                              theta_o_c, quadrant, &norbits_found, 50);
+  if(norbits_found > 0) nfound++;
+  }
+bench_report(fp_res, "get_values_from_RESID_table", "function", nqueries,
+             bench_wall_time() - time0, bench_peak_rss_kb());
+printf("bench_RESID: %d measurements found out of %d\n", nfound, nqueries);
+
+return(0);
+}
+/*************************************************************************
+* get_coordinates_from_PISCO_catalog() and get_data_from_PISCO_catalog()
+* (the catalog is loaded by the first call)
+*************************************************************************/
+static int bench_PISCO(char *bench_dir, int nobjects, int nqueries,
+                       FILE *fp_res)
+{
+char PISCO_catalog[256], name[64], spectral[64], discov[64], comp[64];
+char ads[64], WDS_name[64];
+double time0, alpha, delta, equinox, magV, B_V, paral, err_paral;
+double magV_A, magV_B;
+BENCH_OBJECT obj;
+unsigned long long state = 4;
+int k, i, npisco, nfound;
+
+sprintf(PISCO_catalog, "%s/%s", bench_dir, BENCH_PISCO_FNAME);
+npisco = nqueries;
+
+nfound = 0;
+time0 = bench_wall_time();
+for(i = 0; i < npisco; i++) {
+  k = random_object(&state, nobjects);
+  bench_object(k, nobjects, &obj);
+  if(obj.ADS_number > 0)
+    strcpy(name, obj.ADS_name);
+  else
+    sprintf(name, "%s %d", obj.discov_code, obj.discov_number);
+  if(get_coordinates_from_PISCO_catalog(PISCO_catalog, name, &alpha, &delta,
+                                        &equinox) == 0) nfound++;
+  }
+bench_report(fp_res, "get_coordinates_from_PISCO_catalog", "function", npisco,
+             bench_wall_time() - time0, bench_peak_rss_kb());
+printf("bench_PISCO: %d coordinates found out of %d\n", nfound, npisco);
+
+nfound = 0;
+time0 = bench_wall_time();
+for(i = 0; i < npisco; i++) {
+  k = random_object(&state, nobjects);
+  bench_object(k, nobjects, &obj);
+  if(obj.ADS_number > 0)
+    strcpy(name, obj.ADS_name);
+  else
+    sprintf(name, "%s %d", obj.discov_code, obj.discov_number);
+  if(get_data_from_PISCO_catalog(PISCO_catalog, name, &magV, &B_V, &paral,
+                                 &err_paral, &magV_A, &magV_B, spectral,
+                                 discov, comp, ads, WDS_name) == 0) nfound++;
+  }
+bench_report(fp_res, "get_data_from_PISCO_catalog", "function", npisco,
+             bench_wall_time() - time0, bench_peak_rss_kb());
+printf("bench_PISCO: %d objects found out of %d\n", nfound, npisco);
+
+return(0);
+}
+/*************************************************************************
+* compute_ephemerid() and OrbitModel::Ephemerid() (one call per epoch)
+* and compute_ephemerides() (all the epochs of an orbit in one call),
+* on the same orbits and epochs
+*************************************************************************/
+static int bench_ephemerides(int nobjects, int nqueries, FILE *fp_res)
+{
+std::vector<ORBIT_ELEMENTS> orbits;
+std::vector<double> epochs, theta_c, rho_c;
+ORBIT_ELEMENTS orb;
+double time0, c_tolerance, sum;
+unsigned long long state = 5;
+int norbits, iorb, j, ncalls;
+
+/* Orbits of the first objects and BENCH_NEPOCHS epochs per orbit: */
+norbits = (nqueries * BENCH_EPHEM_PER_QUERY) / BENCH_NEPOCHS + 1;
+for(iorb = 0; iorb < norbits; iorb++) {
+  bench_orbit(iorb % nobjects, iorb / nobjects, &orb.Omega_node,
+              &orb.omega_peri, &orb.i_incl, &orb.e_eccent, &orb.T_periastron,
+              &orb.Period, &orb.a_smaxis);
+  orb.Omega_node *= DEGTORAD;
+  orb.omega_peri *= DEGTORAD;
+  orb.i_incl *= DEGTORAD;
+  orb.mean_motion = (360.0 / orb.Period) * DEGTORAD;
+  orbits.push_back(orb);
+  }
+epochs.resize(norbits * BENCH_NEPOCHS);
+for(j = 0; j < (int)epochs.size(); j++)
+  epochs[j] = bench_uniform(&state, 2004., 2024.);
+theta_c.resize(epochs.size());
+rho_c.resize(epochs.size());
+ncalls = epochs.size();
+
+sum = 0.;
+time0 = bench_wall_time();
+for(iorb = 0; iorb < norbits; iorb++) {
+  orb = orbits[iorb];
+  c_tolerance = ABS(1.5E-5 * cos(orb.i_incl)
+                     / sqrt((1.0 + orb.e_eccent)/(1.0 - orb.e_eccent)));
+  for(j = iorb * BENCH_NEPOCHS; j < (iorb + 1) * BENCH_NEPOCHS; j++) {
+    compute_ephemerid(orb.Omega_node, orb.omega_peri, orb.i_incl,
+                      orb.e_eccent, orb.T_periastron, orb.Period,
+                      orb.a_smaxis, orb.mean_motion, epochs[j], c_tolerance,
+                      &theta_c[j], &rho_c[j]);
+    sum += rho_c[j];
+    }
+  }
+bench_report(fp_res, "compute_ephemerid", "function", ncalls,
+             bench_wall_time() - time0, bench_peak_rss_kb());
+
+time0 = bench_wall_time();
+for(iorb = 0; iorb < norbits; iorb++)
+  compute_ephemerides(&orbits[iorb], &epochs[iorb * BENCH_NEPOCHS],
+                      BENCH_NEPOCHS, &theta_c[iorb * BENCH_NEPOCHS],
+                      &rho_c[iorb * BENCH_NEPOCHS]);
+bench_report(fp_res, "compute_ephemerides", "function", ncalls,
+             bench_wall_time() - time0, bench_peak_rss_kb());
+
+/* One call per epoch, with the constants of the orbit computed once: */
+time0 = bench_wall_time();
+for(iorb = 0; iorb < norbits; iorb++) {
+  orb = orbits[iorb];
+  OrbitModel model(orb.Omega_node, orb.omega_peri, orb.i_incl, orb.e_eccent,
+                   orb.T_periastron, orb.Period, orb.a_smaxis,
+                   orb.mean_motion);
+  for(j = iorb * BENCH_NEPOCHS; j < (iorb + 1) * BENCH_NEPOCHS; j++)
+    model.Ephemerid(epochs[j], &theta_c[j], &rho_c[j]);
+  }
+bench_report(fp_res, "OrbitModel::Ephemerid", "function", ncalls,
+             bench_wall_time() - time0, bench_peak_rss_kb());
+
+for(j = 0; j < ncalls; j++) sum -= rho_c[j];
+printf("bench_ephemerides: %d orbits, %d epochs (mean difference: %.3e arcsec)\n",
+       norbits, ncalls, sum / (double)ncalls);
+
+return(0);
+}
+/*************************************************************************
+* latex_get_column_item() on all the columns of the calibrated table
+*************************************************************************/
+static int bench_latex(char *bench_dir, FILE *fp_res)
+{
+char calib_fname[256], in_line[256], item[256];
+std::vector<std::string> lines;
+double time0;
+long ncalls;
+int i, icol, verbose_if_error = 0;
+FILE *fp_in;
+
+sprintf(calib_fname, "%s/%s", bench_dir, BENCH_CALIB_FNAME);
+if((fp_in = fopen(calib_fname, "r")) == NULL) {
+  fprintf(stderr, "bench_latex/Error opening %s\n", calib_fname);
+  return(-1);
+  }
+while(fgets(in_line, 256, fp_in))
+  if(in_line[0] != '%' && strchr(in_line, '&') != NULL) lines.push_back(in_line);
+fclose(fp_in);
+
+ncalls = 0;
+time0 = bench_wall_time();
+for(i = 0; i < (int)lines.size(); i++) {
+  strcpy(in_line, lines[i].c_str());
+  for(icol = 1; icol <= 12; icol++) {
+    latex_get_column_item(in_line, item, icol, verbose_if_error);
+    ncalls++;
+    }
+  }
+bench_report(fp_res, "latex_get_column_item", "function", ncalls,
+             bench_wall_time() - time0, bench_peak_rss_kb());
+
+return(0);
+}
+/*************************************************************************
+* compute_ephemerid_of_multiple_system() (one call per epoch) and
+* compute_multiple_system_ephemerides() (all the epochs in one call)
+* on triple systems made of three consecutive orbits
+*************************************************************************/
+static int bench_multiple_ephemerides(int nobjects, int nqueries, FILE *fp_res)
+{
+std::vector<double> epochs, theta_c, rho_c;
+double Omega_node[3], omega_peri[3], i_incl[3], e_eccent[3], T_periastron[3];
+double Period[3], a_smaxis[3], mean_motion[3], c_tolerance[3];
+double time0, time_scalar, time_batch, sum;
+THIELE_ORBIT orbits[3];
+unsigned long long state = 7;
+int nsystems, isys, j, k, ncalls;
+
+nsystems = (nqueries * BENCH_EPHEM_PER_QUERY) / BENCH_NEPOCHS + 1;
+epochs.resize(BENCH_NEPOCHS);
+theta_c.resize(BENCH_NEPOCHS);
+rho_c.resize(BENCH_NEPOCHS);
+ncalls = nsystems * BENCH_NEPOCHS;
+
+sum = 0.;
+time_scalar = 0.;
+time_batch = 0.;
+for(isys = 0; isys < nsystems; isys++) {
+  for(k = 0; k < 3; k++) {
+    bench_orbit((3 * isys + k) % nobjects, isys, &Omega_node[k],
+                &omega_peri[k], &i_incl[k], &e_eccent[k], &T_periastron[k],
+                &Period[k], &a_smaxis[k]);
+    Omega_node[k] *= DEGTORAD;
+    omega_peri[k] *= DEGTORAD;
+    i_incl[k] *= DEGTORAD;
+    mean_motion[k] = (360.0 / Period[k]) * DEGTORAD;
+    c_tolerance[k] = ABS(1.5E-5 * cos(i_incl[k])
+                       / sqrt((1.0 + e_eccent[k])/(1.0 - e_eccent[k])));
+    }
+  for(j = 0; j < BENCH_NEPOCHS; j++)
+    epochs[j] = bench_uniform(&state, 2004., 2024.);
+
+  time0 = bench_wall_time();
+  for(j = 0; j < BENCH_NEPOCHS; j++) {
+    compute_ephemerid_of_multiple_system(3, Omega_node, omega_peri, i_incl,
+                      e_eccent, T_periastron, Period, a_smaxis, mean_motion,
+                      epochs[j], c_tolerance, &theta_c[j], &rho_c[j]);
+    sum += rho_c[j];
+    }
+  time_scalar += bench_wall_time() - time0;
+
+  time0 = bench_wall_time();
+  thiele_orbits_init(3, Omega_node, omega_peri, i_incl, e_eccent,
+                     T_periastron, Period, a_smaxis, mean_motion, orbits);
+  compute_multiple_system_ephemerides(orbits, 3, &epochs[0], BENCH_NEPOCHS,
+                                      NULL, NULL, &theta_c[0], &rho_c[0]);
+  time_batch += bench_wall_time() - time0;
+  for(j = 0; j < BENCH_NEPOCHS; j++) sum -= rho_c[j];
+  }
+
+bench_report(fp_res, "compute_ephemerid_of_multiple_system", "function",
+             ncalls, time_scalar, bench_peak_rss_kb());
+bench_report(fp_res, "compute_multiple_system_ephemerides", "function",
+             ncalls, time_batch, bench_peak_rss_kb());
+printf("bench_multiple_ephemerides: %d triple systems, %d epochs (mean difference: %.3e arcsec)\n",
+       nsystems, ncalls, sum / (double)ncalls);
+
+return(0);
+}
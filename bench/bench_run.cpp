@@ -0,0 +1,82 @@
+/************************************************************************
+* "bench_run.cpp"
+* Run a program of pisco_papers on the synthetic files created by
+* bench_make_inputs, and report its elapsed time and its peak resident
+* memory as a JSON line (see bench_report())
+*
+* Syntax:
+* bench_run results_file name nitems program [arguments...]
+* (results_file = "-" for stdout)
+*
+* Example:
+* bench_run bench_results.jsonl merge_calib_resid 300000 \
+*           ../merge_calib_resid.exe tab_calib.tex tab_resid.tex out.tex
+* bench_run bench_results.jsonl residuals_1 100 \
+*           ../residuals_1.exe -j 4 orbits_resid.txt 2 out_resid \
+*           zeiss_doppie.cat tab_calib.tex
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>            // fork(), execvp()
+#include <sys/types.h>
+#include <sys/wait.h>          // wait4()
+#include <sys/resource.h>      // struct rusage
+#include "bench_utils.h"
+
+int main(int argc, char *argv[])
+{
+double time0, seconds;
+long nitems;
+int status;
+pid_t pid;
+struct rusage usage;
+FILE *fp_res;
+
+if(argc < 5) {
+  printf("Syntax: bench_run results_file name nitems program [arguments...]\n");
+  printf("(results_file = - for stdout)\n");
+  return(-1);
+  }
+if(sscanf(argv[3], "%ld", &nitems) != 1) {
+  fprintf(stderr, "bench_run/Fatal error: bad number of items: %s\n", argv[3]);
+  return(-1);
+  }
+
+time0 = bench_wall_time();
+if((pid = fork()) < 0) {
+  fprintf(stderr, "bench_run/Fatal error: fork failed\n");
+  return(-1);
+  }
+if(pid == 0) {
+  execvp(argv[4], &argv[4]);
+  fprintf(stderr, "bench_run/Fatal error: cannot run %s\n", argv[4]);
+  _exit(127);
+  }
+if(wait4(pid, &status, 0, &usage) < 0) {
+  fprintf(stderr, "bench_run/Fatal error: wait4 failed\n");
+  return(-1);
+  }
+seconds = bench_wall_time() - time0;
+
+if(!WIFEXITED(status) || WEXITSTATUS(status) == 127) {
+  fprintf(stderr, "bench_run/Error: %s did not terminate normally (status=%d)\n",
+          argv[4], status);
+  return(-1);
+  }
+
+if(!strcmp(argv[1], "-")) {
+  fp_res = stdout;
+} else if((fp_res = fopen(argv[1], "a")) == NULL) {
+  fprintf(stderr, "bench_run/Fatal error opening %s\n", argv[1]);
+  return(-1);
+  }
+bench_report(fp_res, argv[2], "program", nitems, seconds,
+             (long)usage.ru_maxrss);
+if(fp_res != stdout) fclose(fp_res);
+
+return(0);
+}
@@ -0,0 +1,199 @@
+/************************************************************************
+* "bench_utils.cpp"
+* Routines shared by the benchmark programs of bench/ (see bench_utils.h)
+*
+* Contained here:
+* double bench_wall_time(void);
+* long bench_peak_rss_kb(void);
+* void bench_report(FILE *fp_out, const char *name, const char *kind,
+*                   long nitems, double seconds, long peak_rss_kb);
+* unsigned long long bench_random(unsigned long long *state);
+* double bench_uniform(unsigned long long *state, double vmin, double vmax);
+* void bench_object(int k, int nobjects, BENCH_OBJECT *obj);
+* void bench_measure(int k, int imeas, unsigned long long seed, double *epoch,
+*                    double *rho, double *theta);
+* void bench_orbit(int k, int iorb, double *Omega_node, double *omega_peri,
+*                  double *i_incl, double *e_eccent, double *T_periastron,
+*                  double *Period, double *a_smaxis);
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <time.h>              // clock_gettime()
+#include <sys/resource.h>      // getrusage()
+#include "bench_utils.h"
+
+/* Discoverer's codes used for the synthetic objects (3 characters
+* at most, so that the 7-character WDS designation has 4 digits): */
+static const char *bench_discov_codes[] = {
+  "STF", "STT", "BU", "COU", "HU", "A", "MCA", "HDS", "FIN", "KUI",
+  "WOR", "RST", "CHR", "YSC", "TOK", "JEF", "HO", "AC", "SCA", "MLR",
+  "I", "B", "DA", "ES", "HEI", "LDS"};
+#define BENCH_NCODES ((int)(sizeof(bench_discov_codes) / sizeof(char *)))
+
+/*************************************************************************
+* Elapsed time in seconds (monotonic clock)
+*************************************************************************/
+double bench_wall_time(void)
+{
+struct timespec ts;
+
+clock_gettime(CLOCK_MONOTONIC, &ts);
+
+return((double)ts.tv_sec + 1.e-9 * (double)ts.tv_nsec);
+}
+/*************************************************************************
+* Peak resident memory of the current process since it started (kbytes)
+*************************************************************************/
+long bench_peak_rss_kb(void)
+{
+struct rusage usage;
+
+if(getrusage(RUSAGE_SELF, &usage) != 0) return(-1);
+
+return((long)usage.ru_maxrss);
+}
+/*************************************************************************
+* Write the result of a benchmark in machine-readable form
+* (one JSON object per line), e.g.:
+* {"bench":"compute_ephemerid","kind":"function","n":1000000,
+*  "seconds":0.412000,"per_second":2427184.5,"peak_rss_kb":3456}
+*
+* INPUT:
+* name: name of the function or of the program
+* kind: "function", "load" (first call, including the reading of a file)
+*       or "program" (whole program run by bench_run)
+* nitems: number of items processed (calls, lines, objects...)
+* seconds: elapsed time
+* peak_rss_kb: peak resident memory (kbytes)
+*************************************************************************/
+void bench_report(FILE *fp_out, const char *name, const char *kind,
+                  long nitems, double seconds, long peak_rss_kb)
+{
+double per_second;
+
+per_second = (seconds > 0.) ? (double)nitems / seconds : 0.;
+
+fprintf(fp_out, "{\"bench\":\"%s\",\"kind\":\"%s\",\"n\":%ld,\"seconds\":%.6f,\"per_second\":%.1f,\"peak_rss_kb\":%ld}\n",
+        name, kind, nitems, seconds, per_second, peak_rss_kb);
+fflush(fp_out);
+}
+/*************************************************************************
+* Next pseudo-random number (SplitMix64 generator)
+*************************************************************************/
+unsigned long long bench_random(unsigned long long *state)
+{
+unsigned long long z;
+
+*state += 0x9E3779B97F4A7C15ULL;
+z = *state;
+z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+
+return(z ^ (z >> 31));
+}
+/*************************************************************************
+* Pseudo-random number uniformly distributed in [vmin, vmax[
+*************************************************************************/
+double bench_uniform(unsigned long long *state, double vmin, double vmax)
+{
+double u;
+
+u = (double)(bench_random(state) >> 11) / 9007199254740992.;
+
+return(vmin + u * (vmax - vmin));
+}
+/*************************************************************************
+* Designation and coordinates of the synthetic object #k
+* (the objects are sorted by right ascension, as in the WDS catalog)
+*
+* INPUT:
+* k: index of the object (from 0 to nobjects-1)
+* nobjects: number of objects
+*
+* OUTPUT:
+* obj: designation of the object
+*************************************************************************/
+void bench_object(int k, int nobjects, BENCH_OBJECT *obj)
+{
+unsigned long long state;
+int ra_h, ra_m, dec_d, dec_m;
+double ra_min, dec_abs;
+
+/* Right ascension increasing with k and random declination: */
+obj->alpha = 24. * ((double)k + 0.5) / (double)nobjects;
+state = 12345ULL + (unsigned long long)k;
+obj->delta = bench_uniform(&state, -30., 85.);
+
+/* WDS name: hhmmm+ddmm (minutes of RA with one decimal) */
+ra_h = (int)obj->alpha;
+ra_min = (obj->alpha - ra_h) * 60.;
+ra_m = (int)(ra_min * 10.);
+dec_abs = (obj->delta < 0.) ? -obj->delta : obj->delta;
+dec_d = (int)dec_abs;
+dec_m = (int)((dec_abs - dec_d) * 60.);
+sprintf(obj->WDS_name, "%02d%03d%c%02d%02d", ra_h, ra_m,
+        (obj->delta < 0.) ? '-' : '+', dec_d, dec_m);
+
+/* Discoverer's name with 7 characters (e.g. "STF   2" or "STF1338"): */
+strcpy(obj->discov_code, bench_discov_codes[k % BENCH_NCODES]);
+obj->discov_number = (k / BENCH_NCODES) % 9999 + 1;
+sprintf(obj->discov_name, "%-3s%4d", obj->discov_code, obj->discov_number);
+
+/* Companion: */
+strcpy(obj->comp_name, (k % 7 == 6) ? "BC" : "AB");
+
+/* ADS number for one object out of three: */
+obj->ADS_number = 0;
+obj->ADS_name[0] = '\0';
+if(k % 3 == 0 && k / 3 + 1 <= 99999) {
+  obj->ADS_number = k / 3 + 1;
+  sprintf(obj->ADS_name, "ADS %d", obj->ADS_number);
+  }
+
+/* One object out of four has an orbit, one out of sixteen has two orbits: */
+obj->norbits = 0;
+if(k % 4 == 0) obj->norbits = 1;
+if(k % 16 == 0) obj->norbits = 2;
+}
+/*************************************************************************
+* Measurement #imeas of the synthetic object #k
+* (the values are rounded as in the calibrated tables, so that they can
+*  be used to look for the residuals of this measurement)
+*
+* OUTPUT:
+* epoch: Besselian epoch (years)
+* rho, theta: angular separation (arcsec) and position angle (degrees)
+*************************************************************************/
+void bench_measure(int k, int imeas, unsigned long long seed, double *epoch,
+                   double *rho, double *theta)
+{
+unsigned long long state;
+
+state = seed * 1000003ULL + (unsigned long long)k * 64ULL
+        + (unsigned long long)imeas;
+*epoch = 0.001 * (int)(1000. * bench_uniform(&state, 2004., 2024.));
+*rho = 0.001 * (int)(1000. * bench_uniform(&state, 0.1, 3.));
+*theta = 0.1 * (int)(10. * bench_uniform(&state, 0., 360.));
+}
+/*************************************************************************
+* Orbital elements of the orbit #iorb of the synthetic object #k
+* (angles in degrees, as in the OC6 catalog)
+*************************************************************************/
+void bench_orbit(int k, int iorb, double *Omega_node, double *omega_peri,
+                 double *i_incl, double *e_eccent, double *T_periastron,
+                 double *Period, double *a_smaxis)
+{
+unsigned long long state;
+
+state = 777ULL + (unsigned long long)k * 8ULL + (unsigned long long)iorb;
+*Period = bench_uniform(&state, 2., 500.);
+*a_smaxis = bench_uniform(&state, 0.05, 2.);
+*i_incl = bench_uniform(&state, 0., 180.);
+*Omega_node = bench_uniform(&state, 0., 180.);
+*T_periastron = bench_uniform(&state, 1900., 2020.);
+*e_eccent = bench_uniform(&state, 0., 0.95);
+*omega_peri = bench_uniform(&state, 0., 360.);
+}
@@ -0,0 +1,60 @@
+/************************************************************************
+* "bench_utils.h"
+* Routines shared by the benchmark programs of bench/ :
+* - timer and peak resident memory (RSS),
+* - report of the results in machine-readable form (one JSON object
+*   per line, appended to the results file),
+* - reproducible random numbers and names of the synthetic objects,
+*   so that bench_pscplib can query the objects created by
+*   bench_make_inputs without reading its files.
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#ifndef __bench_utils_h   /* BOF sentry */
+#define __bench_utils_h
+
+#include <stdio.h>
+
+/* Names of the synthetic files created by bench_make_inputs in the
+* benchmark directory: */
+#define BENCH_WDS_FNAME "wdsweb_summ.txt"
+#define BENCH_OC6_FNAME "orb6orbits.txt"
+#define BENCH_PISCO_FNAME "zeiss_doppie.cat"
+#define BENCH_CALIB_FNAME "tab_calib.tex"
+#define BENCH_RESID_FNAME "tab_resid.tex"
+
+/* Designation of a synthetic object: */
+typedef struct {
+  char WDS_name[16];       // e.g. "09210+3811"
+  char discov_name[16];    // 7 characters as in the WDS: e.g. "STF1338"
+  char discov_code[8];     // e.g. "STF"
+  int discov_number;       // e.g. 1338
+  char comp_name[8];       // e.g. "AB"
+  char ADS_name[16];       // e.g. "ADS 7307" or "" if no ADS number
+  int ADS_number;          // 0 if no ADS number
+  double alpha, delta;     // coordinates (hours, degrees) for equinox 2000
+  int norbits;             // number of orbits in the OC6 list (0, 1 or 2)
+} BENCH_OBJECT;
+
+/* Timer and memory: */
+double bench_wall_time(void);
+long bench_peak_rss_kb(void);
+
+/* Report of a benchmark (one JSON line): */
+void bench_report(FILE *fp_out, const char *name, const char *kind,
+                  long nitems, double seconds, long peak_rss_kb);
+
+/* Random numbers (same sequence on all the platforms): */
+unsigned long long bench_random(unsigned long long *state);
+double bench_uniform(unsigned long long *state, double vmin, double vmax);
+
+/* Synthetic objects: */
+void bench_object(int k, int nobjects, BENCH_OBJECT *obj);
+void bench_measure(int k, int imeas, unsigned long long seed, double *epoch,
+                   double *rho, double *theta);
+void bench_orbit(int k, int iorb, double *Omega_node, double *omega_peri,
+                 double *i_incl, double *e_eccent, double *T_periastron,
+                 double *Period, double *a_smaxis);
+
+#endif   /* EOF sentry */
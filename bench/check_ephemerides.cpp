@@ -0,0 +1,189 @@
+/************************************************************************
+* "check_ephemerides.cpp"
+* Check of the accuracy of compute_ephemerides() (pscplib/residuals_utils.cpp)
+* against a reference computed in extended precision (long double),
+* on random orbits and epochs.
+*
+* The reference solves Kepler's equation with Newton's iterations in
+* long double until the correction is below 1e-18, and computes the
+* position angle and the separation with the same formulae as
+* compute_ephemerides(). The conversion to degrees and the interval
+* [0,360] are those of compute_ephemerid() (PI of jlp_catalog_utils.h),
+* hence this is not part of the comparison.
+*
+* Three differences are checked against the tolerance:
+*  - rho (arcseconds),
+*  - rho * theta (arcseconds, displacement along the position angle),
+*  - theta (degrees) for rho >= CHECK_RHO_MIN only, since the position
+*    angle is ill-conditioned close to the primary (e.g. 5e-10 degrees
+*    for rho=0.001", i.e. a displacement of 1e-14")
+*
+* The differences of compute_ephemerid() with the reference are also
+* given (with the tolerance used by residuals_1), for information only.
+*
+* Syntax:
+* check_ephemerides [norbits] [nepochs_per_orbit] [tolerance]
+* (default: 2000 orbits, 2000 epochs per orbit, tolerance 1e-10)
+*
+* Exit status: 0 if the differences of compute_ephemerides()
+* with the reference are below the tolerance, -1 otherwise.
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+#include "bench_utils.h"
+#include "residuals_utils.h"     // compute_ephemerid(), compute_ephemerides()
+
+#define REF_PI 3.14159265358979323846264338327950288L
+/* Minimum separation for the check of theta (arcseconds): */
+#define CHECK_RHO_MIN 0.05
+
+/* Maximum differences with the reference: */
+typedef struct {
+  double drho, dtheta_arc, dtheta;
+} CHECK_DIFF;
+
+static void reference_ephemerid(const ORBIT_ELEMENTS *orb, double epoch,
+                                long double *theta_c, long double *rho_c);
+static void update_differences(double theta1, double rho1,
+                               long double theta_ref, long double rho_ref,
+                               CHECK_DIFF *diff);
+
+int main(int argc, char *argv[])
+{
+std::vector<double> epochs, theta_c, rho_c;
+ORBIT_ELEMENTS orb;
+CHECK_DIFF diff = {0., 0., 0.}, diff1 = {0., 0., 0.};
+long double theta_ref, rho_ref;
+double tolerance = 1.e-10, c_tolerance, theta1, rho1;
+unsigned long long state = 11;
+int norbits = 2000, nepochs = 2000, iorb, j, status;
+
+if(argc > 1) norbits = atoi(argv[1]);
+if(argc > 2) nepochs = atoi(argv[2]);
+if(argc > 3) tolerance = atof(argv[3]);
+if(norbits <= 0 || nepochs <= 0 || tolerance <= 0.) {
+  printf(" Syntax: check_ephemerides [norbits] [nepochs_per_orbit] [tolerance]\n");
+  exit(-1);
+  }
+
+epochs.resize(nepochs);
+theta_c.resize(nepochs);
+rho_c.resize(nepochs);
+
+for(iorb = 0; iorb < norbits; iorb++) {
+/* Random orbit (one out of five with a high eccentricity,
+* one out of ten nearly edge-on): */
+  orb.Period = bench_uniform(&state, 1., 500.);
+  orb.T_periastron = bench_uniform(&state, 1900., 2030.);
+  orb.a_smaxis = bench_uniform(&state, 0.05, 5.);
+  orb.Omega_node = bench_uniform(&state, 0., 180.) * DEGTORAD;
+  orb.omega_peri = bench_uniform(&state, 0., 360.) * DEGTORAD;
+  if(iorb % 10 == 9)
+    orb.i_incl = bench_uniform(&state, 89.5, 90.5) * DEGTORAD;
+  else
+    orb.i_incl = bench_uniform(&state, 0., 180.) * DEGTORAD;
+  if(iorb % 5 == 4)
+    orb.e_eccent = bench_uniform(&state, 0.95, 0.9995);
+  else
+    orb.e_eccent = bench_uniform(&state, 0., 0.95);
+  orb.mean_motion = (360.0 / orb.Period) * DEGTORAD;
+  for(j = 0; j < nepochs; j++)
+    epochs[j] = bench_uniform(&state, 1800., 2100.);
+
+  compute_ephemerides(&orb, &epochs[0], nepochs, &theta_c[0], &rho_c[0]);
+
+  c_tolerance = ABS(1.5E-5 * cos(orb.i_incl)
+                     / sqrt((1.0 + orb.e_eccent)/(1.0 - orb.e_eccent)));
+  for(j = 0; j < nepochs; j++) {
+    reference_ephemerid(&orb, epochs[j], &theta_ref, &rho_ref);
+    update_differences(theta_c[j], rho_c[j], theta_ref, rho_ref, &diff);
+/* Scalar version (for information): */
+    compute_ephemerid(orb.Omega_node, orb.omega_peri, orb.i_incl,
+                      orb.e_eccent, orb.T_periastron, orb.Period,
+                      orb.a_smaxis, orb.mean_motion, epochs[j], c_tolerance,
+                      &theta1, &rho1);
+    update_differences(theta1, rho1, theta_ref, rho_ref, &diff1);
+    }
+  }
+
+printf("check_ephemerides: %d orbits, %d epochs per orbit\n", norbits,
+       nepochs);
+printf("Maximum differences with the reference: |drho| (arcsec), rho*|dtheta| (arcsec), |dtheta| for rho >= %.2f\" (deg)\n",
+       CHECK_RHO_MIN);
+printf("compute_ephemerides: %.3e %.3e %.3e\n", diff.drho,
+       diff.dtheta_arc, diff.dtheta);
+printf("compute_ephemerid:   %.3e %.3e %.3e\n", diff1.drho,
+       diff1.dtheta_arc, diff1.dtheta);
+
+status = (diff.drho < tolerance && diff.dtheta_arc < tolerance
+          && diff.dtheta < tolerance) ? 0 : -1;
+printf("compute_ephemerides: %s (tolerance: %.1e)\n",
+       (status == 0) ? "OK" : "FAILED", tolerance);
+
+return(status);
+}
+/*************************************************************************
+* Ephemerid computed in extended precision
+* (same formulae as compute_ephemerides(), theta in degrees)
+*************************************************************************/
+static void reference_ephemerid(const ORBIT_ELEMENTS *orb, double epoch,
+                                long double *theta_c, long double *rho_c)
+{
+long double daa, mean_anomaly, ee, dee, ecc, rr, cos_nu, sin_nu, pp;
+long double ab, theta;
+int iter;
+
+ecc = orb->e_eccent;
+daa = (long double)epoch - (long double)orb->T_periastron;
+daa = daa - orb->Period * (long double)((int)(daa / orb->Period));
+mean_anomaly = orb->mean_motion * daa;
+mean_anomaly -= 2.L * REF_PI * floorl(mean_anomaly / (2.L * REF_PI) + 0.5L);
+
+/* Newton's iterations, starting from +/-PI for high eccentricities: */
+if(ecc > 0.8) ee = (mean_anomaly < 0.L) ? -REF_PI : REF_PI;
+else ee = mean_anomaly;
+for(iter = 0; iter < 100; iter++) {
+  dee = (ee - ecc * sinl(ee) - mean_anomaly) / (1.L - ecc * cosl(ee));
+  ee -= dee;
+  if(fabsl(dee) < 1.e-18L) break;
+  }
+
+rr = 1.L - ecc * cosl(ee);
+cos_nu = (cosl(ee) - ecc) / rr;
+sin_nu = sqrtl(1.L - ecc * ecc) * sinl(ee) / rr;
+pp = atan2l(sin_nu, cos_nu) + orb->omega_peri;
+ab = cosl((long double)orb->i_incl) * sinl(pp);
+theta = atan2l(ab, cosl(pp));
+if(theta < 0.L) theta += 2.L * PI;
+
+/* Conversion to degrees as in compute_ephemerid(): */
+*theta_c = (theta + orb->Omega_node) * (180.L / PI);
+if(*theta_c < 0.L) *theta_c += 360.L;
+if(*theta_c > 360.L) *theta_c -= 360.L;
+
+*rho_c = orb->a_smaxis * rr * sqrtl(cosl(pp) * cosl(pp) + ab * ab);
+}
+/*************************************************************************
+* Update the maximum differences with the reference
+* (theta in degrees, compared modulo 360)
+*************************************************************************/
+static void update_differences(double theta1, double rho1,
+                               long double theta_ref, long double rho_ref,
+                               CHECK_DIFF *diff)
+{
+double dtheta, drho;
+
+dtheta = (double)fabsl(theta1 - theta_ref);
+if(dtheta > 180.) dtheta = 360. - dtheta;
+drho = (double)fabsl(rho1 - rho_ref);
+
+if(drho > diff->drho) diff->drho = drho;
+if(dtheta * DEGTORAD * (double)rho_ref > diff->dtheta_arc)
+  diff->dtheta_arc = dtheta * DEGTORAD * (double)rho_ref;
+if(rho_ref >= CHECK_RHO_MIN && dtheta > diff->dtheta) diff->dtheta = dtheta;
+}
@@ -21,6 +21,7 @@ with filename in column 1, comments in col. 9, rho in col. 12, theta in col. 14
 *************************************************************************/
 #include "tex_calib_utils.h" 
 #include "csv_utils.h" 
+#include "meas_match.h"    // MeasMatcher 
 #include "latex_utils.h" 
 #include "astrom_utils1.h" 
 #include "astrom_utils2.h" 
@@ -121,7 +122,8 @@ double epoch3, rho3, err_rho3, theta3, err_theta3;
 double max_drho, max_dtheta;
 FILE *fp_in2, *fp_discrep_out, *fp_out;
 OBJECT *obj1, *obj3;
-int i, nobj1 = 0, nobj3 = 0, ncompat = 0;
+MeasMatcher *matcher1;
+int nobj1 = 0, nobj3 = 0, ncompat = 0;
 
 if((fp_discrep_out = fopen(discrep_cmp_out,"w")) == NULL)
  {
@@ -141,13 +143,7 @@ fprintf(fp_discrep_out,"%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 fprintf(fp_discrep_out,"%%%% discrepant/compare file_tex=%s and file_csv=%s\n", file_tex, file_csv);
 fprintf(fp_discrep_out,"%%%% JLP / Version of 14/01/2023 \n");
 
-if((obj1 = (OBJECT *)malloc(NOBJ_MAX * sizeof(OBJECT))) == NULL) {
-  printf("calib_tex_compare_files/Fatal error allocating memory space for OBJECT: nobj_max=%d\n",
-          NOBJ_MAX);
-  exit(-1);
-  }
-// Initialize the number of measurements to zero
-for(i = 0; i < NOBJ_MAX; i++) (obj1[i]).nmeas = 0;
+obj1 = astrom_alloc_objects(NOBJ_MAX);
 
   printf("OK1 calling csv_read_gili_measures for %s\n", file_csv);
 // Read the input Gili's csv meas. and create the catalog of meas. OBJECT obj1
@@ -157,10 +153,10 @@ printf("calib_tex_compare_files: in_csv=%s nobj=%d scale_mini=%.3f\n",
          file_csv, nobj1, scale_mini);
 #endif
 
-if((obj3 = (OBJECT *)malloc(2 * sizeof(OBJECT))) == NULL) {
-  printf("calib_tex_compare_files/Fatal error allocating memory space for OBJECT: nobj_max=1 \n");
-  exit(-1);
-  }
+// Index the catalog of meas. by object name and epoch:
+matcher1 = new MeasMatcher(obj1, nobj1, 0);
+
+obj3 = astrom_alloc_objects(2);
 
 // Scan the LaTeX table of measurements
 if((fp_in2 = fopen(file_tex,"r")) == NULL) {
@@ -205,10 +201,9 @@ while(!feof(fp_in2))
     if((rho3 > 0 && rho3 != NO_DATA) && (theta3 != NO_DATA)) {
 // Look for the measurements of the same object in the catalog obj1 
 // using ObjectName3 and epoch3:
-      istat = tex_calib_get_meas_from_csv_object(obj1, nobj1, ObjectName3, 
-                                       epoch3, ObjectName1, &epoch1, &eyep1,
-                                       &rho1, &err_rho1, &theta1, &err_theta1, 
-                                       &dmag1);
+      istat = matcher1->GetCsvMeas(ObjectName3, epoch3, ObjectName1, 
+                                   &epoch1, &eyep1, &rho1, &err_rho1, 
+                                   &theta1, &err_theta1, &dmag1);
       if(istat == 0) {
         max_drho = 0.3;
         max_dtheta = 100.;
@@ -265,8 +260,9 @@ printf("Returned by calib_tex_read_measures: nobj1 = %d nmeas=%d rho=%.2f theta=
 }
 #endif
 
-free(obj1);
-free(obj3);
+delete matcher1;
+astrom_free_objects(obj1);
+astrom_free_objects(obj3);
 fclose(fp_in2);
 fclose(fp_out);
 fclose(fp_discrep_out);
@@ -681,13 +677,7 @@ int *index_obj2, tabular_only, nm1;
 int i, j, k, nobj2 = 0;
 int quadrant_correction;
 
-if((obj2 = (OBJECT *)malloc(NOBJ_MAX * sizeof(OBJECT))) == NULL) {
-  printf("calib_tex_compare_files/Fatal error allocating memory space for OBJECT: nobj_max=%d\n",
-          NOBJ_MAX);
-  exit(-1);
-  }
-// Initialize the number of measurements to zero
-for(i = 0; i < NOBJ_MAX; i++) (obj2[i]).nmeas = 0;
+obj2 = astrom_alloc_objects(NOBJ_MAX);
 
 if((index_obj2 = (int *)malloc((NOBJ_MAX) * sizeof(int))) == NULL) {
   printf("calib_tex_compare_files/Fatal error allocating memory space for index_obj: nobj_max=%d\n",
@@ -716,11 +706,8 @@ for(i = 0; i < nobj1; i++) {
                (obj1[i]).name, me1->rho, me1->theta,
                ABS(me1->rho - cmp_me1->rho),
                ABS(me1->theta - cmp_me1->theta));
-             strcpy((obj2[k]).wds, (obj1[i]).wds);
              strcpy((obj2[k]).name, (obj1[i]).name);
-             (obj2[k]).nmeas = (obj1[i]).nmeas;
-             (obj2[k]).WR = (obj1[i]).WR;
-             (obj2[k]).WY= (obj1[i]).WY;
+             astrom_copy_object_for_cmp(&obj2[k], &obj1[i]);
              me2 = &(obj2[k]).meas[j];
              cmp_me2 = &(obj2[k]).cmp_meas[j];
              strcpy(me2->filename, me1->filename); 
@@ -779,7 +766,7 @@ calib_tex_write_publi_cmp_table_gili(fp_cmp_out, obj2, index_obj2, nobj2,
 
 fclose(fp_cmp_out);
 free(index_obj2);
-free(obj2);
+astrom_free_objects(obj2);
 return(0);
 }
 /**************************************************************************
@@ -5,8 +5,16 @@
 *
 * Assumes that the stars moves roughtly along the X axis
 *
+* The files of the list are loaded by batches of NFILES_BATCH files,
+* that are processed in parallel with the "-j N" option (the output
+* does not depend on the number of threads).
+* The mean value of theta0 is computed for each night, and saved
+* in an optional output table.
+*
+* Syntax: calib_theta input_list [output_table] [-j N]
+*
 * JLP 
-* Version 11-01-2017
+* Version 17-10-2026
 -------------------------------------------------------------------*/
 #define DEBUG
 
@@ -15,130 +23,255 @@
 #include <string.h>
 #include <fcntl.h>
 #include <math.h>
+#include <vector>
+#include <string>
+#include <unordered_map>
 // #include <jlp_ftoc.h>
 #include "jlp_numeric.h"
 #include "jlp_fitsio.h"
+#include "jlp_threads.h"    // jlp_parallel_for()
 
 #define NCOEFF 2
 
+/* Number of files loaded before being processed in parallel: */
+#define NFILES_BATCH 32
+/* Number of adjacent columns processed together by compute_centers()
+* (the image is read row by row for those columns): */
+#define NCOL_BLOCK 32
+
+/* File of the list, with its image and its results: */
+typedef struct {
+  char fname[128], night[64];
+  double *image;
+  int nx, ny;
+  double theta0, sigma_theta0;
+/* Messages of the processing (written in the order of the list): */
+  char *log;
+  size_t len_log;
+} CALIB_THETA_FILE;
+
 /* Defined here: */
-static int process_list_for_calib_theta(char *list_fname);
-static int calib_theta_for_one_file(char *in_name, double *mean_theta0, 
-                                    double *sigma_theta0);
+static int process_list_for_calib_theta(char *list_fname, char *out_fname,
+                                        int nthreads);
+static int read_list_for_calib_theta(char *list_fname,
+                                     std::vector<CALIB_THETA_FILE> *files);
+static void calib_theta_worker(int k, void *data);
+static int calib_theta_for_one_file(CALIB_THETA_FILE *cf, FILE *fp_log);
+static int output_theta0_per_night(std::vector<CALIB_THETA_FILE> *files,
+                                   char *out_fname);
 static int find_all_centers(double *dble_image1, double *xcent, double *ycent,
                             INT4 nx, INT4 ny, INT4 idim);
 static int compute_centers(double *dble_image1, double *xcent, double *ycent,
                            int *good_col, INT4 nx, INT4 ny, INT4 idim, 
-                           double *phi, int *npts, int hwidth);
-static int compute_matrices(double *AA, double *BB, double *xcent, 
-                            double *ycent, int npts, int nc);
+                           double *phi, int *npts, int hwidth, FILE *fp_log);
 static int compute_residuals(double *xcent, double *ycent, int npts, 
                              double *phi, double *rms_resid);
 static int reject_bad_columns(double *xcent, double *ycent, int nx, 
-                              int *good_col, double *phi, double threshold);
-static int fit_centers(double *AA, double *BB, double *xcent, 
-                       double *ycent, double *phi, double *theta0,
-                       double *rms_resid, int npts, int ncoeff);
+                              int *good_col, double *phi, double threshold,
+                              FILE *fp_log);
+static int fit_centers(double *xcent, double *ycent, double *phi,
+                       double *theta0, double *rms_resid, int npts,
+                       FILE *fp_log);
 
 int main(int argc, char *argv[])
 {
-int status;
-char list_fname[128];
+int status, nthreads;
+char list_fname[128], out_fname[128];
 
 printf(" Program calib_theta to compute theta zero \n");
-printf(" JLP Version 06-12-2017 \n");
+printf(" JLP Version 17-10-2026 \n");
 
-/* One parameters only is allowed to run the program: */
+nthreads = jlp_threads_from_args(&argc, argv);
+
+/* One or two parameters are allowed to run the program: */
 /* Carefull: 7 parameters always, using JLP "runs" */
 if(argc == 7 && *argv[3]) argc = 4;
 if(argc == 7 && *argv[2]) argc = 3;
 if(argc == 7 && *argv[1]) argc = 2;
-if(argc != 2)
+if(argc != 2 && argc != 3)
   {
-  printf(" Syntax: calib_theta input_list\n"); 
+  printf(" Syntax: calib_theta input_list [output_table] [-j N]\n");
   printf(" input_list: list of long integration image fits files\n");
+  printf("   (one file per line, optionally followed by the night,\n");
+  printf("    otherwise the night is the prefix of the file name, e.g. 120109)\n");
+  printf(" output_table: mean theta0 for each night\n");
   printf(" Fatal: Syntax error: argc=%d\n",argc);
   exit(-1);
   }
 
 /* Input of parameters with the command line: */
  strcpy(list_fname, argv[1]);
+ if(argc == 3) strcpy(out_fname, argv[2]);
+ else out_fname[0] = '\0';
 
- status = process_list_for_calib_theta(list_fname);
+ status = process_list_for_calib_theta(list_fname, out_fname, nthreads);
 
 return(status);
 }
 /*************************************************************************
+* Process all the files of the list
 *
+* INPUT:
+* list_fname: name of the file containing the list of FITS files
+* out_fname: name of the output table with theta0 for each night
+*            ("" if not wanted)
+* nthreads: number of threads used for processing the files
 *************************************************************************/
-static int process_list_for_calib_theta(char *list_fname)
+static int process_list_for_calib_theta(char *list_fname, char *out_fname,
+                                        int nthreads)
 {
-int status, k, nfiles;
-char in_fname[128];
+std::vector<CALIB_THETA_FILE> files;
+CALIB_THETA_FILE *cf;
+int status, k, k0, k1, nfiles;
+char comments1[81];
 double mean_theta0, sigma_theta0, mean_theta1, sigma_theta1;
 double ssum, ssumsq, sumweights, ww;
-FILE *fp;
 
-if((fp = fopen(list_fname,"r")) == NULL) {
-  printf("process_list_for_calib_theta/Error reading list of files >%s<\n",
-          list_fname);
-  return(-1);
+status = read_list_for_calib_theta(list_fname, &files);
+if(status) return(-1);
+nfiles = files.size();
+
+for(k0 = 0; k0 < nfiles; k0 += NFILES_BATCH) {
+  k1 = MINI(k0 + NFILES_BATCH, nfiles);
+/* Load the images of the batch: */
+  for(k = k0; k < k1; k++) {
+    cf = &files[k];
+    status = JLP_LoadFITSImage(cf->fname, comments1, &cf->image, &cf->nx,
+                               &cf->ny);
+    if(status != 0) {
+       printf("calib_theta_for_one_file/Fatal error in JLP_LoadFITSImage status=%d\n", status);
+       exit(-1);
+       }
+    }
+/* Process them in parallel: */
+  jlp_parallel_for(k1 - k0, nthreads, calib_theta_worker, &files[k0]);
+/* Messages in the order of the list: */
+  for(k = k0; k < k1; k++) {
+    cf = &files[k];
+    fwrite(cf->log, 1, cf->len_log, stdout);
+    free(cf->log);
+    free(cf->image);
+    }
   }
 
-/* First go to count the files: */
-k = 0;
+/* Mean over all the files: */
 ssum = 0.;
 ssumsq = 0.;
 sumweights = 0.;
-while(!feof(fp)) {
-  if(fscanf(fp, "%s\n", in_fname)) {
-   k++;
-   status  = calib_theta_for_one_file(in_fname, &mean_theta0, &sigma_theta0);
+for(k = 0; k < nfiles; k++) {
+   mean_theta0 = files[k].theta0;
 // DEBUG
    sigma_theta0 = 1.;
    ww = mean_theta0 / sigma_theta0;
    sumweights += 1. / sigma_theta0;
    ssum += ww;
    ssumsq += ww * ww;
-   }
 }
-fclose(fp);
-nfiles = k;
 
 mean_theta1 = ssum / sumweights;
 printf("mean value: %f (nfiles=%d)\n", mean_theta1, nfiles);
 sigma_theta1 = sqrt(ssumsq / sumweights - mean_theta1 * mean_theta1);
 printf("sigma: %f\n", sigma_theta1);
 
-return(status);
+/* Mean for each night: */
+output_theta0_per_night(&files, out_fname);
+
+return(0);
 }
 /*************************************************************************
+* Read the list of files
+*
+* Example of lines:
+* 120109_drift_1.fits
+* 120109_drift_2.fits 12/01/2009
 *
+* OUTPUT:
+* files: names of the files and of the nights
+*   (the night is the prefix of the file name, before "_", if not given)
 *************************************************************************/
-static int calib_theta_for_one_file(char *in_name, double *mean_theta0, 
-                                    double *sigma_theta0) 
+static int read_list_for_calib_theta(char *list_fname,
+                                     std::vector<CALIB_THETA_FILE> *files)
 {
-double *AA, *BB, phi[NCOEFF];
+CALIB_THETA_FILE cf;
+char in_line[256], *pc;
+int nval;
+FILE *fp;
+
+if((fp = fopen(list_fname,"r")) == NULL) {
+  printf("process_list_for_calib_theta/Error reading list of files >%s<\n",
+          list_fname);
+  return(-1);
+  }
+
+while(fgets(in_line, 256, fp)) {
+  nval = sscanf(in_line, "%127s %63s", cf.fname, cf.night);
+  if(nval < 1) continue;
+  if(nval == 1) {
+/* Night from the file name (without directory): */
+    pc = strrchr(cf.fname, '/');
+    pc = (pc == NULL) ? cf.fname : pc + 1;
+    strncpy(cf.night, pc, 63);
+    cf.night[63] = '\0';
+    pc = strchr(cf.night, '_');
+    if(pc != NULL) *pc = '\0';
+    }
+  cf.image = NULL;
+  cf.log = NULL;
+  cf.len_log = 0;
+  cf.theta0 = 0.;
+  cf.sigma_theta0 = 0.;
+  files->push_back(cf);
+  }
+fclose(fp);
+
+return(0);
+}
+/*************************************************************************
+* Process file #k of the batch (called by the threads of the pool)
+* The messages are stored in memory, to be written in the order of the list
+*************************************************************************/
+static void calib_theta_worker(int k, void *data)
+{
+CALIB_THETA_FILE *cf = &((CALIB_THETA_FILE *)data)[k];
+FILE *fp_log;
+
+fp_log = open_memstream(&cf->log, &cf->len_log);
+if(fp_log == NULL) {
+  fprintf(stderr, "calib_theta_worker/Fatal error allocating memory\n");
+  exit(-1);
+  }
+
+calib_theta_for_one_file(cf, fp_log);
+
+fclose(fp_log);
+}
+/*************************************************************************
+* Compute theta0 for one image
+*
+* INPUT:
+* cf->image[cf->nx, cf->ny]: image of the star trace
+*
+* OUTPUT:
+* cf->theta0, cf->sigma_theta0: theta0 (degrees) and rms of the residuals
+*************************************************************************/
+static int calib_theta_for_one_file(CALIB_THETA_FILE *cf, FILE *fp_log)
+{
+double phi[NCOEFF];
 double *xcent, *ycent; 
 double theta0, rms_resid, old_rms_resid, threshold; 
 int *good_col;
 double *dble_image1;
-int status, ncoeff, npts, hwidth, nx1, ny1, idim;
-char comments1[81];
+int status, npts, hwidth, nx1, ny1, idim;
 int i, imax;
 
-AA = NULL; BB= NULL; ncoeff = NCOEFF; 
-*mean_theta0 = 0.;
-*sigma_theta0 = 0.;
+cf->theta0 = 0.;
+cf->sigma_theta0 = 0.;
 
-printf("calib_theta_for_one_file: processing %s\n", in_name);
+fprintf(fp_log, "calib_theta_for_one_file: processing %s\n", cf->fname);
 
-/**********************************************************/
-  status = JLP_LoadFITSImage(in_name, comments1, &dble_image1, &nx1, &ny1);
-  if(status != 0) {
-     printf("calib_theta_for_one_file/Fatal error in JLP_LoadFITSImage status=%d\n", status); 
-     exit(-1);
-     }
+dble_image1 = cf->image;
+nx1 = cf->nx;
+ny1 = cf->ny;
 
 /* Problem with the ICCD when nx = 384: last two columns are bad ! */
   idim = nx1;
@@ -147,17 +280,12 @@ printf("calib_theta_for_one_file: processing %s\n", in_name);
   xcent = (double *)malloc(nx1 * sizeof(double));
   ycent = (double *)malloc(nx1 * sizeof(double));
 /* Flags for good columns */
-  good_col = (int *)malloc(nx1 * sizeof(double));
+  good_col = (int *)malloc(nx1 * sizeof(int));
   for(i = 0; i < nx1; i++) good_col[i] = 1;
 
-/* Matrices for least-squares: */
-AA = (double *)malloc(nx1 * ncoeff * sizeof(double));
-BB = (double *)malloc(nx1 * sizeof(double));
-
 /* First iteration with all columns: */
   find_all_centers(dble_image1, xcent, ycent, nx1, ny1, nx1);
-  status = fit_centers(AA, BB, xcent, ycent, phi, &theta0, &rms_resid,
-                       nx1, ncoeff);
+  status = fit_centers(xcent, ycent, phi, &theta0, &rms_resid, nx1, fp_log);
 
 /* 6 more iterations: */
   if(!status) {
@@ -169,27 +297,86 @@ BB = (double *)malloc(nx1 * sizeof(double));
 * a sigment of size (2 * half_width): */
    hwidth = MAXI(3. * rms_resid, 6);
    compute_centers(dble_image1, xcent, ycent, good_col, nx1, ny1, idim, phi, 
-                   &npts, hwidth);
+                   &npts, hwidth, fp_log);
 
 /* Solve problem again */
-   status = fit_centers(AA, BB, xcent, ycent, phi, &theta0, &rms_resid,
-                        npts, ncoeff);
+   status = fit_centers(xcent, ycent, phi, &theta0, &rms_resid, npts, fp_log);
 
 /* Select columns by removing all columns for which the residuals 
 * are larger than 2.5 sigma (with a minimum value of 1 pixel): */
    threshold = MAXI(2.5 * rms_resid, 1.);
-   reject_bad_columns(xcent, ycent, nx1, good_col, phi, threshold);
+   reject_bad_columns(xcent, ycent, nx1, good_col, phi, threshold, fp_log);
    }
   }
 
-*mean_theta0 = theta0;
-*sigma_theta0 = rms_resid;
+cf->theta0 = theta0;
+cf->sigma_theta0 = rms_resid;
 
   free(xcent);
   free(ycent);
-if(AA != NULL) free(AA);
-if(BB != NULL) free(BB);
+  free(good_col);
 
+return(0);
+}
+/*************************************************************************
+* Mean value of theta0 for each night (in the order of the list)
+*
+* INPUT:
+* files: files with their theta0
+* out_fname: name of the output table ("" if not wanted)
+*************************************************************************/
+static int output_theta0_per_night(std::vector<CALIB_THETA_FILE> *files,
+                                   char *out_fname)
+{
+std::vector<std::string> nights;
+std::vector<double> sum, sumsq;
+std::vector<int> nn;
+std::unordered_map<std::string, int> index_night;
+std::unordered_map<std::string, int>::iterator it;
+double mean, sigma;
+int k, in;
+FILE *fp_out = NULL;
+
+for(k = 0; k < (int)files->size(); k++) {
+  it = index_night.find((*files)[k].night);
+  if(it == index_night.end()) {
+    in = nights.size();
+    index_night[(*files)[k].night] = in;
+    nights.push_back((*files)[k].night);
+    sum.push_back(0.);
+    sumsq.push_back(0.);
+    nn.push_back(0);
+  } else {
+    in = it->second;
+  }
+  sum[in] += (*files)[k].theta0;
+  sumsq[in] += (*files)[k].theta0 * (*files)[k].theta0;
+  nn[in]++;
+  }
+
+if(*out_fname) {
+  if((fp_out = fopen(out_fname, "w")) == NULL) {
+    fprintf(stderr, "output_theta0_per_night/Error opening output file %s\n",
+            out_fname);
+    return(-1);
+    }
+  fprintf(fp_out, "%% theta0 for each night (from calib_theta)\n");
+  fprintf(fp_out, "%% Night  nfiles  theta0 (deg)  sigma (deg)  sigma_mean (deg)\n");
+  }
+
+printf("Night  nfiles  theta0  sigma  sigma_mean\n");
+for(in = 0; in < (int)nights.size(); in++) {
+  mean = sum[in] / (double)nn[in];
+  sigma = sumsq[in] / (double)nn[in] - mean * mean;
+  sigma = (sigma > 0.) ? sqrt(sigma) : 0.;
+  printf("%s %d %.3f %.3f %.3f\n", nights[in].c_str(), nn[in], mean, sigma,
+         sigma / sqrt((double)nn[in]));
+  if(fp_out != NULL)
+    fprintf(fp_out, "%s %d %.3f %.3f %.3f\n", nights[in].c_str(), nn[in],
+            mean, sigma, sigma / sqrt((double)nn[in]));
+  }
+
+if(fp_out != NULL) fclose(fp_out);
 return(0);
 }
 /******************************************************************
@@ -254,6 +441,15 @@ return(0);
 * Determine the center of gravity of the trace along the columns using the
 * result of the coefficient fit as a first guess 
 *
+* The columns are processed by blocks of NCOL_BLOCK adjacent columns:
+* the image is read row by row over the windows of the columns of the block,
+* with contiguous access in the inner loops.
+* The sums of each column are done in the same order as column by column.
+*
+* The background has the same value as with the former loops on [jback1,j1[
+* and [2,jback2[ of each column (last pixel of those ranges divided by their
+* number of pixels).
+* The columns whose window is empty or has a zero weight are not selected.
 *
 * INPUT:
 * dble_image1[nx, ny]: input image
@@ -267,106 +463,103 @@ return(0);
 *******************************************************************/
 static int compute_centers(double *dble_image1, double *xcent, double *ycent,
                            int *good_col, INT4 nx, INT4 ny, INT4 idim, 
-                           double *phi, int *npts, int hwidth)
+                           double *phi, int *npts, int hwidth, FILE *fp_log)
 {
-double sum, sumw, yyc, backg;
-double ww, wmax;
-int j1, j2, jmax, jjc, jback1, jback2, nn;
-register int i, j, k;
+double sum[NCOL_BLOCK], sumw[NCOL_BLOCK], backg[NCOL_BLOCK];
+double wmax[NCOL_BLOCK], mask[NCOL_BLOCK], yyc, ww, *row;
+int j1[NCOL_BLOCK], j2[NCOL_BLOCK], jmax[NCOL_BLOCK];
+int jjc, jback1, jback2, jlow, jhigh, nn, i0, nc;
+register int i, j, k, ic;
 
-/* Loop on the columns */
 k = 0;
-for(i = 0; i < nx; i++) {
-
-  if(good_col[i]) {
+/* Loop on the blocks of columns */
+for(i0 = 0; i0 < nx; i0 += NCOL_BLOCK) {
+  nc = MINI(NCOL_BLOCK, nx - i0);
+
+/* Window of each column (empty for bad columns): */
+  jlow = ny;
+  jhigh = 0;
+  for(ic = 0; ic < nc; ic++) {
+    i = i0 + ic;
+    j1[ic] = 0;
+    j2[ic] = 0;
+    if(good_col[i]) {
 /* Location of the center using the polynomial */
-   yyc = phi[0] - phi[1] * xcent[i];
-   jjc = (int)(yyc + 0.5);
-
+      yyc = phi[0] - phi[1] * xcent[i];
+      jjc = (int)(yyc + 0.5);
 /* Select a window of 2*hwidth+1 pixels for computing the gravity center: */
-   j1 = MAXI(jjc - hwidth, 0);
-   j2 = MINI(jjc + hwidth + 1, ny);
-
-/* Localize the maximum along the column in the selected range: */
-   wmax = dble_image1[i + j1 * idim];
-   jmax = j1;
-   for(j = j1 + 1; j < j2; j++) {
-     ww = dble_image1[i + j * idim];
-     if(ww > wmax) {
-       wmax = ww;
-       jmax = j;
-       }
-     }
-/* New window for the location of the maximum: */
-   j1 = MAXI(jmax - hwidth, 0);
-   j2 = MINI(jmax + hwidth + 1, ny);
+      j1[ic] = MAXI(jjc - hwidth, 0);
+      j2[ic] = MINI(jjc + hwidth + 1, ny);
+      jlow = MINI(jlow, j1[ic]);
+      jhigh = MAXI(jhigh, j2[ic]);
+      }
+    wmax[ic] = (j1[ic] < j2[ic]) ? dble_image1[i + j1[ic] * idim] : 0.;
+    jmax[ic] = j1[ic];
+    }
+
+/* Localize the maximum along the columns in the selected ranges: */
+  for(j = jlow + 1; j < jhigh; j++) {
+    row = &dble_image1[i0 + j * idim];
+    for(ic = 0; ic < nc; ic++) {
+      if(j > j1[ic] && j < j2[ic] && row[ic] > wmax[ic]) {
+        wmax[ic] = row[ic];
+        jmax[ic] = j;
+        }
+      }
+    }
+
+/* New windows for the location of the maximum: */
+  jlow = ny;
+  jhigh = 0;
+  for(ic = 0; ic < nc; ic++) {
+    i = i0 + ic;
+    sum[ic] = 0.;
+    sumw[ic] = 0.;
+    if(j1[ic] >= j2[ic]) continue;
+    j1[ic] = MAXI(jmax[ic] - hwidth, 0);
+    j2[ic] = MINI(jmax[ic] + hwidth + 1, ny);
+    jlow = MINI(jlow, j1[ic]);
+    jhigh = MAXI(jhigh, j2[ic]);
 /* Select a window of 10*hwidth+1 pixels for computing the backgound: */
-   jback1 = MAXI(jmax - 5*hwidth, 0);
-   jback2 = MINI(jmax + 5*hwidth + 1, ny);
-
-/*
-if(i < 10) 
-  printf("jjc = %d jmax=%d wmax=%f backg=%f\n", jjc, jmax, wmax, backg);
-*/
-
-/* Compute the backgound along the column: */
-   backg = 0.;
-   nn = 0;
-   for(j = jback1; j < j1; j++) {
-     backg = dble_image1[i + j * idim];
-     nn++;
-     }
-   for(j = 2; j < jback2; j++) {
-     backg = dble_image1[i + j * idim];
-     nn++;
-     }
-   backg /= (double)nn;
+    jback1 = MAXI(jmax[ic] - 5*hwidth, 0);
+    jback2 = MINI(jmax[ic] + 5*hwidth + 1, ny);
+/* Backgound along the column
+* (same value as the former loops on [jback1,j1[ and [2,jback2[,
+* i.e. last pixel of those ranges divided by their number of pixels): */
+    nn = MAXI(j1[ic] - jback1, 0) + MAXI(jback2 - 2, 0);
+    if(jback2 > 2) backg[ic] = dble_image1[i + (jback2 - 1) * idim];
+    else if(j1[ic] > jback1) backg[ic] = dble_image1[i + (j1[ic] - 1) * idim];
+    else backg[ic] = 0.;
+    if(nn > 0) backg[ic] /= (double)nn;
+    }
 
 /* Compute more accurately the location of the maximum: */
-   sum = 0; sumw = 0.; 
-   for(j = j1; j < j2; j++) {
-     ww = dble_image1[i + j * idim] - backg;
-     sum += ww * (double)j; 
-     sumw += ww;
-     } 
-   ycent[k] = sum / sumw;
-   xcent[k] = (double)i;
-   k++;
-/* DEBUG
-printf(" k=%d Column %d ycent = %.1f (j1=%d j2=%d jmax=%d wmax=%f)\n", 
-         k, i, ycent[k], j1, j2, jmax, wmax);
-*/
- } /* EOF test on good_col[i] */
-}
+  for(j = jlow; j < jhigh; j++) {
+    row = &dble_image1[i0 + j * idim];
+    for(ic = 0; ic < nc; ic++)
+      mask[ic] = (j >= j1[ic] && j < j2[ic]) ? 1. : 0.;
+    for(ic = 0; ic < nc; ic++) {
+      ww = (row[ic] - backg[ic]) * mask[ic];
+      sum[ic] += ww * (double)j;
+      sumw[ic] += ww;
+      }
+    }
+
+  for(ic = 0; ic < nc; ic++) {
+/* Empty window (center outside of the image) or zero weight: */
+    if(!good_col[i0 + ic] || j1[ic] >= j2[ic] || sumw[ic] == 0.) continue;
+    ycent[k] = sum[ic] / sumw[ic];
+    xcent[k] = (double)(i0 + ic);
+    k++;
+    }
+ } /* EOF loop on blocks */
    
 *npts = k;
-printf("compute_centers/Successful selection of %d columns (nx=%d)\n",
+fprintf(fp_log, "compute_centers/Successful selection of %d columns (nx=%d)\n",
         *npts, nx);
 return(0);
 }
 /*********************************************************************
-* To compute the elements of matrices AA and BB 
-* which correspond to the least-square problem:
-*  AA^* AA phi = AA^* BB 
-*
-* with phi: polynomial of 1st order to be multiplied with x
-*  phi(x,y) = a x  + c
-*********************************************************************/
-static int compute_matrices(double *AA, double *BB, double *xcent, 
-                            double *ycent, int npts, int nc)
-{
-register int i;
-
-/* Loop on the data points */
-   for(i = 0; i < npts; i++) {
-     AA[0 + i * nc] = 1;
-     AA[1 + i * nc] = xcent[i];
-     BB[i] = ycent[i];
-   }
-
-return(0);
-}
-/*********************************************************************
 * Compute the residuals 
 *********************************************************************/
 static int compute_residuals(double *xcent, double *ycent, int npts, 
@@ -395,7 +588,8 @@ return(0);
 * Reject bad columns 
 *********************************************************************/
 static int reject_bad_columns(double *xcent, double *ycent, int nx, 
-                              int *good_col, double *phi, double threshold)
+                              int *good_col, double *phi, double threshold,
+                              FILE *fp_log)
 {
 double ww;
 register int i, k;
@@ -408,45 +602,56 @@ register int i, k;
        k++;
        } 
    }
-printf("reject_bad_columns/removing %d columns\n", k);
+fprintf(fp_log, "reject_bad_columns/removing %d columns\n", k);
 
 return(0);
 }  
 /********************************************************************
+* Least-squares fit of the centers with a polynomial of 1st order:
+*  ycent = phi[0] + phi[1] * xcent
 *
+* The normal equations AA^* AA phi = AA^* BB (with AA[i] = (1, xcent[i])
+* and BB[i] = ycent[i]) are solved directly (2x2 system), which
+* can be done in the threads (formerly solved with JLP_CGRAD)
 ********************************************************************/
-static int fit_centers(double *AA, double *BB, double *xcent, 
-                       double *ycent, double *phi, double *theta0,
-                       double *rms_resid, int npts, int ncoeff)
+static int fit_centers(double *xcent, double *ycent, double *phi,
+                       double *theta0, double *rms_resid, int npts,
+                       FILE *fp_log)
 {
-int ifail, status;
+double sx, sy, sxx, sxy, det;
+int status;
 register int i;
 
   *theta0 = 0.;
   *rms_resid = 0.;
+  phi[0] = 0.;
+  phi[1] = 0.;
 
-  compute_matrices(AA, BB, xcent, ycent, npts, ncoeff);
-
-/* Initial guess: */
-  for(i = 0; i < ncoeff; i++) phi[i] = 0.;
-/* Solve problem
-    AA^* AA phi = AA^* BB
- with conjugate gradients:
-*/
-  status = JLP_CGRAD(AA, BB, phi, &ncoeff, &npts, &ifail);
-  if(ifail != 0 || status) {
-     printf("From JLP_CGRAD/status=%d ifail=%d\n", status, ifail);
+  sx = 0.; sy = 0.; sxx = 0.; sxy = 0.;
+  for(i = 0; i < npts; i++) {
+    sx += xcent[i];
+    sy += ycent[i];
+    sxx += xcent[i] * xcent[i];
+    sxy += xcent[i] * ycent[i];
+    }
+  det = (double)npts * sxx - sx * sx;
+
+  if(npts < 2 || det == 0.) {
+     fprintf(fp_log, "fit_centers/Error: singular system (npts=%d)\n", npts);
      status = -2;
   } 
   else {
+   phi[0] = (sxx * sy - sx * sxy) / det;
+   phi[1] = ((double)npts * sxy - sx * sy) / det;
 /* Output coefficients: b + ax */
-   printf("  ycent = %f + %f * xcent\n", phi[0], phi[1]);
+   fprintf(fp_log, "  ycent = %f + %f * xcent\n", phi[0], phi[1]);
 /* Compute residuals */
    compute_residuals(xcent, ycent, npts, phi, rms_resid);
    *theta0 =  atan(phi[1])*180./PI;
-   printf("theta=%f degrees (rms_residuals=%f)\n", *theta0,
+   fprintf(fp_log, "theta=%f degrees (rms_residuals=%f)\n", *theta0,
            *rms_resid);
+   status = 0;
   }
 
-return(ifail);
+return(status);
 }
@@ -0,0 +1,90 @@
+/*************************************************************************
+* catalog_compile
+* Program to convert the ASCII WDS, HIC and HIP catalogs
+* to binary snapshots that are memory-mapped by the catalog readers
+* of pscplib (WDSCatalog, HICCatalog, HIPCatalog)
+*
+* The snapshot is written next to the catalog, with the ".bin" extension
+* (e.g. wdsweb_summ.txt -> wdsweb_summ.txt.bin).
+* It is ignored by the readers as soon as the ASCII catalog is modified,
+* hence this program should be run again after each update of the catalogs.
+* With the "check" option, the checksum of an existing snapshot is verified
+* (this is not done by the catalog readers, which only read the header).
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "WDS_catalog.h"
+#include "HIP_catalog.h"
+
+int main(int argc, char *argv[])
+{
+char catalog_type[40], catalog_fname[256];
+int status, nrecords, check_only = 0;
+
+/* If command line with "runs" */
+if(argc == 7){
+ if(*argv[3]) argc = 4;
+ else if(*argv[2]) argc = 3;
+ else if(*argv[1]) argc = 2;
+ else argc = 1;
+ }
+
+if(argc != 3 && argc != 4)
+  {
+  printf(" Syntax: catalog_compile WDS/HIC/HIP catalog_file [check]\n");
+  printf(" Example: runs catalog_compile WDS wdsweb_summ.txt\n");
+  printf(" Example: runs catalog_compile HIC hic.dat\n");
+  printf(" Example: runs catalog_compile HIP hip_main.dat\n");
+  printf(" Example: runs catalog_compile WDS wdsweb_summ.txt check\n");
+  exit(-1);
+  }
+else
+  {
+  strcpy(catalog_type, argv[1]);
+  strcpy(catalog_fname, argv[2]);
+  if(argc == 4 && !strcmp(argv[3], "check")) check_only = 1;
+  }
+
+printf(" OK: catalog_type=%s catalog=%s\n", catalog_type, catalog_fname);
+
+/* Verification of the checksum of the existing snapshot: */
+if(check_only) {
+  status = snapshot_check(catalog_fname);
+  if(status == 0)
+    printf(" OK: checksum of %s%s is correct\n", catalog_fname,
+           SNAPSHOT_EXTENSION);
+  return(status);
+  }
+
+/* The ASCII catalog is always read (use_snapshot = 0): */
+if(!strcmp(catalog_type, "WDS")) {
+  WDSCatalog WDS_cat(catalog_fname, 0);
+  if(!WDS_cat.IsLoaded()) exit(-1);
+  nrecords = WDS_cat.NRecords();
+  status = WDS_cat.WriteSnapshot();
+} else if(!strcmp(catalog_type, "HIC")) {
+  HICCatalog HIC_cat(catalog_fname, 0);
+  if(!HIC_cat.IsLoaded()) exit(-1);
+  nrecords = HIC_cat.NRecords();
+  status = HIC_cat.WriteSnapshot();
+} else if(!strcmp(catalog_type, "HIP")) {
+  HIPCatalog HIP_cat(catalog_fname, 0);
+  if(!HIP_cat.IsLoaded()) exit(-1);
+  nrecords = HIP_cat.NRecords();
+  status = HIP_cat.WriteSnapshot();
+} else {
+  fprintf(stderr, "catalog_compile/Fatal error: unknown catalog type >%s< (should be WDS, HIC or HIP)\n",
+          catalog_type);
+  exit(-1);
+}
+
+if(status == 0)
+  printf(" OK: %d records written to %s%s\n", nrecords, catalog_fname,
+         SNAPSHOT_EXTENSION);
+
+return(status);
+}
@@ -9,8 +9,11 @@
 wds000.new:00004+2749       2013.963   q 86.2    0.8      0.834    0.007      .     .       .     .                0.8   1 Gii2022  S    7
 wds000.new:00005+2031       2013.924     39.5    0.3      0.693    0.007      .     .      3.25   .                0.8   1 Gii2022  S  X 7
 wds000.new:00010+2721 Aa,Ab 2013.927    358.3    0.3      1.442    0.007      .     .      2.26   .                0.8   1 Gii2022  S  X 7
+* The calibrated table can also be a binary table 
+* (written by merge_calib_resid --binary)
+*
 * JLP
-* Version 02/05/2009
+* Version 17/10/2026
 *************************************************************************/
 #include <stdio.h>
 #include <stdlib.h>   /* exit() */
@@ -20,6 +23,8 @@ wds000.new:00010+2721 Aa,Ab 2013.927    358.3    0.3      1.442    0.007      .
 #include "latex_utils.h" // jlp: latex_read_fvalue...
 #include "jlp_string.h"    // jlp_trim_string, jlp_compact_string
 #include "tex_calib_utils.h" //extract_companion_from 
+#include "calib_bintab.h"    // CalibBinTable
+#include "astrom_def.h"      // NO_DATA
 
 /* Maximum number of columns to be extracted: */
 #define IMAX 10 
@@ -31,6 +36,12 @@ wds000.new:00010+2721 Aa,Ab 2013.927    358.3    0.3      1.442    0.007      .
 static int jlp_convert_table_for_WDS(char *filein,char *fileout);
 static int jlp_convert_line_for_WDS(char *in_line, char *out_line, 
                                     int line_length);
+static int jlp_convert_bintab_for_WDS(char *filein, char *fileout);
+static int jlp_convert_row_for_WDS(CALIB_ROW *row, char *out_line);
+static int jlp_format_line_for_WDS(char *wds_name0, char *comp_name0, 
+                                   double epoch0, char q_flag, double theta0,
+                                   double dtheta0, double rho0, double drho0,
+                                   double dmag0, char *out_line);
 static int jlp_latex_to_ascii(FILE *fp_in, FILE *fp_out, int ix, int *iy,
                               int ncols, int icol_name);
 static int jlp_latex_table_to_ascii(FILE *fp_in, FILE *fp_out, int ix, int *iy,
@@ -66,7 +77,10 @@ printf(" OK: filein=%s fileout=%s \n",
          filein, fileout);
 
 /* Scan the file and make the conversion: */
-status = jlp_convert_table_for_WDS(filein,fileout);
+if(calib_bintab_is_binary(filein))
+  status = jlp_convert_bintab_for_WDS(filein,fileout);
+else
+  status = jlp_convert_table_for_WDS(filein,fileout);
 
 return(status);
 }
@@ -121,9 +135,7 @@ wds000.new:00010+2721 Aa,Ab 2013.927    358.3    0.3      1.442    0.007      .
 static int jlp_convert_line_for_WDS(char *in_line, char *out_line, 
                                     int line_length)
 {
-int status = 0, verbose_if_error = 0, icol, object_len0, i;
-char wds_name0[64], object_name0[64], comp_name0[64], buffer[54], q_flag[1], *pc;
-double epoch0, rho0, drho0, theta0, dtheta0, dmag0;
+CALIB_ROW row;
 /*
 * icol=1: wds_name
 * icol=2: object_name including companion_name
@@ -131,14 +143,82 @@ double epoch0, rho0, drho0, theta0, dtheta0, dmag0;
 * icol=4: ibin 
 * icol=5: rho 
 * icol=6: drho 
-* icol=7: theta
+* icol=7: theta (with \rlap{$^*$} if no 180 deg. ambiguity)
 * icol=8: dtheta
 * icol=9: dmag
+* (decoded as the lines of the binary tables, to have the same quadrant flag)
 */
-  icol = 1;
-  status = latex_read_svalue(in_line, buffer, icol);
+  calib_row_from_latex(in_line, &row, CALIB_FMT_GILI);
+  jlp_convert_row_for_WDS(&row, out_line);
+return(0);
+}
+/***********************************************************************
+* Line of the WDS format
+*************************************************************************/
+static int jlp_format_line_for_WDS(char *wds_name0, char *comp_name0, 
+                                   double epoch0, char q_flag, double theta0,
+                                   double dtheta0, double rho0, double drho0,
+                                   double dmag0, char *out_line)
+{
+  if(dmag0 > 0.) {
+    sprintf(out_line, "wds000.new:%s %5.5s %8.3f  %c%6.1f    %2.1f     %6.3f    %5.3f      .     .      %4.2f   .                0.8   1 Gii2022  S  X 7",
+            wds_name0, comp_name0, epoch0, q_flag, theta0, dtheta0, rho0, 
+            drho0, dmag0); 
+    } else {
+    sprintf(out_line, "wds000.new:%s %5.5s %8.3f  %c%6.1f    %2.1f     %6.3f    %5.3f      .     .       .     .                0.8   1 Gii2022  S    7",
+            wds_name0, comp_name0, epoch0, q_flag, theta0, dtheta0, rho0, 
+            drho0); 
+    }
+return(0);
+}
+/***********************************************************************
+* Binary calibrated table: same conversion as jlp_convert_table_for_WDS()
+* with the values already decoded
+*************************************************************************/
+static int jlp_convert_bintab_for_WDS(char *filein, char *fileout)
+{
+char out_line[512];
+int irow;
+CalibBinTable *tab;
+CALIB_ROW row;
+FILE *fp_out;
+
+tab = new CalibBinTable(CALIB_FMT_GILI);
+if(tab->LoadFromFile(filein) != 0) {
+  delete tab;
+  return(-1);
+  }
+
+if((fp_out = fopen(fileout,"w")) == NULL)
+{
+printf(" Fatal error opening output file %s \n",fileout);
+delete tab;
+return(-1);
+}
+
+for(irow = 0; irow < tab->NRows(); irow++) {
+  tab->GetRow(irow, &row);
+  jlp_convert_row_for_WDS(&row, out_line);
+  fprintf(fp_out,"%s\n", out_line);
+  }
+
+fclose(fp_out);
+delete tab;
+return(0);
+}
+/***********************************************************************
+* Row of a LaTeX or binary table
+* (with the quadrant flag of the theta column)
+*************************************************************************/
+static int jlp_convert_row_for_WDS(CALIB_ROW *row, char *out_line)
+{
+char wds_name0[64], object_name0[64], comp_name0[64], discov_name0[64];
+int object_len0, i;
+char *pc;
+double dmag0;
+
 // Remove $ if present (for negative values: $-$):
-  pc = buffer;
+  pc = row->wds;
   i = 0;
   while(*pc) {
     if(*pc != '$') wds_name0[i++] = *pc; 
@@ -146,36 +226,13 @@ double epoch0, rho0, drho0, theta0, dtheta0, dmag0;
     }
   wds_name0[i] = '\0';
   jlp_compact_string(wds_name0, 64);
-  icol = 2;
-  status = latex_read_svalue(in_line, buffer, icol);
-  extract_companion_from_name(buffer, object_name0, comp_name0, &object_len0);
-  icol = 3;
-  status = latex_read_dvalue(in_line, &epoch0, icol, verbose_if_error);
-  icol = 5;
-  status = latex_read_dvalue(in_line, &rho0, icol, verbose_if_error);
-  status = latex_read_svalue(in_line, buffer, icol);
-  if(strstr(buffer,"rlap") != NULL) 
-    q_flag[0] = 'q';
-  else
-    q_flag[0] = ' ';
-  icol = 6;
-  status = latex_read_dvalue(in_line, &drho0, icol, verbose_if_error);
-  icol = 7;
-  status = latex_read_dvalue(in_line, &theta0, icol, verbose_if_error);
-  icol = 8;
-  status = latex_read_dvalue(in_line, &dtheta0, icol, verbose_if_error);
-  icol = 9;
-  status = latex_read_dvalue(in_line, &dmag0, icol, verbose_if_error);
-  if(status != 0) dmag0 = 0.;
-  if(dmag0 > 0.) {
-    sprintf(out_line, "wds000.new:%s %5.5s %8.3f  %c%6.1f    %2.1f     %6.3f    %5.3f      .     .      %4.2f   .                0.8   1 Gii2022  S  X 7",
-            wds_name0, comp_name0, epoch0, q_flag[0], theta0, dtheta0, rho0, 
-            drho0, dmag0); 
-    } else {
-    sprintf(out_line, "wds000.new:%s %5.5s %8.3f  %c%6.1f    %2.1f     %6.3f    %5.3f      .     .       .     .                0.8   1 Gii2022  S    7",
-            wds_name0, comp_name0, epoch0, q_flag[0], theta0, dtheta0, rho0, 
-            drho0); 
-    }
+  strcpy(discov_name0, row->discov);
+  extract_companion_from_name(discov_name0, object_name0, comp_name0, 
+                              &object_len0);
+  dmag0 = (row->dmag != NO_DATA) ? row->dmag : 0.;
+  jlp_format_line_for_WDS(wds_name0, comp_name0, row->epoch, 
+                          row->quadrant_flag ? 'q' : ' ', row->theta,
+                          row->dtheta, row->rho, row->drho, dmag0, out_line);
 return(0);
 }
 /*************************************************************************
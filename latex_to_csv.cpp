@@ -1,9 +1,10 @@
 /*************************************************************************
 * Program latex_to_ascii
 * To convert a LaTeX table to a csv file 
+* (or a binary table written by merge_calib_resid --binary)
 *
 * JLP
-* Version 02/09/2023
+* Version 17/10/2026
 *************************************************************************/
 #include <stdio.h>
 #include <stdlib.h>   /* exit() */
@@ -11,12 +12,14 @@
 #include <string.h>
 #include <ctype.h>  // isalpha(), isdigit()
 #include "latex_utils.h" // jlp: latex_read_fvalue...
+#include "calib_bintab.h" // CalibBinTable
 
 #define DEBUG
 /*
 */
 
 static int jlp_latex_to_csv(char *filein, char *fileout);
+static int jlp_bintab_to_csv(char *filein, char *fileout);
 
 int main(int argc, char *argv[])
 {
@@ -34,6 +37,7 @@ if(argc != 3)
   {
   printf("Error: argc=%d\n\n", argc);
   printf("Syntax: latex_to_ascii in_latex_table out_csv_file \n");
+  printf("(in_latex_table can also be a binary table)\n");
   exit(-1);
   }
 else
@@ -45,7 +49,10 @@ else
 printf(" OK: filein=%s fileout=%s\n", filein, fileout);
 
 /* Scan the file and make the conversion: */
-jlp_latex_to_csv(filein, fileout);
+if(calib_bintab_is_binary(filein))
+  jlp_bintab_to_csv(filein, fileout);
+else
+  jlp_latex_to_csv(filein, fileout);
 
 return(0);
 }
@@ -259,3 +266,43 @@ fclose(fp_in);
 fclose(fp_out);
 return(0);
 }
+/***************************************************
+* Binary table: the columns are written in the same order
+* as in the corresponding LaTeX table (without parsing any text)
+****************************************************/
+static int jlp_bintab_to_csv(char *filein, char *fileout) 
+{
+char columns[CALIB_NCOLS][80];
+int irow, icol, ncols, latex_signs = 0;
+CalibBinTable *tab;
+CALIB_ROW row;
+FILE *fp_out;
+
+tab = new CalibBinTable(CALIB_FMT_ADS);
+if(tab->LoadFromFile(filein) != 0) {
+printf(" Fatal error reading binary table %s \n",filein);
+exit(-1);
+}
+
+if((fp_out = fopen(fileout,"w")) == NULL)
+{
+printf(" Fatal error opening output file %s \n",fileout);
+delete tab;
+exit(-1);
+}
+fprintf(fp_out,"%s\n", "WDS, Name, Epoch, Bin., $\\rho$, $\\sigma_\\rho$, $\\theta$, $\\sigma_\\theta$, $\\Delta$m, Notes, Orbit, $\\Delta \\rho$(O-C), $\\Delta \\theta$(O-C), Grade"); 
+fprintf(fp_out,"%s\n", ", , , , (\\arcsec) , (\\arcsec) ,  ($^\\circ$) , ($^\\circ$) , , ,  , (\\arcsec) , ($^\\circ$)"); 
+
+for(irow = 0; irow < tab->NRows(); irow++) {
+  tab->GetRow(irow, &row);
+  calib_row_to_columns(&row, columns, &ncols, tab->CalibFormat(), latex_signs);
+  for(icol = 0; icol < ncols; icol++)
+    fprintf(fp_out, "%s\"%s\"", (icol > 0) ? "," : "", columns[icol]);
+  fprintf(fp_out, "\n");
+  }
+
+printf(" %d rows converted from binary table %s\n", tab->NRows(), filein);
+fclose(fp_out);
+delete tab;
+return(0);
+}
@@ -14,6 +14,7 @@ NO 888 00002+3613   &   TDS1236   & 2013.944 & & 0.346 & 0.173 & 158.100 & 6.900
 *************************************************************************/
 #include <ctype.h>  // isalpha(), isdigit()
 #include "tex_calib_utils.h" 
+#include "meas_match.h"    // MeasMatcher 
 #include "latex_utils.h" 
 // #include "astrom_utils1.h" 
 // #include "astrom_utils2.h" 
@@ -213,13 +214,14 @@ static int calib_tex_compare_files(char *filein1, char *filein2,
                                int calib_fmt2)
 {
 char b_in[NMAX], wds_name[40], discov_name[40], orbit__string[64];     
-int status, istat, iline, compatible_meas31, orbit_status, verbose;
-char *pc, *pc1, WDSName3[64], ObjectName3[64];
+int status, istat, iline, compatible_meas31, orbit_status, verbose, eyep1;
+char *pc, *pc1, WDSName3[64], ObjectName3[64], filt1[32];
 char WDSName1[64], ObjectName1[64];
 double epoch1, rho1, err_rho1, theta1, err_theta1;
 double epoch3, rho3, err_rho3, theta3, err_theta3;
 FILE *fp_in2, *fp_discrep_out, *fp_unres1_out, *fp_out;
 OBJECT *obj1, *obj3;
+MeasMatcher *matcher1;
 int i, nobj1 = 0, nobj3 = 0, ncompat = 0, nunres1 = 0, nunres3 = 0;
 
 if((fp_discrep_out = fopen(discrep_cmp_out,"w")) == NULL)
@@ -250,13 +252,7 @@ fprintf(fp_unres1_out,"%%%% compare/unres1 file1=%s and file2=%s\n", filein1, fi
 fprintf(fp_unres1_out,"%%%% JLP / Version of 27/10/2021 \n");
 fprintf(fp_unres1_out,"%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%\n");
 
-if((obj1 = (OBJECT *)malloc(NOBJ_MAX * sizeof(OBJECT))) == NULL) {
-  printf("calib_tex_compare_files/Fatal error allocating memory space for OBJECT: nobj_max=%d\n",
-          NOBJ_MAX);
-  exit(-1);
-  }
-// Initialize the number of measurements to zero
-for(i = 0; i < NOBJ_MAX; i++) (obj1[i]).nmeas = 0;
+obj1 = astrom_alloc_objects(NOBJ_MAX);
 
 // Read the input table of automatic meas. and load the meas. to OBJECT obj1
 tex_calib_read_measures(filein1, obj1, &nobj1, &nunres1, calib_fmt1);
@@ -264,10 +260,10 @@ tex_calib_read_measures(filein1, obj1, &nobj1, &nunres1, calib_fmt1);
 printf("calib_tex_compare_files: input=%s nobj=%d\n", filein1, nobj1);
 #endif
 
-if((obj3 = (OBJECT *)malloc(2 * sizeof(OBJECT))) == NULL) {
-  printf("calib_tex_compare_files/Fatal error allocating memory space for OBJECT: nobj_max=1 \n");
-  exit(-1);
-  }
+// Index the catalog of meas. by WDS name, object name and epoch:
+matcher1 = new MeasMatcher(obj1, nobj1, 1);
+
+obj3 = astrom_alloc_objects(2);
 
 // Scan the input table of manual meas.
 if((fp_in2 = fopen(filein2,"r")) == NULL) {
@@ -308,11 +304,10 @@ while(!feof(fp_in2))
     orbit_status = latex_get_column_item(b_in, orbit__string, 11, verbose);
     err_theta3 = (obj3[0].meas[0]).dtheta;
     if((rho3 != NO_DATA) && (theta3 != NO_DATA)) {
-      istat = tex_calib_get_meas_from_object(obj1, nobj1, WDSName3, ObjectName3,
-                                             epoch3,
-                                             WDSName1, ObjectName1, &epoch1,
-                                             &rho1, &err_rho1, &theta1, 
-                                             &err_theta1);
+      istat = matcher1->GetMeas(WDSName3, ObjectName3, epoch3,
+                                WDSName1, ObjectName1, &epoch1, filt1,
+                                &eyep1, &rho1, &err_rho1, &theta1, 
+                                &err_theta1);
       if(istat == 0) {
         tex_calib_compare(rho3, err_rho3, theta3, err_theta3, 
                           rho1, err_rho1, theta1, err_theta1,
@@ -362,8 +357,9 @@ printf("Returned by calib_tex_read_measures: nobj1 = %d nmeas=%d rho=%.2f theta=
 }
 #endif
 
-free(obj1);
-free(obj3);
+delete matcher1;
+astrom_free_objects(obj1);
+astrom_free_objects(obj3);
 fclose(fp_in2);
 fclose(fp_out);
 fclose(fp_unres1_out);
@@ -776,13 +772,7 @@ int *index_obj2, tabular_only, nm1;
 int i, j, k, nobj2 = 0;
 int quadrant_correction;
 
-if((obj2 = (OBJECT *)malloc(NOBJ_MAX * sizeof(OBJECT))) == NULL) {
-  printf("calib_tex_compare_files/Fatal error allocating memory space for OBJECT: nobj_max=%d\n",
-          NOBJ_MAX);
-  exit(-1);
-  }
-// Initialize the number of measurements to zero
-for(i = 0; i < NOBJ_MAX; i++) (obj2[i]).nmeas = 0;
+obj2 = astrom_alloc_objects(NOBJ_MAX);
 
 if((index_obj2 = (int *)malloc((NOBJ_MAX) * sizeof(int))) == NULL) {
   printf("calib_tex_compare_files/Fatal error allocating memory space for index_obj: nobj_max=%d\n",
@@ -811,11 +801,8 @@ for(i = 0; i < nobj1; i++) {
                (obj1[i]).name, me1->rho, me1->theta,
                ABS(me1->rho - cmp_me1->rho),
                ABS(me1->theta - cmp_me1->theta));
-             strcpy((obj2[k]).wds, (obj1[i]).wds);
              strcpy((obj2[k]).name, (obj1[i]).name);
-             (obj2[k]).nmeas = (obj1[i]).nmeas;
-             (obj2[k]).WR = (obj1[i]).WR;
-             (obj2[k]).WY= (obj1[i]).WY;
+             astrom_copy_object_for_cmp(&obj2[k], &obj1[i]);
              me2 = &(obj2[k]).meas[j];
              cmp_me2 = &(obj2[k]).cmp_meas[j];
              strcpy(me2->filename, me1->filename); 
@@ -874,7 +861,7 @@ calib_tex_write_publi_cmp_table_gili(fp_cmp_out, obj2, index_obj2, nobj2,
 
 fclose(fp_cmp_out);
 free(index_obj2);
-free(obj2);
+astrom_free_objects(obj2);
 return(0);
 }
 /****************************************************************
@@ -893,13 +880,7 @@ int *index_obj2, tabular_only, nm1;
 int i, j, k, nobj2 = 0;
 int quadrant_correction;
 
-if((obj2 = (OBJECT *)malloc(NOBJ_MAX * sizeof(OBJECT))) == NULL) {
-  printf("calib_tex_compare_files/Fatal error allocating memory space for OBJECT: nobj_max=%d\n",
-          NOBJ_MAX);
-  exit(-1);
-  }
-// Initialize the number of measurements to zero
-for(i = 0; i < NOBJ_MAX; i++) (obj2[i]).nmeas = 0;
+obj2 = astrom_alloc_objects(NOBJ_MAX);
 
 if((index_obj2 = (int *)malloc((NOBJ_MAX) * sizeof(int))) == NULL) {
   printf("calib_tex_compare_files/Fatal error allocating memory space for index_obj: nobj_max=%d\n",
@@ -924,11 +905,8 @@ for(i = 0; i < nobj1; i++) {
          if((cmp_me1->rho != NO_DATA) && (cmp_me1->theta != NO_DATA)) {
              printf("name=%s rho=%.2f theta=%.2f\n",
                (obj1[i]).name, me1->rho, me1->theta);
-             strcpy((obj2[k]).wds, (obj1[i]).wds);
              strcpy((obj2[k]).name, (obj1[i]).name);
-             (obj2[k]).nmeas = (obj1[i]).nmeas;
-             (obj2[k]).WR = (obj1[i]).WR;
-             (obj2[k]).WY= (obj1[i]).WY;
+             astrom_copy_object_for_cmp(&obj2[k], &obj1[i]);
              me2 = &(obj2[k]).meas[j];
              cmp_me2 = &(obj2[k]).cmp_meas[j];
              strcpy(me2->filename, me1->filename); 
@@ -1037,7 +1015,7 @@ calib_tex_write_publi_cmp_table_gili(fp_cmp_out, obj2, index_obj2, nobj2,
 
 fclose(fp_cmp_out);
 free(index_obj2);
-free(obj2);
+astrom_free_objects(obj2);
 return(0);
 }
 /**************************************************************************
@@ -4,13 +4,22 @@
 * To compute the mass and linear semi-major axis of a binary star
 * whose orbit is known.
 *
+* With the optional "nsamples,seed" argument, the errors of all
+* the orbital elements and of the parallax are also propagated with
+* a Monte-Carlo method (see orbit_montecarlo.h), to the semi-major axis,
+* the sum of the masses and the ephemerids at the requested epochs.
+*
 * JLP 
-* Version 12/10/2010
+* Version 17/10/2026
 *************************************************************************/
 #include <stdio.h>
+#include <stdlib.h>    // atof()
+#include <string.h>    // strtok()
 #include <math.h>
 #include "jlp_catalog_utils.h"
 #include "residuals_utils.h"
+#include "orbit_montecarlo.h"  // orbit_montecarlo()
+#include "jlp_threads.h"       // jlp_threads_from_args()
 
 #define SQUARE(a) ((a)*(a))
 #define DEBUG
@@ -24,6 +33,15 @@ static int compute_mass_and_semiaxis(char *out_filename, double *Omega_node,
               double *err_e_eccent, double *err_T_periastron, double *err_Period,
               double *err_a_smaxis, double *err_mean_motion, double err_parallax, 
               int nber_of_orbits);
+static int montecarlo_mass_and_semiaxis(FILE *fp_out, double *Omega_node, 
+              double *omega_peri, double *i_incl, double *e_eccent, 
+              double *T_periastron, double *Period, double *a_smaxis, 
+              double parallax, double *err_Omega_node, double *err_omega_peri,
+              double *err_i_incl, double *err_e_eccent, 
+              double *err_T_periastron, double *err_Period, 
+              double *err_a_smaxis, double err_parallax, int nber_of_orbits,
+              int nsamples, unsigned long long seed, double *epochs, 
+              int nepochs, int nthreads);
 
 int main(int argc, char *argv[])
 {
@@ -31,9 +49,14 @@ double Omega_node[3], omega_peri[3], i_incl[3], e_eccent[3];
 double T_periastron[3], Period[3], a_smaxis[3], mean_motion[3], orbit_equinox[3];
 double err_Omega_node[3], err_omega_peri[3], err_i_incl[3], err_e_eccent[3]; 
 double err_T_periastron[3], err_Period[3], err_a_smaxis[3], err_mean_motion[3]; 
-double parallax, err_parallax;
-int orbit_format, nber_of_orbits, nval, status;
-char out_filename[80], orbit_infile[80];
+double parallax, err_parallax, epochs[ORBIT_MC_NEPOCHS_MAX];
+int orbit_format, nber_of_orbits, nval, status, nsamples, nepochs, nthreads;
+unsigned long long seed;
+char out_filename[80], orbit_infile[80], epoch_list[256], *pc;
+FILE *fp_out;
+
+// Number of threads used by the Monte-Carlo method ("-j N" option):
+nthreads = jlp_threads_from_args(&argc, argv);
 
 if(argc == 7) {
   if(*argv[6]) argc = 7;
@@ -44,10 +67,13 @@ if(argc == 7) {
   else if(*argv[1]) argc = 2;
   else argc = 1;
 }
-if(argc != 5) {
-  printf("Syntax: mass_and_semiaxis outfile infile_with_orbit orbit_format,number_of_orbits parallax_msec,err_parallax_msec\n");
+if(argc < 5 || argc > 7) {
+  printf("Syntax: mass_and_semiaxis outfile infile_with_orbit orbit_format,number_of_orbits parallax_msec,err_parallax_msec [nsamples,seed] [epoch1,epoch2,...] [-j nthreads]\n");
   printf("Format: 1 if Marco's format (Omega=node, omep=longitude of periastron, i, e, T, P, a, [equinox])\n");
   printf("        2 if OC6 format (P, a, i, Omega, T, e, omep, [equinox] )\n");
+  printf("nsamples: number of samples of the Monte-Carlo method (e.g., %d)\n",
+         ORBIT_MC_NSAMPLES);
+  printf("epoch1,epoch2,...: epochs of the ephemerids (Monte-Carlo only)\n");
   return(-1);
 }
 strcpy(out_filename, argv[1]);
@@ -57,6 +83,21 @@ if(nval == 1) nber_of_orbits = 1;
 sscanf(argv[4], "%lf,%lf", &parallax, &err_parallax);
 if(nval == 1) err_parallax = 0.;
 
+/* Optional parameters of the Monte-Carlo method: */
+nsamples = 0;
+seed = 1;
+nepochs = 0;
+if(argc >= 6) {
+  nval = sscanf(argv[5], "%d,%llu", &nsamples, &seed);
+  if(nval < 1) nsamples = 0;
+  }
+if(argc == 7) {
+  strncpy(epoch_list, argv[6], 255);
+  epoch_list[255] = '\0';
+  for(pc = strtok(epoch_list, ","); pc != NULL && nepochs < ORBIT_MC_NEPOCHS_MAX;
+      pc = strtok(NULL, ",")) epochs[nepochs++] = atof(pc);
+  }
+
 #ifdef DEBUG
 printf("OK: orbit in %s orbit_format=%d\n",
        orbit_infile, orbit_format);
@@ -91,6 +132,22 @@ compute_mass_and_semiaxis(out_filename, Omega_node, omega_peri, i_incl,
                           err_a_smaxis, err_mean_motion, err_parallax, 
                           nber_of_orbits);
 
+/* Monte-Carlo propagation of the errors (results appended to outfile): */
+if(nsamples > 0) {
+  if((fp_out = fopen(out_filename, "a")) == NULL) {
+    fprintf(stderr, "Fatal error opening output file: %s\n", out_filename);
+    exit(-1);
+    }
+  montecarlo_mass_and_semiaxis(fp_out, Omega_node, omega_peri, i_incl, 
+                               e_eccent, T_periastron, Period, a_smaxis,
+                               parallax, err_Omega_node, err_omega_peri, 
+                               err_i_incl, err_e_eccent, err_T_periastron, 
+                               err_Period, err_a_smaxis, err_parallax, 
+                               nber_of_orbits, nsamples, seed, epochs, nepochs,
+                               nthreads);
+  fclose(fp_out);
+  }
+
 return(0);
 }
 /************************************************************************
@@ -152,3 +209,88 @@ fclose(fp_out);
 
 return(0);
 }
+/************************************************************************
+* Monte-Carlo propagation of the errors of the orbital elements (Omega,
+* omega, i, e, T, P, a) and of the parallax, for each orbit
+*
+* INPUT:
+* fp_out: output file
+* orbital elements and their errors (angles in radians)
+* parallax, err_parallax: parallax and its error (mas)
+* nsamples, seed: number of samples and seed of the random generator
+* epochs[nepochs]: epochs of the ephemerids
+* nthreads: number of threads
+*
+*************************************************************************/
+static int montecarlo_mass_and_semiaxis(FILE *fp_out, double *Omega_node, 
+              double *omega_peri, double *i_incl, double *e_eccent, 
+              double *T_periastron, double *Period, double *a_smaxis, 
+              double parallax, double *err_Omega_node, double *err_omega_peri,
+              double *err_i_incl, double *err_e_eccent, 
+              double *err_T_periastron, double *err_Period, 
+              double *err_a_smaxis, double err_parallax, int nber_of_orbits,
+              int nsamples, unsigned long long seed, double *epochs, 
+              int nepochs, int nthreads)
+{
+ORBIT_ELEMENTS orbit, err_orbit;
+ORBIT_MC_RESULTS results;
+double percents[ORBIT_MC_NPERCENT] = ORBIT_MC_PERCENTS;
+int j, k, status;
+
+fprintf(fp_out, "Monte-Carlo: %d samples (seed=%llu), percentiles:", 
+        nsamples, seed);
+for(j = 0; j < ORBIT_MC_NPERCENT; j++) fprintf(fp_out, " %.1f%%", percents[j]);
+fprintf(fp_out, "\n");
+
+for(k = 0; k < nber_of_orbits; k++) {
+  orbit.Omega_node = Omega_node[k];
+  orbit.omega_peri = omega_peri[k];
+  orbit.i_incl = i_incl[k];
+  orbit.e_eccent = e_eccent[k];
+  orbit.T_periastron = T_periastron[k];
+  orbit.Period = Period[k];
+  orbit.a_smaxis = a_smaxis[k];
+  orbit.mean_motion = (360.0 / Period[k]) * DEGTORAD;
+  err_orbit.Omega_node = err_Omega_node[k];
+  err_orbit.omega_peri = err_omega_peri[k];
+  err_orbit.i_incl = err_i_incl[k];
+  err_orbit.e_eccent = err_e_eccent[k];
+  err_orbit.T_periastron = err_T_periastron[k];
+  err_orbit.Period = err_Period[k];
+  err_orbit.a_smaxis = err_a_smaxis[k];
+  err_orbit.mean_motion = 0.;
+
+  status = orbit_montecarlo(&orbit, &err_orbit, parallax, err_parallax, 
+                            epochs, nepochs, nsamples, seed, nthreads, 
+                            &results);
+  if(status != 0) {
+    fprintf(stderr, "montecarlo_mass_and_semiaxis/Error for orbit #%d\n", k);
+    continue;
+    }
+
+  fprintf(fp_out, "Orbit #%d:\n", k + 1);
+  fprintf(fp_out, "Semi-axis (AU):");
+  for(j = 0; j < ORBIT_MC_NPERCENT; j++) 
+    fprintf(fp_out, " %.3f", results.a_AU[j]);
+  fprintf(fp_out, "\nSum of masses (Solar Masses):");
+  for(j = 0; j < ORBIT_MC_NPERCENT; j++) 
+    fprintf(fp_out, " %.3f", results.sum_masses[j]);
+  fprintf(fp_out, "\n");
+  printf("Monte-Carlo: orbit #%d  a = %.2f (+%.2f -%.2f) AU  M_1 + M_2 = %.2f (+%.2f -%.2f) Solar Masses\n",
+         k + 1, results.a_AU[2], results.a_AU[3] - results.a_AU[2], 
+         results.a_AU[2] - results.a_AU[1], results.sum_masses[2], 
+         results.sum_masses[3] - results.sum_masses[2],
+         results.sum_masses[2] - results.sum_masses[1]);
+  for(j = 0; j < results.nepochs; j++) {
+    fprintf(fp_out, "Epoch %.3f rho (arcsec): %.4f %.4f %.4f %.4f %.4f", 
+            results.epochs[j], results.rho_c[j][0], results.rho_c[j][1], 
+            results.rho_c[j][2], results.rho_c[j][3], results.rho_c[j][4]);
+    fprintf(fp_out, " theta (deg): %.2f %.2f %.2f %.2f %.2f\n", 
+            results.theta_c[j][0], results.theta_c[j][1], 
+            results.theta_c[j][2], results.theta_c[j][3], 
+            results.theta_c[j][4]);
+    }
+  }
+
+return(0);
+}
@@ -3,39 +3,60 @@
 *
 * To merge the two Latex tables: calibrated table and residual table
 *
+* The output table is written as a binary table (see calib_bintab.h)
+* with "--binary"
+*
 * JLP 
-* Version 15/09/2011
+* Version 17/10/2026
 *************************************************************************/
 #include "jlp_catalog_utils.h"
 #include "jlp_string.h"
 #include "latex_utils.h"
+#include "calib_bintab.h"   // CalibBinTable
 
 #define DEBUG
 #define DEBUG_1
 /*
 */
 
-int add_residuals_to_calib(FILE *fp_calib, char *resid_fname, FILE *fp_out); 
+int add_residuals_to_calib(FILE *fp_calib, char *resid_fname, FILE *fp_out,
+                           CalibBinTable *out_tab); 
+static int output_with_residuals(char *in_line, CALIB_ROW *row, 
+                                 char *object_name, char *comp_name, 
+                                 double epoch_o, double rho_o, 
+                                 char *resid_fname, FILE *fp_out, 
+                                 CalibBinTable *out_tab);
 static int modify_LaTeX_header(char *in_line, FILE *fp_out);
 static int remove_orbit_column(char *in_line, int ilen);
 
 int main(int argc, char *argv[])
 {
 char calib_fname[80], resid_fname[80], out_fname[80];
-FILE *fp_calib, *fp_out;
+int binary_output = 0;
+CalibBinTable *out_tab = NULL;
+FILE *fp_calib = NULL, *fp_out = NULL;
 time_t t = time(NULL);
 
+/* Option "--binary" (binary output table): */
+if(argc == 5 && !strcmp(argv[4], "--binary")) {
+  binary_output = 1;
+  argc = 4;
+  }
 
 if(argc != 4) {
-  printf("Syntax: merge_calib_resid calibrated_table residual_table out_table\n");
+  printf("Syntax: merge_calib_resid calibrated_table residual_table out_table [--binary]\n");
+  printf("(out_table is a binary table with --binary)\n");
   return(-1);
 }
 strcpy(calib_fname, argv[1]);
 strcpy(resid_fname, argv[2]);
 strcpy(out_fname, argv[3]);
 
-printf("OK: calib=%s resid=%s output=%s \n", calib_fname, resid_fname, 
-           out_fname); 
+printf("OK: calib=%s resid=%s output=%s (binary output=%d)\n", 
+       calib_fname, resid_fname, out_fname, binary_output); 
+
+/* Binary output table: */
+if(binary_output) out_tab = new CalibBinTable(CALIB_FMT_ADS);
 
 /* Open input calibrated table: */
 if((fp_calib = fopen(calib_fname, "r")) == NULL) {
@@ -45,6 +66,7 @@ if((fp_calib = fopen(calib_fname, "r")) == NULL) {
   }
 
 /* Open output table: */
+if(!binary_output) {
   if((fp_out = fopen(out_fname, "w")) == NULL) {
     fprintf(stderr, "merge_calib_resid/Fatal error opening output file: %s\n",
            out_fname);
@@ -58,15 +80,23 @@ fprintf(fp_out, "%% Merged table from: %s and %s \n%% Created on %s",
         calib_fname, resid_fname, ctime(&t));
 fprintf(fp_out, "%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%\
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% \n");
+}
 
 /* Scan the input calibrated table and add the residuals 
 */
-add_residuals_to_calib(fp_calib, resid_fname, fp_out); 
+add_residuals_to_calib(fp_calib, resid_fname, fp_out, out_tab); 
+
+if(binary_output) {
+  out_tab->WriteToFile(out_fname);
+  printf("merge_calib_resid: %d rows written to %s\n", out_tab->NRows(), 
+         out_fname);
+  }
 
 /* Close opened files:
 */
 fclose(fp_calib);
-fclose(fp_out);
+if(fp_out != NULL) fclose(fp_out);
+if(out_tab != NULL) delete out_tab;
 return(0);
 }
 /************************************************************************
@@ -76,28 +106,31 @@ return(0);
 * fp_calib: pointer to the input file containing the calibrated table 
 * resid_fname: name of the file containing the Latex table with the residuals
 * fp_out: pointer to the output Latex file with the full table 
+*         (NULL if binary output)
+* out_tab: binary output table (NULL if LaTeX output)
 *
 *************************************************************************/
-int add_residuals_to_calib(FILE *fp_calib, char *resid_fname, FILE *fp_out) 
+int add_residuals_to_calib(FILE *fp_calib, char *resid_fname, FILE *fp_out,
+                           CalibBinTable *out_tab) 
 {
-char in_line[256], wds_name[40]; 
+char in_line[256], row_line[264], wds_name[40]; 
 char object_name[40], ads_name[40], discov_name[40], comp_name[40]; 
-char buffer[128], orbit_ref[60*50], quadrant_discrep[20]; 
+char buffer[128];
 char previous_object_name[40], previous_comp_name[40];
-char sign_Drho[20], sign_Dtheta[20];
-double epoch_o, rho_o, rho_o_c[50], theta_o_c[50];
-int i, iline, norbits_found, status, orbit_grade, verbose_if_error = 0;
-int ref_slength = 60, nmax_orbits = 50;
+double epoch_o, rho_o;
+int iline, status, verbose_if_error = 0;
+CALIB_ROW row, previous_row;
 
 previous_object_name[0] = '\0';
 previous_comp_name[0] = '\0';
+calib_row_init(&previous_row);
 iline = 0;
 while(!feof(fp_calib)) {
   if(fgets(in_line, 256, fp_calib)) {
     iline++;
 // Read header and add 3 columns for output header
     if(!strncmp(in_line,"& & & & & & & & & & & \\\\", 24)){
-      fprintf(fp_out,   "& & & & & & & & & & & & & \\\\ \n");
+      if(fp_out != NULL) fprintf(fp_out,   "& & & & & & & & & & & & & \\\\ \n");
     } 
 // Good lines start with a digit (WDS names...) or with \idem
 // Lines starting with % are ignored
@@ -151,6 +184,62 @@ while(!feof(fp_calib)) {
                  in_line, iline);
          }
 
+/* Binary output: decode the measurements of this line once */
+      if(out_tab != NULL) {
+/* (with "\\" at the end, to read the last column) */
+         sprintf(row_line, "%s \\\\", in_line);
+         calib_row_from_latex(row_line, &row, CALIB_FMT_ADS, &previous_row);
+         previous_row = row;
+         output_with_residuals(NULL, &row, object_name, comp_name, epoch_o,
+                               rho_o, resid_fname, NULL, out_tab);
+      } else {
+         output_with_residuals(in_line, NULL, object_name, comp_name, epoch_o,
+                               rho_o, resid_fname, fp_out, NULL);
+      }
+    } else if (in_line[0] == '%') {
+/* Simply copy the input line to the output file if it is a comment: */
+/* Remove the end of line '\n' from input line: */
+      jlp_cleanup_string(in_line, 256);
+      if(fp_out != NULL) fprintf(fp_out, "%s\n", in_line);
+    } else {
+      if(fp_out != NULL) modify_LaTeX_header(in_line, fp_out);
+    }/* EOF if !isdigit ... */
+  } /* EOF if fgets */ 
+/* Load object name to handle the case of "idem" (i.e. multiple measurements
+* of the same object, without repeating the object name in cols. 1 2 3)*/
+ strcpy(previous_object_name, object_name);
+ strcpy(previous_comp_name, comp_name);
+ } /* EOF while ... */
+printf("add_residuals_to_calib: %d lines sucessfully read and processed\n", 
+        iline);
+return(0);
+}
+/************************************************************************
+* Retrieve the residuals for this object and epoch in the residual table
+* and write the measurement with one line per orbit
+*
+* INPUT:
+* in_line: input LaTeX line (without the orbit column),
+*          or NULL if binary output
+* row: decoded measurement (used if binary output)
+* object_name, comp_name: name used in the residual table (e.g., ADS 123 AB)
+* epoch_o, rho_o: epoch and measured separation
+* fp_out: pointer to the output Latex file (NULL if binary output)
+* out_tab: binary output table (NULL if LaTeX output)
+*************************************************************************/
+static int output_with_residuals(char *in_line, CALIB_ROW *row, 
+                                 char *object_name, char *comp_name, 
+                                 double epoch_o, double rho_o, 
+                                 char *resid_fname, FILE *fp_out, 
+                                 CalibBinTable *out_tab)
+{
+char orbit_ref[60*50], quadrant_discrep[20]; 
+char sign_Drho[20], sign_Dtheta[20];
+double rho_o_c[50], theta_o_c[50];
+int i, norbits_found, orbit_grade;
+int ref_slength = 60, nmax_orbits = 50;
+CALIB_ROW row1;
+
 /* Retrieve the residuals for this object and epoch in the residual table: */
       strcpy(quadrant_discrep,"");
       get_values_from_RESID_table(resid_fname, object_name, comp_name, epoch_o,
@@ -162,8 +251,22 @@ while(!feof(fp_calib)) {
          fprintf(stderr," Residuals for %s %s not found in resid_table for epoch=%f in %s\n", 
                  object_name, comp_name, epoch_o, resid_fname);
 /* Simply copy the input line to the output file: */
-         fprintf(fp_out, "%s \\\\ \n", in_line);
-         } else {
+         if(in_line != NULL)
+           fprintf(fp_out, "%s \\\\ \n", in_line);
+         else
+           out_tab->AddRow(row);
+/* Binary output: one row per orbit */
+      } else if(in_line == NULL) {
+         for(i = 0; i < norbits_found; i++) {
+           row1 = *row;
+           strncpy(row1.orbit_ref, &orbit_ref[i*ref_slength], 63);
+           row1.orbit_ref[63] = '\0';
+           row1.rho_o_c = rho_o_c[i];
+           row1.theta_o_c = theta_o_c[i];
+           row1.quadrant_discrep = (quadrant_discrep[0] != '\0');
+           out_tab->AddRow(&row1);
+         }
+      } else {
 /* quadrant_discrep = "$^Q$" if Quadrant discrepancy between measure and orbit */
          for(i = 0; i < norbits_found; i++) {
            if(rho_o_c[i] < 0.) {
@@ -202,22 +305,6 @@ while(!feof(fp_calib)) {
            }
          } /* EOF for (i=0, norbits_found) */
          }
-    } else if (in_line[0] == '%') {
-/* Simply copy the input line to the output file if it is a comment: */
-/* Remove the end of line '\n' from input line: */
-      jlp_cleanup_string(in_line, 256);
-      fprintf(fp_out, "%s\n", in_line);
-    } else {
-      modify_LaTeX_header(in_line, fp_out);
-    }/* EOF if !isdigit ... */
-  } /* EOF if fgets */ 
-/* Load object name to handle the case of "idem" (i.e. multiple measurements
-* of the same object, without repeating the object name in cols. 1 2 3)*/
- strcpy(previous_object_name, object_name);
- strcpy(previous_comp_name, comp_name);
- } /* EOF while ... */
-printf("add_residuals_to_calib: %d lines sucessfully read and processed\n", 
-        iline);
 return(0);
 }
 /********************************************************************
@@ -0,0 +1,282 @@
+/************************************************************************
+* "predict_ephemerides.cpp"
+*
+* To predict the positions (rho, theta) of all the binaries of the OC6
+* orbit catalog at a grid of epochs, and create an observing list
+* with the objects that can be resolved by the instrument
+* (rho_min <= rho <= rho_max at one of the epochs at least),
+* sorted by WDS name (i.e., by right ascension).
+*
+* The catalog is read only once, and the ephemerids of each orbit
+* are computed for all the epochs with a single call to
+* compute_multiple_system_ephemerides(). The orbits are processed in
+* parallel with the "-j N" option (the output does not depend on N).
+*
+* When the catalog contains several orbits of the same object,
+* the orbit with the best grade is used (the first one in the catalog
+* if they have the same grade).
+*
+* Syntax:
+* predict_ephemerides OC6_catalog is_master_file epoch1,epoch2,nepochs
+*                     rho_min,rho_max out_list [grade_max] [-j N]
+*
+* Example (PISCO2 in Merate, 1m telescope, diffraction limit of 0".13
+* in the V band, field of 3"):
+* predict_ephemerides orb6orbits.txt 0 2027.0,2027.5,3 0.13,3.0 list.txt 4
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>    // exit()
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include <string>
+#include <algorithm>   // std::sort
+#include <unordered_map>
+#include "jlp_catalog_utils.h"
+#include "residuals_utils.h"    // THIELE_ORBIT, compute_multiple_system_ephemerides
+#include "OC6_catalog.h"        // OC6Catalog
+#include "jlp_threads.h"        // jlp_parallel_for()
+
+/* Maximum number of epochs: */
+#define PREDICT_NEPOCHS_MAX 64
+/* Number of orbits processed by a call to the worker: */
+#define PREDICT_CHUNK 256
+
+/* Data shared by the threads: */
+typedef struct {
+std::vector<OC6_ORBIT> *orbits;
+double *epochs;
+int nepochs;
+double *rho_c, *theta_c;     /* norbits * nepochs (orbit by orbit) */
+} PREDICT_DATA;
+
+static int predict_ephemerides_main(char *OC6_fname, int is_master_file,
+                                    double *epochs, int nepochs,
+                                    double rho_min, double rho_max,
+                                    char *out_fname, int grade_max,
+                                    int nthreads);
+static int select_orbits(OC6Catalog *catalog, int grade_max,
+                         std::vector<OC6_ORBIT> *orbits);
+static void predict_worker(int ichunk, void *data0);
+static bool predict_wds_before(const OC6_ORBIT &orb1, const OC6_ORBIT &orb2);
+
+int main(int argc, char *argv[])
+{
+char OC6_fname[128], out_fname[128];
+double epochs[PREDICT_NEPOCHS_MAX], epoch1, epoch2, rho_min, rho_max;
+int is_master_file, nepochs, grade_max, nthreads, i;
+
+printf("predict_ephemerides/ JLP/ Version 17/10/2026\n");
+
+nthreads = jlp_threads_from_args(&argc, argv);
+
+if(argc != 6 && argc != 7) {
+  printf("Syntax: predict_ephemerides OC6_catalog is_master_file epoch1,epoch2,nepochs rho_min,rho_max out_list [grade_max] [-j N]\n");
+  printf("is_master_file: 1 if orb6.master, 0 if orb6orbits.txt\n");
+  printf("rho_min, rho_max: resolution limit and field of the instrument (arcsec)\n");
+  printf("grade_max: maximum grade of the orbits (5 by default)\n");
+  printf("Example: predict_ephemerides orb6orbits.txt 0 2027.0,2027.5,3 0.13,3.0 list.txt 4 -j 4\n");
+  return(-1);
+  }
+
+strcpy(OC6_fname, argv[1]);
+sscanf(argv[2], "%d", &is_master_file);
+if(sscanf(argv[3], "%lf,%lf,%d", &epoch1, &epoch2, &nepochs) != 3
+   || nepochs < 1 || nepochs > PREDICT_NEPOCHS_MAX) {
+  fprintf(stderr, "Fatal error: bad epochs >%s< (nepochs should be in [1,%d])\n",
+          argv[3], PREDICT_NEPOCHS_MAX);
+  return(-1);
+  }
+if(sscanf(argv[4], "%lf,%lf", &rho_min, &rho_max) != 2 || rho_min >= rho_max) {
+  fprintf(stderr, "Fatal error: bad separations >%s<\n", argv[4]);
+  return(-1);
+  }
+strcpy(out_fname, argv[5]);
+grade_max = 5;
+if(argc == 7) sscanf(argv[6], "%d", &grade_max);
+
+for(i = 0; i < nepochs; i++) {
+  if(nepochs == 1) epochs[i] = epoch1;
+  else epochs[i] = epoch1 + i * (epoch2 - epoch1) / (double)(nepochs - 1);
+  }
+
+printf("OK: OC6_catalog=%s is_master_file=%d grade_max=%d\n",
+       OC6_fname, is_master_file, grade_max);
+printf("OK: epochs from %.3f to %.3f (nepochs=%d) rho_min=%.3f rho_max=%.3f\n",
+       epochs[0], epochs[nepochs - 1], nepochs, rho_min, rho_max);
+
+predict_ephemerides_main(OC6_fname, is_master_file, epochs, nepochs,
+                         rho_min, rho_max, out_fname, grade_max, nthreads);
+
+return(0);
+}
+/************************************************************************
+* Compute the ephemerids of all the selected orbits and write
+* the observing list
+*
+* INPUT:
+* OC6_fname: name of the OC6 catalog
+* is_master_file: 1 if orb6.master, 0 if orb6orbits.txt
+* epochs[nepochs]: epochs of the ephemerids
+* rho_min, rho_max: range of separations that can be measured (arcsec)
+* out_fname: name of the output list
+* grade_max: maximum grade of the orbits
+* nthreads: number of threads
+*************************************************************************/
+static int predict_ephemerides_main(char *OC6_fname, int is_master_file,
+                                    double *epochs, int nepochs,
+                                    double rho_min, double rho_max,
+                                    char *out_fname, int grade_max,
+                                    int nthreads)
+{
+OC6Catalog *catalog;
+std::vector<OC6_ORBIT> orbits;
+std::vector<double> rho_c, theta_c;
+PREDICT_DATA data;
+double *rho, *theta;
+char name[80];
+int norbits, nchunks, nselected, iorb, j, resolved;
+FILE *fp_out;
+
+catalog = OC6Catalog_get_cached(OC6_fname, is_master_file);
+if(catalog == NULL) {
+  fprintf(stderr, "predict_ephemerides/Fatal error loading %s\n", OC6_fname);
+  exit(-1);
+  }
+
+/* Decode the orbits (only once) and sort them by WDS name: */
+select_orbits(catalog, grade_max, &orbits);
+norbits = orbits.size();
+printf("predict_ephemerides: %d orbits selected out of %d\n",
+       norbits, catalog->NOrbits());
+if(norbits == 0) return(-1);
+
+/* Ephemerids of all the orbits: */
+rho_c.resize((size_t)norbits * nepochs);
+theta_c.resize((size_t)norbits * nepochs);
+data.orbits = &orbits;
+data.epochs = epochs;
+data.nepochs = nepochs;
+data.rho_c = &rho_c[0];
+data.theta_c = &theta_c[0];
+nchunks = (norbits + PREDICT_CHUNK - 1) / PREDICT_CHUNK;
+jlp_parallel_for(nchunks, nthreads, predict_worker, &data);
+
+/* Observing list: */
+if((fp_out = fopen(out_fname, "w")) == NULL) {
+  fprintf(stderr, "predict_ephemerides/Fatal error opening output file %s\n",
+          out_fname);
+  exit(-1);
+  }
+fprintf(fp_out, "%% Observing list from %s (grade <= %d)\n", OC6_fname,
+        grade_max);
+fprintf(fp_out, "%% Objects with %.3f <= rho <= %.3f arcsec at one epoch at least\n",
+        rho_min, rho_max);
+fprintf(fp_out, "%% WDS        Name                 Grade");
+for(j = 0; j < nepochs; j++)
+  fprintf(fp_out, "  rho(%.2f) theta ", epochs[j]);
+fprintf(fp_out, "\n");
+
+nselected = 0;
+for(iorb = 0; iorb < norbits; iorb++) {
+  rho = &rho_c[(size_t)iorb * nepochs];
+  theta = &theta_c[(size_t)iorb * nepochs];
+  resolved = 0;
+  for(j = 0; j < nepochs; j++)
+    if(rho[j] >= rho_min && rho[j] <= rho_max) resolved = 1;
+  if(!resolved) continue;
+
+  sprintf(name, "%s %s", orbits[iorb].discov_name, orbits[iorb].comp_name);
+  fprintf(fp_out, "%-10.10s %-20.20s %2d  ", orbits[iorb].WDS_name, name,
+          orbits[iorb].orbit_grade);
+/* Separations that cannot be measured are flagged with a star: */
+  for(j = 0; j < nepochs; j++)
+    fprintf(fp_out, "  %7.3f%c %6.1f ", rho[j],
+            (rho[j] >= rho_min && rho[j] <= rho_max) ? ' ' : '*', theta[j]);
+  fprintf(fp_out, "\n");
+  nselected++;
+  }
+fprintf(fp_out, "%% %d objects\n", nselected);
+fclose(fp_out);
+
+printf("predict_ephemerides: %d objects written to %s\n", nselected, out_fname);
+
+return(0);
+}
+/************************************************************************
+* Decode all the orbits of the catalog and keep the best orbit
+* of each object (smallest grade, the first one in the catalog
+* in case of equality), with grade <= grade_max
+*
+* OUTPUT:
+* orbits: selected orbits, sorted by WDS name
+*************************************************************************/
+static int select_orbits(OC6Catalog *catalog, int grade_max,
+                         std::vector<OC6_ORBIT> *orbits)
+{
+std::unordered_map<std::string, int> index_object;
+std::unordered_map<std::string, int>::iterator it;
+std::string key;
+OC6_ORBIT orb;
+int iorb;
+
+for(iorb = 0; iorb < catalog->NOrbits(); iorb++) {
+  if(catalog->GetOrbit(iorb, &orb) != 0) continue;
+  if(orb.orbit_grade > grade_max || orb.Period <= 0.) continue;
+  key = std::string(orb.WDS_name) + " " + orb.discov_name + " "
+        + orb.comp_name;
+  it = index_object.find(key);
+  if(it == index_object.end()) {
+    index_object[key] = orbits->size();
+    orbits->push_back(orb);
+    } else if(orb.orbit_grade < (*orbits)[it->second].orbit_grade) {
+    (*orbits)[it->second] = orb;
+    }
+  }
+
+std::stable_sort(orbits->begin(), orbits->end(), predict_wds_before);
+
+return(0);
+}
+/************************************************************************
+* Order of the observing list: WDS name, then discoverer's name and
+* companion
+*************************************************************************/
+static bool predict_wds_before(const OC6_ORBIT &orb1, const OC6_ORBIT &orb2)
+{
+int cmp;
+
+cmp = strcmp(orb1.WDS_name, orb2.WDS_name);
+if(cmp == 0) cmp = strcmp(orb1.discov_name, orb2.discov_name);
+if(cmp == 0) cmp = strcmp(orb1.comp_name, orb2.comp_name);
+
+return(cmp < 0);
+}
+/************************************************************************
+* Compute the ephemerids of the orbits of chunk #ichunk at all the epochs
+*************************************************************************/
+static void predict_worker(int ichunk, void *data0)
+{
+PREDICT_DATA *data = (PREDICT_DATA *)data0;
+OC6_ORBIT *orb;
+THIELE_ORBIT thiele;
+int iorb, iorb1, iorb2;
+
+iorb1 = ichunk * PREDICT_CHUNK;
+iorb2 = iorb1 + PREDICT_CHUNK;
+if(iorb2 > (int)data->orbits->size()) iorb2 = data->orbits->size();
+
+for(iorb = iorb1; iorb < iorb2; iorb++) {
+  orb = &(*data->orbits)[iorb];
+  thiele_orbits_init(1, &orb->Omega_node, &orb->omega_peri, &orb->i_incl,
+                     &orb->e_eccent, &orb->T_periastron, &orb->Period,
+                     &orb->a_smaxis, &orb->mean_motion, &thiele);
+  compute_multiple_system_ephemerides(&thiele, 1, data->epochs,
+                                      data->nepochs, NULL, NULL,
+                                      &data->theta_c[(size_t)iorb * data->nepochs],
+                                      &data->rho_c[(size_t)iorb * data->nepochs]);
+  }
+}
@@ -15,8 +15,13 @@
 * - iop=10 look for observations with dtheta > dtheta_max
 * - iop=11 look for observations of TDS and HDS and displays statistics
 *
+* The input table can also be a binary table (see calib_bintab.h),
+* e.g. written by merge_calib_resid --binary: it is then first rendered
+* from its rows as the LaTeX table old_table.tex (with the layout of the
+* LaTeX table it was made from), which is processed with the option
+*
 * JLP 
-* Version 18/05/2023
+* Version 17/10/2026
 *************************************************************************/
 #include <stdio.h> 
 #include <stdlib.h> // exit(-1) 
@@ -24,6 +29,8 @@
 #include <ctype.h>  // isalpha(), isdigit() 
 #include <time.h>   // time_t 
 #include "latex_utils.h" // latex_get_column_item(), latex_remove_column()
+#include "latex_row.h"   // LatexRow
+#include "calib_bintab.h" // CalibBinTable
 #include "jlp_string.h"  // (in jlplib/jlp_fits/ ) jlp_cleanup_..
 #include "jlp_catalog_utils.h"  // ABS 
 #include "jlp_string.h"  // ABS 
@@ -85,6 +92,7 @@ static int jlp_clean_dollars(char *str0, int str_len0);
 static int extract_large_dtheta_table1(char *in_fname, double dtheta_max, 
                                        char *out_fname);
 static int observations_HDS_TDS_table1(char *in_fname, char *out_fname);
+static int render_binary_table(char *in_fname, char *out_fname);
 
 /************************************************************************
 * Set all column numbers of input calib table
@@ -234,7 +242,7 @@ return(0);
 ************************************************************************/
 int main(int argc, char *argv[])
 {
-char in_fname[128], out_fname[128];
+char in_fname[128], out_fname[128], tex_fname[128];
 double rho_diff = 0.16, drhodiff_mini = 0., dthetadiff_mini = 0., rho_c;
 double rho_res_min = 0., theta_res_min = 0., dtheta_max = 0.;
 int iopt, resid_only;
@@ -277,6 +285,19 @@ else if(iopt == 8)
 else if(iopt == 10)
    sscanf(argv[3], "%d,%lf", &iopt, &dtheta_max);
 
+/* Binary input table: rendered first as a LaTeX table (in_fname.tex),
+* that is then processed with the requested option */
+if(calib_bintab_is_binary(in_fname)) {
+  if(strlen(in_fname) + 5 > 128) {
+    fprintf(stderr, "process_table_for_publi/Error: name of %s too long\n",
+            in_fname);
+    return(-1);
+    }
+  sprintf(tex_fname, "%s.tex", in_fname);
+  if(render_binary_table(in_fname, tex_fname) != 0) return(-1);
+  strcpy(in_fname, tex_fname);
+  }
+
 #ifdef DEBUG
 printf("%s\n", argv[3]);
 printf("OK: in_table=%s output=%s\n", 
@@ -346,6 +367,30 @@ switch(iopt) {
 return(0);
 }
 /************************************************************************
+* Render a binary table as a LaTeX table (with the layout of the table
+* and the decimals of the LaTeX table it was made from)
+*
+* INPUT:
+* in_fname: binary table
+* out_fname: LaTeX table
+************************************************************************/
+static int render_binary_table(char *in_fname, char *out_fname)
+{
+int status;
+CalibBinTable *tab;
+
+tab = new CalibBinTable(CALIB_FMT_ADS);
+status = tab->LoadFromFile(in_fname);
+if(status == 0) 
+  status = tab->WriteLatexFile(out_fname, tab->CalibFormat(), 50);
+if(status == 0) 
+  printf("render_binary_table: %d rows of %s written to %s\n", tab->NRows(), 
+         in_fname, out_fname);
+delete tab;
+
+return(status);
+}
+/************************************************************************
 * Scan the input table and make the modifications 
 * - look for the smallest and largest separations
 * - look for the smallest and largest sep. errors (when rho < rho_diff) 
@@ -372,6 +417,7 @@ double dthetadiff_min, dthetadiff_max;
 int i, resolved;
 PSC_MEAS psc_rho_min, psc_rho_max, psc_drhodiff_min, psc_drhodiff_max;
 PSC_MEAS psc_dthetadiff_min, psc_dthetadiff_max;
+LatexRow row;
 FILE *fp_in;
 time_t ttime = time(NULL);
 
@@ -418,10 +464,12 @@ while(!feof(fp_in)) {
 // Lines starting with % are ignored
     if(isdigit(in_line[0])) { 
      nlines_meas++;
+/* Tokenize the line only once for all the columns: */
+     row.Set(in_line);
 /* Get wds_name from column 1: */
-     latex_get_column_item(in_line, wds_name, 1, verbose_if_error);
+     row.GetItem(1, wds_name, verbose_if_error);
 /* Get discov_name from column 2: */
-     latex_get_column_item(in_line, discov_name, 2, verbose_if_error);
+     row.GetItem(2, discov_name, verbose_if_error);
      if(strcmp(old_discov_name, discov_name) != 0) {
         nobj++;
         strcpy(old_discov_name, discov_name);
@@ -438,13 +486,13 @@ while(!feof(fp_in)) {
       rho_val = -1;
       drho_val = -1;
 
-      if(latex_get_column_item(in_line, rho_meas, irho, verbose_if_error) == 0){
+      if(row.GetItem(irho, rho_meas, verbose_if_error) == 0){
         if(sscanf(rho_meas, "%lf", &dval) == 1) {
           rho_val = dval;
           nmeas++;
           if(resolved == 0) resolved = 1;
           }
-        if(latex_get_column_item(in_line, drho_meas, idrho, verbose_if_error) == 0){
+        if(row.GetItem(idrho, drho_meas, verbose_if_error) == 0){
           if(sscanf(drho_meas, "%lf", &dval) == 1) drho_val = dval;
           }
       }
@@ -454,9 +502,9 @@ while(!feof(fp_in)) {
       theta_val = -1;
       dtheta_val = -1;
 
-      if(latex_get_column_item(in_line, theta_meas, itheta, verbose_if_error) == 0){
+      if(row.GetItem(itheta, theta_meas, verbose_if_error) == 0){
         if(sscanf(theta_meas, "%lf", &dval) == 1) theta_val = dval;
-        if(latex_get_column_item(in_line, dtheta_meas, idtheta, verbose_if_error) == 0){
+        if(row.GetItem(idtheta, dtheta_meas, verbose_if_error) == 0){
           if(sscanf(dtheta_meas, "%lf", &dval) == 1) dtheta_val = dval;
           }
       }
@@ -464,7 +512,7 @@ while(!feof(fp_in)) {
       verbose_if_error = 0;
       dmag_val = -1;
       if(idmag > 0) {
-      if(latex_get_column_item(in_line, dmag_str, idmag, verbose_if_error) == 0){
+      if(row.GetItem(idmag, dmag_str, verbose_if_error) == 0){
         if(sscanf(dmag_str, "%lf", &dval) == 1) {
           dmag_val  = dval;
 #ifdef DEBUG1
@@ -475,7 +523,7 @@ while(!feof(fp_in)) {
       }
       } // dmag > 0
 /* Get orbit ref from column iorbit_ref: */
-      if(latex_get_column_item(in_line, orbit_ref, iorbit_ref, verbose_if_error) == 0){
+      if(row.GetItem(iorbit_ref, orbit_ref, verbose_if_error) == 0){
 #ifdef DEBUG1
         printf("discov_name=%s orbit_ref=%s\n", discov_name, orbit_ref);
 #endif
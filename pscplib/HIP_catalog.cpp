@@ -0,0 +1,652 @@
+/************************************************************************
+* "HIP_catalog.cpp"
+* In-memory versions of the Hipparcos Input Catalog (HIC)
+* and of the Hipparcos main catalog (HIP), loaded only once
+*
+* The useful fields are stored in fixed-length columns.
+* If a valid snapshot created by catalog_compile is found
+* (e.g. hic.dat.bin), the columns and the indexes are memory-mapped
+* from it instead of parsing the ASCII file.
+*
+* The HIC is indexed with declination zones, whose records are sorted
+* by right ascension, so that a search by position only looks at the few
+* hundred stars close to the requested position.
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>                /* exit() */
+#include <string.h>
+#include <math.h>
+#include <algorithm>               // std::stable_sort, std::lower_bound
+#include "HIP_catalog.h"
+#include "jlp_string.h"            // jlp_compact_string, jlp_trim_string
+
+#define ABS(a) ((a) < 0.0  ? (-(a)) : (a))
+#ifndef PI
+#define PI 3.14159265358979323846
+#endif
+#define DEGTORAD   (PI/180.00)
+
+/*
+#define DEBUG
+*/
+
+/* Minimum length of the lines (without '\n') used to decode the fields */
+#define HIC_LINE_LEN 316
+#define HIP_LINE_LEN 125
+
+static HICCatalog *cached_HIC_catalog = NULL;
+static HIPCatalog *cached_HIP_catalog = NULL;
+
+/*************************************************************************
+* Remove the end of line and pad the line with blanks
+* up to min_length characters
+*************************************************************************/
+static void HIP_pad_line(char *cat_line, int min_length)
+{
+int i, ilen;
+
+ilen = strlen(cat_line);
+while(ilen > 0 && (cat_line[ilen-1] == '\n' || cat_line[ilen-1] == '\r'))
+   ilen--;
+for(i = ilen; i < min_length; i++) cat_line[i] = ' ';
+if(ilen < min_length) ilen = min_length;
+cat_line[ilen] = '\0';
+}
+/*************************************************************************
+* Return the process-wide instance of the HIC catalog
+* (the catalog is loaded only once, or when its name changes)
+*************************************************************************/
+HICCatalog *HICCatalog_get_cached(char *HIC_catalog)
+{
+if(cached_HIC_catalog != NULL) {
+  if(!strcmp(cached_HIC_catalog->Filename(), HIC_catalog))
+     return(cached_HIC_catalog);
+  delete cached_HIC_catalog;
+  cached_HIC_catalog = NULL;
+  }
+
+cached_HIC_catalog = new HICCatalog(HIC_catalog);
+if(!cached_HIC_catalog->IsLoaded()) {
+  delete cached_HIC_catalog;
+  cached_HIC_catalog = NULL;
+  }
+
+return(cached_HIC_catalog);
+}
+/*************************************************************************
+* Return the process-wide instance of the HIP catalog
+* (the catalog is loaded only once, or when its name changes)
+*************************************************************************/
+HIPCatalog *HIPCatalog_get_cached(char *HIP_catalog)
+{
+if(cached_HIP_catalog != NULL) {
+  if(!strcmp(cached_HIP_catalog->Filename(), HIP_catalog))
+     return(cached_HIP_catalog);
+  delete cached_HIP_catalog;
+  cached_HIP_catalog = NULL;
+  }
+
+cached_HIP_catalog = new HIPCatalog(HIP_catalog);
+if(!cached_HIP_catalog->IsLoaded()) {
+  delete cached_HIP_catalog;
+  cached_HIP_catalog = NULL;
+  }
+
+return(cached_HIP_catalog);
+}
+/*************************************************************************
+* Constructor of the HIC catalog
+*
+* INPUT:
+*  HIC_catalog0: name of the Hipparcos Input Catalog
+*  use_snapshot: if 1, use the binary snapshot when present and valid
+*************************************************************************/
+HICCatalog::HICCatalog(char *HIC_catalog0, int use_snapshot)
+{
+strncpy(HIC_catalog_fname, HIC_catalog0, 255);
+HIC_catalog_fname[255] = '\0';
+nrecords = 0;
+loaded = 0;
+data = NULL;
+snap.map_address = NULL;
+snap.data = NULL;
+
+if(use_snapshot
+   && snapshot_open(HIC_catalog_fname, SNAPSHOT_HIC, HIC_RECORD_SIZE,
+                    &snap) == 0) {
+  nrecords = snap.nrecords;
+  if(snap.index_size == IndexSize()) {
+    SetColumns(snap.data);
+    SetIndexes(snap.index);
+    loaded = 1;
+    } else {
+    fprintf(stderr, "HICCatalog/Warning: bad index size in the snapshot of %s (ignored)\n",
+            HIC_catalog_fname);
+    snapshot_close(&snap);
+    nrecords = 0;
+    }
+  }
+
+if(!loaded && LoadFromTextFile() == 0) {
+  index_buffer.resize(IndexSize() / sizeof(double) + 1);
+  SetIndexes((char *)&index_buffer[0]);
+  BuildZoneIndex();
+  loaded = 1;
+  }
+}
+/*************************************************************************
+* Set the addresses of the columns (double precision columns first)
+*************************************************************************/
+void HICCatalog::SetColumns(char *data0)
+{
+char *pc;
+
+data = data0;
+pc = data;
+col_alpha = (double *)pc;
+pc += nrecords * sizeof(double);
+col_delta = (double *)pc;
+pc += nrecords * sizeof(double);
+col_V_mag = (double *)pc;
+pc += nrecords * sizeof(double);
+col_B_V = (double *)pc;
+pc += nrecords * sizeof(double);
+col_HIP_name = pc;
+pc += nrecords * HIP_NAME_LEN;
+col_CCDM_name = pc;
+}
+/*************************************************************************
+* Size of the spatial index (in bytes)
+*************************************************************************/
+size_t HICCatalog::IndexSize()
+{
+nzones = (int)(180. / HIC_ZONE_HEIGHT + 0.5);
+return((size_t)nrecords * (sizeof(double) + sizeof(int32_t))
+       + (size_t)(nzones + 1) * sizeof(int32_t));
+}
+/*************************************************************************
+* Set the addresses of the spatial index (double precision column first)
+*************************************************************************/
+void HICCatalog::SetIndexes(char *index0)
+{
+char *pc;
+
+nzones = (int)(180. / HIC_ZONE_HEIGHT + 0.5);
+pc = index0;
+zone_alpha = (double *)pc;
+pc += nrecords * sizeof(double);
+zone_irec = (int32_t *)pc;
+pc += nrecords * sizeof(int32_t);
+zone_start = (int32_t *)pc;
+}
+/*************************************************************************
+* Save the columns to a binary snapshot (used by catalog_compile)
+*************************************************************************/
+int HICCatalog::WriteSnapshot()
+{
+if(!loaded) return(-1);
+return(snapshot_write(HIC_catalog_fname, SNAPSHOT_HIC, HIC_RECORD_SIZE,
+                      data, nrecords, (char *)zone_alpha, IndexSize()));
+}
+/*************************************************************************
+* Read the Hipparcos Input Catalog
+* (same fields as in search_object_in_HIC_catalog())
+*
+   1-  6  I6     ---     HIC      [1/120313]+ Hipparcos Input Catalogue
+                                    running number.
+  15- 16  I2     h       RAh      Right ascension J2000 (hours), at Epoch
+  18- 19  I2     min     RAm      Right ascension (minutes)
+  21- 26  F6.3   s       RAs      Right ascension (seconds)
+      28  A1     ---     DE-      Declination J2000 (sign)
+  29- 30  I2     deg     DEd      Declination (degrees)
+  32- 33  I2     arcmin  DEm      Declination (minutes)
+  35- 39  F5.2   arcsec  DEs      Declination (seconds)
+  41- 44  I4     a       Epoch   *Epoch for the position, generally 2000
+ 191-196  F6.3   mag     Vmag     V magnitude
+ 203-208  F6.3   mag     B-V      ?B-V colour index
+ 286-295  A10    ---     CCDM    *CCDM number (details in annex1)
+*************************************************************************/
+int HICCatalog::LoadFromTextFile()
+{
+FILE *fp_HIC_cat;
+char cat_line0[1024], c_sign, HIP_name0[64], CCDM_name0[64], buffer[64];
+int ilen, iline, a1, a2, d1, d2, i_equinox0, nval;
+double a3, alpha0, delta0, fw;
+float d3;
+std::vector<double> v_alpha, v_delta, v_V_mag, v_B_V;
+std::vector<char> v_HIP_name, v_CCDM_name;
+
+/* Open input file containing the HIC catalog */
+if((fp_HIC_cat = fopen(HIC_catalog_fname, "r")) == NULL) {
+   fprintf(stderr, "HICCatalog/Fatal error opening HIC catalog: %s\n",
+           HIC_catalog_fname);
+   return(-1);
+  }
+
+nrecords = 0;
+iline = 0;
+while(!feof(fp_HIC_cat)) {
+ if(fgets(cat_line0, 1024, fp_HIC_cat)) {
+   iline++;
+   if(cat_line0[0] == '%') continue;
+   HIP_pad_line(cat_line0, HIC_LINE_LEN);
+
+/* Warning: C arrays start at 0, hence should remove one from field number: */
+   ilen = 44 - 15 + 1;
+   strncpy(buffer, &cat_line0[14], ilen);
+   buffer[ilen] = '\0';
+   nval = sscanf(buffer, "%2d %2d %6lf %c %2d %2d %5f %4d",
+                 &a1, &a2, &a3, &c_sign, &d1, &d2, &d3, &i_equinox0);
+   if(nval != 8) {
+      fprintf(stderr, "HICCatalog/Error reading coordinates in Hipparcos input catalog/iline=%d nval=%d\n buffer=>%s< (line ignored)\n",
+              iline, nval, buffer);
+      continue;
+      }
+/* alpha in hours and delta in degrees */
+   alpha0 = (double)a1 + ((double)a2)/60. + a3/3600.;
+   delta0 = (double)d1 + ((double)d2)/60. + d3/3600.;
+   if(c_sign == '-') delta0 *= -1.;
+   v_alpha.push_back(alpha0);
+   v_delta.push_back(delta0);
+
+/* HIC number (trimmed): */
+   memset(HIP_name0, 0, 64);
+   strncpy(HIP_name0, &cat_line0[0], 6);
+   jlp_trim_string(HIP_name0, 7);
+   v_HIP_name.insert(v_HIP_name.end(), HIP_name0, HIP_name0 + HIP_NAME_LEN);
+
+/* V magnitude and B-V index (100. if unknown): */
+   ilen = 6;
+   strncpy(buffer, &cat_line0[190], ilen);
+   buffer[ilen] = '\0';
+   if(sscanf(buffer, "%6lf", &fw) != 1) fw = 100.;
+   v_V_mag.push_back(fw);
+   strncpy(buffer, &cat_line0[202], ilen);
+   buffer[ilen] = '\0';
+   if(sscanf(buffer, "%6lf", &fw) != 1) fw = 100.;
+   v_B_V.push_back(fw);
+
+/* CCDM name and components: */
+   memset(CCDM_name0, 0, 64);
+   strncpy(CCDM_name0, &cat_line0[285], 13);
+   v_CCDM_name.insert(v_CCDM_name.end(), CCDM_name0,
+                      CCDM_name0 + HIC_CCDM_LEN);
+   nrecords++;
+  } /* EOF fgets... */
+} /* EOF while */
+
+fclose(fp_HIC_cat);
+
+/* Store all the columns contiguously (same layout as the snapshot): */
+data_buffer.resize((nrecords * HIC_RECORD_SIZE) / sizeof(double) + 1);
+SetColumns((char *)&data_buffer[0]);
+if(nrecords > 0) {
+  memcpy(col_alpha, &v_alpha[0], nrecords * sizeof(double));
+  memcpy(col_delta, &v_delta[0], nrecords * sizeof(double));
+  memcpy(col_V_mag, &v_V_mag[0], nrecords * sizeof(double));
+  memcpy(col_B_V, &v_B_V[0], nrecords * sizeof(double));
+  memcpy(col_HIP_name, &v_HIP_name[0], nrecords * HIP_NAME_LEN);
+  memcpy(col_CCDM_name, &v_CCDM_name[0], nrecords * HIC_CCDM_LEN);
+  }
+
+#ifdef DEBUG
+printf("HICCatalog: %d records loaded from %s\n", nrecords, HIC_catalog_fname);
+#endif
+
+return(0);
+}
+/*************************************************************************
+* Comparison of the right ascensions of two records (used to sort the zones)
+*************************************************************************/
+struct HIC_alpha_less {
+  double *alpha;
+  bool operator()(int i1, int i2) const { return(alpha[i1] < alpha[i2]); }
+};
+/*************************************************************************
+* Angular distance (in degrees) between two positions
+* (alpha in hours and delta in degrees)
+*************************************************************************/
+static double HIC_angular_distance(double alpha1, double delta1,
+                                   double alpha2, double delta2)
+{
+double sin_dd, sin_da, hav;
+
+sin_dd = sin((delta2 - delta1) * DEGTORAD / 2.);
+sin_da = sin((alpha2 - alpha1) * 15. * DEGTORAD / 2.);
+hav = sin_dd * sin_dd
+      + cos(delta1 * DEGTORAD) * cos(delta2 * DEGTORAD) * sin_da * sin_da;
+if(hav > 1.) hav = 1.;
+
+return(2. * asin(sqrt(hav)) / DEGTORAD);
+}
+/*************************************************************************
+* Build the spatial index: declination zones of HIC_ZONE_HEIGHT degrees,
+* with the records of each zone sorted by right ascension
+* (only when the catalog is read from the ASCII file: the index
+* is saved in the snapshot)
+*************************************************************************/
+void HICCatalog::BuildZoneIndex()
+{
+HIC_alpha_less alpha_less;
+int irec, izone, k;
+std::vector<int> zone_of_rec(nrecords);
+
+for(izone = 0; izone <= nzones; izone++) zone_start[izone] = 0;
+
+for(irec = 0; irec < nrecords; irec++) {
+  izone = (int)((col_delta[irec] + 90.) / HIC_ZONE_HEIGHT);
+  if(izone < 0) izone = 0;
+  if(izone > nzones - 1) izone = nzones - 1;
+  zone_of_rec[irec] = izone;
+  zone_start[izone + 1]++;
+  }
+for(izone = 0; izone < nzones; izone++)
+  zone_start[izone + 1] += zone_start[izone];
+
+/* Counting sort by zone (the order of the catalog is kept in each zone) */
+std::vector<int> next(zone_start, zone_start + nzones);
+for(irec = 0; irec < nrecords; irec++)
+  zone_irec[next[zone_of_rec[irec]]++] = irec;
+
+/* Sort each zone by right ascension (stable: same order as the catalog
+* for identical right ascensions) */
+alpha_less.alpha = col_alpha;
+for(izone = 0; izone < nzones; izone++)
+  std::stable_sort(zone_irec + zone_start[izone],
+                   zone_irec + zone_start[izone + 1], alpha_less);
+
+for(k = 0; k < nrecords; k++) zone_alpha[k] = col_alpha[zone_irec[k]];
+}
+/*************************************************************************
+* Look for the nearest object of a zone with alpha_min <= alpha <= alpha_max
+* and within the tolerance box
+*************************************************************************/
+void HICCatalog::SearchInZone(int izone, double alpha_min, double alpha_max,
+                              double alpha, double delta, double D_tolerance,
+                              int *irec_best, double *ang_dist_best)
+{
+double *it;
+double D_alpha, D_delta, ang_dist;
+int k, irec;
+
+it = std::lower_bound(zone_alpha + zone_start[izone],
+                      zone_alpha + zone_start[izone + 1], alpha_min);
+for(k = it - zone_alpha; k < zone_start[izone + 1]; k++) {
+  if(zone_alpha[k] > alpha_max) break;
+  irec = zone_irec[k];
+/* Same tolerance box as in the previous versions
+* (D_alpha in hours, D_delta and D_tolerance in degrees) */
+  D_alpha = ABS(col_alpha[irec] - alpha);
+  if(D_alpha > 12.) D_alpha = 24. - D_alpha;
+  D_delta = ABS(col_delta[irec] - delta);
+  if(D_alpha < D_tolerance/15. && D_delta < D_tolerance) {
+    ang_dist = HIC_angular_distance(alpha, delta, col_alpha[irec],
+                                    col_delta[irec]);
+    if(*irec_best < 0 || ang_dist < *ang_dist_best
+       || (ang_dist == *ang_dist_best && irec < *irec_best)) {
+      *irec_best = irec;
+      *ang_dist_best = ang_dist;
+      }
+    }
+  }
+}
+/*************************************************************************
+* Search for the Hipparcos object located at the coordinates (alpha, delta)
+* (see search_object_in_HIC_catalog() in "HIP_catalog_utils.cpp")
+*
+* INPUT:
+*  alpha, delta: coordinates of the object to be searched for
+*                (alpha in hours and delta in degrees)
+*  equinox: not used (as in the former search_object_in_HIC_catalog(),
+*           the coordinates are compared without precession to those
+*           of the catalog)
+*  D_tolerance: tolerance of D_alpha/D_delta in degrees
+*
+* OUTPUT:
+*  HIP_name, CCDM_name, V_mag, B_V_index: data of the nearest entry
+*                         of the catalog within the tolerance box
+*  ang_dist: angular distance to this entry (in degrees)
+*  found: 1 is object was found, 0 otherwise
+*************************************************************************/
+int HICCatalog::SearchObject(double alpha, double delta, double /*equinox*/,
+                             char *HIP_name, char *CCDM_name,
+                             double *V_mag, double *B_V_index,
+                             double D_tolerance, double *ang_dist, int *found)
+{
+double alpha_min, alpha_max;
+int izone, izone_min, izone_max, irec_best;
+
+HIP_name[0] = '\0';
+CCDM_name[0] = '\0';
+*V_mag = 100.;
+*B_V_index = 100.;
+*ang_dist = -1.;
+*found = 0;
+if(nrecords == 0) return(0);
+
+izone_min = (int)((delta - D_tolerance + 90.) / HIC_ZONE_HEIGHT);
+izone_max = (int)((delta + D_tolerance + 90.) / HIC_ZONE_HEIGHT);
+if(izone_min < 0) izone_min = 0;
+if(izone_max > nzones - 1) izone_max = nzones - 1;
+alpha_min = alpha - D_tolerance / 15.;
+alpha_max = alpha + D_tolerance / 15.;
+
+irec_best = -1;
+for(izone = izone_min; izone <= izone_max; izone++) {
+  SearchInZone(izone, alpha_min, alpha_max, alpha, delta, D_tolerance,
+               &irec_best, ang_dist);
+/* Handle the objects close to alpha=0h or alpha=24h: */
+  if(alpha_min < 0.)
+    SearchInZone(izone, alpha_min + 24., 24., alpha, delta, D_tolerance,
+                 &irec_best, ang_dist);
+  if(alpha_max > 24.)
+    SearchInZone(izone, 0., alpha_max - 24., alpha, delta, D_tolerance,
+                 &irec_best, ang_dist);
+  }
+
+if(irec_best >= 0) {
+  strcpy(HIP_name, &col_HIP_name[irec_best * HIP_NAME_LEN]);
+  strcpy(CCDM_name, &col_CCDM_name[irec_best * HIC_CCDM_LEN]);
+  *V_mag = col_V_mag[irec_best];
+  *B_V_index = col_B_V[irec_best];
+  *found = 1;
+  } else {
+  *ang_dist = -1.;
+  }
+
+#ifdef DEBUG
+printf("HICCatalog::SearchObject: alpha=%f delta=%f found=%d HIP%s dist=%f deg\n",
+        alpha, delta, *found, HIP_name, *ang_dist);
+#endif
+
+return(0);
+}
+/*************************************************************************
+* Constructor of the HIP catalog
+*
+* INPUT:
+*  HIP_catalog0: name of the Hipparcos/Tycho main catalog
+*  use_snapshot: if 1, use the binary snapshot when present and valid
+*************************************************************************/
+HIPCatalog::HIPCatalog(char *HIP_catalog0, int use_snapshot)
+{
+strncpy(HIP_catalog_fname, HIP_catalog0, 255);
+HIP_catalog_fname[255] = '\0';
+nrecords = 0;
+loaded = 0;
+data = NULL;
+snap.map_address = NULL;
+snap.data = NULL;
+
+if(use_snapshot
+   && snapshot_open(HIP_catalog_fname, SNAPSHOT_HIP, HIP_RECORD_SIZE,
+                    &snap) == 0) {
+  nrecords = snap.nrecords;
+  if(snap.index_size == IndexSize()) {
+    SetColumns(snap.data);
+    SetIndexes(snap.index);
+    loaded = 1;
+    } else {
+    fprintf(stderr, "HIPCatalog/Warning: bad index size in the snapshot of %s (ignored)\n",
+            HIP_catalog_fname);
+    snapshot_close(&snap);
+    nrecords = 0;
+    }
+  }
+
+if(!loaded && LoadFromTextFile() == 0) {
+  index_buffer.resize(IndexSize() / sizeof(double) + 1);
+  SetIndexes((char *)&index_buffer[0]);
+  BuildIndex();
+  loaded = 1;
+  }
+}
+/*************************************************************************
+* Set the addresses of the columns (double precision columns first)
+*************************************************************************/
+void HIPCatalog::SetColumns(char *data0)
+{
+char *pc;
+
+data = data0;
+pc = data;
+col_paral = (double *)pc;
+pc += nrecords * sizeof(double);
+col_err_paral = (double *)pc;
+pc += nrecords * sizeof(double);
+col_HIP_name = pc;
+}
+/*************************************************************************
+* Size of the hash index (in bytes)
+*************************************************************************/
+size_t HIPCatalog::IndexSize()
+{
+nslots = snapshot_hash_nslots(nrecords);
+return((size_t)nslots * sizeof(int32_t));
+}
+/*************************************************************************
+* Set the address of the hash index
+*************************************************************************/
+void HIPCatalog::SetIndexes(char *index0)
+{
+nslots = snapshot_hash_nslots(nrecords);
+index_HIP = (int32_t *)index0;
+}
+/*************************************************************************
+* Save the columns to a binary snapshot (used by catalog_compile)
+*************************************************************************/
+int HIPCatalog::WriteSnapshot()
+{
+if(!loaded) return(-1);
+return(snapshot_write(HIP_catalog_fname, SNAPSHOT_HIP, HIP_RECORD_SIZE,
+                      data, nrecords, (char *)index_HIP, IndexSize()));
+}
+/*************************************************************************
+* Read the Hipparcos/Tycho main Catalog
+* (same fields as in read_data_in_HIP_catalog())
+*
+   9- 14  I6    ---     HIP       Identifier (HIP number)                   (H1)
+  80- 86  F7.2  mas     Plx       ? Trigonometric parallax                 (H11)
+ 120-125  F6.2  mas   e_Plx       ? Standard error in Plx                  (H16)
+*************************************************************************/
+int HIPCatalog::LoadFromTextFile()
+{
+FILE *fp_HIP_cat;
+char cat_line0[1024], HIP_name0[64], buffer[64];
+double fw;
+std::vector<double> v_paral, v_err_paral;
+std::vector<char> v_HIP_name;
+
+/* Open input file containing the HIP catalog */
+if((fp_HIP_cat = fopen(HIP_catalog_fname, "r")) == NULL) {
+   fprintf(stderr, "HIPCatalog/Fatal error opening HIP catalog: %s\n",
+           HIP_catalog_fname);
+   return(-1);
+  }
+
+nrecords = 0;
+while(!feof(fp_HIP_cat)) {
+ if(fgets(cat_line0, 1024, fp_HIP_cat)) {
+   if(cat_line0[0] == '%') continue;
+   HIP_pad_line(cat_line0, HIP_LINE_LEN);
+
+/* Warning: C arrays start at 0, hence should remove one from field number: */
+   memset(HIP_name0, 0, 64);
+   strncpy(HIP_name0, &cat_line0[8], 6);
+   jlp_compact_string(HIP_name0, 7);
+   v_HIP_name.insert(v_HIP_name.end(), HIP_name0, HIP_name0 + HIP_NAME_LEN);
+
+/* Parallax and error (-1 if unknown): */
+   strncpy(buffer, &cat_line0[79], 7);
+   buffer[7] = '\0';
+   if(sscanf(buffer, "%lf", &fw) != 1) fw = -1.;
+   v_paral.push_back(fw);
+   strncpy(buffer, &cat_line0[119], 6);
+   buffer[6] = '\0';
+   if(sscanf(buffer, "%lf", &fw) != 1) fw = -1.;
+   v_err_paral.push_back(fw);
+   nrecords++;
+  } /* EOF fgets... */
+} /* EOF while */
+
+fclose(fp_HIP_cat);
+
+/* Store all the columns contiguously (same layout as the snapshot): */
+data_buffer.resize((nrecords * HIP_RECORD_SIZE) / sizeof(double) + 1);
+SetColumns((char *)&data_buffer[0]);
+if(nrecords > 0) {
+  memcpy(col_paral, &v_paral[0], nrecords * sizeof(double));
+  memcpy(col_err_paral, &v_err_paral[0], nrecords * sizeof(double));
+  memcpy(col_HIP_name, &v_HIP_name[0], nrecords * HIP_NAME_LEN);
+  }
+
+#ifdef DEBUG
+printf("HIPCatalog: %d records loaded from %s\n", nrecords, HIP_catalog_fname);
+#endif
+
+return(0);
+}
+/*************************************************************************
+* Build the hash index on the HIP number
+* (the first record is kept for duplicated numbers)
+* (only when the catalog is read from the ASCII file: the index
+* is saved in the snapshot)
+*************************************************************************/
+void HIPCatalog::BuildIndex()
+{
+int irec;
+
+snapshot_hash_init(index_HIP, nslots);
+for(irec = 0; irec < nrecords; irec++)
+  snapshot_hash_insert(index_HIP, nslots, col_HIP_name, HIP_NAME_LEN, irec);
+}
+/*************************************************************************
+* Read the parallax of an object from its HIP number
+* (see read_data_in_HIP_catalog() in "HIP_catalog_utils.cpp")
+*
+* OUTPUT:
+*  paral, err_paral: parallax and error on this parallax
+*  found: 1 is object was found, 0 otherwise
+*************************************************************************/
+int HIPCatalog::ReadData(char *HIP_name, double *paral, double *err_paral,
+                         int *found)
+{
+int irec;
+
+*paral = -1.;
+*err_paral = -1.;
+*found = 0;
+
+irec = snapshot_hash_find(index_HIP, nslots, col_HIP_name, HIP_NAME_LEN,
+                          HIP_name);
+if(irec < 0) return(0);
+
+*paral = col_paral[irec];
+*err_paral = col_err_paral[irec];
+*found = 1;
+
+return(0);
+}
@@ -0,0 +1,128 @@
+/************************************************************************
+* "HIP_catalog.h"
+* In-memory versions of the Hipparcos Input Catalog (HIC)
+* and of the Hipparcos main catalog (HIP), loaded only once
+* (columns and indexes memory-mapped from the snapshots created
+* by catalog_compile if present)
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#ifndef __HIP_catalog_h   /* BOF sentry */
+#define __HIP_catalog_h
+
+#include <vector>
+#include <stdint.h>
+#include "catalog_snapshot.h"
+
+/* Fixed length of the columns (including the final '\0') */
+#define HIP_NAME_LEN     8
+#define HIC_CCDM_LEN     14
+/* Size of one record of the HIC: alpha, delta, V_mag, B_V, HIP, CCDM */
+#define HIC_RECORD_SIZE  (4 * sizeof(double) + HIP_NAME_LEN + HIC_CCDM_LEN)
+/* Size of one record of the HIP: paral, err_paral, HIP */
+#define HIP_RECORD_SIZE  (2 * sizeof(double) + HIP_NAME_LEN)
+/* Height of the declination zones of the spatial index of the HIC (deg.)
+* (about 160 stars per zone for the 118000 stars of the HIC) */
+#define HIC_ZONE_HEIGHT  0.25
+
+/************************************************************************
+* Hipparcos Input Catalog: search by position
+*************************************************************************/
+class HICCatalog {
+
+public:
+    HICCatalog(char *HIC_catalog0, int use_snapshot = 1);
+    ~HICCatalog() { snapshot_close(&snap); };
+
+    int IsLoaded() { return(loaded); }
+    int IsFromSnapshot() { return(snap.data != NULL); }
+    int NRecords() { return(nrecords); }
+    int WriteSnapshot();
+    const char *Filename() { return(HIC_catalog_fname); }
+
+// Same interface as search_object_in_HIC_catalog(),
+// with the angular distance to the nearest object (in degrees)
+    int SearchObject(double alpha, double delta, double equinox,
+                     char *HIP_name, char *CCDM_name,
+                     double *V_mag, double *B_V_index,
+                     double D_tolerance, double *ang_dist, int *found);
+
+private:
+    int LoadFromTextFile();
+    void SetColumns(char *data0);
+    size_t IndexSize();
+    void SetIndexes(char *index0);
+    void BuildZoneIndex();
+    void SearchInZone(int izone, double alpha_min, double alpha_max,
+                      double alpha, double delta, double D_tolerance,
+                      int *irec_best, double *ang_dist_best);
+
+    char HIC_catalog_fname[256];
+    int nrecords, loaded;
+
+// Columns (alpha in hours, delta in degrees), stored contiguously
+// in data_buffer or in the memory-mapped snapshot:
+    std::vector<double> data_buffer;
+    SNAPSHOT_MAP snap;
+    char *data;
+    double *col_alpha, *col_delta, *col_V_mag, *col_B_V;
+    char *col_HIP_name, *col_CCDM_name;
+
+// Spatial index: declination zones of HIC_ZONE_HEIGHT degrees,
+// with the records of each zone sorted by right ascension
+// (zone k: from zone_start[k] to zone_start[k+1]-1 in zone_irec/zone_alpha),
+// stored contiguously in index_buffer or in the memory-mapped snapshot:
+    std::vector<double> index_buffer;
+    int nzones;
+    double *zone_alpha;
+    int32_t *zone_start, *zone_irec;
+};
+
+/************************************************************************
+* Hipparcos main catalog: search by HIP number
+*************************************************************************/
+class HIPCatalog {
+
+public:
+    HIPCatalog(char *HIP_catalog0, int use_snapshot = 1);
+    ~HIPCatalog() { snapshot_close(&snap); };
+
+    int IsLoaded() { return(loaded); }
+    int IsFromSnapshot() { return(snap.data != NULL); }
+    int NRecords() { return(nrecords); }
+    int WriteSnapshot();
+    const char *Filename() { return(HIP_catalog_fname); }
+
+// Same interface as read_data_in_HIP_catalog()
+    int ReadData(char *HIP_name, double *paral, double *err_paral,
+                 int *found);
+
+private:
+    int LoadFromTextFile();
+    void SetColumns(char *data0);
+    size_t IndexSize();
+    void SetIndexes(char *index0);
+    void BuildIndex();
+
+    char HIP_catalog_fname[256];
+    int nrecords, loaded;
+
+    std::vector<double> data_buffer;
+    SNAPSHOT_MAP snap;
+    char *data;
+    double *col_paral, *col_err_paral;
+    char *col_HIP_name;
+
+// Hash index (HIP number -> first record), stored in index_buffer
+// or in the memory-mapped snapshot:
+    std::vector<double> index_buffer;
+    int nslots;
+    int32_t *index_HIP;
+};
+
+// Process-wide instances (reloaded only if the catalog name changes):
+HICCatalog *HICCatalog_get_cached(char *HIC_catalog);
+HIPCatalog *HIPCatalog_get_cached(char *HIP_catalog);
+
+#endif   /* EOF sentry */
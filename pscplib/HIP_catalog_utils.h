@@ -25,6 +25,12 @@ int search_object_in_HIC_catalog(char *HIC_catalog, double alpha, double delta,
                                  char *CCDM_name,
                                  double *V_mag, double *B_V_index, 
                                  double D_tolerance, int *found);
+int search_nearest_object_in_HIC_catalog(char *HIC_catalog, double alpha,
+                                         double delta, double equinox,
+                                         char *HIP_name, char *CCDM_name,
+                                         double *V_mag, double *B_V_index,
+                                         double D_tolerance, double *ang_dist,
+                                         int *found);
 int read_data_in_HIP_catalog(char *HIP_catalog, char *HIP_name, 
                              double *paral, double *err_paral, int *found);
 int check_consistency_coord_WDSname(double alpha_Pcat, double delta_Pcat, 
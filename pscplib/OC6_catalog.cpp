@@ -0,0 +1,305 @@
+/************************************************************************
+* "OC6_catalog.cpp"
+* In-memory version of the OC6 orbit catalog ("orb6orbits.txt" or
+* "orb6.master"), read only once and indexed by discoverer's name
+*
+* line_extraction_from_OC6_catalog() and its "_gili" version call
+* the process-wide instance returned by OC6Catalog_get_cached(), so that
+* extracting the orbits of a full table is done with a single reading
+* of the catalog.
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>    // exit()
+#include <string.h>    // strcpy()
+#include "OC6_catalog.h"
+#include "OC6_catalog_utils.h"  // get_name_from_OC6_line, get_orbit_from_OC6_list
+#include "jlp_catalog_utils.h"  // jlp_really_compact_companion
+#include "jlp_string.h"         // jlp_compact_string
+
+/*
+#define DEBUG
+*/
+
+static OC6Catalog *cached_OC6_catalog = NULL;
+
+/*************************************************************************
+* Return the process-wide instance of the OC6 catalog
+* (the catalog is loaded only once, or when its name changes)
+*************************************************************************/
+OC6Catalog *OC6Catalog_get_cached(char *OC6_fname, int is_master_file)
+{
+if(cached_OC6_catalog != NULL) {
+  if(!strcmp(cached_OC6_catalog->Filename(), OC6_fname)
+     && cached_OC6_catalog->IsMasterFile() == is_master_file)
+     return(cached_OC6_catalog);
+  delete cached_OC6_catalog;
+  cached_OC6_catalog = NULL;
+  }
+
+cached_OC6_catalog = new OC6Catalog(OC6_fname, is_master_file);
+if(!cached_OC6_catalog->IsLoaded()) {
+  delete cached_OC6_catalog;
+  cached_OC6_catalog = NULL;
+  }
+
+return(cached_OC6_catalog);
+}
+/*************************************************************************
+* Constructor
+*
+* INPUT:
+* OC6_fname0: name of master file or Sixth Orbit catalog
+* is_master_file0: flag set to 1 if master file ("orb6.master",
+*                          to 0 if OC6 file ("orb6orbits.txt")
+*************************************************************************/
+OC6Catalog::OC6Catalog(char *OC6_fname0, int is_master_file0)
+{
+strncpy(OC6_fname, OC6_fname0, 255);
+OC6_fname[255] = '\0';
+is_master_file = is_master_file0;
+loaded = 0;
+
+if(LoadFromTextFile() == 0) loaded = 1;
+}
+/*************************************************************************
+* Read all the orbits of the catalog and decode their names
+* (same reading as in line_extraction_from_OC6_catalog())
+*************************************************************************/
+int OC6Catalog::LoadFromTextFile()
+{
+/* Line length is 278 + "\n" for OC6 catalog (orb6.master, november 2009)... */
+/* Line length is 264 + "\n" for OC6 catalog (orb6orbits.txt, november 2009)... */
+char line_buffer[300], OC6_ads_name[60], OC6_discov_name[40];
+char OC6_comp_name[40], OC6_comp_really_compacted[40];
+int iline, iblock, iorb, nlines_in_header, status;
+FILE *fp_in;
+
+if((fp_in = fopen(OC6_fname,"r")) == NULL) {
+  fprintf(stderr, "OC6Catalog/Fatal error opening %s\n", OC6_fname);
+  return(-1);
+  }
+
+if(is_master_file)
+  nlines_in_header = 4;
+else
+  nlines_in_header = 8;
+
+iline = 0;
+iblock = 0;
+while(!feof(fp_in)) {
+/* Should read more than
+* 278 characters in master OC6 file
+* 264 characters in non-master OC6 file
+* in order to be sure to copy the complete line: */
+  if(fgets(line_buffer, 280, fp_in)) {
+    iline++;
+/* Empty lines generally indicate the end of a given object: */
+    if(!strncmp(line_buffer,"    ",4)) {
+      iblock++;
+      continue;
+      }
+    if(iline <= nlines_in_header) continue;
+
+    status = get_name_from_OC6_line(line_buffer, OC6_ads_name,
+                                    OC6_discov_name, OC6_comp_name);
+    if(status) {
+      fprintf(stderr, "OC6Catalog/Error processing line #%d\n", iline);
+      fclose(fp_in);
+      return(-1);
+      }
+    jlp_compact_string(OC6_ads_name, 60);
+    jlp_compact_string(OC6_comp_name, 40);
+    jlp_really_compact_companion(OC6_comp_name, OC6_comp_really_compacted, 40);
+
+    iorb = orbit_line.size();
+    orbit_line.push_back(line_buffer);
+    orbit_ads.push_back(OC6_ads_name);
+    orbit_comp.push_back(OC6_comp_name);
+    orbit_comp_really.push_back(OC6_comp_really_compacted);
+    orbit_block.push_back(iblock);
+    index_discov[OC6_discov_name].push_back(iorb);
+  } /* EOF if fgets */
+}
+
+fclose(fp_in);
+
+orbit_elements.resize(orbit_line.size());
+decode_status.assign(orbit_line.size(), 1);
+
+#ifdef DEBUG
+printf("OC6Catalog: %d lines read and %d orbits loaded from %s\n",
+        iline, (int)orbit_line.size(), OC6_fname);
+#endif
+
+return(0);
+}
+/*************************************************************************
+* Select the orbits of an object
+* (same selection as in line_extraction_from_OC6_catalog(): only the
+*  first group of consecutive orbits of the object is considered)
+*
+* INPUT:
+* ads_name: ADS name of object ('\0' if not in ADS, or if gili_format=1)
+* discov_name: discovery name of object
+* comp_name: name of the companion (e.g., AB, Aa, etc)
+* gili_format: if 1, the companion is always checked (and not the ADS name)
+* norbits_per_object: maximum number of orbits to be selected
+*                     (0=all 1=last 2=last two orbits, etc.)
+*
+* OUTPUT:
+* selected: index of the selected orbits, most recent orbit first
+* candidate_found: flag set to one if an orbit with the same ADS and
+*                  discoverer's name, but another companion was found
+*************************************************************************/
+int OC6Catalog::FindOrbits(char *ads_name, char *discov_name, char *comp_name,
+                           int gili_format, int norbits_per_object,
+                           std::vector<int> *selected, int *candidate_found)
+{
+std::unordered_map<std::string, std::vector<int> >::iterator it;
+std::vector<int> matching;
+char compacted_ads_name[60], compacted_comp_name[40];
+char compacted_discov_name[40], comp_really_compacted[40];
+const char *OC6_comp_name;
+int k, iorb, iblock_found, discov_name_only, comp_is_AB, OC6_comp_is_AB;
+int is_matching, imin, i;
+
+selected->clear();
+*candidate_found = 0;
+
+compacted_ads_name[0] = '\0';
+if(!gili_format) {
+  strcpy(compacted_ads_name, ads_name);
+  jlp_compact_string(compacted_ads_name, 60);
+  }
+discov_name_only = (!gili_format && compacted_ads_name[0] == '\0') ? 1 : 0;
+
+strcpy(compacted_comp_name, comp_name);
+jlp_compact_string(compacted_comp_name, 40);
+jlp_really_compact_companion(compacted_comp_name, comp_really_compacted, 40);
+
+strcpy(compacted_discov_name, discov_name);
+jlp_compact_string(compacted_discov_name, 40);
+
+it = index_discov.find(compacted_discov_name);
+if(it == index_discov.end()) return(0);
+
+comp_is_AB = 0;
+if((compacted_comp_name[0] == '\0')
+   || !strcmp(compacted_comp_name,"AB")
+   || !strncmp(compacted_comp_name,"Aa-B",4)) comp_is_AB = 1;
+
+iblock_found = -1;
+for(k = 0; k < (int)it->second.size(); k++) {
+  iorb = it->second[k];
+/* Stop at the end of the first group containing the object: */
+  if(iblock_found >= 0 && orbit_block[iorb] != iblock_found) break;
+
+/* CASE 1 : no ADS name */
+  if(discov_name_only) {
+    is_matching = 1;
+/* CASE 2 : ADS name and companion (or only companion with gili_format) */
+  } else {
+    if(!gili_format && strcmp(compacted_ads_name, orbit_ads[iorb].c_str()))
+       continue;
+    OC6_comp_name = orbit_comp[iorb].c_str();
+    OC6_comp_is_AB = 0;
+    if((OC6_comp_name[0] == '\0') || !strcmp(OC6_comp_name,"AB")
+       || !strncmp(OC6_comp_name,"Aa-B",4)) OC6_comp_is_AB = 1;
+    is_matching = 0;
+    if((*compacted_comp_name != '\0'
+         && !strcmp(OC6_comp_name, compacted_comp_name))
+/* If not mentionned in Latex calibrated table, should
+* be either not mentioned in OC6 or equal to AB: */
+       || (comp_is_AB && OC6_comp_is_AB)
+       || (*comp_really_compacted != '\0' &&
+           !strcmp(comp_really_compacted, orbit_comp_really[iorb].c_str())))
+       is_matching = 1;
+    }
+
+  if(is_matching) {
+    matching.push_back(iorb);
+    iblock_found = orbit_block[iorb];
+  } else if(!gili_format && iblock_found < 0) {
+    printf("CURRENT OBJECT: ads_name=%s comp_name=%s discov_name=%s \n",
+           ads_name, comp_name, discov_name);
+    printf("From_OC6_cat/Not yet found, possible candidate in OC6: >%s< >%s< >%s< (companion names look different though...)\n",
+           orbit_ads[iorb].c_str(), compacted_discov_name,
+           orbit_comp[iorb].c_str());
+    *candidate_found = 1;
+  }
+}
+
+/* number of orbits per object:
+* 0=all 1=last 2=last two orbits, etc.
+*/
+if(norbits_per_object > 0 && (int)matching.size() > norbits_per_object)
+  imin = matching.size() - norbits_per_object;
+else
+  imin = 0;
+
+for(i = (int)matching.size() - 1; i >= imin; i--)
+   selected->push_back(matching[i]);
+
+return(0);
+}
+/*************************************************************************
+* Copy the lines of the selected orbits of an object to an output file
+* (see line_extraction_from_OC6_catalog() in "OC6_catalog_utils.cpp")
+*
+* OUTPUT:
+* fp_out: pointer to the output ASCII file
+* found: flag set to one if at least one orbit was found for object
+*************************************************************************/
+int OC6Catalog::ExtractLines(char *ads_name, char *discov_name,
+                             char *comp_name, int gili_format, FILE *fp_out,
+                             int *found, int *candidate_found,
+                             int norbits_per_object)
+{
+std::vector<int> selected;
+int k;
+
+FindOrbits(ads_name, discov_name, comp_name, gili_format,
+           norbits_per_object, &selected, candidate_found);
+
+*found = (selected.size() > 0) ? 1 : 0;
+for(k = 0; k < (int)selected.size(); k++)
+   fprintf(fp_out, "%s", orbit_line[selected[k]].c_str());
+
+return(0);
+}
+/*************************************************************************
+* Orbital elements of an orbit, decoded with get_orbit_from_OC6_list()
+* the first time they are requested
+*
+* OUTPUT:
+* orbit: orbital elements
+* RETURN: status of get_orbit_from_OC6_list() (0 if OK)
+*************************************************************************/
+int OC6Catalog::GetOrbit(int iorb, OC6_ORBIT *orbit)
+{
+char in_line[300];
+OC6_ORBIT *orb;
+
+if(iorb < 0 || iorb >= (int)orbit_line.size()) return(-1);
+
+orb = &orbit_elements[iorb];
+if(decode_status[iorb] == 1) {
+  strcpy(in_line, orbit_line[iorb].c_str());
+  decode_status[iorb] = get_orbit_from_OC6_list(in_line, iorb + 1,
+                          is_master_file, orb->WDS_name, orb->ADS_name,
+                          orb->discov_name, orb->comp_name, orb->object_name,
+                          orb->author, &orb->Omega_node, &orb->omega_peri,
+                          &orb->i_incl, &orb->e_eccent, &orb->T_periastron,
+                          &orb->Period, &orb->a_smaxis, &orb->mean_motion,
+                          &orb->orbit_equinox, &orb->orbit_grade);
+/* Should not be 1, to be able to know that it has been decoded: */
+  if(decode_status[iorb] == 1) decode_status[iorb] = -1;
+  }
+
+*orbit = *orb;
+
+return(decode_status[iorb]);
+}
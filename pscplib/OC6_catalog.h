@@ -0,0 +1,72 @@
+/************************************************************************
+* "OC6_catalog.h"
+* In-memory version of the OC6 orbit catalog ("orb6orbits.txt" or
+* "orb6.master"), read only once and indexed by discoverer's name
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#ifndef __OC6_catalog_h   /* BOF sentry */
+#define __OC6_catalog_h
+
+#include <stdio.h>
+#include <vector>
+#include <string>
+#include <unordered_map>
+
+/* Orbital elements decoded with get_orbit_from_OC6_list()
+* (angles in radians, Period and T_periastron in years) */
+typedef struct {
+  char WDS_name[40], ADS_name[40], discov_name[40], comp_name[40];
+  char object_name[80], author[60];
+  double Omega_node, omega_peri, i_incl, e_eccent, T_periastron;
+  double Period, a_smaxis, mean_motion, orbit_equinox;
+  int orbit_grade;
+} OC6_ORBIT;
+
+class OC6Catalog {
+
+public:
+    OC6Catalog(char *OC6_fname0, int is_master_file0);
+    ~OC6Catalog() {};
+
+    int IsLoaded() { return(loaded); }
+    int IsMasterFile() { return(is_master_file); }
+    int NOrbits() { return((int)orbit_line.size()); }
+    const char *Filename() { return(OC6_fname); }
+    const char *Line(int iorb) { return(orbit_line[iorb].c_str()); }
+
+// Orbits of an object (same selection as line_extraction_from_OC6_catalog)
+// returned in output order (most recent orbit first):
+    int FindOrbits(char *ads_name, char *discov_name, char *comp_name,
+                   int gili_format, int norbits_per_object,
+                   std::vector<int> *selected, int *candidate_found);
+    int ExtractLines(char *ads_name, char *discov_name, char *comp_name,
+                     int gili_format, FILE *fp_out, int *found,
+                     int *candidate_found, int norbits_per_object);
+// Orbital elements of an orbit (decoded only once):
+    int GetOrbit(int iorb, OC6_ORBIT *orbit);
+
+private:
+    int LoadFromTextFile();
+
+    char OC6_fname[256];
+    int is_master_file, loaded;
+
+// One entry per orbit (in the order of the catalog):
+    std::vector<std::string> orbit_line;
+    std::vector<std::string> orbit_ads, orbit_comp, orbit_comp_really;
+// Group of orbits (the groups are separated by lines starting with blanks)
+    std::vector<int> orbit_block;
+// Decoded orbital elements (decode_status = 1 if not yet decoded)
+    std::vector<OC6_ORBIT> orbit_elements;
+    std::vector<int> decode_status;
+
+// Compacted discoverer's name -> orbits (in the order of the catalog)
+    std::unordered_map<std::string, std::vector<int> > index_discov;
+};
+
+// Process-wide instance (reloaded only if the catalog name changes):
+OC6Catalog *OC6Catalog_get_cached(char *OC6_fname, int is_master_file);
+
+#endif   /* EOF sentry */
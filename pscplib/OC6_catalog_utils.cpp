@@ -16,6 +16,7 @@
 * are defined in "OC6_catalog_utils.h":
 */
 #include "OC6_catalog_utils.h"
+#include "OC6_catalog.h"
 
 #ifndef MAXI
 #define MAXI(a,b) ((a) < (b)) ? (b) : (a)
@@ -409,6 +410,7 @@ return(0);
 * fp_out: pointer to the output ASCII file 
 * found: flag set to one if at least one orbit was found for object
 *
+* The catalog is read only once (see OC6Catalog in "OC6_catalog.cpp")
 ***************************************************************************/
 int line_extraction_from_OC6_catalog(char *OC6_fname, int is_master_file,
                                      char *ads_name, 
@@ -417,174 +419,28 @@ int line_extraction_from_OC6_catalog(char *OC6_fname, int is_master_file,
                                      int *candidate_found, 
                                      int norbits_per_object)
 {
-/* Line length is 278 + "\n" for OC6 catalog (orb6.master, november 2009)... */
-/* Line length is 264 + "\n" for OC6 catalog (orb6orbits.txt, november 2009)... */
-int iline, status, max_norbits = 1024, norbits, imin, nlines_in_header;
-int OC6_comp_is_AB, comp_is_AB, discov_name_only;
-char OC6_comp_really_compacted[40], comp_really_compacted[40];
-char OC6_ads_name[60], OC6_comp_name[40], OC6_discov_name[40];
-char line_buffer[300], compacted_ads_name[60], compacted_comp_name[40];
-char compacted_discov_name[40];
-/* Assume that the number of orbits for one object is always less than 1024: */
-char object_orbits[300*1024];
-FILE *fp_in;
-int i;
+OC6Catalog *OC6_cat;
 
 *found = 0;
 *candidate_found = 0;
-norbits = 0;
-
-strcpy(compacted_ads_name, ads_name);
-jlp_compact_string(compacted_ads_name, 60);
-
-if(compacted_ads_name[0] == '\0') discov_name_only = 1;
-else discov_name_only = 0; 
-
-strcpy(compacted_comp_name, comp_name);
-jlp_compact_string(compacted_comp_name, 40);
-jlp_really_compact_companion(compacted_comp_name, comp_really_compacted, 40);
-
-strcpy(compacted_discov_name, discov_name);
-jlp_compact_string(compacted_discov_name, 40);
 
 #ifdef DEBUG
- printf("CURRENT OBJECT: ads_name=%s comp_name=%s discov_name=%s (discov_name_only=%d\n", 
-ads_name, comp_name, discov_name, discov_name_only);
+ printf("CURRENT OBJECT: ads_name=%s comp_name=%s discov_name=%s\n", 
+ads_name, comp_name, discov_name);
 #endif
 
-/* Open OC6 catalog: */
-if((fp_in = fopen(OC6_fname,"r")) == NULL) {
+/* OC6 catalog (read only once, when called for the first object): */
+OC6_cat = OC6Catalog_get_cached(OC6_fname, is_master_file);
+if(OC6_cat == NULL) {
   fprintf(stderr, "line_extraction_from_OC6_catalog/Fatal error opening %s\n",
           OC6_fname);
   exit(-1);
   }
 
-iline = 0;
-
-if(is_master_file)
-  nlines_in_header = 4;
-else
-  nlines_in_header = 8;
-
-while(!feof(fp_in)) {
-/* Should read more than 
-* 278 characters in master OC6 file
-* 264 characters in non-master OC6 file
-* in order to be sure to copy the complete line: */
-  if(fgets(line_buffer, 280, fp_in)) {
-    iline++;
-    if(*found && !strncmp(line_buffer,"    ",4)) break; 
-/* Skip the header and empty lines (that
-* generally indicate the end of a given object):*/
-    if(iline > nlines_in_header && strncmp(line_buffer,"    ",4)) {
-/* Get the object name of each line */
-     status = get_name_from_OC6_line(line_buffer, OC6_ads_name,
-                                     OC6_discov_name, OC6_comp_name);
-     if(status) {
-     fprintf(stderr, "line_extraction_from_OC6_catalog/Error processing line #%d\n", iline); 
-     return(-1);
-     }
-#ifdef DEBUG_1
-if(iline < nlines_in_header+3) 
-     printf("OK1found=%d iline=%d: >%s<\n ads=%s< disc=%s< comp=%s<\n", 
-             *found, iline, line_buffer, OC6_ads_name, OC6_discov_name, 
-             OC6_comp_name);
-#endif
-/* If "ads_name" was found, copy the full line containing 
-* the orbital elements: */
-     jlp_compact_string(OC6_ads_name, 60);
-/* CASE 1 : no ADS name*/
-    if(discov_name_only){
-    if(!strcmp(OC6_discov_name, compacted_discov_name)) {
-        for(i = 0; i < 300; i++) 
-           object_orbits[i + 300*norbits] = line_buffer[i];
-        *found = 1;
-        norbits++;
-        if(norbits >= max_norbits) {
-            fprintf(stderr, "line_extraction_from_OC6_catalog/Fatal error: %d orbits found for a single object!\n", norbits);
-            fprintf(stderr, "(OC6_discov_name=%s)\n", OC6_discov_name);
-            exit(-1);
-            }
-      }
-/* CASE 2 */
-    } else if(!strcmp(compacted_ads_name, OC6_ads_name)
-         && !strcmp(OC6_discov_name, compacted_discov_name)) {
-/* Test on the companion names if present in the object name: 
-*/
-     jlp_compact_string(OC6_comp_name, 40);
-     jlp_really_compact_companion(OC6_comp_name, OC6_comp_really_compacted, 40);
-#ifdef DEBUG
-printf("DEBUG/OC6_object=%s OC6_companion=%s| comp=%s| (really compacted: OC6 comp=%s comp=%s)\n", 
-        OC6_ads_name, OC6_comp_name, comp_name, OC6_comp_really_compacted, 
-        comp_really_compacted);
-#endif
-        comp_is_AB = 0;
-        if((compacted_comp_name[0] == '\0') 
-           || !strcmp(compacted_comp_name,"AB")
-           || !strncmp(compacted_comp_name,"Aa-B",4)) comp_is_AB = 1;
-        OC6_comp_is_AB = 0;
-        if((OC6_comp_name[0] == '\0') || !strcmp(OC6_comp_name,"AB")
-           || !strncmp(OC6_comp_name,"Aa-B",4)) OC6_comp_is_AB = 1;
-           
-        if((*compacted_comp_name != '\0' 
-             && !strcmp(OC6_comp_name, compacted_comp_name))
-/* If not mentionned in Latex calibrated table, should
-* be either not mentioned in OC6 or equal to AB: */
-           || (comp_is_AB && OC6_comp_is_AB)
-           || (*comp_really_compacted != '\0' && 
-               !strcmp(comp_really_compacted, OC6_comp_really_compacted))){
-        for(i = 0; i < 300; i++) 
-           object_orbits[i + 300*norbits] = line_buffer[i];
-        *found = 1;
-#ifdef DEBUG
-        if(*found) {
-          printf("From_OC6_cat/Object found now in OC6: >%s< >%s< >%s<\n", 
-                  OC6_ads_name, OC6_discov_name, OC6_comp_name); 
-          }
-#endif
-        norbits++;
-        if(norbits >= max_norbits) {
-            fprintf(stderr, "line_extraction_from_OC6_catalog/Fatal error: %d orbits found for a single object!\n", norbits);
-            fprintf(stderr, "(OC6_ads_name=%s OC6_discov_name=%s)\n", 
-                    OC6_ads_name, OC6_discov_name);
-            exit(-1);
-            }
-        } else if(!(*found)) {
-        printf("CURRENT OBJECT: ads_name=%s comp_name=%s discov_name=%s \n",
-	 ads_name, comp_name, discov_name);
-        printf("From_OC6_cat/Not yet found, possible candidate in OC6: >%s< >%s< >%s< (companion names look different though...)\n", 
-               OC6_ads_name, OC6_discov_name, OC6_comp_name); 
-         *candidate_found = 1;
-        }
-#ifdef DEBUG
-  printf("DEBUG/iline=%d OC6_ads_name=>%s< OC6_comp_name=>%s<\n", 
-          iline, OC6_ads_name, OC6_comp_name);
-#endif
-     } /* EOF if(!strcmp ads_name ...) */
-    } /* EOF if line > nlines_header */
-  } /* EOF if fgets */ 
- }
-
-#ifdef DEBUG
-printf("line_extraction_from_OC6_catalog: %d lines read and %d orbits found for current object\n", 
-        iline, norbits);
-#endif
-
-/* number of orbits per object: 
-* 0=all 1=last 2=last two orbits, etc.
-*/
- 
-if(*found) {
-if(norbits_per_object > 0) 
-  imin = MAXI(norbits - norbits_per_object, 0);
-else
-  imin = 0;
-
-for(i = norbits - 1; i >= imin; i--)
-   fprintf(fp_out, "%s", &object_orbits[i*300]);
-}
+/* Copy the lines of the orbits found for this object to fp_out: */
+OC6_cat->ExtractLines(ads_name, discov_name, comp_name, 0, fp_out, found,
+                      candidate_found, norbits_per_object);
 
-fclose(fp_in);
 return(0);
 }
 /***************************************************************************
@@ -604,6 +460,7 @@ return(0);
 * fp_out: pointer to the output ASCII file 
 * found: flag set to one if at least one orbit was found for object
 *
+* The catalog is read only once (see OC6Catalog in "OC6_catalog.cpp")
 ***************************************************************************/
 int line_extraction_from_OC6_catalog_gili(char *OC6_fname, int is_master_file,
                                      char *discov_name, char *comp_name, 
@@ -611,135 +468,28 @@ int line_extraction_from_OC6_catalog_gili(char *OC6_fname, int is_master_file,
                                      int *candidate_found, 
                                      int norbits_per_object)
 {
-/* Line length is 278 + "\n" for OC6 catalog (orb6.master, november 2009)... */
-/* Line length is 264 + "\n" for OC6 catalog (orb6orbits.txt, november 2009)... */
-int iline, status, max_norbits = 1024, norbits, imin, nlines_in_header;
-int OC6_comp_is_AB, comp_is_AB, discov_name_only;
-char OC6_comp_really_compacted[40], comp_really_compacted[40];
-char OC6_comp_name[40], OC6_discov_name[40];
-char line_buffer[300], compacted_comp_name[40];
-char compacted_discov_name[40];
-/* Assume that the number of orbits for one object is always less than 1024: */
-char object_orbits[300*1024];
-FILE *fp_in;
-int i;
+OC6Catalog *OC6_cat;
 
 *found = 0;
 *candidate_found = 0;
-norbits = 0;
-
-discov_name_only = 1;
-
-strcpy(compacted_comp_name, comp_name);
-jlp_compact_string(compacted_comp_name, 40);
-jlp_really_compact_companion(compacted_comp_name, comp_really_compacted, 40);
-
-strcpy(compacted_discov_name, discov_name);
-jlp_compact_string(compacted_discov_name, 40);
 
 #ifdef DEBUG
  printf("(line_ext_OC6_cat_gili) CURRENT OBJECT: comp_name=%s discov_name=%s \n", 
  comp_name, discov_name);
 #endif
 
-/* Open OC6 catalog: */
-if((fp_in = fopen(OC6_fname,"r")) == NULL) {
+/* OC6 catalog (read only once, when called for the first object): */
+OC6_cat = OC6Catalog_get_cached(OC6_fname, is_master_file);
+if(OC6_cat == NULL) {
   fprintf(stderr, "line_extraction_from_OC6_catalog_gili/Fatal error opening %s\n",
           OC6_fname);
   exit(-1);
   }
 
-iline = 0;
-
-if(is_master_file)
-  nlines_in_header = 4;
-else
-  nlines_in_header = 8;
-
-while(!feof(fp_in)) {
-/* Should read more than 
-* 278 characters in master OC6 file
-* 264 characters in non-master OC6 file
-* in order to be sure to copy the complete line: */
-  if(fgets(line_buffer, 280, fp_in)) {
-    iline++;
-    if(*found && !strncmp(line_buffer,"    ",4)) break; 
-/* Skip the header and empty lines (that
-* generally indicate the end of a given object):*/
-    if(iline > nlines_in_header && strncmp(line_buffer,"    ",4)) {
-/* Get the object name of each line */
-     status = get_name_from_OC6_line_gili(line_buffer, OC6_discov_name, 
-                                          OC6_comp_name);
-     if(status) {
-     fprintf(stderr, "line_extraction_from_OC6_catalog/Error processing line #%d\n", iline); 
-     return(-1);
-     }
-#ifdef DEBUG_1
-if(iline < nlines_in_header+3) 
-     printf("OK1found=%d iline=%d: >%s<\n disc=%s< comp=%s<\n", 
-             *found, iline, line_buffer, OC6_discov_name, OC6_comp_name);
-#endif
-    if(!strcmp(OC6_discov_name, compacted_discov_name)) {
-
-/* Test on the companion names if present in the object name:
-*/
-     jlp_compact_string(OC6_comp_name, 40);
-     jlp_really_compact_companion(OC6_comp_name, OC6_comp_really_compacted, 40);
-#ifdef DEBUG_1
-printf("DEBUG/OC6_object=%s OC6_companion=%s| comp=%s| (really compacted: OC6 comp=%s comp=%s)\n",
-        OC6_discov_name, OC6_comp_name, comp_name, OC6_comp_really_compacted,
-        comp_really_compacted);
-#endif
-        comp_is_AB = 0;
-        if((compacted_comp_name[0] == '\0')
-           || !strcmp(compacted_comp_name,"AB")
-           || !strncmp(compacted_comp_name,"Aa-B",4)) comp_is_AB = 1;
-        OC6_comp_is_AB = 0;
-        if((OC6_comp_name[0] == '\0') || !strcmp(OC6_comp_name,"AB")
-           || !strncmp(OC6_comp_name,"Aa-B",4)) OC6_comp_is_AB = 1;
-
-        if((*compacted_comp_name != '\0'
-             && !strcmp(OC6_comp_name, compacted_comp_name))
-/* If not mentionned in Latex calibrated table, should
-* be either not mentioned in OC6 or equal to AB: */
-           || (comp_is_AB && OC6_comp_is_AB)
-           || (*comp_really_compacted != '\0' &&
-               !strcmp(comp_really_compacted, OC6_comp_really_compacted))){
-        for(i = 0; i < 300; i++)
-           object_orbits[i + 300*norbits] = line_buffer[i];
-        *found = 1;
-        norbits++;
-        if(norbits >= max_norbits) {
-            fprintf(stderr, "line_extraction_from_OC6_catalog/Fatal error: %d orbits found for a single object!\n", norbits);
-            fprintf(stderr, "(OC6_discov_name=%s)\n", OC6_discov_name);
-            exit(-1);
-            }
-         }
-      }
-    } /* EOF if line > nlines_header */
-  } /* EOF if fgets */ 
- }
-
-#ifdef DEBUG
-printf("line_extraction_from_OC6_catalog: %d lines read and %d orbits found for current object\n", 
-        iline, norbits);
-#endif
-
-/* number of orbits per object: 
-* 0=all 1=last 2=last two orbits, etc.
-*/
- 
-if(*found) {
-if(norbits_per_object > 0) 
-  imin = MAXI(norbits - norbits_per_object, 0);
-else
-  imin = 0;
-
-for(i = norbits - 1; i >= imin; i--)
-   fprintf(fp_out, "%s", &object_orbits[i*300]);
-}
+/* Copy the lines of the orbits found for this object to fp_out: */
+OC6_cat->ExtractLines((char *)"", discov_name, comp_name, 1, fp_out, found,
+                      candidate_found, norbits_per_object);
 
-fclose(fp_in);
 return(0);
 }
 /***************************************************************************
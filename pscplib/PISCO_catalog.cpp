@@ -0,0 +1,459 @@
+/************************************************************************
+* "PISCO_catalog.cpp"
+* In-memory version of the PISCO catalog ("zeiss_doppie.cat")
+*
+* The catalog is read and its two-line records are decoded only once
+* by the process-wide instance returned by PiscoCatalog_get_cached(),
+* so that get_coordinates_from_PISCO_catalog() and
+* get_data_from_PISCO_catalog() do not read the file for each object.
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>    // exit()
+#include <string.h>    // strcpy()
+#include <ctype.h>     // isdigit()
+#include <mutex>
+#include "PISCO_catalog.h"
+#include "PISCO_catalog_utils.h" // PISCO_catalog_read_line1, ...
+#include "latex_utils.h"         // latex_get_column_item()
+#include "jlp_string.h"          // jlp_compact_string
+
+/*
+#define DEBUG
+*/
+
+static PiscoCatalog *cached_PISCO_catalog = NULL;
+/* The catalog may be requested by several threads (see residuals_1.c): */
+static std::mutex cached_PISCO_mutex;
+
+/*************************************************************************
+* Return the process-wide instance of the PISCO catalog
+* (the catalog is loaded only once, or when its name changes)
+*************************************************************************/
+PiscoCatalog *PiscoCatalog_get_cached(char *PISCO_catalog_name)
+{
+std::lock_guard<std::mutex> lock(cached_PISCO_mutex);
+
+if(cached_PISCO_catalog != NULL) {
+  if(!strcmp(cached_PISCO_catalog->Filename(), PISCO_catalog_name))
+     return(cached_PISCO_catalog);
+  delete cached_PISCO_catalog;
+  cached_PISCO_catalog = NULL;
+  }
+
+cached_PISCO_catalog = new PiscoCatalog(PISCO_catalog_name);
+if(!cached_PISCO_catalog->IsLoaded()) {
+  delete cached_PISCO_catalog;
+  cached_PISCO_catalog = NULL;
+  }
+
+return(cached_PISCO_catalog);
+}
+/*************************************************************************
+* Constructor
+*
+* INPUT:
+* PISCO_catalog_name0: name of PISCO catalog ("zeiss_doppie.cat")
+*************************************************************************/
+PiscoCatalog::PiscoCatalog(char *PISCO_catalog_name0)
+{
+strncpy(PISCO_catalog_name, PISCO_catalog_name0, 255);
+PISCO_catalog_name[255] = '\0';
+loaded = 0;
+
+if(LoadFromTextFile() == 0) loaded = 1;
+}
+/*************************************************************************
+* Read the catalog and decode the two lines of all the objects
+*
+* The lines are truncated to 127 characters, as when they were read
+* by get_data_from_PISCO_catalog() for each object.
+* The second line of an object is the line following its first line
+* (lines starting with '&').
+*************************************************************************/
+int PiscoCatalog::LoadFromTextFile()
+{
+char in_line[512], next_line[512], new_ads_name[128], *pc;
+int iline, has_next_line, verbose_if_error = 0;
+FILE *fp_cat;
+
+if((fp_cat = fopen(PISCO_catalog_name, "r")) == NULL) {
+  fprintf(stderr, "PiscoCatalog/Error opening %s\n", PISCO_catalog_name);
+  return(-1);
+ }
+
+new_ads_name[0] = '\0';
+iline = 0;
+has_next_line = 0;
+while(1) {
+  if(has_next_line) {
+    strcpy(in_line, next_line);
+    has_next_line = 0;
+  } else {
+    if(!fgets(in_line, 512, fp_cat)) break;
+    in_line[127] = '\0';
+    iline++;
+  }
+  if(in_line[0] == '%') continue;
+
+/* Second line without first line: */
+  if(in_line[0] == '&') {
+    AddObject((char *)"", in_line, 0, iline, new_ads_name);
+    continue;
+    }
+
+/* First line: ADS name as written in the first column
+* (first two words, e.g. "ADS 326AB") */
+  new_ads_name[0] = '\0';
+  latex_get_column_item(in_line, new_ads_name, 1, verbose_if_error);
+  pc = new_ads_name;
+  while(*pc && *pc != ' ') pc++;
+  if(*pc) {
+    pc++;
+    while(*pc && *pc != ' ') pc++;
+    }
+  *pc = '\0';
+
+/* Blank lines are ignored: */
+  strcpy(next_line, in_line);
+  jlp_compact_string(next_line, 512);
+  if(next_line[0] == '\0') continue;
+
+/* Second line: */
+  if(fgets(next_line, 512, fp_cat)) {
+    next_line[127] = '\0';
+    iline++;
+    AddObject(in_line, next_line, iline - 1, iline, new_ads_name);
+/* If it is not a second line, it will be processed as a new line: */
+    if(next_line[0] != '&') has_next_line = 1;
+  } else {
+    AddObject(in_line, (char *)"", iline, 0, new_ads_name);
+  }
+}
+
+fclose(fp_cat);
+
+#ifdef DEBUG
+printf("PiscoCatalog: %d lines read and %d objects loaded from %s\n",
+        iline, (int)line1.size(), PISCO_catalog_name);
+#endif
+
+return(0);
+}
+/*************************************************************************
+* Decode the two lines of an object and add it to the indexes
+*
+* INPUT:
+* in_line1, in_line2: first and second lines ("" if missing)
+* iline1, iline2: line numbers in the catalog (0 if missing)
+* ads_name0: ADS name as written in the first column (e.g. "ADS 326AB")
+*************************************************************************/
+int PiscoCatalog::AddObject(char *in_line1, char *in_line2, int iline1_0,
+                            int iline2_0, const char *ads_name0)
+{
+char buffer[128], object_name0[128], comp_name0[128], ADS_name0[128];
+char discov_name0[64], WDS_name0[64], spectral_type0[128], *pc;
+double alpha0, delta0, equinox0, magV_A0, magV_B0, magV0, B_V0;
+double paral0, err_paral0;
+int k, status, digit_found;
+
+k = line1.size();
+line1.push_back(in_line1);
+line2.push_back(in_line2);
+iline1.push_back(iline1_0);
+iline2.push_back(iline2_0);
+ads_name.push_back(ads_name0);
+
+/**** First line: */
+object_name0[0] = '\0';
+comp_name0[0] = '\0';
+ADS_name0[0] = '\0';
+alpha0 = delta0 = equinox0 = 0.;
+status = -1;
+buffer[0] = '\0';
+if(*in_line1) {
+/* Coordinates (from the first 79 characters, as in the previous version
+* of get_coordinates_from_PISCO_catalog()) */
+  strncpy(buffer, in_line1, 79);
+  buffer[79] = '\0';
+  status = read_coordinates_from_PISCO_catalog(buffer, &alpha0, &delta0,
+                                               &equinox0);
+/* Name used for the coordinates: first 19 characters, cut after the
+* first number (ADS 213 is sometimes written as: ADS 213AB) */
+  buffer[19] = '\0';
+  pc = buffer;
+  digit_found = 0;
+  while(*pc) {
+    if(isdigit(*pc)) digit_found = 1;
+    if(!isdigit(*pc) && digit_found) break;
+    pc++;
+    }
+  *pc = '\0';
+  jlp_compact_string(buffer, 128);
+  index_coord.emplace(buffer, k);
+  coord_name.push_back(buffer);
+
+/* Object name, companion and ADS number (only for the lines with
+* valid coordinates, to avoid error messages for the other lines): */
+  if(status == 0) {
+    strncpy(buffer, in_line1, 119);
+    buffer[119] = '\0';
+    PISCO_catalog_read_line1(buffer, object_name0, comp_name0, ADS_name0,
+                             &magV0, &magV0, &magV0);
+    if(ADS_name0[0] != '\0') index_ADS.emplace(ADS_name0, k);
+    }
+
+/* Names found in the first line by get_data_from_PISCO_catalog(): */
+  strncpy(buffer, in_line1, 127);
+  buffer[127] = '\0';
+  jlp_compact_string(buffer, 128);
+  AddNameKeys(buffer, 2 * k);
+  } else {
+  coord_name.push_back("");
+  }
+coord_status.push_back(status);
+alpha.push_back(alpha0);
+delta.push_back(delta0);
+coord_equinox.push_back(equinox0);
+object_name.push_back(object_name0);
+comp_name.push_back(comp_name0);
+ADS_number.push_back(ADS_name0);
+
+/**** Second line (decoded as in get_data_from_PISCO_catalog()): */
+magV_A0 = magV_B0 = magV0 = 100.;
+B_V0 = paral0 = err_paral0 = 0.;
+discov_name0[0] = '\0';
+comp_name0[0] = '\0';
+WDS_name0[0] = '\0';
+spectral_type0[0] = '\0';
+if(*in_line2) {
+  PISCO_catalog_read_line2_discov(in_line2, discov_name0, comp_name0);
+  line2_status.push_back(PISCO_catalog_read_line2(in_line2, &magV_A0,
+                                                  &magV_B0, spectral_type0));
+  WDS_status.push_back(PISCO_catalog_read_line2_WDS(in_line2, WDS_name0));
+  if(WDS_name0[0] != '\0') index_WDS.emplace(WDS_name0, k);
+  PISCO_catalog_read_line2_Hip(in_line2, &magV0, &B_V0, &paral0,
+                               &err_paral0);
+} else {
+  line2_status.push_back(-1);
+  WDS_status.push_back(-1);
+}
+discov_name.push_back(discov_name0);
+discov_comp_name.push_back(comp_name0);
+WDS_name.push_back(WDS_name0);
+spectral_type.push_back(spectral_type0);
+magV_A.push_back(magV_A0);
+magV_B.push_back(magV_B0);
+magV.push_back(magV0);
+B_V.push_back(B_V0);
+paral.push_back(paral0);
+err_paral.push_back(err_paral0);
+
+/* Discoverer's names found in the second line by
+* get_data_from_PISCO_catalog(): */
+if(in_line2[0] == '&') {
+  strcpy(buffer, discov_name0);
+  jlp_compact_string(buffer, 128);
+  AddNameKeys(buffer, 2 * k + 1);
+  }
+
+return(0);
+}
+/*************************************************************************
+* Add the names accepted by get_data_from_PISCO_catalog() for a
+* compacted line (or discoverer's name) to index_name:
+* the object is found when the compacted line starts with the compacted
+* name, and if the following character is not a digit
+* (ADS 213AB is found with ADS 213, but ADS 2136 is not)
+*
+* INPUT:
+* compacted: compacted line (only the object name, before '(' or '&',
+*            is considered) or compacted discoverer's name
+* order: 2*k for the first line of object #k, 2*k+1 for its second line
+*************************************************************************/
+void PiscoCatalog::AddNameKeys(const char *compacted, int order)
+{
+std::string key;
+int len, len_max;
+
+len_max = 0;
+while(compacted[len_max] && compacted[len_max] != '('
+      && compacted[len_max] != '&') len_max++;
+
+/* The first object (in the order of the catalog) is kept: */
+for(len = 0; len <= len_max; len++) {
+  if(isdigit(compacted[len])) continue;
+  key.assign(compacted, len);
+  index_name.emplace(key, order);
+  }
+}
+/*************************************************************************
+* Search for the coordinates of an object
+* (see get_coordinates_from_PISCO_catalog() in "PISCO_catalog_utils.cpp")
+*
+* The object name is compared up to the end of its first number
+* (ADS123AB -> ADS123, COU12AB -> COU12).
+*
+* OUTPUT:
+* alpha, delta: coordinates of object (in radians)
+* coord_equinox: equinox corresponding to the coordinates
+*************************************************************************/
+int PiscoCatalog::GetCoordinates(char *NameInPiscoCatalog, double *alpha0,
+                                 double *delta0, double *coord_equinox0)
+{
+std::unordered_map<std::string, int>::iterator it;
+char compacted_object_name[40], *pc;
+int k, i, digit_found, object_len;
+
+strncpy(compacted_object_name, NameInPiscoCatalog, 39);
+compacted_object_name[39] = '\0';
+jlp_compact_string(compacted_object_name, 40);
+
+/* Compute the useful length of the compacted_object_name:
+* ADS123AB should be 6 only
+* COU12AB should be 5 only
+*/
+pc = compacted_object_name;
+object_len = 0;
+digit_found = 0;
+while(*pc) {
+  if(isdigit(*pc)) digit_found = 1;
+  if(!isdigit(*pc) && digit_found) break;
+  pc++;
+  object_len++;
+  }
+*pc = '\0';
+
+k = -1;
+if(digit_found) {
+  it = index_coord.find(compacted_object_name);
+  if(it != index_coord.end()) k = it->second;
+} else {
+/* Names without any number: first object whose name starts with it */
+  for(i = 0; i < (int)line1.size(); i++) {
+    if(line1[i].empty()) continue;
+    if(!strncmp(coord_name[i].c_str(), compacted_object_name, object_len)) {
+      k = i;
+      break;
+      }
+    }
+}
+if(k < 0) return(-1);
+if(iline2[k] == 0) {
+  fprintf(stderr, "Error reading second line of object data\n");
+  return(-1);
+  }
+
+*alpha0 = alpha[k];
+*delta0 = delta[k];
+*coord_equinox0 = coord_equinox[k];
+if(coord_status[k]) {
+  fprintf(stderr, "Error reading PISCO_catalog at line: >%.79s< (status=%d)\n",
+          line1[k].c_str(), coord_status[k]);
+  }
+
+return(coord_status[k]);
+}
+/*************************************************************************
+* Search for photometric data of an object
+* (see get_data_from_PISCO_catalog() in "PISCO_catalog_utils.cpp")
+*
+* The object is searched for in the first line of the objects
+* and in the discoverer's name of the second line.
+*************************************************************************/
+int PiscoCatalog::GetData(char *NameInPiscoCatalog, double *magV0,
+                          double *B_V0, double *paral0, double *err_paral0,
+                          double *magV_A0, double *magV_B0,
+                          char *spectral_type0, char *discov_name0,
+                          char *comp_name0, char *ads_name0, char *WDS_name0)
+{
+std::unordered_map<std::string, int>::iterator it;
+char compacted_object[64];
+int k, iline;
+
+*magV_A0 = 100.;
+*magV_B0 = 100.;
+spectral_type0[0] = '\0';
+discov_name0[0] = '\0';
+comp_name0[0] = '\0';
+*magV0 = 100.;
+*paral0 = 0.;
+*err_paral0 = 0.;
+
+strncpy(compacted_object, NameInPiscoCatalog, 63);
+compacted_object[63] = '\0';
+jlp_compact_string(compacted_object, 64);
+
+it = index_name.find(compacted_object);
+if(it == index_name.end()) return(-1);
+k = it->second / 2;
+
+/* Case of first line: */
+if(it->second % 2 == 0) {
+  if(iline2[k] == 0) {
+    fprintf(stderr, "Error reading second line of object data\n");
+    return(-1);
+    }
+  iline = iline1[k];
+/* Case of second line: */
+} else {
+  fprintf(stderr, "get_data_from_PISCO_catalog/Object %s found in 2nd line!\n",
+          NameInPiscoCatalog);
+  if(!ads_name[k].empty()) {
+    fprintf(stderr, "Hence the object name %s is corrected to: %s\n",
+            NameInPiscoCatalog, ads_name[k].c_str());
+    strcpy(NameInPiscoCatalog, ads_name[k].c_str());
+    }
+  iline = iline2[k];
+}
+strcpy(ads_name0, ads_name[k].c_str());
+strcpy(discov_name0, discov_name[k].c_str());
+strcpy(comp_name0, discov_comp_name[k].c_str());
+
+*magV_A0 = magV_A[k];
+*magV_B0 = magV_B[k];
+strcpy(spectral_type0, spectral_type[k].c_str());
+if(line2_status[k]) {
+  fprintf(stderr, "From read_line2/Fatal error/Bad syntax in line #%d\n", iline);
+  exit(-1);
+  }
+strcpy(WDS_name0, WDS_name[k].c_str());
+if(WDS_status[k]) {
+  fprintf(stderr, "From read_line2_WDS/Fatal error/Object=%s Bad syntax in line #%d\n",
+          NameInPiscoCatalog, iline);
+  exit(-1);
+  }
+*magV0 = magV[k];
+*B_V0 = B_V[k];
+*paral0 = paral[k];
+*err_paral0 = err_paral[k];
+
+return(0);
+}
+/*************************************************************************
+* Index of an object from its ADS number (e.g. "326"), or -1 if not found
+*************************************************************************/
+int PiscoCatalog::FindADS(const char *ADS_number0)
+{
+std::unordered_map<std::string, int>::iterator it;
+
+it = index_ADS.find(ADS_number0);
+if(it == index_ADS.end()) return(-1);
+
+return(it->second);
+}
+/*************************************************************************
+* Index of an object from its WDS name (e.g. "00014+3937"),
+* or -1 if not found
+*************************************************************************/
+int PiscoCatalog::FindWDS(const char *WDS_name0)
+{
+std::unordered_map<std::string, int>::iterator it;
+
+it = index_WDS.find(WDS_name0);
+if(it == index_WDS.end()) return(-1);
+
+return(it->second);
+}
@@ -0,0 +1,93 @@
+/************************************************************************
+* "PISCO_catalog.h"
+* In-memory version of the PISCO catalog ("zeiss_doppie.cat", list of
+* the objects used by TAV1.EXE), read only once: the two lines of each
+* object are decoded when the catalog is loaded, and indexed by name,
+* ADS number and WDS name
+*
+* Example of the two lines of an object:
+* ADS 326AB (3.40, 340) &  0 23 59.8 &-03 28 31 & 2000.0
+* & A: 9.1, B: 9.8 K0   & HLD   60, orbit & WDS00014+3937 HIP110 CCDM00014+3937AB V=8.61 B-V=0.79 PI=20.42(1.91) \cr
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#ifndef __PISCO_catalog_h   /* BOF sentry */
+#define __PISCO_catalog_h
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+
+class PiscoCatalog {
+
+public:
+    PiscoCatalog(char *PISCO_catalog_name0);
+    ~PiscoCatalog() {};
+
+    int IsLoaded() { return(loaded); }
+    int NObjects() { return((int)line1.size()); }
+    const char *Filename() { return(PISCO_catalog_name); }
+
+// Same interface as get_coordinates_from_PISCO_catalog():
+    int GetCoordinates(char *NameInPiscoCatalog, double *alpha, double *delta,
+                       double *coord_equinox);
+// Same interface as get_data_from_PISCO_catalog():
+    int GetData(char *NameInPiscoCatalog, double *magV, double *B_V,
+                double *paral, double *err_paral, double *magV_A,
+                double *magV_B, char *spectral_type, char *discov_name,
+                char *comp_name, char *ads_name, char *WDS_name);
+
+// Index of an object from its ADS number (e.g. "326") or its WDS name
+// (e.g. "00014+3937"), or -1 if not found:
+    int FindADS(const char *ADS_number);
+    int FindWDS(const char *WDS_name);
+// Decoded values of object #k:
+    const char *ObjectName(int k) { return(object_name[k].c_str()); }
+    const char *CompName(int k) { return(comp_name[k].c_str()); }
+    const char *DiscovName(int k) { return(discov_name[k].c_str()); }
+    const char *WDSName(int k) { return(WDS_name[k].c_str()); }
+    double Alpha(int k) { return(alpha[k]); }
+    double Delta(int k) { return(delta[k]); }
+
+private:
+    int LoadFromTextFile();
+    int AddObject(char *in_line1, char *in_line2, int iline1, int iline2,
+                  const char *ads_name0);
+    void AddNameKeys(const char *compacted, int order);
+
+    char PISCO_catalog_name[256];
+    int loaded;
+
+// One entry per object (in the order of the catalog), with the two lines
+// and their line numbers (line1 is empty if a second line was found
+// without its first line):
+    std::vector<std::string> line1, line2;
+    std::vector<int> iline1, iline2;
+// From the first line: ADS name as written in the catalog (e.g.
+// "ADS 326AB"), name, companion, ADS number, coordinates (radians)
+    std::vector<std::string> ads_name, object_name, comp_name, ADS_number;
+    std::vector<double> alpha, delta, coord_equinox;
+    std::vector<int> coord_status;
+// Name used by get_coordinates_from_PISCO_catalog() (e.g. "ADS326")
+    std::vector<std::string> coord_name;
+// From the second line (discov_comp_name: companion given with the
+// discoverer's name):
+    std::vector<std::string> discov_name, discov_comp_name, WDS_name;
+    std::vector<std::string> spectral_type;
+    std::vector<double> magV_A, magV_B, magV, B_V, paral, err_paral;
+    std::vector<int> line2_status, WDS_status;
+
+// Name used by get_coordinates_from_PISCO_catalog() -> first object
+    std::unordered_map<std::string, int> index_coord;
+// Compacted names accepted by get_data_from_PISCO_catalog() ->
+// 2*k (found in the first line of object #k) or 2*k+1 (second line)
+    std::unordered_map<std::string, int> index_name;
+// ADS number -> first object, WDS name -> first object
+    std::unordered_map<std::string, int> index_ADS, index_WDS;
+};
+
+// Process-wide instance (reloaded only if the catalog name changes):
+PiscoCatalog *PiscoCatalog_get_cached(char *PISCO_catalog_name);
+
+#endif   /* EOF sentry */
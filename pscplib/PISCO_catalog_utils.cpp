@@ -17,6 +17,7 @@
 #include "PISCO_catalog_utils.h"
 #include "jlp_catalog_utils.h" // is_in_line()
 #include "latex_utils.h" // latex_get_column_item() 
+#include "PISCO_catalog.h" // PiscoCatalog
 
 /*
 #define DEBUG 
@@ -26,6 +27,9 @@
 * Search for the coordinates of an object 
 * in the PISCO catalog containing the list of objects (used by TAV1.EXE)
 *
+* The catalog is read only once, and the object is searched for
+* in its index (see PiscoCatalog in "PISCO_catalog.cpp")
+*
 * INPUT : 
 * NameInPiscoCatalog: name of object
 * PISCO_catalog_name: name of PISCO catalog ("zeiss_doppie.cat")
@@ -41,96 +45,25 @@ int get_coordinates_from_PISCO_catalog(char *PISCO_catalog_name,
                                        double *alpha, double *delta, 
                                        double *coord_equinox)
 {
-char in_line1[80], in_line2[80], *pc;
-FILE *fp_cat;
-int found, digit_found, object_len, status;
-char compacted_object_name[40], object_in_catalog[40];
-
-strcpy(compacted_object_name, NameInPiscoCatalog);
-jlp_compact_string(compacted_object_name, 40);
+PiscoCatalog *PiscoCat;
 
-if((fp_cat = fopen(PISCO_catalog_name, "r")) == NULL) {
+PiscoCat = PiscoCatalog_get_cached(PISCO_catalog_name);
+if(PiscoCat == NULL) {
   fprintf(stderr, "get_coordinates_from_PISCO_catalog/Error opening %s\n", 
           PISCO_catalog_name);
   return(-1);
  }
 
-/* Compute the useful length of the compacted_object_name: 
-* ADS123AB should be 6 only 
-* COU12AB should be 5 only 
-* ADS123AC should also be 8, but the discovery component should be AC ! 
-* (this is not useful for coordinates...)
-*/
-pc = compacted_object_name;
-object_len = 0;
-digit_found = 0;
-while(*pc) {
-  if(isdigit(*pc)) digit_found = 1;
-  if(!isdigit(*pc) && digit_found) break; 
-  pc++; 
-  object_len++;
-  }
-
-/* Look for the data concerning this object: */
-found = 0;
-while(!feof(fp_cat)) {
-  if(fgets(in_line1,80,fp_cat)) {
-  if(in_line1[0] != '%') {
-    strncpy(object_in_catalog, in_line1, 20); 
-    object_in_catalog[19] = '\0';
-    pc = object_in_catalog;
-
-digit_found = 0;
-while(*pc) {
-  if(isdigit(*pc)) digit_found = 1;
-  if(!isdigit(*pc) && digit_found) break;
-  pc++; 
-  }
-*pc = '\0';
-jlp_compact_string(object_in_catalog, 40);
-
-/* ADS 213 is sometimes written as: ADS 213AB
-* but not as ADS 2136
-*/
-    if(!strncmp(object_in_catalog, compacted_object_name, object_len)){
-       if(fgets(in_line2,80,fp_cat)) {
-         found = 1;
-         break;
-         } else {
-         fprintf(stderr, "Error reading second line of object data\n");
-         break;
-         }
-     } 
-   } /* EOF in_line1 != % */ 
- } /* EOF fgets */
-} /* EOF while */
-
-if(found) {
-  status = read_coordinates_from_PISCO_catalog(in_line1, alpha, delta, 
-                                               coord_equinox);
-  if(status) {
-    fprintf(stderr, "Error reading PISCO_catalog at line: >%s< (status=%d)\n", 
-            in_line1, status);
-    } else {
-#ifdef DEBUG
-    printf("object=%s object_len=%d alpha=%f delta=%f \n %s\n %s\n", 
-           NameInPiscoCatalog, object_len, *alpha, *delta, 
-           in_line1, in_line2);
-#endif
-    status = 0;
-    }
-  } else {
-  status = -1;
-  }
-
-/* Close PISCO_catalog */
-fclose(fp_cat);
-return(status);
+return(PiscoCat->GetCoordinates(NameInPiscoCatalog, alpha, delta,
+                                coord_equinox));
 }
 /************************************************************
 * Search for photometric data of an object 
 * in the PISCO catalog containing the list of objects (used by TAV1.EXE)
 *
+* The catalog is read only once, and the object is searched for
+* in its index (see PiscoCatalog in "PISCO_catalog.cpp")
+*
 * INPUT : 
 * NameInPiscoCatalog: name of object (ADS or discoverer's name)
 * PISCO_catalog_name: name of PISCO catalog ("zeiss_doppie.cat")
@@ -147,154 +80,18 @@ int get_data_from_PISCO_catalog(char *PISCO_catalog_name,
                                 char *comp_name,
                                 char *ads_name, char *WDS_name) 
 {
-char in_line1[128], in_line2[128], compacted_line[128], *pc;
-char compacted_object[64], compacted_discov[64], new_ads_name[80];
-FILE *fp_cat;
-int iline, found; 
-int object_len, status, verbose_if_error;
-
-*magV_A = 100.;
-*magV_B = 100.;
-spectral_type[0] = '\0';
-discov_name[0] = '\0';
-comp_name[0] = '\0';
-*magV = 100.;
-*paral = 0.;
-*err_paral = 0.;
+PiscoCatalog *PiscoCat;
 
-if((fp_cat = fopen(PISCO_catalog_name, "r")) == NULL) {
+PiscoCat = PiscoCatalog_get_cached(PISCO_catalog_name);
+if(PiscoCat == NULL) {
   fprintf(stderr, "get_data_from_PISCO_catalog/Error opening %s\n", 
           PISCO_catalog_name);
   return(-1);
  }
 
-/* Compute the useful length of the object_name: 
-* ADS123AB should be 6 only 
-* COU12Ac should be 5 only 
-* But ADS123AC should also be 8, but the discovery component should be AC !
-*/
-strcpy(compacted_object, NameInPiscoCatalog);
-jlp_compact_string(compacted_object, 64);
-pc = compacted_object;
-object_len = 0;
-while(*pc) {
-/* To upper case: not used since it modifies Ab-B components for example 
-*  if(islower(*pc)) *pc = toupper(*pc);
-*/
-  pc++; 
-  object_len++;
-  }
-
-/* Look for the data concerning this object: 
-ADS 16198 (2.50, 58) & 22 42 29.9 & 39 18 39 & 2000.0
-& A: 9.5, B: 9.9      & BU   176,       & WDS22425+3917 \cr
-*/
-found = 0;
-iline = 0;
-
-while(!feof(fp_cat)) {
-  if(fgets(in_line1,128,fp_cat)) {
-  iline++;
-  if(in_line1[0] != '%' && in_line1[0] != '&') {
-/* Detect ADS name and store it,
- (needed in case filename corresponds to discoverer's name): */
-    new_ads_name[0] = '\0';
-    verbose_if_error = 0;
-    latex_get_column_item(in_line1, new_ads_name, 1, verbose_if_error);
-    pc = new_ads_name;
-/* Remove the heading blanks */
-    while(*pc && *pc != ' ') pc++;
-    pc++;
-/* Stop at the blanks encontered in the middle */
-    while(*pc && *pc != ' ') pc++;
-    *pc = '\0';
-/* ADS 213 is sometimes written as: ADS 213AB
-* but not as ADS 2136
-*/
-    strcpy(compacted_line, in_line1);
-    jlp_compact_string(compacted_line,128);
-    if(!strncmp(compacted_line, compacted_object, object_len) 
-       && !isdigit(compacted_line[object_len]) ){
-         strcpy(ads_name, new_ads_name);
-         found = 1;
-/* Read 2nd line if object found in first line: */
-         if(!fgets(in_line2,128,fp_cat)) {
-           fprintf(stderr, "Error reading second line of object data\n");
-/* Close PISCO_catalog */
-           fclose(fp_cat);
-           return(-1);
-           }
-/* Look for the discoverer's name the 2nd line */
-         PISCO_catalog_read_line2_discov(in_line2, discov_name, comp_name);
-         strcpy(compacted_discov, discov_name);
-         jlp_compact_string(compacted_discov, 64);
-         break;
-     } /* EOF !strncmp(compacted_line, compacted_object, object_len) */
-/* Case of second line: */
-   } else if(in_line1[0] == '&') {
-    strcpy(in_line2, in_line1);
-/* Look for the discoverer's name the 2nd line */
-    PISCO_catalog_read_line2_discov(in_line2, discov_name, comp_name);
-    strcpy(compacted_discov, discov_name);
-    jlp_compact_string(compacted_discov, 64);
-    if(!strncmp(compacted_object, compacted_discov, object_len)
-        && !isdigit(compacted_discov[object_len])) {
-      fprintf(stderr, "get_data_from_PISCO_catalog/Object %s found in 2nd line!\n",
-              NameInPiscoCatalog);
-      if(new_ads_name[0] != '\0') {
-              fprintf(stderr, "Hence the object name %s is corrected to: %s\n",
-              NameInPiscoCatalog, new_ads_name);
-         strcpy(NameInPiscoCatalog, new_ads_name);
-         }
-      strcpy(ads_name, new_ads_name);
-      found = 1;
-      break;
-    }
-  } /* EOF in_line1[0] == '&' */
- } /* EOF fgets */
-} /* EOF while */
-
-
-if(found) {
-  status = PISCO_catalog_read_line2(in_line2, magV_A, magV_B, spectral_type); 
-  if (status) {
-      fprintf(stderr, "From read_line2/Fatal error/Bad syntax in line #%d\n", iline);
-      exit(-1);
-      }
-
-  status = PISCO_catalog_read_line2_WDS(in_line2, WDS_name);
-  if (status) {
-      fprintf(stderr, "From read_line2_WDS/Fatal error/Object=%s Bad syntax in line #%d\n", NameInPiscoCatalog, iline);
-      exit(-1);
-      }
-
-  status = PISCO_catalog_read_line2_Hip(in_line2, magV, B_V, paral, err_paral);
-/*
-  if (status) {
-      fprintf(stderr, "From read_line2_Hip/Fatal error/Bad syntax in line #%d\n", iline);
-      exit(-1);
-      }
-*/
-
-  status = 0;
- 
-/*
-  status = read_coordinates_from_PISCO_catalog(in_line1, alpha, delta, 
-                                               coord_equinox);
-  if(status) {
-    fprintf(stderr, "Error reading PISCO_catalog at line: >%s< (status=%d)\n", 
-            in_line1, status);
-    } 
-*/
-/* EOF case: object was found */
-} else  {
-/* Case: object was not found */
- status = -1;
-}
-
-/* Close PISCO_catalog */
-fclose(fp_cat);
-return(status);
+return(PiscoCat->GetData(NameInPiscoCatalog, magV, B_V, paral, err_paral,
+                         magV_A, magV_B, spectral_type, discov_name,
+                         comp_name, ads_name, WDS_name));
 }
 /*********************************************************************
 * Read coordinates in a line extracted from 
@@ -0,0 +1,269 @@
+/************************************************************************
+* "RESID_table.cpp"
+* In-memory version of the LaTeX table of residuals (O-C)
+* created by residuals_1.c, read only once and indexed by object
+*
+* get_values_from_RESID_table() calls the process-wide instance
+* returned by RESIDTable_get_cached(), so that merging a calibrated table
+* with the residuals is done with a single reading of the residual table.
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>    // exit()
+#include <string.h>    // strcpy()
+#include <ctype.h>     // isalpha()
+#include <algorithm>   // stable_sort, lower_bound
+#include "RESID_table.h"
+#include "jlp_catalog_utils.h"  // read_values_from_RESID_line, is_in_line
+#include "latex_utils.h"        // latex_get_column_item()
+#include "jlp_string.h"         // jlp_compact_string, jlp_trim_string
+
+/*
+#define DEBUG
+*/
+
+/* Tolerance on the epochs and on rho to identify a measurement: */
+#define RESID_EPOCH_TOLER 0.002
+#define RESID_RHO_TOLER 0.002
+
+static RESIDTable *cached_RESID_table = NULL;
+
+static bool resid_epoch_is_smaller(const RESID_ENTRY &e1, const RESID_ENTRY &e2)
+{
+ return(e1.epoch < e2.epoch);
+}
+static bool resid_epoch_is_smaller_than(const RESID_ENTRY &e1, double epoch)
+{
+ return(e1.epoch < epoch);
+}
+static bool resid_iline_is_smaller(const RESID_ENTRY *e1, const RESID_ENTRY *e2)
+{
+ return(e1->iline < e2->iline);
+}
+
+/*************************************************************************
+* Return the process-wide instance of the residual table
+* (the table is loaded only once, or when its name changes)
+*************************************************************************/
+RESIDTable *RESIDTable_get_cached(char *resid_fname)
+{
+if(cached_RESID_table != NULL) {
+  if(!strcmp(cached_RESID_table->Filename(), resid_fname))
+     return(cached_RESID_table);
+  delete cached_RESID_table;
+  cached_RESID_table = NULL;
+  }
+
+cached_RESID_table = new RESIDTable(resid_fname);
+if(!cached_RESID_table->IsLoaded()) {
+  delete cached_RESID_table;
+  cached_RESID_table = NULL;
+  }
+
+return(cached_RESID_table);
+}
+/*************************************************************************
+* Constructor
+*
+* INPUT:
+* resid_fname0: file name of the residual LateX table
+*************************************************************************/
+RESIDTable::RESIDTable(char *resid_fname0)
+{
+strncpy(resid_fname, resid_fname0, 255);
+resid_fname[255] = '\0';
+nlines = 0;
+loaded = 0;
+
+if(LoadFromTextFile() == 0) loaded = 1;
+}
+/*************************************************************************
+* Key of the index: compacted object name and companion
+* (an empty companion is considered as "AB")
+*************************************************************************/
+void RESIDTable::ObjectKey(char *object_name, char *comp_name,
+                           std::string &key)
+{
+key = object_name;
+key += '|';
+if(*comp_name == '\0') key += "AB";
+else key += comp_name;
+}
+/*************************************************************************
+* Read all the lines of the residual table
+* (same reading as in the former version of get_values_from_RESID_table())
+*************************************************************************/
+int RESIDTable::LoadFromTextFile()
+{
+char in_line[128], object_name0[128], comp_name0[40], orbit_grade_str0[128];
+char orbit_ref0[128], *pc;
+int status, iline, verbose_if_error = 1;
+std::unordered_map<std::string, RESID_OBJECT>::iterator it;
+std::string key;
+RESID_ENTRY entry;
+RESID_OBJECT *obj;
+FILE *fp_resid_table;
+
+/* Open LaTeX RESID table: */
+if((fp_resid_table = fopen(resid_fname, "r")) == NULL) {
+  fprintf(stderr, "get_values_from_RESID_table/Error opening %s\n",
+          resid_fname);
+  return(-1);
+ }
+
+iline = 0;
+while(!feof(fp_resid_table)){
+  if(fgets(in_line, 128, fp_resid_table)) {
+  iline++;
+  if(in_line[0] == '%' || in_line[0] == '\\' || in_line[0] == ' '
+     || in_line[0] == '&') continue;
+
+  status = latex_get_column_item(in_line, object_name0, 1, verbose_if_error);
+  if(status) {
+    fprintf(stderr, "Fatal error/Bad syntax of %s in line %d\n",
+            resid_fname, iline);
+    exit(-1);
+    }
+  jlp_compact_string(object_name0, 40);
+  if(*object_name0 == '\0') continue;
+
+/* Extract the companion and cut the object name: */
+  pc = object_name0;
+  while(*pc  && (isalpha(*pc) || *pc == ' ')) pc++;
+  while(*pc  && (isdigit(*pc) || *pc == ' ')) pc++;
+  strncpy(comp_name0, pc, 39);
+  comp_name0[39] = '\0';
+  *pc = '\0';
+  jlp_compact_string(comp_name0, 40);
+  if(!strcmp(comp_name0, "AB")) *comp_name0 = '\0';
+
+  ObjectKey(object_name0, comp_name0, key);
+  it = index_object.find(key);
+  if(it == index_object.end()) {
+    obj = &index_object[key];
+    obj->bad_iline = 0;
+  } else {
+    obj = &it->second;
+  }
+
+  status = read_values_from_RESID_line(in_line, &entry.epoch,
+                                       &entry.rho_val, &entry.rho_o_c,
+                                       &entry.theta_o_c);
+/* The error is reported when this object is requested: */
+  if(status) {
+    if(obj->bad_iline == 0) obj->bad_iline = iline;
+    continue;
+    }
+
+// Orbit grade in column 8:
+  entry.orbit_grade = 0;
+  latex_get_column_item(in_line, orbit_grade_str0, 8, verbose_if_error);
+  sscanf(orbit_grade_str0, "%d", &entry.orbit_grade);
+
+// Orbit reference in column 2:
+  latex_get_column_item(in_line, orbit_ref0, 2, verbose_if_error);
+/* Truncate to the first word only
+* Cou1973b - Couteau (1973b)    => Cou1973b
+*/
+  jlp_trim_string(orbit_ref0, 60);
+  strncpy(entry.orbit_ref, orbit_ref0, RESID_REF_LEN - 1);
+  entry.orbit_ref[RESID_REF_LEN - 1] = '\0';
+
+  entry.quadrant_discrep = is_in_line(in_line, (char *)"$^Q$");
+  entry.iline = iline;
+  obj->entries.push_back(entry);
+  } /* EOF fgets() */
+} /* EOF while */
+
+fclose(fp_resid_table);
+nlines = iline;
+
+/* Sort the lines of each object by epoch
+* (stable sort, to keep the order of the file for a given epoch): */
+for(it = index_object.begin(); it != index_object.end(); it++)
+  std::stable_sort(it->second.entries.begin(), it->second.entries.end(),
+                   resid_epoch_is_smaller);
+
+#ifdef DEBUG
+printf("RESIDTable: %d lines read and %d objects loaded from %s\n",
+        nlines, (int)index_object.size(), resid_fname);
+#endif
+
+return(0);
+}
+/***********************************************************************
+* Retrieve the residuals for a given object at a given epoch
+* (see get_values_from_RESID_table() in "jlp_catalog_utils.cpp")
+*
+* The lines of the object with the same epoch are located with
+* a binary search, and processed in the order of the file.
+***********************************************************************/
+int RESIDTable::GetValues(char *object_name, char *comp_name, double epoch_o,
+                          double rho_o, char *orbit_ref, int *orbit_grade,
+                          int ref_slength, double *rho_o_c,
+                          double *theta_o_c, char *quadrant_discrep,
+                          int *norbits_found, int nmax_orbits)
+{
+char object_name1[40], comp_name1[40], old_orbit_ref[RESID_REF_LEN];
+std::unordered_map<std::string, RESID_OBJECT>::iterator it;
+std::vector<RESID_ENTRY>::iterator ie;
+std::vector<const RESID_ENTRY*> same_epoch;
+std::string key;
+const RESID_ENTRY *entry;
+int k, kk;
+
+*norbits_found = 0;
+
+/* Remove all blanks: */
+strncpy(object_name1, object_name, 39);
+object_name1[39] = '\0';
+jlp_compact_string(object_name1, 40);
+strncpy(comp_name1, comp_name, 39);
+comp_name1[39] = '\0';
+jlp_compact_string(comp_name1, 40);
+if(!strcmp(comp_name1, "AB")) *comp_name1 = '\0';
+
+ObjectKey(object_name1, comp_name1, key);
+it = index_object.find(key);
+if(it == index_object.end()) return(0);
+
+if(it->second.bad_iline) {
+  fprintf(stderr, "Fatal error/Bad syntax of %s in line %d\n",
+          resid_fname, it->second.bad_iline);
+  exit(-1);
+  }
+
+/* Lines with the same epoch, in the order of the file: */
+ie = std::lower_bound(it->second.entries.begin(), it->second.entries.end(),
+                      epoch_o - RESID_EPOCH_TOLER, resid_epoch_is_smaller_than);
+for(; ie != it->second.entries.end()
+      && ie->epoch < epoch_o + RESID_EPOCH_TOLER; ie++) {
+   if(ABS(ie->epoch - epoch_o) < RESID_EPOCH_TOLER) same_epoch.push_back(&*ie);
+   }
+std::sort(same_epoch.begin(), same_epoch.end(), resid_iline_is_smaller);
+
+strcpy(old_orbit_ref,"none");
+kk = 0;
+for(k = 0; k < (int)same_epoch.size() && kk < nmax_orbits; k++) {
+  entry = same_epoch[k];
+/* If the rho are equal, and orbit_ref is new,
+*  load the values of this orbit: */
+  if((ABS(rho_o - entry->rho_val) < RESID_RHO_TOLER)
+     && (strcmp(entry->orbit_ref, old_orbit_ref) != 0)) {
+    strcpy(old_orbit_ref, entry->orbit_ref);
+    rho_o_c[kk] = entry->rho_o_c;
+    theta_o_c[kk] = entry->theta_o_c;
+    if(entry->quadrant_discrep) strcpy(quadrant_discrep, "\\rlap{$^Q$}");
+    strncpy(&orbit_ref[kk * ref_slength], entry->orbit_ref, ref_slength - 1);
+    orbit_ref[kk * ref_slength + ref_slength - 1] = '\0';
+    *orbit_grade = entry->orbit_grade;
+    kk++;
+    }
+  }
+
+*norbits_found = kk;
+
+return(0);
+}
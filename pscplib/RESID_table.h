@@ -0,0 +1,67 @@
+/************************************************************************
+* "RESID_table.h"
+* In-memory version of the LaTeX table of residuals (O-C)
+* created by residuals_1.c, read only once and indexed by object
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#ifndef __RESID_table_h   /* BOF sentry */
+#define __RESID_table_h
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+
+/* Maximum length of the orbit references (including the final '\0') */
+#define RESID_REF_LEN 64
+
+/* One line of the residual table
+* Example:
+* ADS 9494 AB & Sod1999 - Soderhjelm (1999) & 2007.534 & 1.842 & 350.4 & 0.01 & 0.10 \\
+*/
+typedef struct {
+  double epoch, rho_val, rho_o_c, theta_o_c;
+  int orbit_grade, quadrant_discrep, iline;
+  char orbit_ref[RESID_REF_LEN];
+} RESID_ENTRY;
+
+/* All the lines of an object (and companion), sorted by epoch */
+typedef struct {
+  std::vector<RESID_ENTRY> entries;
+/* First line of this object with a bad syntax (0 if none) */
+  int bad_iline;
+} RESID_OBJECT;
+
+class RESIDTable {
+
+public:
+    RESIDTable(char *resid_fname0);
+    ~RESIDTable() {};
+
+    int IsLoaded() { return(loaded); }
+    int NLines() { return(nlines); }
+    const char *Filename() { return(resid_fname); }
+
+// Same interface as get_values_from_RESID_table()
+    int GetValues(char *object_name, char *comp_name, double epoch_o,
+                  double rho_o, char *orbit_ref, int *orbit_grade,
+                  int ref_slength, double *rho_o_c, double *theta_o_c,
+                  char *quadrant_discrep, int *norbits_found,
+                  int nmax_orbits);
+
+private:
+    int LoadFromTextFile();
+    void ObjectKey(char *object_name, char *comp_name, std::string &key);
+
+    char resid_fname[256];
+    int nlines, loaded;
+
+// Compacted object name + companion ("AB" if empty) -> lines of this object
+    std::unordered_map<std::string, RESID_OBJECT> index_object;
+};
+
+// Process-wide instance (reloaded only if the file name changes):
+RESIDTable *RESIDTable_get_cached(char *resid_fname);
+
+#endif   /* EOF sentry */
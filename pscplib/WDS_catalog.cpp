@@ -0,0 +1,504 @@
+/************************************************************************
+* "WDS_catalog.cpp"
+* In-memory version of the WDS catalog, loaded only once
+* and indexed by discoverer's name and WDS name
+*
+* The catalog is read once and stored in fixed-length columns.
+* If a valid snapshot created by catalog_compile is found
+* (e.g. wdsweb_summ.txt.bin), the columns and the hash indexes are
+* memory-mapped from it instead of parsing the ASCII file.
+* The routines of "WDS_catalog_utils.cpp" call the process-wide instance
+* returned by WDSCatalog_get_cached(), so that the catalog is no longer
+* scanned for each object.
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>                /* exit() */
+#include <string.h>
+#include "WDS_catalog.h"
+#include "jlp_string.h"            // jlp_compact_string
+
+/*
+#define DEBUG
+*/
+
+/* Length of the lines of the WDS catalog (without '\n') */
+#define WDS_LINE_LEN 130
+
+static WDSCatalog *cached_WDS_catalog = NULL;
+
+/*************************************************************************
+* Copy a fixed-width field of the catalog line to dest (terminated by '\0')
+*************************************************************************/
+static void WDS_copy_field(char *dest, char *cat_line, int istart, int ilen)
+{
+strncpy(dest, &cat_line[istart], ilen);
+dest[ilen] = '\0';
+}
+/*************************************************************************
+* Return the process-wide instance of the WDS catalog
+* (the catalog is loaded only once, or when its name changes)
+*
+* INPUT:
+*  WDS_catalog: name of the WDS catalog
+*
+* OUTPUT:
+*  pointer to the catalog or NULL if it could not be loaded
+*************************************************************************/
+WDSCatalog *WDSCatalog_get_cached(char *WDS_catalog)
+{
+if(cached_WDS_catalog != NULL) {
+  if(!strcmp(cached_WDS_catalog->Filename(), WDS_catalog))
+     return(cached_WDS_catalog);
+  delete cached_WDS_catalog;
+  cached_WDS_catalog = NULL;
+  }
+
+cached_WDS_catalog = new WDSCatalog(WDS_catalog);
+if(!cached_WDS_catalog->IsLoaded()) {
+  delete cached_WDS_catalog;
+  cached_WDS_catalog = NULL;
+  }
+
+return(cached_WDS_catalog);
+}
+/*************************************************************************
+* Constructor
+*
+* INPUT:
+*  WDS_catalog0: name of the WDS catalog
+*  use_snapshot: if 1, use the binary snapshot when present and valid
+*************************************************************************/
+WDSCatalog::WDSCatalog(char *WDS_catalog0, int use_snapshot)
+{
+strncpy(WDS_catalog_fname, WDS_catalog0, 255);
+WDS_catalog_fname[255] = '\0';
+nrecords = 0;
+loaded = 0;
+data = NULL;
+snap.map_address = NULL;
+snap.data = NULL;
+
+if(use_snapshot
+   && snapshot_open(WDS_catalog_fname, SNAPSHOT_WDS, WDS_RECORD_SIZE,
+                    &snap) == 0) {
+  nrecords = snap.nrecords;
+  if(snap.index_size == IndexSize()) {
+    SetColumns(snap.data);
+    SetIndexes(snap.index);
+    loaded = 1;
+    } else {
+    fprintf(stderr, "WDSCatalog/Warning: bad index size in the snapshot of %s (ignored)\n",
+            WDS_catalog_fname);
+    snapshot_close(&snap);
+    nrecords = 0;
+    }
+  }
+
+if(!loaded && LoadFromTextFile() == 0) {
+  index_buffer.resize(IndexSize() / sizeof(double) + 1);
+  SetIndexes((char *)&index_buffer[0]);
+  BuildIndex();
+  loaded = 1;
+  }
+}
+/*************************************************************************
+* Set the addresses of the columns (double precision columns first)
+*************************************************************************/
+void WDSCatalog::SetColumns(char *data0)
+{
+char *pc;
+
+data = data0;
+pc = data;
+col_last_year = (double *)pc;
+pc += nrecords * sizeof(double);
+col_last_theta = (double *)pc;
+pc += nrecords * sizeof(double);
+col_last_rho = (double *)pc;
+pc += nrecords * sizeof(double);
+col_magA = (double *)pc;
+pc += nrecords * sizeof(double);
+col_magB = (double *)pc;
+pc += nrecords * sizeof(double);
+col_wds_name = pc;
+pc += nrecords * WDS_NAME_LEN;
+col_discov = pc;
+pc += nrecords * WDS_DISCOV_LEN;
+col_comp = pc;
+pc += nrecords * WDS_COMP_LEN;
+col_spectral = pc;
+pc += nrecords * WDS_SPECT_LEN;
+col_coord = pc;
+}
+/*************************************************************************
+* Size of the indexes (in bytes)
+*************************************************************************/
+size_t WDSCatalog::IndexSize()
+{
+nslots = snapshot_hash_nslots(nrecords);
+return((size_t)(3 * nslots) * sizeof(int32_t)
+       + (size_t)nrecords * WDS_FULL_DISCOV_LEN);
+}
+/*************************************************************************
+* Set the addresses of the indexes (hash tables first)
+*************************************************************************/
+void WDSCatalog::SetIndexes(char *index0)
+{
+int32_t *pi;
+
+nslots = snapshot_hash_nslots(nrecords);
+pi = (int32_t *)index0;
+index_discov = pi;
+pi += nslots;
+index_full_discov = pi;
+pi += nslots;
+index_wds = pi;
+pi += nslots;
+col_full_discov = (char *)pi;
+}
+/*************************************************************************
+* Save the columns to a binary snapshot (used by catalog_compile)
+*************************************************************************/
+int WDSCatalog::WriteSnapshot()
+{
+if(!loaded) return(-1);
+return(snapshot_write(WDS_catalog_fname, SNAPSHOT_WDS, WDS_RECORD_SIZE,
+                      data, nrecords, (char *)index_discov, IndexSize()));
+}
+/*************************************************************************
+* Read the WDS catalog and store the useful fields in the columns
+*
+* Format of WDS catalog (version of 2009-2012):
+*
+  COLUMN     Format                     DATA
+  --------   ------         ----------------------------
+  1  -  10   A10             2000 Coordinates
+  11 -  17   A7              Discoverer & Number
+  18 -  22   A5              Components
+  24 -  27   I4              Date (first)
+  29 -  32   I4              Date (last)
+  34 -  37   I4              Number of Observations (up to 9999)
+  39 -  41   I3              Position Angle (first - XXX)
+  43 -  45   I3              Position Angle (last  - XXX)
+  47 -  51   F5.1            Separation (first)
+  53 -  57   F5.1            Separation (last)
+  59 -  63   F5.2            Magnitude of First Component
+  65 -  69   F5.2            Magnitude of Second Component
+  71 -  79   A9              Spectral Type (Primary/Secondary)
+ 113 - 130   A18             2000 arcsecond coordinates
+*************************************************************************/
+int WDSCatalog::LoadFromTextFile()
+{
+FILE *fp_WDS_cat;
+char cat_line0[256], cvalue[64], buffer[WDS_COORD_LEN];
+double dvalue, last_year, last_theta, last_rho, magA, magB;
+int i, ilen, ivalue;
+std::vector<char> v_wds_name, v_discov, v_comp, v_spectral, v_coord;
+std::vector<double> v_last_year, v_last_theta, v_last_rho, v_magA, v_magB;
+
+/* Open input file containing the WDS catalog */
+if((fp_WDS_cat = fopen(WDS_catalog_fname, "r")) == NULL) {
+   fprintf(stderr, "WDSCatalog/Fatal error opening WDS catalog: %s\n",
+           WDS_catalog_fname);
+   return(-1);
+  }
+
+/* Typical size of the WDS catalog (2020): about 150000 lines */
+v_wds_name.reserve(160000 * WDS_NAME_LEN);
+v_discov.reserve(160000 * WDS_DISCOV_LEN);
+v_comp.reserve(160000 * WDS_COMP_LEN);
+v_spectral.reserve(160000 * WDS_SPECT_LEN);
+v_coord.reserve(160000 * WDS_COORD_LEN);
+
+nrecords = 0;
+while(!feof(fp_WDS_cat)) {
+ if(fgets(cat_line0, 256, fp_WDS_cat)) {
+   if(cat_line0[0] == '%') continue;
+
+/* Remove the end of line and pad with blanks,
+* to have all the fixed-width fields defined: */
+   ilen = strlen(cat_line0);
+   while(ilen > 0 && (cat_line0[ilen-1] == '\n' || cat_line0[ilen-1] == '\r'))
+      ilen--;
+   for(i = ilen; i < WDS_LINE_LEN; i++) cat_line0[i] = ' ';
+   if(ilen < WDS_LINE_LEN) ilen = WDS_LINE_LEN;
+   cat_line0[ilen] = '\0';
+
+//** 1. WDS name: "1  -  10   A10"
+   WDS_copy_field(buffer, cat_line0, 0, 10);
+   v_wds_name.insert(v_wds_name.end(), buffer, buffer + WDS_NAME_LEN);
+//** 2. Discoverer & Number: "11 -  17   A7"
+// Removes all the blanks since 7 characters for WDS, and 8 characters
+// for Marco's file (the end of the slot is filled with zeros)
+   memset(cvalue, 0, 64);
+   WDS_copy_field(cvalue, cat_line0, 10, 7);
+   jlp_compact_string(cvalue, 20);
+   v_discov.insert(v_discov.end(), cvalue, cvalue + WDS_DISCOV_LEN);
+//** 3. Components: "18 -  22   A5"
+   memset(cvalue, 0, 64);
+   WDS_copy_field(cvalue, cat_line0, 17, 5);
+   jlp_compact_string(cvalue, 20);
+   v_comp.insert(v_comp.end(), cvalue, cvalue + WDS_COMP_LEN);
+//** 4. Spectral Type (Primary/Secondary): "71 -  79   A9"
+   WDS_copy_field(buffer, cat_line0, 70, 9);
+   v_spectral.insert(v_spectral.end(), buffer, buffer + WDS_SPECT_LEN);
+//** 5. Arcsecond coordinates: "113 - 130   A18"
+   WDS_copy_field(buffer, cat_line0, 112, 18);
+   v_coord.insert(v_coord.end(), buffer, buffer + WDS_COORD_LEN);
+
+//** 6. (last) year: "29 -  32   I4"
+   last_year = 0.;
+   WDS_copy_field(cvalue, cat_line0, 28, 4);
+   if(sscanf(cvalue, "%d", &ivalue) == 1) last_year = ivalue;
+//** 7. (last) theta: "43 -  45   I3"
+   last_theta = 0.;
+   WDS_copy_field(cvalue, cat_line0, 42, 3);
+   if(sscanf(cvalue, "%d", &ivalue) == 1) last_theta = ivalue;
+//** 8. (last) rho: "53 -  57   F5.1"
+   last_rho = 0.;
+   WDS_copy_field(cvalue, cat_line0, 52, 5);
+   if(sscanf(cvalue, "%lf", &dvalue) == 1) last_rho = dvalue;
+//** 9. Magnitude of First Component: "59 -  63   F5.2"
+   magA = 0.;
+   WDS_copy_field(cvalue, cat_line0, 58, 5);
+   if(sscanf(cvalue, "%lf", &dvalue) == 1) magA = dvalue;
+//** 10. Magnitude of Second Component: "65 -  69   F5.2"
+   magB = 0.;
+   WDS_copy_field(cvalue, cat_line0, 64, 5);
+   if(sscanf(cvalue, "%lf", &dvalue) == 1) magB = dvalue;
+
+   v_last_year.push_back(last_year);
+   v_last_theta.push_back(last_theta);
+   v_last_rho.push_back(last_rho);
+   v_magA.push_back(magA);
+   v_magB.push_back(magB);
+   nrecords++;
+  } /* EOF fgets... */
+} /* EOF while */
+
+fclose(fp_WDS_cat);
+
+/* Store all the columns contiguously (same layout as the snapshot): */
+data_buffer.resize((nrecords * WDS_RECORD_SIZE) / sizeof(double) + 1);
+SetColumns((char *)&data_buffer[0]);
+if(nrecords > 0) {
+  memcpy(col_last_year, &v_last_year[0], nrecords * sizeof(double));
+  memcpy(col_last_theta, &v_last_theta[0], nrecords * sizeof(double));
+  memcpy(col_last_rho, &v_last_rho[0], nrecords * sizeof(double));
+  memcpy(col_magA, &v_magA[0], nrecords * sizeof(double));
+  memcpy(col_magB, &v_magB[0], nrecords * sizeof(double));
+  memcpy(col_wds_name, &v_wds_name[0], nrecords * WDS_NAME_LEN);
+  memcpy(col_discov, &v_discov[0], nrecords * WDS_DISCOV_LEN);
+  memcpy(col_comp, &v_comp[0], nrecords * WDS_COMP_LEN);
+  memcpy(col_spectral, &v_spectral[0], nrecords * WDS_SPECT_LEN);
+  memcpy(col_coord, &v_coord[0], nrecords * WDS_COORD_LEN);
+  }
+
+#ifdef DEBUG
+printf("WDSCatalog: %d records loaded from %s\n", nrecords, WDS_catalog_fname);
+#endif
+
+return(0);
+}
+/*************************************************************************
+* Full discoverer's name used for the index:
+* discov_name + comp_name, or discov_name only for the AB companion
+*************************************************************************/
+void WDSCatalog::AddFullDiscovName(char *discov_name, char *comp_name,
+                                   char *full_discov_name)
+{
+if(!strcmp(comp_name, "AB")) {
+  sprintf(full_discov_name, "%s", discov_name);
+  } else {
+  sprintf(full_discov_name, "%s%s", discov_name, comp_name);
+  }
+}
+/*************************************************************************
+* Build the hash indexes (the first record is kept for duplicated keys)
+* (only when the catalog is read from the ASCII file: the indexes
+* are saved in the snapshot)
+*************************************************************************/
+void WDSCatalog::BuildIndex()
+{
+char full_discov_name0[64];
+int irec;
+
+snapshot_hash_init(index_discov, nslots);
+snapshot_hash_init(index_full_discov, nslots);
+snapshot_hash_init(index_wds, nslots);
+
+for(irec = 0; irec < nrecords; irec++) {
+  char *discov_name0 = &col_discov[irec * WDS_DISCOV_LEN];
+  char *comp_name0 = &col_comp[irec * WDS_COMP_LEN];
+
+  snapshot_hash_insert(index_discov, nslots, col_discov, WDS_DISCOV_LEN,
+                       irec);
+
+  AddFullDiscovName(discov_name0, comp_name0, full_discov_name0);
+  jlp_compact_string(full_discov_name0, 64);
+  memset(&col_full_discov[irec * WDS_FULL_DISCOV_LEN], 0,
+         WDS_FULL_DISCOV_LEN);
+  strncpy(&col_full_discov[irec * WDS_FULL_DISCOV_LEN], full_discov_name0,
+          WDS_FULL_DISCOV_LEN - 1);
+  snapshot_hash_insert(index_full_discov, nslots, col_full_discov,
+                       WDS_FULL_DISCOV_LEN, irec);
+
+  snapshot_hash_insert(index_wds, nslots, col_wds_name, WDS_NAME_LEN, irec);
+  }
+}
+/*************************************************************************
+* Search for the WDS name of an object from its discoverer's name
+* (see search_discov_name_in_WDS_catalog() in "WDS_catalog_utils.cpp")
+*
+* INPUT:
+*  discov_name: discoverer's name of the object to be searched for
+*  comp_name: companion name of the object to be searched for
+*
+* OUTPUT:
+*  wds_name: WDS name corresponding to discov_name
+*  found: 2 if object and companion were found,
+*         1 if only the object was found, 0 otherwise
+*************************************************************************/
+int WDSCatalog::SearchDiscovName(char *discov_name, char *comp_name,
+                                 char *wds_name, char *wds_discov_name,
+                                 char *wds_comp_name, int *found)
+{
+char *comp_name0;
+int irec, same_comp;
+
+*found = 0;
+
+/* Removes all the blanks since 7 characters for WDS, and 8 characters
+* for Marco's file */
+jlp_compact_string(discov_name, 20);
+jlp_compact_string(comp_name, 20);
+
+irec = snapshot_hash_find(index_discov, nslots, col_discov, WDS_DISCOV_LEN,
+                          discov_name);
+if(irec < 0) return(0);
+
+/* As in search_discov_name_in_WDS_catalog(), the first entry of the catalog
+* with the same discov_name is returned (found=2 if its companion
+* is also the same, found=1 otherwise) */
+comp_name0 = &col_comp[irec * WDS_COMP_LEN];
+strcpy(wds_name, &col_wds_name[irec * WDS_NAME_LEN]);
+strcpy(wds_discov_name, &col_discov[irec * WDS_DISCOV_LEN]);
+strcpy(wds_comp_name, comp_name0);
+*found = 1;
+same_comp = 0;
+if(!strcmp(comp_name, comp_name0)) same_comp = 1;
+if((comp_name[0] == '\0') && !strcmp(comp_name0, "AB")) same_comp = 1;
+if((comp_name0[0] == '\0') && !strcmp(comp_name, "AB")) same_comp = 1;
+if(same_comp == 1) *found = 2;
+
+return(0);
+}
+/*************************************************************************
+* Get miscellaneous data from discov_name and comp_name
+* (see get_data_from_WDS_catalog() in "WDS_catalog_utils.cpp")
+*************************************************************************/
+int WDSCatalog::GetData(char *discov_name1, char *comp_name1,
+                        char *wds_name, double *WdsLastYear,
+                        double *WdsLastRho, double *WdsLastTheta,
+                        double *WdsMagA, double *WdsMagB,
+                        char *WdsSpectralType, int *wds_meas_found)
+{
+char full_discov_name[64];
+int irec;
+
+*WdsLastYear = 0.;
+*WdsLastRho = 0.;
+*WdsLastTheta = 0.;
+*WdsMagA = 0.;
+*WdsMagB = 0.;
+WdsSpectralType[0] = '\0';
+wds_name[0] = '\0';
+*wds_meas_found = 0;
+
+// Handle case of AB companion
+jlp_compact_string(comp_name1, 20);
+AddFullDiscovName(discov_name1, comp_name1, full_discov_name);
+
+/* Removes all the blanks since 7 characters for WDS, and 8 characters
+* for Marco's file */
+jlp_compact_string(full_discov_name, 20);
+
+irec = snapshot_hash_find(index_full_discov, nslots, col_full_discov,
+                          WDS_FULL_DISCOV_LEN, full_discov_name);
+if(irec < 0) return(0);
+
+strcpy(wds_name, &col_wds_name[irec * WDS_NAME_LEN]);
+strcpy(WdsSpectralType, &col_spectral[irec * WDS_SPECT_LEN]);
+*WdsMagA = col_magA[irec];
+*WdsMagB = col_magB[irec];
+*WdsLastYear = col_last_year[irec];
+*WdsLastTheta = col_last_theta[irec];
+*WdsLastRho = col_last_rho[irec];
+*wds_meas_found = 1;
+
+#ifdef DEBUG
+printf("WDSCatalog::GetData/last rho=%f theta=%f epoch=%f found=%d\n",
+        *WdsLastRho, *WdsLastTheta, *WdsLastYear, *wds_meas_found);
+#endif
+
+return(0);
+}
+/*************************************************************************
+* Look for accurate coordinates from the WDS name
+* (see read_coordinates_from_WDS_catalog() in "WDS_catalog_utils.cpp")
+*
+* OUTPUT:
+* alpha, delta, equinox: coordinates of the object
+*            (alpha in hours and delta in degrees)
+*************************************************************************/
+int WDSCatalog::ReadCoordinates(char *wds_name, char *str_alpha,
+                                char *str_delta, double *alpha,
+                                double *delta, double *equinox, int *found)
+{
+char cvalue[WDS_COORD_LEN], sign[1];
+int irec, hh, hm, hs, hss, dd, dm, ds, dss;
+
+*alpha = 0.;
+*delta = 0.;
+*equinox = 2000.;
+*found = 0;
+
+/* Removes all the blanks since 10 characters for WDS */
+jlp_compact_string(wds_name, 40);
+
+irec = snapshot_hash_find(index_wds, nslots, col_wds_name, WDS_NAME_LEN,
+                          wds_name);
+if(irec < 0) return(0);
+
+*found = 1;
+
+/* Example:
+060156.93+605244.8 in 113-130
+*/
+strcpy(cvalue, &col_coord[irec * WDS_COORD_LEN]);
+strncpy(str_alpha, cvalue, 9);
+str_alpha[9] = '\0';
+strncpy(str_delta, &cvalue[9], 9);
+str_delta[9] = '\0';
+if(sscanf(cvalue, "%02d%02d%02d.%02d%c%02d%02d%02d.%d",
+   &hh, &hm, &hs, &hss, sign, &dd, &dm, &ds, &dss) == 9) {
+   *alpha = (double)hh + ((double)hm)/60.
+           + ((double)hs + (double)hss/10.)/3600.;
+   *delta = (double)dd + ((double)dm)/60.
+           + ((double)ds + (double)dss/10.)/3600.;
+   if(sign[0] == '-') *delta *= -1.;
+   else if(sign[0] != '+') {
+      fprintf(stderr,"read_coordinates/Fatal error: sign=%c\n", sign[0]);
+      exit(-1);
+      }
+  } else {
+   fprintf(stderr,"read_coordinates_from_WDS_catalog/Error in catalog\n");
+   fprintf(stderr,"Warning: error reading coordinates: >%s< of WDS%s\n",
+           cvalue, wds_name);
+  }
+
+return(0);
+}
@@ -0,0 +1,92 @@
+/************************************************************************
+* "WDS_catalog.h"
+* In-memory version of the WDS catalog, loaded only once
+* and indexed by discoverer's name and WDS name
+* (columns and indexes memory-mapped from the snapshot created
+* by catalog_compile if present)
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#ifndef __WDS_catalog_h   /* BOF sentry */
+#define __WDS_catalog_h
+
+#include <vector>
+#include <stdint.h>
+#include "catalog_snapshot.h"
+
+/* Fixed length of the columns (including the final '\0') */
+#define WDS_NAME_LEN     11
+#define WDS_DISCOV_LEN   8
+#define WDS_COMP_LEN     6
+#define WDS_SPECT_LEN    10
+#define WDS_COORD_LEN    19
+/* Compacted discov_name + comp_name (used as a key by GetData) */
+#define WDS_FULL_DISCOV_LEN (WDS_DISCOV_LEN + WDS_COMP_LEN - 1)
+/* Size of one record (5 double precision columns and 5 string columns) */
+#define WDS_RECORD_SIZE  (5 * sizeof(double) + WDS_NAME_LEN + WDS_DISCOV_LEN \
+                          + WDS_COMP_LEN + WDS_SPECT_LEN + WDS_COORD_LEN)
+
+class WDSCatalog {
+
+public:
+    WDSCatalog(char *WDS_catalog0, int use_snapshot = 1);
+    ~WDSCatalog() { snapshot_close(&snap); };
+
+    int IsLoaded() { return(loaded); }
+    int IsFromSnapshot() { return(snap.data != NULL); }
+    int NRecords() { return(nrecords); }
+    int WriteSnapshot();
+    const char *Filename() { return(WDS_catalog_fname); }
+
+// Same interface as the routines of "WDS_catalog_utils.cpp"
+    int SearchDiscovName(char *discov_name, char *comp_name,
+                         char *wds_name, char *wds_discov_name,
+                         char *wds_comp_name, int *found);
+    int GetData(char *discov_name, char *comp_name,
+                char *wds_name, double *WdsLastYear,
+                double *WdsLastRho, double *WdsLastTheta,
+                double *WdsMagA, double *WdsMagB,
+                char *WdsSpectralType, int *found);
+    int ReadCoordinates(char *wds_name, char *str_alpha, char *str_delta,
+                        double *alpha, double *delta, double *equinox,
+                        int *found);
+
+private:
+    int LoadFromTextFile();
+    void SetColumns(char *data0);
+    size_t IndexSize();
+    void SetIndexes(char *index0);
+    void BuildIndex();
+    void AddFullDiscovName(char *discov_name, char *comp_name,
+                           char *full_discov_name);
+
+    char WDS_catalog_fname[256];
+    int nrecords, loaded;
+
+// Columns (one fixed-length slot per record), stored contiguously
+// in data_buffer or in the memory-mapped snapshot:
+    std::vector<double> data_buffer;
+    SNAPSHOT_MAP snap;
+    char *data;
+    char *col_wds_name, *col_discov, *col_comp, *col_spectral, *col_coord;
+    double *col_last_year, *col_last_theta, *col_last_rho;
+    double *col_magA, *col_magB;
+
+// Hash indexes (hash tables of nslots record numbers), stored contiguously
+// in index_buffer or in the memory-mapped snapshot:
+    std::vector<double> index_buffer;
+    int nslots;
+// compacted discov_name -> first record
+    int32_t *index_discov;
+// compacted discov_name+comp_name ("AB" omitted) -> first record
+    int32_t *index_full_discov;
+    char *col_full_discov;
+// WDS name -> first record
+    int32_t *index_wds;
+};
+
+// Process-wide instance (reloaded only if the catalog name changes):
+WDSCatalog *WDSCatalog_get_cached(char *WDS_catalog);
+
+#endif   /* EOF sentry */
@@ -3,7 +3,9 @@
 * To retrieve data from the WDS catalog
 *
 * JLP 
-* Version 20/11/2009
+* Version 17/10/2026
+*
+* The catalog is now loaded only once (see WDSCatalog in "WDS_catalog.cpp")
 *************************************************************************/
 #include <stdio.h>
 #include <stdlib.h>                /* exit() */
@@ -14,6 +16,7 @@
 #include "jlp_catalog_utils.h"     // Routines used to read catalogs:
 
 #include "WDS_catalog_utils.h"     /* Prototypes of the routines defined here */ 
+#include "WDS_catalog.h"           /* WDSCatalog (catalog loaded only once) */
 #include "HIP_catalog_utils.h"     
 #include "jlp_string.h"
 
@@ -84,73 +87,19 @@ int search_discov_name_in_WDS_catalog(char *WDS_catalog, char *discov_name,
                                       char *wds_name, char *wds_discov_name,
                                       char *wds_comp_name, int *found)
 {
-FILE *fp_WDS_cat;
-char cat_line0[256], discov_name0[20], comp_name0[20], wds_name0[20];
-int iline, same_comp;
+WDSCatalog *WDS_cat;
 
 *found = 0;
 
-/* Removes all the blanks since 7 characters for WDS, and 8 characters 
-* for Marco's file */
-jlp_compact_string(discov_name, 20);
-jlp_compact_string(comp_name, 20);
-
-/* Open input file containing the WDS catalog */
-if((fp_WDS_cat = fopen(WDS_catalog, "r")) == NULL) {
+/* Load the WDS catalog (only once) */
+if((WDS_cat = WDSCatalog_get_cached(WDS_catalog)) == NULL) {
    fprintf(stderr, "search_discov_name_in_WDS_catalog/Fatal error opening WDS catalog: %s\n",
            WDS_catalog);
    return(-1);
   }
 
-/* Look for the data concerning this object: */
-*found = 0;
-iline = 0;
-while(!feof(fp_WDS_cat) && (*found != 1)) {
- if(fgets(cat_line0, 256, fp_WDS_cat)) {
-   iline++;
-   if(cat_line0[0] != '%') {
-/*   
-  1  -  10   A10             2000 Coordinates
-  11 -  17   A7              Discoverer & Number
-  18 -  22   A5              Components
-*/
-   strncpy(wds_name0, &cat_line0[0], 10);
-   wds_name0[10] = '\0';
-/* 7 characters for WDS, 8 characters for Marco's file */
-   strncpy(discov_name0, &cat_line0[10], 7);
-   discov_name0[7] = '\0';
-   strncpy(comp_name0, &cat_line0[17], 5);
-   comp_name0[5] = '\0';
-
-/* Removes all the blanks since 7 characters for WDS, and 8 characters 
-* for Marco's file */
-   jlp_compact_string(discov_name0, 20);
-   jlp_compact_string(comp_name0, 20);
-   same_comp = 0; 
-   if(!strcmp(comp_name, comp_name0)) same_comp = 1; 
-   if((comp_name[0] == '\0') && !strcmp(comp_name0, "AB")) same_comp = 1; 
-   if((comp_name0[0] == '\0') && !strcmp(comp_name, "AB")) same_comp = 1; 
-   if(!strcmp(discov_name, discov_name0)) {
-     strcpy(wds_name, wds_name0);
-     strcpy(wds_discov_name, discov_name0);
-     strcpy(wds_comp_name, comp_name0);
-     *found = 1;
-   if(same_comp == 1) {
-     *found = 2;
-     break;
-     }
-#ifdef DEBUG_1
-     printf("search_discov_name_in_WDS_catalog/Object found (discov_name=%s< comp_name=%s<) found=%d", 
-             discov_name, comp_name,  *found);
-     printf(" WDS=%s discov0=%s< comp0=%s<\n", wds_name0, discov_name0, comp_name0);
-#endif
-     }
-   } /* EOF cat_line[0] != '%' */
-  } /* EOF fgets... */
-} /* EOF while */
-
-fclose(fp_WDS_cat);
-return(0);
+return(WDS_cat->SearchDiscovName(discov_name, comp_name, wds_name,
+                                 wds_discov_name, wds_comp_name, found));
 }
 /***********************************************************************
 * Get miscellaneous data from the WDS catalog from discov_name and comp_name
@@ -175,27 +124,7 @@ int get_data_from_WDS_catalog(char *WDS_catalog, char *discov_name1,
                               double *WdsMagA, double *WdsMagB,
                               char *WdsSpectralType, int *wds_meas_found)
 {
-FILE *fp_WDS_cat;
-char cat_line0[256], discov_name0[20], comp_name0[20], wds_name0[20];
-char cvalue[64], notes0[64], orbit0, *pc, full_discov_name[64];
-char full_discov_name0[64];
-double dvalue;
-int iline, ivalue;
-
-// Copy input discov_name and comp name: 
-// Handle case of AB companion 
-jlp_compact_string(comp_name1, 20);
-if(!strcmp(comp_name1, "AB")) {
-  sprintf(full_discov_name, "%s", discov_name1);
-  } else {
-  sprintf(full_discov_name, "%s%s", discov_name1, comp_name1);
-  }
-
-/* DEBUG
-printf("get_data_from_WDS_catalog: looking for discov=%s comp=%s\n", 
-       discov_name1, comp_name1);
-printf("get_data_from_WDS_catalog: looking for full discov=%s\n", full_discov_name);
-*/
+WDSCatalog *WDS_cat;
 
 *WdsLastYear = 0.;
 *WdsLastRho = 0.;
@@ -204,120 +133,18 @@ printf("get_data_from_WDS_catalog: looking for full discov=%s\n", full_discov_na
 *WdsMagB = 0.;
 WdsSpectralType[0] = '\0';
 wds_name[0] = '\0';
+*wds_meas_found = 0;
 
-/* Removes all the blanks since 7 characters for WDS, and 8 characters 
-* for Marco's file */
-jlp_compact_string(full_discov_name, 20);
-
-/* Open input file containing the WDS catalog */
-if((fp_WDS_cat = fopen(WDS_catalog, "r")) == NULL) {
+/* Load the WDS catalog (only once) */
+if((WDS_cat = WDSCatalog_get_cached(WDS_catalog)) == NULL) {
    fprintf(stderr, "get_data_from_WDS_catalog/Fatal error opening WDS catalog: %s\n",
            WDS_catalog);
    return(-1);
   }
 
-/* Look for the data concerning this object: */
-*wds_meas_found = 0;
-iline = 0;
-while(!feof(fp_WDS_cat)) {
- if(fgets(cat_line0, 256, fp_WDS_cat)) {
-   iline++;
-   if(cat_line0[0] != '%') {
-/*   
-  1  -  10   A10             2000 Coordinates
-  11 -  17   A7              Discoverer & Number
-  18 -  22   A5              Components
-  59 -  63   F5.2            Magnitude of First Component
-  65 -  69   F5.2            Magnitude of Second Component
-  71 -  79   A9              Spectral Type (Primary/Secondary)
-  108 - 111  A4              Notes
-*/
-//** 1. WDS name: "1  -  10   A10"
-   strncpy(wds_name0, &cat_line0[0], 10);
-   wds_name0[10] = '\0';
-//** 2. Discoverer & Number: "11 -  17   A7" 
-// 7 characters for WDS, 8 characters for Marco's file
-   strncpy(discov_name0, &cat_line0[10], 7);
-   discov_name0[7] = '\0';
-//** 3. Components: "18 -  22   A5" 
-   strncpy(comp_name0, &cat_line0[17], 5);
-   comp_name0[5] = '\0';
-//** 4. Magnitude of First Component: "59 -  63   F5.2" 
-   strncpy(cvalue, &cat_line0[58], 5);
-   ivalue = sscanf(cvalue, "%lf", &dvalue);
-   if(ivalue == 1) *WdsMagA = dvalue;
-//** 5. Magnitude of Second Component: "65 -  69   F5.2" 
-   strncpy(cvalue, &cat_line0[64], 5);
-   ivalue = sscanf(cvalue, "%lf", &dvalue);
-   if(ivalue == 1) *WdsMagB = dvalue;
-//** 6. Spectral Type (Primary/Secondary): "71 -  79   A9" 
-   strncpy(WdsSpectralType, &cat_line0[70], 9);
-   WdsSpectralType[9] = '\0';
-//** 7. Orbit
-// O: Orbit. A published orbit exists
-// Orbit, briefly described in WDSNOT MEMO and has entry in Orbit Catalog
-   strncpy(notes0, &cat_line0[107], 4);
-   notes0[4] = '\0';
-   pc = strchr(notes0, 'O');
-   if(pc != NULL) orbit0 = 1;
-   else orbit0 = 0;
-
-/* Removes all the blanks since 7 characters for WDS, and 8 characters 
-* for Marco's file */
-   jlp_compact_string(discov_name0, 20);
-// Handle case of AB companion 
-   jlp_compact_string(comp_name0, 20);
-   if(!strcmp(comp_name0, "AB")) {
-     sprintf(full_discov_name0, "%s", discov_name0);
-   } else {
-     sprintf(full_discov_name0, "%s%s", discov_name0, comp_name0);
-   }
-   jlp_compact_string(full_discov_name0, 64);
-   if(!strcmp(full_discov_name, full_discov_name0)) {
-// Copy to output value of wds_name:
-     strcpy(wds_name, wds_name0);
-#ifdef DEBUG_1
-     printf("get_data_from_WDS_catalog/Full object name found in WDS catalog (discov_name =%s)\n", full_discov_name);
-     printf("WDS=%s discov=%s comp=%s\n", wds_name0, discov_name0, comp_name0);
-     printf("WDS_cat/notes0=%s pc_notes=%s orbit=%d\n", notes0, pc, orbit0);
-#endif
-/* Read WdsLastYear, WdsLastRho, WdsLastTheta: 
-  24 -  27   I4              Date (first)
-  29 -  32   I4              Date (last)
-  34 -  37   I4              Number of Observations (up to 9999)
-  39 -  41   I3              Position Angle (first - XXX)
-  43 -  45   I3              Position Angle (last  - XXX)
-  47 -  51   F5.1            Separation (first)
-  53 -  57   F5.1            Separation (last)
-*/
-/* (last) year */
-     strncpy(cvalue, &cat_line0[28], 4);
-     cvalue[4] = '\0';
-     if(sscanf(cvalue, "%d", &ivalue) == 1) *WdsLastYear = ivalue;
-
-/* (last) theta */
-     strncpy(cvalue, &cat_line0[42], 3);
-     cvalue[3] = '\0';
-     if(sscanf(cvalue, "%d", &ivalue) == 1) *WdsLastTheta = ivalue;
-
-/* (last) rho */
-     strncpy(cvalue, &cat_line0[52], 5);
-     cvalue[5] = '\0';
-     if(sscanf(cvalue, "%lf", &dvalue) == 1) *WdsLastRho = dvalue;
-
-     *wds_meas_found = 1;
-#ifdef DEBUG
-     printf("last rho=%f theta=%f epoch=%f found=%d\n",
-             *WdsLastRho, *WdsLastTheta, *WdsLastYear, *wds_meas_found);
-#endif
-     break;
-     }
-   } /* EOF cat_line[0] != '%' */
-  } /* EOF fgets... */
-} /* EOF while */
-
-fclose(fp_WDS_cat);
-return(0);
+return(WDS_cat->GetData(discov_name1, comp_name1, wds_name, WdsLastYear,
+                        WdsLastRho, WdsLastTheta, WdsMagA, WdsMagB,
+                        WdsSpectralType, wds_meas_found));
 }
 /***********************************************************************
 * Look for accurate coordinates in WDS catalog
@@ -359,87 +186,22 @@ int read_coordinates_from_WDS_catalog(char *wds_name, char *WDS_catalog,
                                       double *alpha, double *delta,
                                       double *equinox, int *found)
 {
-FILE *fp_WDS_cat;
-char cat_line0[256], wds_name0[40], cvalue[64], sign[1];
-int iline, hh, hm, hs, hss, dd, dm, ds, dss;
+WDSCatalog *WDS_cat;
 
 *alpha = 0.;
 *delta = 0.;
 *equinox = 2000.;
+*found = 0;
 
-/* Removes all the blanks since 10 characters for WDS */ 
-jlp_compact_string(wds_name, 40);
-
-/* Open input file containing the WDS catalog */
-if((fp_WDS_cat = fopen(WDS_catalog, "r")) == NULL) {
+/* Load the WDS catalog (only once) */
+if((WDS_cat = WDSCatalog_get_cached(WDS_catalog)) == NULL) {
    fprintf(stderr, "read_coordinates_in_WDS_catalog/Fatal error opening WDS catalog: %s\n",
            WDS_catalog);
    return(-1);
   }
 
-/* Look for the data concerning this object: */
-*found = 0;
-iline = 0;
-while(!feof(fp_WDS_cat)) {
- if(fgets(cat_line0, 256, fp_WDS_cat)) {
-   iline++;
-   if(cat_line0[0] != '%') {
-/*   
-  1  -  10   A10             2000 Coordinates (= WDS name)
-  11 -  17   A7              Discoverer & Number
-  18 -  22   A5              Components
-*/
-   strncpy(wds_name0, &cat_line0[0], 10);
-   wds_name0[10] = '\0';
-
-   if(!strcmp(wds_name, wds_name0)) {
-     *found = 1;
-#ifdef DEBUG
-     printf("read_coordinates_from_WDS_catalog/Object found in WDS catalog (wds_name =%s)\n", wds_name);
-#endif
-
-/* Read WdsLastYear, WdsLastRho, WdsLastTheta: 
-  113 - 130   A18            2000 precise coordinates
-Example:
-060156.93+605244.8 in 113-130
-*/
-     strncpy(cvalue, &cat_line0[112], 18);
-     strncpy(str_alpha, &cat_line0[112], 9);
-     str_alpha[9] = '\0';
-     strncpy(str_delta, &cat_line0[121], 9);
-     str_delta[9] = '\0';
-     cvalue[18] = '\0';
-     if(sscanf(cvalue, "%02d%02d%02d.%02d%c%02d%02d%02d.%d", 
-        &hh, &hm, &hs, &hss, sign, &dd, &dm, &ds, &dss) == 9) {
-        *alpha = (double)hh + ((double)hm)/60. 
-                + ((double)hs + (double)hss/10.)/3600.;
-        *delta = (double)dd + ((double)dm)/60. 
-                + ((double)ds + (double)dss/10.)/3600.;
-        if(sign[0] == '-') *delta *= -1.;
-        else if(sign[0] != '+') {
-           fprintf(stderr,"read_coordinates/Fatal error: sign=%s\n", sign);
-           exit(-1);
-           }
-#ifdef DEBUG_1
-     printf("WDS%s : %02d%02d%02d.%02d%s%02d%02d%02d.%d\n",
-            wds_name, hh, hm, hs, hss, sign, dd, dm, ds, dss); 
-     printf("WDS%s : alpha=%f delta=%f \n", wds_name, *alpha, *delta);
-#endif
-     } else {
-       fprintf(stderr,"read_coordinates_from_WDS_catalog/Error in catalog\n");
-       fprintf(stderr,"Warning: error reading coordinates: >%s< of WDS%s in line%d\n",
-               cvalue, wds_name, iline);
-     } 
-
-     *found = 1;
-     break;
-     }
-   } /* EOF cat_line[0] != '%' */
-  } /* EOF fgets... */
-} /* EOF while */
-
-fclose(fp_WDS_cat);
-return(0);
+return(WDS_cat->ReadCoordinates(wds_name, str_alpha, str_delta,
+                                alpha, delta, equinox, found));
 }
 /***********************************************************************
 * Get miscellaneous data from the WDS catalog
@@ -1,7 +1,7 @@
 /*************************************************************************
 *
 * JLP
-* Version 03/03/2020
+* Version 17/10/2026
 *************************************************************************/
 #ifndef _astrom_def
 #define _astrom_def
@@ -19,14 +19,17 @@
 #define DEBUG
 */
 
-/* Maximum number of measurements per object: */
+/* Maximum number of measurements per object
+* (the measurements are stored in the arena of AstromStore,
+* see astrom_store.h, and only use the memory needed): */
 #define NMEAS 64
 /* Maximum number of objects: */
 #define NOBJ_MAX 8000
 
 /* Structure to define a measurement: */
 typedef struct {
-char comments[40][80]; 	/* Comments (lines starting with %) */
+const char *comments;   /* Comments (lines starting with %), in the string pool
+                           of AstromStore (NULL if none) */
 char data[180];         /* Data: line with filename, filter, measurements */
 char filename[40];      /* Name of the FITS file used for this measurement */
 char date[12];          /* Date, e.g., 29/12/2004 */
@@ -54,8 +57,10 @@ char wds[40];		/* WDS name */
 char discov_name[40];	/* Discoverer's binary name */
 char comp_name[40];	/* Companion name */
 char ads[40];		/* ADS name */
-MEASURE meas[NMEAS];	/* Measurements concerning this object */
-MEASURE cmp_meas[NMEAS]; /* Measurements in compared file concerning this object */
+MEASURE *meas;		/* Measurements concerning this object */
+MEASURE *cmp_meas;	/* Measurements in compared file concerning this object */
+int nmeas_alloc;        /* Room available in meas[] and cmp_meas[] */
+void *store;            /* AstromStore containing meas[] and cmp_meas[] */
 char notes[80];		/* Notes which are common to all measurements */
 double ra; 		/* Right ascension */
 int dec; 		/* Declination */
@@ -0,0 +1,244 @@
+/*************************************************************************
+* "astrom_store.cpp"
+* Storage of the OBJECT and MEASURE structures (see astrom_store.h)
+*
+* Contained here:
+* OBJECT *astrom_alloc_objects(int nobj_max);
+* void astrom_free_objects(OBJECT *obj);
+* int astrom_reserve_measures(OBJECT *ob, int nmeas_min);
+* MEASURE *astrom_next_measure(OBJECT *ob);
+* int astrom_copy_object_for_cmp(OBJECT *ob2, OBJECT *ob1);
+* const char *astrom_intern_comments(OBJECT *ob, const char *comments);
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>    // exit(), calloc()
+#include <string.h>    // memset(), memcpy()
+#include "astrom_store.h"
+
+/*
+#define DEBUG
+*/
+
+/*************************************************************************
+* Allocate an array of nobj_max objects, with nmeas = 0
+* (replaces malloc(nobj_max * sizeof(OBJECT)))
+*************************************************************************/
+OBJECT *astrom_alloc_objects(int nobj_max)
+{
+AstromStore *store;
+
+if(nobj_max < 1) nobj_max = 1;
+store = new AstromStore(nobj_max);
+
+return(store->Objects());
+}
+/*************************************************************************
+* Free the objects allocated by astrom_alloc_objects()
+* and their measurements
+*************************************************************************/
+void astrom_free_objects(OBJECT *obj)
+{
+AstromStore *store;
+
+if(obj == NULL) return;
+store = (AstromStore *)obj[0].store;
+
+#ifdef DEBUG
+printf("astrom_free_objects: %d objects, %.1f Mbytes\n", store->NObjects(),
+       (double)store->MemoryUsed() / 1.e6);
+#endif
+
+delete store;
+}
+/*************************************************************************
+* Room for at least nmeas_min measurements in ob->meas and ob->cmp_meas
+*************************************************************************/
+int astrom_reserve_measures(OBJECT *ob, int nmeas_min)
+{
+return(((AstromStore *)ob->store)->ReserveMeasures(ob, nmeas_min));
+}
+/*************************************************************************
+* Return the address of the next measurement of an object
+* (ob->meas[ob->nmeas]), after having checked that there is enough room
+* ob->nmeas should be increased by the calling routine
+*************************************************************************/
+MEASURE *astrom_next_measure(OBJECT *ob)
+{
+astrom_reserve_measures(ob, ob->nmeas + 1);
+
+return(&ob->meas[ob->nmeas]);
+}
+/*************************************************************************
+* Copy the parameters of object ob1 to object ob2 (used by the compare
+* tools to list some measurements of ob1 in ob2), with room for all
+* the measurements of ob1 in ob2->meas and ob2->cmp_meas
+* (ob2->nmeas = ob1->nmeas, and the measurements that are not copied
+* are set to zero)
+*************************************************************************/
+int astrom_copy_object_for_cmp(OBJECT *ob2, OBJECT *ob1)
+{
+strcpy(ob2->wds, ob1->wds);
+ob2->nmeas = ob1->nmeas;
+ob2->WR = ob1->WR;
+ob2->WY = ob1->WY;
+
+return(astrom_reserve_measures(ob2, ob1->nmeas));
+}
+/*************************************************************************
+* Copy of the comments in the string pool of the store of an object
+* (to be used for MEASURE.comments)
+*************************************************************************/
+const char *astrom_intern_comments(OBJECT *ob, const char *comments)
+{
+return(((AstromStore *)ob->store)->InternString(comments));
+}
+/*************************************************************************
+* Constructor
+*
+* INPUT:
+* nobj_max: number of objects available with Objects()
+*************************************************************************/
+AstromStore::AstromStore(int nobj_max)
+{
+int i;
+
+last_block_used = 0;
+objects.resize(nobj_max);
+for(i = 0; i < nobj_max; i++) InitObject(&objects[i]);
+}
+/*************************************************************************
+* Destructor
+*************************************************************************/
+AstromStore::~AstromStore()
+{
+int k;
+
+for(k = 0; k < (int)blocks.size(); k++) free(blocks[k]);
+}
+/*************************************************************************
+* Empty object, with room for ASTROM_NMEAS_INIT measurements
+*************************************************************************/
+void AstromStore::InitObject(OBJECT *ob)
+{
+memset(ob, 0, sizeof(OBJECT));
+ob->store = this;
+ReserveMeasures(ob, ASTROM_NMEAS_INIT);
+}
+/*************************************************************************
+* Add a new object at the end of the vector and return its index
+*************************************************************************/
+int AstromStore::AddObject()
+{
+OBJECT ob;
+
+InitObject(&ob);
+objects.push_back(ob);
+
+return((int)objects.size() - 1);
+}
+/*************************************************************************
+* Span of nmeas consecutive measurements (set to zero) in the arena
+* (nmeas is a power of two)
+*************************************************************************/
+MEASURE *AstromStore::NewSpan(int nmeas)
+{
+MEASURE *span;
+int size, k;
+
+/* Span released by another object: */
+for(k = 0; (1 << k) < nmeas; k++);
+if(k < (int)free_spans.size() && !free_spans[k].empty()) {
+  span = free_spans[k].back();
+  free_spans[k].pop_back();
+  memset(span, 0, nmeas * sizeof(MEASURE));
+  return(span);
+  }
+
+if(blocks.empty() || last_block_used + nmeas > block_size.back()) {
+  size = (nmeas > ASTROM_ARENA_BLOCK) ? nmeas : ASTROM_ARENA_BLOCK;
+/* calloc: the pages are only used when the measurements are written */
+  if((span = (MEASURE *)calloc(size, sizeof(MEASURE))) == NULL) {
+    fprintf(stderr, "AstromStore/Fatal error allocating memory for %d measurements\n",
+            size);
+    exit(-1);
+    }
+  blocks.push_back(span);
+  block_size.push_back(size);
+  last_block_used = 0;
+  }
+
+span = blocks.back() + last_block_used;
+last_block_used += nmeas;
+
+return(span);
+}
+/*************************************************************************
+* Release a span of nmeas measurements (nmeas is a power of two)
+*************************************************************************/
+void AstromStore::FreeSpan(MEASURE *span, int nmeas)
+{
+int k;
+
+for(k = 0; (1 << k) < nmeas; k++);
+if(k >= (int)free_spans.size()) free_spans.resize(k + 1);
+free_spans[k].push_back(span);
+}
+/*************************************************************************
+* Room for at least nmeas_min measurements in ob->meas and ob->cmp_meas
+* (the span of the object is moved to a larger span if needed,
+*  so the pointers to its previous measurements are no longer valid)
+*************************************************************************/
+int AstromStore::ReserveMeasures(OBJECT *ob, int nmeas_min)
+{
+MEASURE *span;
+int nalloc;
+
+if(nmeas_min <= ob->nmeas_alloc) return(0);
+
+/* Double the size, to limit the number of copies: */
+nalloc = (ob->nmeas_alloc > 0) ? 2 * ob->nmeas_alloc : 1;
+while(nalloc < nmeas_min) nalloc *= 2;
+
+/* meas[] in the first half and cmp_meas[] in the second half: */
+span = NewSpan(2 * nalloc);
+if(ob->nmeas_alloc > 0) {
+  memcpy(span, ob->meas, ob->nmeas_alloc * sizeof(MEASURE));
+  memcpy(span + nalloc, ob->cmp_meas, ob->nmeas_alloc * sizeof(MEASURE));
+  FreeSpan(ob->meas, 2 * ob->nmeas_alloc);
+  }
+ob->meas = span;
+ob->cmp_meas = span + nalloc;
+ob->nmeas_alloc = nalloc;
+
+return(0);
+}
+/*************************************************************************
+* Copy of a string in the string pool
+* (the address remains valid until the store is deleted)
+*************************************************************************/
+const char *AstromStore::InternString(const char *str)
+{
+if(str == NULL) return(NULL);
+
+return(string_pool.insert(std::string(str)).first->c_str());
+}
+/*************************************************************************
+* Size of the memory allocated for the objects and measurements (bytes)
+*************************************************************************/
+size_t AstromStore::MemoryUsed()
+{
+std::unordered_set<std::string>::iterator it;
+size_t size;
+int k;
+
+size = objects.capacity() * sizeof(OBJECT);
+for(k = 0; k < (int)blocks.size(); k++)
+  size += block_size[k] * sizeof(MEASURE);
+for(it = string_pool.begin(); it != string_pool.end(); it++)
+  size += it->size() + 1;
+
+return(size);
+}
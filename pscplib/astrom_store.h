@@ -0,0 +1,85 @@
+/*************************************************************************
+* "astrom_store.h"
+* Storage of the OBJECT and MEASURE structures (defined in astrom_def.h):
+* - the objects are stored in a vector,
+* - the measurements are stored in an arena, with a span of consecutive
+*   measurements for each object (meas[] and cmp_meas[]), that grows
+*   when new measurements are added (the smaller spans are used again),
+* - the comments are stored only once in a string pool.
+*
+* The routines working on "OBJECT *obj" arrays are used as before with
+* the array returned by astrom_alloc_objects() (instead of malloc()),
+* provided that the measurements are added with astrom_next_measure()
+* or after calling astrom_reserve_measures().
+* There is always room for one measurement in meas[] and cmp_meas[].
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#ifndef _astrom_store_h  /* BOF sentry */
+#define _astrom_store_h
+
+#include "astrom_def.h"
+
+/* Number of measurements in each block of the arena: */
+#define ASTROM_ARENA_BLOCK 4096
+/* Initial room for the measurements of each object: */
+#define ASTROM_NMEAS_INIT 1
+
+#ifdef __cplusplus
+#include <vector>
+#include <string>
+#include <unordered_set>
+
+class AstromStore {
+
+public:
+    AstromStore(int nobj_max);
+    ~AstromStore();
+
+// Adapter for the routines working on OBJECT arrays
+// (valid as long as no object is added with AddObject()):
+    OBJECT *Objects() { return(objects.data()); }
+    int NObjects() { return((int)objects.size()); }
+// Add a new object at the end of the vector and return its index:
+    int AddObject();
+
+// Room for at least nmeas_min measurements in ob->meas and ob->cmp_meas:
+    int ReserveMeasures(OBJECT *ob, int nmeas_min);
+// Copy of a string in the string pool (only one copy for identical strings):
+    const char *InternString(const char *str);
+// Size of the memory allocated for the objects and measurements (bytes):
+    size_t MemoryUsed();
+
+private:
+    void InitObject(OBJECT *ob);
+    MEASURE *NewSpan(int nmeas);
+    void FreeSpan(MEASURE *span, int nmeas);
+
+    std::vector<OBJECT> objects;
+// Arena of measurements (blocks of ASTROM_ARENA_BLOCK measurements,
+// larger blocks for large spans), used from the beginning of the last block:
+    std::vector<MEASURE *> blocks;
+    std::vector<int> block_size;
+    int last_block_used;
+// Spans released when an object has been moved to a larger span
+// (free_spans[k]: spans of 2^k measurements), used again for other objects:
+    std::vector< std::vector<MEASURE *> > free_spans;
+    std::unordered_set<std::string> string_pool;
+};
+
+extern "C" {
+#endif
+
+OBJECT *astrom_alloc_objects(int nobj_max);
+void astrom_free_objects(OBJECT *obj);
+int astrom_reserve_measures(OBJECT *ob, int nmeas_min);
+MEASURE *astrom_next_measure(OBJECT *ob);
+int astrom_copy_object_for_cmp(OBJECT *ob2, OBJECT *ob1);
+const char *astrom_intern_comments(OBJECT *ob, const char *comments);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* EOF sentry */
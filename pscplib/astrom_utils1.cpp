@@ -742,7 +742,7 @@ if(!status) {
               i_obj, nm, NMEAS, filename); 
       exit(-1);
       }
-   me = &(obj[i_obj]).meas[nm];
+   me = astrom_next_measure(&obj[i_obj]);
 
    me->rho = rho; 
 /* Minimum value for rho error: 0.1 pixel or 0.5% */
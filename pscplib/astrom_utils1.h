@@ -13,6 +13,7 @@
 #include <malloc.h>
 #include <string.h>
 #include "astrom_def.h" 
+#include "astrom_store.h"  // astrom_alloc_objects(), astrom_next_measure()
 
 #ifdef __cplusplus
 extern "C" {
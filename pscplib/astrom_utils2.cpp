@@ -12,30 +12,58 @@
 #include "jlp_numeric.h" // JLP_QSORT, MINI, MAXI, PI, etc
 #include "jlp_string.h"    // jlp_trim_string, jlp_compact_string 
 #include "latex_utils.h"  // latex_read_svalue...
+#include "fits_epoch_cache.h"  // FitsEpochCache
+#include <vector>
+#include <string>
+#include <unordered_map>
 
 #include "astrom_utils2.h" // prototypes defined here
 #define DEBUG
 /*
 */
 
+/* FITS file referenced in the astrom file (one per file): */
+typedef struct {
+  char fits_filename[100], full_directory[100], path[300];
+  long long mtime, size;
+  int path_found, cached;
+  FITS_EPOCH ep;
+} ASTROM_FITS_REQUEST;
+
 /*************************************************************************
 * Scan the astrom file and add the epoch read from the header 
 * of FITS autocorrelation files 
 *
+* The names of all the FITS files are collected first, the epochs of the
+* files that are not in the cache (or that were modified) are read
+* (the headers being loaded in parallel), and then all the lines are written
+*
 * INPUT:
 * fits_directory: directory containing the FITS files 
 *                (e.g., /home/data/pisco_merate/2004-2008/ )
+* epoch_cache_fname: name of the cache file with the epochs of the
+*                    FITS files ("" if no cache)
+* nthreads: number of threads used for reading the FITS headers
 *
 **************************************************************************/
 int astrom_add_epoch_from_fits_file(FILE *fp_in, FILE *fp_out, 
-                                    char *fits_directory)
+                                    char *fits_directory,
+                                    char *epoch_cache_fname, int nthreads)
 {
-int iline, is_measurement, epoch_was_found;
-int eyepiece0, eyepiece1;
+int iline, is_measurement, epoch_was_found, ireq, nread;
+int eyepiece1;
 double epoch0;
-char b_in[NMAX], fits_filename[100], *pc, date0[20], date1[20];
+char b_in[NMAX], b_out[NMAX], fits_filename[100], *pc, date1[20];
 char full_directory[100];
-
+std::vector<std::string> lines, prefetch_paths;
+std::vector<int> line_request;
+std::vector<ASTROM_FITS_REQUEST> requests;
+std::unordered_map<std::string, int> index_request;
+std::unordered_map<std::string, int>::iterator it;
+ASTROM_FITS_REQUEST req, *rq;
+FitsEpochCache *cache = NULL;
+
+/* Read all the lines and collect the names of the FITS files: */
 iline = 0;
 while(!feof(fp_in))
 {
@@ -51,6 +79,7 @@ while(!feof(fp_in))
   pc++;
   }
  
+  ireq = -1;
     if(b_in[0] == '&') { 
 /* Check if input LateX line contains a measurement: 
 */
@@ -63,10 +92,67 @@ while(!feof(fp_in))
                   fits_filename, date1, eyepiece1);
 #endif
            merate_get_full_directory(fits_directory, date1, full_directory);
+           it = index_request.find(std::string(full_directory) + fits_filename);
+           if(it != index_request.end()) {
+             ireq = it->second;
+           } else {
+             strcpy(req.fits_filename, fits_filename);
+             strcpy(req.full_directory, full_directory);
+             req.cached = 0;
+             ireq = (int)requests.size();
+             requests.push_back(req);
+             index_request[std::string(full_directory) + fits_filename] = ireq;
+           }
+         } /* EOF is_measurement */
+    }  /* EOF case of not commented line*/
+  lines.push_back(b_in);
+  line_request.push_back(ireq);
+  } /* EOF if fgets() */
+} /* EOF while loop */
+
+/* Epochs of the FITS files that have not been modified since the last run: */
+if(*epoch_cache_fname) {
+  cache = new FitsEpochCache(epoch_cache_fname);
+  cache->Load();
+  }
+for(ireq = 0; ireq < (int)requests.size(); ireq++) {
+  rq = &requests[ireq];
+  rq->path_found = (fits_epoch_find_file(rq->full_directory, rq->fits_filename,
+                                         rq->path, &rq->mtime, &rq->size) == 0);
+  if(rq->path_found && cache != NULL 
+     && cache->Lookup(rq->path, rq->mtime, rq->size, &rq->ep) == 0) 
+     rq->cached = 1;
+  else if(rq->path_found) prefetch_paths.push_back(rq->path);
+  }
 
-/* In "FITS_utils.c" */
-           get_bessel_epoch_from_fits_file(fits_filename, full_directory, 
-                                           &epoch0, date0, &epoch_was_found);
+/* Load the headers of the other files in parallel: */
+fits_prefetch_headers(&prefetch_paths, nthreads);
+
+/* Decode the epochs (in "FITS_utils.c"): */
+nread = 0;
+for(ireq = 0; ireq < (int)requests.size(); ireq++) {
+  rq = &requests[ireq];
+  if(rq->cached) continue;
+  get_bessel_epoch_from_fits_file(rq->fits_filename, rq->full_directory, 
+                                  &rq->ep.epoch, rq->ep.date, &rq->ep.found);
+  if(cache != NULL && rq->path_found) 
+     cache->Store(rq->path, rq->mtime, rq->size, &rq->ep);
+  nread++;
+  }
+printf("astrom_add_epoch_from_fits_file: %d FITS files (%d read, %d from the cache)\n",
+       (int)requests.size(), nread, (int)requests.size() - nread);
+if(cache != NULL) {
+  cache->Save();
+  delete cache;
+  }
+
+/* Add the epochs and copy the lines to the output file: */
+for(iline = 0; iline < (int)lines.size(); iline++) {
+  strcpy(b_in, lines[iline].c_str());
+  if(line_request[iline] >= 0) {
+    rq = &requests[line_request[iline]];
+    epoch_was_found = rq->ep.found;
+    epoch0 = rq->ep.epoch;
  printf("astrom_add_epoch_from_fits_file: epoch_was_found=%d (bessel epoch0=%f)\n", epoch_was_found, epoch0);
            if(epoch_was_found) { 
 /* Remove "\\" (EOF line for Latex tables) if present: */
@@ -77,15 +163,14 @@ while(!feof(fp_in))
             }
             *pc = '\0';
 /* Add epoch to truncated line: */
-            sprintf(b_in, "%s EP=%.4f \\\\\n", b_in, epoch0);
+            sprintf(b_out, "%s EP=%.4f \\\\\n", b_in, epoch0);
+            strcpy(b_in, b_out);
             }
-         } /* EOF is_measurement */
-    }  /* EOF case of not commented line*/
+    }
 
 // Copy current line to file:
         fputs(b_in, fp_out);
-  } /* EOF if fgets() */
-} /* EOF while loop */
+} /* EOF loop on lines */
 
 return(0);
 }
@@ -408,13 +493,7 @@ OBJECT *obj;
 int *index_obj, tabular_only, with_wds_data;
 int i, nobj = 0;
 
-if((obj = (OBJECT *)malloc(NOBJ_MAX * sizeof(OBJECT))) == NULL) {
-  printf("astrom_calib_publi/Fatal error allocating memory space for OBJECT: nobj_max=%d\n", 
-          NOBJ_MAX);
-  exit(-1);
-  }
-// Initialize the number of measurements to zero
-for(i = 0; i < NOBJ_MAX; i++) (obj[i]).nmeas = 0;
+obj = astrom_alloc_objects(NOBJ_MAX);
 
 if((index_obj = (int *)malloc((NOBJ_MAX) * sizeof(int))) == NULL) {
   printf("astrom_calib_publi/Fatal error allocating memory space for index_obj: nobj_max=%d\n", 
@@ -462,7 +541,7 @@ tabular_only = 0;
 astrom_compute_statistics(fp_out, obj, nobj, filein);
 
 free(index_obj);
-free(obj);
+astrom_free_objects(obj);
 return(0);
 }
 /*****************************************************************************
@@ -10,12 +10,17 @@
 
 #include "astrom_utils1.h"
 
+/* Default name of the cache file with the epochs of the FITS files
+* (used by astrom_add_epoch_from_fits_file): */
+#define ASTROM_EPOCH_CACHE_DEFAULT "fits_epoch_cache.txt"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 int astrom_add_epoch_from_fits_file(FILE *fp_in, FILE *fp_out, 
-                                    char *fits_directory);
+                                    char *fits_directory,
+                                    char *epoch_cache_fname, int nthreads);
 int astrom_check_if_measurement(char *b_in, char *fits_filename, char *date1,  
                                 int *eyepiece1, int *is_measurement);
 int astrom_calib_publi(FILE *fp_in, FILE *fp_out, 
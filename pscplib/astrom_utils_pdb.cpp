@@ -13,6 +13,7 @@
 #include "jlp_numeric.h" // JLP_QSORT, MINI, MAXI, PI, etc
 #include "jlp_string.h"
 #include "latex_utils.h"  // latex_read_svalue...
+#include "crossref_table.h" // CrossRefTable (loaded only once)
 
 #include "astrom_utils_pdb.h"
 /*
@@ -427,10 +428,11 @@ int get_discov_from_ads_wds_crossref(char *ADS_WDS_cross, char *ads_name1,
                                      char *discov_name1, char *comp_name1,
                                      char *wds_name1)
 {
-char buffer[256], ads_name0[256], discov_name0[256], comp_name0[256], *pc;
+char buffer[256], discov_name0[256], comp_name0[256], *pc;
 char wds_name0[256], in_comp_name1[256];
-int iline, ival, ads_nber0, ads_nber1, status = -1;
-FILE *fp_in;
+int i, ival, ads_nber1, status = -1;
+const std::vector<int> *rows;
+CrossRefTable *ADS_WDS_cat;
 
 // Decode input ads name:
 
@@ -463,52 +465,42 @@ FILE *fp_in;
   jlp_trim_string(in_comp_name1, 256);
   if(!strcmp(in_comp_name1, "ab")) strcpy(in_comp_name1, "AB");
 
-if((fp_in = fopen(ADS_WDS_cross, "r")) == NULL) {
+/* Load the cross-reference file (only once): */
+if((ADS_WDS_cat = CrossRefTable_get_cached(ADS_WDS_cross, 
+                                           CROSSREF_ADS_WDS)) == NULL) {
   fprintf(stderr, "read_ads_wds_cross_reference/error opening %s\n",
           ADS_WDS_cross); 
   return(-1);
   }
 
-iline = 0;
-while(!feof(fp_in))
-{
-/* Maximum length for a line will be 256 characters: */
-  if(fgets(buffer, 256, fp_in))
-  {
-  iline++;
-  buffer[255] = '\0';
-  if(buffer[0] != '%') {
-// ads_name0 from '    1' to '17180'
-    strcpy(ads_name0, &buffer[10]);
-    ads_name0[5] ='\0';
-    sscanf(ads_name0, "%d", &ads_nber0); 
+/* Lines with this ADS number (in the order of the file): */
+sprintf(buffer, "%d", ads_nber1);
+rows = ADS_WDS_cat->Find(CROSSREF_IDX_ADS_NUMBER, buffer);
+if(rows == NULL) return(-1);
+
+for(i = 0; i < (int)rows->size(); i++) {
+  strcpy(buffer, ADS_WDS_cat->Line((*rows)[i]));
 // 7 characters: 'J   858' or  'HDS3301' for instance
-    strcpy(discov_name0, &buffer[20]);
-    discov_name0[7] ='\0';
+  strcpy(discov_name0, &buffer[20]);
+  discov_name0[7] ='\0';
 // 4 characters maximum: A-BC, AB-C or AB-D...
-    strcpy(comp_name0, &buffer[29]);
-    comp_name0[4] ='\0';
+  strcpy(comp_name0, &buffer[29]);
+  comp_name0[4] ='\0';
 // Remove first and trailing blanks:
-    jlp_trim_string(comp_name0, 256);
-    strcpy(wds_name0, &buffer[38]);
+  jlp_trim_string(comp_name0, 256);
+  strcpy(wds_name0, &buffer[38]);
 // -----     16949     STI1200                      {1}
-    if(wds_name0[0] == ' ') wds_name0[0] = '\0';
-    if(ads_nber1 == ads_nber0) {
-      if(!strcmp(comp_name0, in_comp_name1)
-         || (!strcmp(in_comp_name1, "AB") && (comp_name0[0] == '\0')) 
-         || (!strcmp(comp_name0, "AB") && (in_comp_name1[0] == '\0'))) {
-        status = 0;
-        strcpy(discov_name1, discov_name0);
-        strcpy(comp_name1, in_comp_name1);
-        strcpy(wds_name1, wds_name0);
-        break;
-        }
-      }
-    } 
-  } /* EOF if fgets() */
-} /* EOF while loop */
-
-fclose(fp_in);
+  if(wds_name0[0] == ' ') wds_name0[0] = '\0';
+  if(!strcmp(comp_name0, in_comp_name1)
+     || (!strcmp(in_comp_name1, "AB") && (comp_name0[0] == '\0')) 
+     || (!strcmp(comp_name0, "AB") && (in_comp_name1[0] == '\0'))) {
+    status = 0;
+    strcpy(discov_name1, discov_name0);
+    strcpy(comp_name1, in_comp_name1);
+    strcpy(wds_name1, wds_name0);
+    break;
+    }
+} /* EOF loop on rows */
 
 return(status);
 }
@@ -526,9 +518,9 @@ return(status);
 int get_ads_from_ads_wds_crossref(char *ADS_WDS_cross, char *discov_name1,
                                   char *ads_name1)
 {
-char buffer[256], discov_name0[256], in_discov_name1[256], *pc;
-int iline, ival, ads_nber0, status = -1;
-FILE *fp_in;
+char in_discov_name1[256], *pc;
+int irow, ads_nber0, status = -1;
+CrossRefTable *ADS_WDS_cat;
 
 strcpy(in_discov_name1, discov_name1);
 // Compact input name (i.e., 'BGH   1' becomes 'BGH1') 
@@ -546,51 +538,25 @@ printf("DEBUG: searching for discov_name=%s< (or >%s<) in ads_wds_crossref \n",
        discov_name1, in_discov_name1);
 */
 
-if((fp_in = fopen(ADS_WDS_cross, "r")) == NULL) {
+/* Load the cross-reference file (only once): */
+if((ADS_WDS_cat = CrossRefTable_get_cached(ADS_WDS_cross, 
+                                           CROSSREF_ADS_WDS)) == NULL) {
   fprintf(stderr, "read_ads_wds_cross_reference/error opening %s\n",
           ADS_WDS_cross); 
   return(-1);
   }
 
-iline = 0;
-while(!feof(fp_in))
-{
-/* Maximum length for a line will be 256 characters: */
-  if(fgets(buffer, 256, fp_in))
-  {
-  iline++;
-  buffer[255] = '\0';
-  if(buffer[0] != '%') {
+// First line with this discoverer's name (and with an ADS number):
+irow = ADS_WDS_cat->FindFirst(CROSSREF_IDX_DISCOV, in_discov_name1);
+if(irow >= 0) {
 // ads_name0 from '    1' to '17180'
-    ival = sscanf(&buffer[10], "%d", &ads_nber0);
-    if(ival == 1) {
-// 7 characters: 'J   858' or  'HDS3301' for instance
-      strcpy(discov_name0, &buffer[20]);
-      discov_name0[7] ='\0';
-// Compact input name (i.e., 'BGH   1' becomes 'BGH1') 
-// First remove first and trailing blanks:
-      jlp_trim_string(discov_name0, 256);
-// Then remove remaining blanks in the middle:
-      pc = discov_name0;
-      while(*pc && isalpha(*pc)) pc++;
-      while(*pc && (*pc == ' ')) pc++;
-      while(*pc && isdigit(*pc)) pc++;
-
-// -----     16949     STI1200                      {1}
-      if(!strcmp(in_discov_name1, discov_name0)) {
+  sscanf(&(ADS_WDS_cat->Line(irow))[10], "%d", &ads_nber0);
 /* DEBUG
-printf("DEBUG: discov_name=%d found in ads catalog\n", discov_name0);
+printf("DEBUG: discov_name=%s found in ads catalog\n", in_discov_name1);
 */
-        status = 0;
-        sprintf(ads_name1, "ADS %d", ads_nber0);
-        break;
-        }
-      } // EOF if ival == 1
-    } // EOF buffer[0] != '%'
-  } /* EOF if fgets() */
-} /* EOF while loop */
-
-fclose(fp_in);
+  status = 0;
+  sprintf(ads_name1, "ADS %d", ads_nber0);
+  }
 
 return(status);
 }
@@ -0,0 +1,668 @@
+/************************************************************************
+* "calib_bintab.cpp"
+* Binary version of the calibrated tables of measurements
+* (with or without the O-C residuals)
+*
+* The rows are converted from/to LaTeX only once: at the beginning of
+* the chain (LoadFromLatexFile) and for the publication (WriteLatexFile),
+* the intermediate programs exchanging the binary files.
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>        // fstat()
+#include <ctype.h>           // isdigit()
+#include <stddef.h>          // offsetof()
+#include <time.h>            // ctime()
+#include "calib_bintab.h"
+#include "catalog_snapshot.h" // snapshot_checksum()
+#include "latex_row.h"       // LatexRow
+#include "astrom_def.h"      // NO_DATA
+#include "jlp_string.h"      // jlp_cleanup_string(), jlp_trim_string()
+
+/*
+#define DEBUG
+*/
+
+#define CALIB_TYPE_DOUBLE 1
+#define CALIB_TYPE_INT    2
+#define CALIB_TYPE_STRING 3
+
+/* Columns of the binary file (same order as CALIB_COL_xxx): */
+typedef struct {
+  int offset, width, type;
+} CALIB_COLUMN_DEF;
+
+#define DCOL(f) { (int)offsetof(CALIB_ROW, f), (int)sizeof(double), \
+                  CALIB_TYPE_DOUBLE }
+#define ICOL(f) { (int)offsetof(CALIB_ROW, f), (int)sizeof(int), \
+                  CALIB_TYPE_INT }
+#define SCOL(f) { (int)offsetof(CALIB_ROW, f), \
+                  (int)sizeof(((CALIB_ROW *)0)->f), CALIB_TYPE_STRING }
+
+static const CALIB_COLUMN_DEF calib_cols[CALIB_NCOLS] = {
+  DCOL(epoch), DCOL(rho), DCOL(drho), DCOL(theta), DCOL(dtheta),
+  DCOL(dmag), DCOL(rho_o_c), DCOL(theta_o_c),
+  ICOL(eyepiece), ICOL(quadrant_flag), ICOL(quadrant_discrep),
+  ICOL(orbit_grade), ICOL(idem_names),
+  SCOL(wds), SCOL(discov), SCOL(ads), SCOL(filter), SCOL(notes),
+  SCOL(orbit_ref), SCOL(decimals)
+};
+
+/* Column numbers in the LaTeX tables (-1 if absent): */
+typedef struct {
+  int iwds, idiscov, iads, iepoch, ifilter, ieyepiece, irho, idrho;
+  int itheta, idtheta, idmag, inotes, iorbit_ref, irho_o_c, itheta_o_c;
+  int igrade, ncols;
+} CALIB_LAYOUT;
+
+static int calib_get_layout(int calib_format, CALIB_LAYOUT *lay);
+
+/*************************************************************************
+* Constructor of an empty table
+*
+* INPUT:
+* calib_format0: CALIB_FMT_GILI, CALIB_FMT_CALERN or CALIB_FMT_ADS
+*                (layout of the LaTeX tables)
+*************************************************************************/
+CalibBinTable::CalibBinTable(int calib_format0)
+{
+calib_format = calib_format0;
+nrows = 0;
+columns.resize(CALIB_NCOLS);
+}
+/*************************************************************************
+* Add a row at the end of the table
+*************************************************************************/
+int CalibBinTable::AddRow(CALIB_ROW *row)
+{
+const char *pc;
+int icol;
+
+for(icol = 0; icol < CALIB_NCOLS; icol++) {
+  pc = (const char *)row + calib_cols[icol].offset;
+  columns[icol].insert(columns[icol].end(), pc, pc + calib_cols[icol].width);
+  if(calib_cols[icol].type == CALIB_TYPE_STRING)
+     columns[icol].back() = '\0';
+  }
+nrows++;
+
+return(0);
+}
+/*************************************************************************
+* Copy the row #irow (from 0 to nrows-1) of the table
+*************************************************************************/
+int CalibBinTable::GetRow(int irow, CALIB_ROW *row)
+{
+int icol, width;
+
+if(irow < 0 || irow >= nrows) return(-1);
+
+for(icol = 0; icol < CALIB_NCOLS; icol++) {
+  width = calib_cols[icol].width;
+  memcpy((char *)row + calib_cols[icol].offset,
+         &columns[icol][(size_t)irow * width], width);
+  }
+
+return(0);
+}
+/*************************************************************************
+* Values of a column (nrows values), NULL if not a double precision column
+*************************************************************************/
+const double *CalibBinTable::DoubleColumn(int icol)
+{
+if(icol < 0 || icol >= CALIB_NCOLS
+   || calib_cols[icol].type != CALIB_TYPE_DOUBLE || nrows == 0) return(NULL);
+
+return((const double *)&columns[icol][0]);
+}
+/*************************************************************************
+* Values of a column (nrows values), NULL if not an integer column
+*************************************************************************/
+const int *CalibBinTable::IntColumn(int icol)
+{
+if(icol < 0 || icol >= CALIB_NCOLS
+   || calib_cols[icol].type != CALIB_TYPE_INT || nrows == 0) return(NULL);
+
+return((const int *)&columns[icol][0]);
+}
+/*************************************************************************
+* Write the table to a binary file
+*************************************************************************/
+int CalibBinTable::WriteToFile(char *bin_fname)
+{
+CALIB_BINTAB_HEADER header;
+std::vector<char> data;
+int icol;
+FILE *fp_out;
+
+for(icol = 0; icol < CALIB_NCOLS; icol++)
+  data.insert(data.end(), columns[icol].begin(), columns[icol].end());
+
+memset(&header, 0, sizeof(CALIB_BINTAB_HEADER));
+memcpy(header.magic, CALIB_BINTAB_MAGIC, 8);
+header.version = CALIB_BINTAB_VERSION;
+header.byte_order = CALIB_BINTAB_BYTE_ORDER;
+header.calib_format = calib_format;
+header.ncols = CALIB_NCOLS;
+header.nrows = nrows;
+header.checksum = snapshot_checksum(data.empty() ? "" : &data[0], data.size());
+
+if((fp_out = fopen(bin_fname, "wb")) == NULL) {
+  fprintf(stderr, "CalibBinTable/Error opening output file %s\n", bin_fname);
+  return(-1);
+  }
+
+if(fwrite(&header, sizeof(CALIB_BINTAB_HEADER), 1, fp_out) != 1
+   || (!data.empty() && fwrite(&data[0], data.size(), 1, fp_out) != 1)) {
+  fprintf(stderr, "CalibBinTable/Error writing %s\n", bin_fname);
+  fclose(fp_out);
+  return(-1);
+  }
+
+fclose(fp_out);
+return(0);
+}
+/*************************************************************************
+* Load the table from a binary file (written by WriteToFile)
+*************************************************************************/
+int CalibBinTable::LoadFromFile(char *bin_fname)
+{
+CALIB_BINTAB_HEADER header;
+std::vector<char> data;
+size_t length, pos, row_width;
+struct stat st;
+int icol;
+FILE *fp_in;
+
+if((fp_in = fopen(bin_fname, "rb")) == NULL) {
+  fprintf(stderr, "CalibBinTable/Error opening input file %s\n", bin_fname);
+  return(-1);
+  }
+
+if(fread(&header, sizeof(CALIB_BINTAB_HEADER), 1, fp_in) != 1
+   || memcmp(header.magic, CALIB_BINTAB_MAGIC, 8)
+   || header.version != CALIB_BINTAB_VERSION
+   || header.byte_order != CALIB_BINTAB_BYTE_ORDER
+   || header.ncols != CALIB_NCOLS) {
+  fprintf(stderr, "CalibBinTable/Error: %s is not a valid binary table\n",
+          bin_fname);
+  fclose(fp_in);
+  return(-1);
+  }
+
+if(header.calib_format != CALIB_FMT_GILI
+   && header.calib_format != CALIB_FMT_CALERN
+   && header.calib_format != CALIB_FMT_ADS) {
+  fprintf(stderr, "CalibBinTable/Error: unknown format %u in %s\n",
+          header.calib_format, bin_fname);
+  fclose(fp_in);
+  return(-1);
+  }
+
+/* The number of rows should correspond to the size of the file: */
+row_width = 0;
+for(icol = 0; icol < CALIB_NCOLS; icol++) row_width += calib_cols[icol].width;
+length = 0;
+if(fstat(fileno(fp_in), &st) == 0
+   && (size_t)st.st_size >= sizeof(CALIB_BINTAB_HEADER))
+  length = (size_t)st.st_size - sizeof(CALIB_BINTAB_HEADER);
+if(length % row_width != 0 || header.nrows != length / row_width) {
+  fprintf(stderr, "CalibBinTable/Error: the size of %s does not match %llu rows (truncated file?)\n",
+          bin_fname, (unsigned long long)header.nrows);
+  fclose(fp_in);
+  return(-1);
+  }
+
+data.resize(length);
+if(length > 0 && fread(&data[0], length, 1, fp_in) != 1) {
+  fprintf(stderr, "CalibBinTable/Error reading %s (truncated file?)\n",
+          bin_fname);
+  fclose(fp_in);
+  return(-1);
+  }
+fclose(fp_in);
+
+if(snapshot_checksum(data.empty() ? "" : &data[0], length)
+   != header.checksum) {
+  fprintf(stderr, "CalibBinTable/Error: bad checksum in %s\n", bin_fname);
+  return(-1);
+  }
+
+calib_format = header.calib_format;
+nrows = (int)header.nrows;
+pos = 0;
+for(icol = 0; icol < CALIB_NCOLS; icol++) {
+  length = (size_t)nrows * calib_cols[icol].width;
+  columns[icol].assign(data.begin() + pos, data.begin() + pos + length);
+  pos += length;
+  }
+
+#ifdef DEBUG
+printf("CalibBinTable: %d rows loaded from %s\n", nrows, bin_fname);
+#endif
+
+return(0);
+}
+/*************************************************************************
+* Read all the lines with measurements (starting with a digit or with
+* \idem) of a LaTeX table (with the layout of calib_format)
+*************************************************************************/
+int CalibBinTable::LoadFromLatexFile(char *latex_fname)
+{
+char in_line[512];
+CALIB_ROW row, previous_row;
+FILE *fp_in;
+
+if((fp_in = fopen(latex_fname, "r")) == NULL) {
+  fprintf(stderr, "CalibBinTable/Error opening input file %s\n", latex_fname);
+  return(-1);
+  }
+
+calib_row_init(&previous_row);
+while(fgets(in_line, 512, fp_in)) {
+  if(isdigit(in_line[0]) || !strncmp(in_line, "\\idem", 5)) {
+    jlp_cleanup_string(in_line, 512);
+    if(calib_row_from_latex(in_line, &row, calib_format, &previous_row) == 0) {
+      AddRow(&row);
+      previous_row = row;
+      }
+    }
+  }
+
+fclose(fp_in);
+return(0);
+}
+/*************************************************************************
+* Write the rows as a LaTeX table, nlines_per_page rows between
+* \jlpBeginTable and \jlpEndTable
+* (with \idem for the names as in the input LaTeX table, and for
+* the other orbits of a measurement as in merge_calib_resid)
+*
+* INPUT:
+* out_calib_format: layout of the LaTeX table (CALIB_FMT_GILI, ...),
+*                   which may differ from the layout of the input table
+*************************************************************************/
+int CalibBinTable::WriteLatexFile(char *latex_fname, int out_calib_format,
+                                  int nlines_per_page)
+{
+char out_line[1024];
+CALIB_ROW row, previous_row;
+int irow;
+time_t t = time(NULL);
+FILE *fp_out;
+
+if((fp_out = fopen(latex_fname, "w")) == NULL) {
+  fprintf(stderr, "CalibBinTable/Error opening output file %s\n", latex_fname);
+  return(-1);
+  }
+
+fprintf(fp_out, "%% LaTeX table generated from a binary table (%d rows)\n\
+%% Created on %s", nrows, ctime(&t));
+fprintf(fp_out, "\\def\\idem{''} \n");
+fprintf(fp_out, "\\jlpBeginTable0 \n");
+for(irow = 0; irow < nrows; irow++) {
+  if((irow > 0) && (nlines_per_page > 0) && (irow % nlines_per_page == 0))
+    fprintf(fp_out, "\\jlpEndTable \n\\jlpBeginTable \n");
+  GetRow(irow, &row);
+  calib_row_to_latex(&row, out_line, out_calib_format,
+                     (irow > 0) ? &previous_row : NULL);
+  fprintf(fp_out, "%s\n", out_line);
+  previous_row = row;
+  }
+fprintf(fp_out, "\\jlpEndTableE \n");
+
+fclose(fp_out);
+return(0);
+}
+/*************************************************************************
+* Return 1 if the file is a binary table written by CalibBinTable,
+* 0 otherwise
+*************************************************************************/
+int calib_bintab_is_binary(char *fname)
+{
+char magic[8];
+int is_binary = 0;
+FILE *fp_in;
+
+if((fp_in = fopen(fname, "rb")) == NULL) return(0);
+if(fread(magic, 8, 1, fp_in) == 1
+   && !memcmp(magic, CALIB_BINTAB_MAGIC, 8)) is_binary = 1;
+fclose(fp_in);
+
+return(is_binary);
+}
+/*************************************************************************
+* Empty row (no data)
+*************************************************************************/
+void calib_row_init(CALIB_ROW *row)
+{
+memset(row, 0, sizeof(CALIB_ROW));
+row->epoch = NO_DATA;
+row->rho = NO_DATA;
+row->drho = NO_DATA;
+row->theta = NO_DATA;
+row->dtheta = NO_DATA;
+row->dmag = NO_DATA;
+row->rho_o_c = NO_DATA;
+row->theta_o_c = NO_DATA;
+row->orbit_grade = -1;
+strcpy(row->decimals, CALIB_DEFAULT_DECIMALS);
+}
+/*************************************************************************
+* Column numbers of the LaTeX tables
+*************************************************************************/
+static int calib_get_layout(int calib_format, CALIB_LAYOUT *lay)
+{
+/* WDS & discov & epoch & nbin & rho & drho & theta & dtheta & dm & notes
+* & orbit_ref & rho_o_c & theta_o_c & grade */
+static const CALIB_LAYOUT gili = {1, 2, -1, 3, -1, 4, 5, 6, 7, 8, 9, 10,
+                                  11, 12, 13, 14, 14};
+/* WDS & discov & epoch & filter & eyepiece & rho & drho & theta & dtheta
+* & notes & orbit_ref & rho_o_c & theta_o_c & grade */
+static const CALIB_LAYOUT calern = {1, 2, -1, 3, 4, 5, 6, 7, 8, 9, -1, 10,
+                                    11, 12, 13, 14, 14};
+/* WDS & discov & ADS & epoch & rho & drho & theta & dtheta & dm & eyepiece
+* & notes & orbit_ref & rho_o_c & theta_o_c */
+static const CALIB_LAYOUT ads = {1, 2, 3, 4, -1, 10, 5, 6, 7, 8, 9, 11,
+                                 12, 13, 14, -1, 14};
+
+switch(calib_format) {
+  case CALIB_FMT_GILI:
+    *lay = gili;
+    break;
+  case CALIB_FMT_CALERN:
+    *lay = calern;
+    break;
+  case CALIB_FMT_ADS:
+    *lay = ads;
+    break;
+  default:
+    fprintf(stderr, "calib_get_layout/Error: unknown format %d\n",
+            calib_format);
+    return(-1);
+  }
+
+return(0);
+}
+/*************************************************************************
+* String value of a column (empty if absent or "\nodata")
+*************************************************************************/
+static void calib_get_string(LatexRow *lrow, int icol, char *value,
+                             int length)
+{
+char buffer[512];
+
+value[0] = '\0';
+if(icol <= 0 || lrow->GetString(icol, buffer) != 0) return;
+jlp_trim_string(buffer, 512);
+strncpy(value, buffer, length - 1);
+value[length - 1] = '\0';
+}
+/*************************************************************************
+* Numerical value of a column ("$-$" is accepted for the negative values)
+* (NO_DATA if absent or "\nodata")
+*
+* OUTPUT:
+* item: content of the column
+* ndec: number of decimals of the value (digit '0' to '9'),
+*       unchanged if no value (or if ndec is NULL)
+*************************************************************************/
+static double calib_get_double(LatexRow *lrow, int icol, char *item,
+                               char *ndec)
+{
+char buffer[512], *pc, *pc1;
+double value;
+int nd;
+
+item[0] = '\0';
+if(icol <= 0 || lrow->GetString(icol, item) != 0) return(NO_DATA);
+
+pc1 = buffer;
+for(pc = item; *pc; pc++) if(*pc != '$') *(pc1++) = *pc;
+*pc1 = '\0';
+if(sscanf(buffer, "%lf", &value) != 1) return(NO_DATA);
+
+if(ndec != NULL) {
+  nd = 0;
+  if((pc = strchr(buffer, '.')) != NULL)
+    while(isdigit(pc[nd + 1]) && nd < 9) nd++;
+  *ndec = '0' + nd;
+  }
+
+return(value);
+}
+/*************************************************************************
+* Return 1 if the column is "\idem" (same value as in the previous line)
+*************************************************************************/
+static int calib_is_idem(LatexRow *lrow, int icol)
+{
+char buffer[512];
+
+if(icol <= 0 || lrow->GetString(icol, buffer) != 0) return(0);
+
+return(strstr(buffer, "\\idem") != NULL);
+}
+/*************************************************************************
+* Decode a line of a LaTeX calibrated table
+*
+* INPUT:
+* in_line: line of the table (starting with the WDS name or with \idem)
+* calib_format: CALIB_FMT_GILI, CALIB_FMT_CALERN or CALIB_FMT_ADS
+* previous_row: values of the previous line, used for the columns
+*               with \idem (NULL if not available)
+*
+* OUTPUT:
+* row: values of the line (NO_DATA if not available)
+*
+* RETURN: 0 if OK, -1 if the epoch could not be read
+*************************************************************************/
+int calib_row_from_latex(char *in_line, CALIB_ROW *row, int calib_format,
+                         CALIB_ROW *previous_row)
+{
+CALIB_LAYOUT lay;
+LatexRow lrow(in_line);
+char item[512], *dec;
+double value;
+
+calib_row_init(row);
+if(calib_get_layout(calib_format, &lay) != 0) return(-1);
+
+calib_get_string(&lrow, lay.iwds, row->wds, 16);
+calib_get_string(&lrow, lay.idiscov, row->discov, 40);
+calib_get_string(&lrow, lay.iads, row->ads, 16);
+calib_get_string(&lrow, lay.ifilter, row->filter, 8);
+calib_get_string(&lrow, lay.inotes, row->notes, 80);
+calib_get_string(&lrow, lay.iorbit_ref, row->orbit_ref, 64);
+
+dec = row->decimals;
+row->epoch = calib_get_double(&lrow, lay.iepoch, item, &dec[CALIB_DEC_EPOCH]);
+row->rho = calib_get_double(&lrow, lay.irho, item, &dec[CALIB_DEC_RHO]);
+row->drho = calib_get_double(&lrow, lay.idrho, item, &dec[CALIB_DEC_DRHO]);
+row->theta = calib_get_double(&lrow, lay.itheta, item, &dec[CALIB_DEC_THETA]);
+if(strstr(item, "^*") != NULL) row->quadrant_flag = 1;
+row->dtheta = calib_get_double(&lrow, lay.idtheta, item,
+                               &dec[CALIB_DEC_DTHETA]);
+row->dmag = calib_get_double(&lrow, lay.idmag, item, &dec[CALIB_DEC_DMAG]);
+row->rho_o_c = calib_get_double(&lrow, lay.irho_o_c, item,
+                                &dec[CALIB_DEC_RHO_O_C]);
+row->theta_o_c = calib_get_double(&lrow, lay.itheta_o_c, item,
+                                  &dec[CALIB_DEC_THETA_O_C]);
+if(strstr(item, "^Q") != NULL) row->quadrant_discrep = 1;
+value = calib_get_double(&lrow, lay.ieyepiece, item, NULL);
+if(value != NO_DATA) row->eyepiece = (int)(value + 0.5);
+value = calib_get_double(&lrow, lay.igrade, item, NULL);
+if(value != NO_DATA) row->orbit_grade = (int)(value + 0.5);
+
+/* Columns with \idem: same values as in the previous line
+* (the orbit and the residuals are never given with \idem) */
+row->idem_names = calib_is_idem(&lrow, lay.iwds);
+if(previous_row != NULL) {
+  if(calib_is_idem(&lrow, lay.iwds)) strcpy(row->wds, previous_row->wds);
+  if(calib_is_idem(&lrow, lay.idiscov))
+    strcpy(row->discov, previous_row->discov);
+  if(calib_is_idem(&lrow, lay.iads)) strcpy(row->ads, previous_row->ads);
+  if(calib_is_idem(&lrow, lay.ifilter))
+    strcpy(row->filter, previous_row->filter);
+  if(calib_is_idem(&lrow, lay.iepoch)) {
+    row->epoch = previous_row->epoch;
+    dec[CALIB_DEC_EPOCH] = previous_row->decimals[CALIB_DEC_EPOCH];
+    }
+  if(calib_is_idem(&lrow, lay.ieyepiece))
+    row->eyepiece = previous_row->eyepiece;
+  if(calib_is_idem(&lrow, lay.irho)) {
+    row->rho = previous_row->rho;
+    row->drho = previous_row->drho;
+    row->theta = previous_row->theta;
+    row->dtheta = previous_row->dtheta;
+    row->quadrant_flag = previous_row->quadrant_flag;
+    strncpy(dec + CALIB_DEC_RHO, previous_row->decimals + CALIB_DEC_RHO, 4);
+    }
+  if(calib_is_idem(&lrow, lay.idmag)) {
+    row->dmag = previous_row->dmag;
+    dec[CALIB_DEC_DMAG] = previous_row->decimals[CALIB_DEC_DMAG];
+    }
+  if(calib_is_idem(&lrow, lay.inotes)
+     || (calib_is_idem(&lrow, lay.irho) && row->notes[0] == '\0'))
+    strcpy(row->notes, previous_row->notes);
+  }
+
+if(row->epoch == NO_DATA) return(-1);
+
+return(0);
+}
+/*************************************************************************
+* Signed value with "$-$" (LaTeX) or "-" for the negative values
+*************************************************************************/
+static void calib_signed_value(double value, char ndec, int latex_signs,
+                               char *out)
+{
+if(value < 0.)
+  sprintf(out, "%s%.*f", latex_signs ? "$-$" : "-", ndec - '0', -value);
+else
+  sprintf(out, "%.*f", ndec - '0', value);
+}
+/*************************************************************************
+* Values of a row, formatted as the columns of a LaTeX calibrated table
+* (with the number of decimals of the input table)
+*
+* INPUT:
+* row: values of the line
+* calib_format: CALIB_FMT_GILI, CALIB_FMT_CALERN or CALIB_FMT_ADS
+* latex_signs: 1 if "$-$" for the negative residuals, 0 if "-"
+*
+* OUTPUT:
+* columns: columns[icol-1] for icol = 1 to ncols
+* ncols: number of columns
+*************************************************************************/
+int calib_row_to_columns(CALIB_ROW *row, char columns[][80], int *ncols,
+                         int calib_format, int latex_signs)
+{
+CALIB_LAYOUT lay;
+char *dec;
+int icol;
+
+*ncols = 0;
+if(calib_get_layout(calib_format, &lay) != 0) return(-1);
+
+*ncols = lay.ncols;
+for(icol = 0; icol < lay.ncols; icol++) columns[icol][0] = '\0';
+
+strcpy(columns[lay.iwds - 1], row->wds);
+strcpy(columns[lay.idiscov - 1], row->discov);
+if(lay.iads > 0) strcpy(columns[lay.iads - 1], row->ads);
+if(lay.ifilter > 0) strcpy(columns[lay.ifilter - 1], row->filter);
+dec = row->decimals;
+sprintf(columns[lay.iepoch - 1], "%.*f", dec[CALIB_DEC_EPOCH] - '0',
+        row->epoch);
+sprintf(columns[lay.ieyepiece - 1], "%d", row->eyepiece);
+if(row->rho != NO_DATA) {
+  sprintf(columns[lay.irho - 1], "%.*f", dec[CALIB_DEC_RHO] - '0', row->rho);
+  sprintf(columns[lay.idrho - 1], "%.*f", dec[CALIB_DEC_DRHO] - '0',
+          row->drho);
+  sprintf(columns[lay.itheta - 1], "%.*f%s", dec[CALIB_DEC_THETA] - '0',
+          row->theta, row->quadrant_flag ? "\\rlap{$^*$}" : "");
+  sprintf(columns[lay.idtheta - 1], "%.*f", dec[CALIB_DEC_DTHETA] - '0',
+          row->dtheta);
+  } else {
+  strcpy(columns[lay.irho - 1], "\\nodata");
+  strcpy(columns[lay.idrho - 1], "\\nodata");
+  strcpy(columns[lay.itheta - 1], "\\nodata");
+  strcpy(columns[lay.idtheta - 1], "\\nodata");
+  }
+if(lay.idmag > 0 && row->dmag != NO_DATA)
+  sprintf(columns[lay.idmag - 1], "%.*f", dec[CALIB_DEC_DMAG] - '0',
+          row->dmag);
+strcpy(columns[lay.inotes - 1], row->notes);
+strcpy(columns[lay.iorbit_ref - 1], row->orbit_ref);
+if(row->rho_o_c != NO_DATA)
+  calib_signed_value(row->rho_o_c, dec[CALIB_DEC_RHO_O_C], latex_signs,
+                     columns[lay.irho_o_c - 1]);
+if(row->theta_o_c != NO_DATA) {
+  calib_signed_value(row->theta_o_c, dec[CALIB_DEC_THETA_O_C], latex_signs,
+                     columns[lay.itheta_o_c - 1]);
+  if(row->quadrant_discrep) strcat(columns[lay.itheta_o_c - 1],
+                                   "\\rlap{$^Q$}");
+  }
+if(lay.igrade > 0 && row->orbit_grade >= 0)
+  sprintf(columns[lay.igrade - 1], "%d", row->orbit_grade);
+
+return(0);
+}
+/*************************************************************************
+* Return 1 if the two rows are the same measurement (with another orbit)
+*************************************************************************/
+static int calib_same_measurement(CALIB_ROW *row1, CALIB_ROW *row2)
+{
+return(!strcmp(row1->wds, row2->wds) && !strcmp(row1->discov, row2->discov)
+       && !strcmp(row1->ads, row2->ads) && !strcmp(row1->filter, row2->filter)
+       && row1->epoch == row2->epoch && row1->eyepiece == row2->eyepiece
+       && row1->rho == row2->rho && row1->drho == row2->drho
+       && row1->theta == row2->theta && row1->dtheta == row2->dtheta
+       && row1->dmag == row2->dmag && row1->orbit_ref[0] != '\0'
+       && strcmp(row1->orbit_ref, row2->orbit_ref));
+}
+/*************************************************************************
+* Line of a LaTeX calibrated table (terminated by "\\")
+*
+* INPUT:
+* previous_row: row of the previous line (NULL if not available):
+*               if same measurement with another orbit, the columns
+*               before the orbit are replaced by \idem (and the notes
+*               are not repeated), as in merge_calib_resid,
+*               if same object and row->idem_names, the names are
+*               replaced by \idem
+*************************************************************************/
+int calib_row_to_latex(CALIB_ROW *row, char *out_line, int calib_format,
+                       CALIB_ROW *previous_row)
+{
+char columns[CALIB_NCOLS][80];
+CALIB_LAYOUT lay;
+int icol, ncols, latex_signs = 1;
+
+out_line[0] = '\0';
+if(calib_row_to_columns(row, columns, &ncols, calib_format, latex_signs))
+  return(-1);
+
+calib_get_layout(calib_format, &lay);
+if(previous_row != NULL && calib_same_measurement(row, previous_row)) {
+  for(icol = 0; icol < lay.iorbit_ref - 1; icol++)
+    strcpy(columns[icol], (icol == lay.inotes - 1) ? "" : "\\idem");
+  } else if(previous_row != NULL && row->idem_names
+            && !strcmp(row->wds, previous_row->wds)
+            && !strcmp(row->discov, previous_row->discov)) {
+  strcpy(columns[lay.iwds - 1], "\\idem");
+  strcpy(columns[lay.idiscov - 1], "\\idem");
+  if(lay.iads > 0) strcpy(columns[lay.iads - 1], "\\idem");
+  }
+
+for(icol = 0; icol < ncols; icol++) {
+  if(icol > 0) strcat(out_line, " & ");
+  strcat(out_line, columns[icol]);
+  }
+strcat(out_line, " \\\\");
+
+return(0);
+}
@@ -0,0 +1,156 @@
+/************************************************************************
+* "calib_bintab.h"
+* Binary version of the calibrated tables of measurements
+* (with or without the O-C residuals), to be exchanged between
+* the programs of the chain without parsing LaTeX again
+* (written by merge_calib_resid --binary, read by latex_to_csv,
+* convert_for_WDS and process_table_for_publi)
+*
+* Layout of a file:
+*  - header (CALIB_BINTAB_HEADER, 64 bytes)
+*  - the columns of the table, one after the other (nrows values each),
+*    in the order of CALIB_COL_xxx: double precision columns first,
+*    then integer columns, then fixed-length strings
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#ifndef __calib_bintab_h   /* BOF sentry */
+#define __calib_bintab_h
+
+#include <stdio.h>           // NULL
+#include <stdint.h>
+#include <vector>
+
+#define CALIB_BINTAB_MAGIC      "PSCPCALT"
+#define CALIB_BINTAB_VERSION    2
+#define CALIB_BINTAB_BYTE_ORDER 0x01020304
+
+/* Layouts of the LaTeX calibrated tables: */
+/* Gili's format:
+* WDS & discov & epoch & nbin & rho & drho & theta & dtheta & dm & notes
+* & orbit_ref & rho_o_c & theta_o_c & grade \\  */
+#define CALIB_FMT_GILI    1
+/* Calern format:
+* WDS & discov & epoch & filter & eyepiece & rho & drho & theta & dtheta
+* & notes & orbit_ref & rho_o_c & theta_o_c & grade \\  */
+#define CALIB_FMT_CALERN  2
+/* Format with ADS names (output of merge_calib_resid):
+* WDS & discov & ADS & epoch & rho & drho & theta & dtheta & dm & eyepiece
+* & notes & orbit_ref & rho_o_c & theta_o_c \\  */
+#define CALIB_FMT_ADS     3
+
+/* One measurement (and one orbit if residuals): */
+typedef struct {
+double epoch;           /* Bessel epoch */
+double rho;             /* Angular separation (arcsec), NO_DATA if unres. */
+double drho;
+double theta;           /* Position angle (deg.) */
+double dtheta;
+double dmag;            /* Delta mag (NO_DATA if not available) */
+double rho_o_c;         /* O-C residual in rho (NO_DATA if no orbit) */
+double theta_o_c;       /* O-C residual in theta (NO_DATA if no orbit) */
+int eyepiece;           /* Eyepiece (mm) or number of binned frames */
+int quadrant_flag;      /* 1 if theta without 180 deg. ambiguity ($^*$) */
+int quadrant_discrep;   /* 1 if quadrant discrepancy with the orbit ($^Q$) */
+int orbit_grade;        /* Grade of the orbit (-1 if not available) */
+int idem_names;         /* 1 if \idem instead of the names in the LaTeX
+                           table (same object as in the previous line) */
+char wds[16];           /* WDS name, e.g., 00024+1047 */
+char discov[40];        /* Discoverer's name with companion, e.g., BU 733AB */
+char ads[16];           /* ADS number (CALIB_FMT_ADS only) */
+char filter[8];
+char notes[80];
+char orbit_ref[64];
+char decimals[12];      /* Number of decimals of the values in the LaTeX
+                           table, one digit per value (CALIB_DEC_xxx) */
+} CALIB_ROW;
+
+/* Position of the values in CALIB_ROW.decimals
+* (default: CALIB_DEFAULT_DECIMALS, i.e. the formats of astrom_calib
+* and merge_calib_resid): */
+#define CALIB_DEC_EPOCH     0
+#define CALIB_DEC_RHO       1
+#define CALIB_DEC_DRHO      2
+#define CALIB_DEC_THETA     3
+#define CALIB_DEC_DTHETA    4
+#define CALIB_DEC_DMAG      5
+#define CALIB_DEC_RHO_O_C   6
+#define CALIB_DEC_THETA_O_C 7
+#define CALIB_DEFAULT_DECIMALS "33311221"
+
+/* Columns of the binary file: */
+#define CALIB_COL_EPOCH           0
+#define CALIB_COL_RHO             1
+#define CALIB_COL_DRHO            2
+#define CALIB_COL_THETA           3
+#define CALIB_COL_DTHETA          4
+#define CALIB_COL_DMAG            5
+#define CALIB_COL_RHO_O_C         6
+#define CALIB_COL_THETA_O_C       7
+#define CALIB_COL_EYEPIECE        8
+#define CALIB_COL_QUADRANT_FLAG   9
+#define CALIB_COL_QUADRANT_DISCREP 10
+#define CALIB_COL_ORBIT_GRADE     11
+#define CALIB_COL_IDEM_NAMES      12
+#define CALIB_COL_WDS             13
+#define CALIB_COL_DISCOV          14
+#define CALIB_COL_ADS             15
+#define CALIB_COL_FILTER          16
+#define CALIB_COL_NOTES           17
+#define CALIB_COL_ORBIT_REF       18
+#define CALIB_COL_DECIMALS        19
+#define CALIB_NCOLS               20
+
+typedef struct {
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint32_t calib_format;
+  uint32_t ncols;
+  uint64_t nrows;
+  uint64_t checksum;
+  char reserved[24];
+} CALIB_BINTAB_HEADER;
+
+class CalibBinTable {
+
+public:
+    CalibBinTable(int calib_format0);
+    ~CalibBinTable() {};
+
+    int NRows() { return(nrows); }
+    int CalibFormat() { return(calib_format); }
+
+    int AddRow(CALIB_ROW *row);
+    int GetRow(int irow, CALIB_ROW *row);
+// Direct access to the columns (NULL if bad type):
+    const double *DoubleColumn(int icol);
+    const int *IntColumn(int icol);
+
+    int WriteToFile(char *bin_fname);
+    int LoadFromFile(char *bin_fname);
+// Read all the lines with measurements of a LaTeX table:
+    int LoadFromLatexFile(char *latex_fname);
+// Write the rows as a LaTeX table with the layout of out_calib_format
+// (with \jlpBeginTable/\jlpEndTable, and \idem as in the LaTeX table
+// it was made from, or for the other orbits of the same measurement):
+    int WriteLatexFile(char *latex_fname, int out_calib_format, 
+                       int nlines_per_page);
+
+private:
+    int calib_format, nrows;
+    std::vector< std::vector<char> > columns;
+};
+
+/* Accessory routines: */
+int calib_bintab_is_binary(char *fname);
+void calib_row_init(CALIB_ROW *row);
+int calib_row_from_latex(char *in_line, CALIB_ROW *row, int calib_format,
+                         CALIB_ROW *previous_row = NULL);
+int calib_row_to_columns(CALIB_ROW *row, char columns[][80], int *ncols,
+                         int calib_format, int latex_signs);
+int calib_row_to_latex(CALIB_ROW *row, char *out_line, int calib_format,
+                       CALIB_ROW *previous_row = NULL);
+
+#endif   /* EOF sentry */
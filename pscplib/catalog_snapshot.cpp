@@ -0,0 +1,334 @@
+/************************************************************************
+* "catalog_snapshot.cpp"
+* Binary snapshots of the catalogs (WDS, HIC, HIP), created by
+* catalog_compile and memory-mapped by the catalog readers
+*
+* A snapshot is only used when its header is valid (magic, version,
+* byte order, kind, record size, file size) and when the size and
+* modification time of the ASCII catalog have not changed since
+* its creation. The indexes are stored in the snapshot, so that opening
+* it only reads the header: the pages of the columns and of the indexes
+* are only loaded when they are accessed. The checksum is computed when
+* the snapshot is written, and only verified on demand (snapshot_check(),
+* e.g. "catalog_compile WDS wdsweb_summ.txt check").
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>       // open()
+#include <unistd.h>      // close()
+#include <sys/stat.h>    // stat()
+#include <sys/mman.h>    // mmap()
+#include "catalog_snapshot.h"
+
+/*
+#define DEBUG
+*/
+
+static uint64_t snapshot_checksum_update(uint64_t hash, const char *data,
+                                         size_t length);
+
+/*************************************************************************
+* Name of the snapshot corresponding to a catalog:
+* e.g. wdsweb_summ.txt -> wdsweb_summ.txt.bin
+*************************************************************************/
+void snapshot_fname_from_catalog(char *catalog_fname, char *snapshot_fname,
+                                 int length)
+{
+snprintf(snapshot_fname, length, "%s%s", catalog_fname, SNAPSHOT_EXTENSION);
+}
+/*************************************************************************
+* 64-bit FNV-1a checksum
+*************************************************************************/
+uint64_t snapshot_checksum(const char *data, size_t length)
+{
+return(snapshot_checksum_update(14695981039346656037ULL, data, length));
+}
+/*************************************************************************
+* Update a FNV-1a checksum with the following bytes
+*************************************************************************/
+static uint64_t snapshot_checksum_update(uint64_t hash, const char *data,
+                                         size_t length)
+{
+size_t i;
+
+for(i = 0; i < length; i++) {
+  hash ^= (unsigned char)data[i];
+  hash *= 1099511628211ULL;
+  }
+
+return(hash);
+}
+/*************************************************************************
+* Number of slots of the hash tables of the indexes
+* (power of two, at least twice the number of records)
+*************************************************************************/
+int snapshot_hash_nslots(int nrecords)
+{
+int nslots = 16;
+
+while(nslots < 2 * nrecords) nslots *= 2;
+
+return(nslots);
+}
+/*************************************************************************
+* Hash code of a key (64-bit FNV-1a of the string)
+*************************************************************************/
+static uint64_t snapshot_hash_key(const char *key)
+{
+return(snapshot_checksum(key, strlen(key)));
+}
+/*************************************************************************
+* Empty all the slots of a hash table
+*************************************************************************/
+void snapshot_hash_init(int32_t *slots, int nslots)
+{
+int i;
+
+for(i = 0; i < nslots; i++) slots[i] = -1;
+}
+/*************************************************************************
+* Insert a record in a hash table (linear probing)
+* (the first record is kept for duplicated keys)
+*
+* INPUT:
+*  keys, key_stride: the key of record irec is &keys[irec * key_stride]
+*
+* RETURN: the first record with the same key (irec if it is a new key)
+*************************************************************************/
+int snapshot_hash_insert(int32_t *slots, int nslots, const char *keys,
+                         int key_stride, int irec)
+{
+const char *key = &keys[irec * key_stride];
+int i;
+
+i = (int)(snapshot_hash_key(key) & (uint64_t)(nslots - 1));
+while(slots[i] >= 0) {
+  if(!strcmp(&keys[slots[i] * key_stride], key)) return(slots[i]);
+  i = (i + 1) & (nslots - 1);
+  }
+slots[i] = irec;
+
+return(irec);
+}
+/*************************************************************************
+* Look for a key in a hash table
+*
+* RETURN: the first record with this key, -1 if not found
+*************************************************************************/
+int snapshot_hash_find(const int32_t *slots, int nslots, const char *keys,
+                       int key_stride, const char *key)
+{
+int i;
+
+i = (int)(snapshot_hash_key(key) & (uint64_t)(nslots - 1));
+while(slots[i] >= 0) {
+  if(!strcmp(&keys[slots[i] * key_stride], key)) return(slots[i]);
+  i = (i + 1) & (nslots - 1);
+  }
+
+return(-1);
+}
+/*************************************************************************
+* Write a snapshot of a catalog
+*
+* INPUT:
+*  catalog_fname: name of the ASCII catalog
+*  kind: SNAPSHOT_WDS, SNAPSHOT_HIC or SNAPSHOT_HIP
+*  record_size: sum of the strides of all the columns
+*  data: columns of the catalog (nrecords * record_size bytes)
+*  index: indexes of the catalog (index_size bytes)
+*************************************************************************/
+int snapshot_write(char *catalog_fname, int kind, int record_size,
+                   char *data, int nrecords, char *index, size_t index_size)
+{
+SNAPSHOT_HEADER header;
+struct stat st;
+char snapshot_fname[512], padding[8];
+size_t length, index_offset;
+uint64_t checksum;
+FILE *fp_snap;
+
+memset(&header, 0, sizeof(SNAPSHOT_HEADER));
+memcpy(header.magic, SNAPSHOT_MAGIC, 8);
+header.version = SNAPSHOT_VERSION;
+header.byte_order = SNAPSHOT_BYTE_ORDER;
+header.kind = kind;
+header.record_size = record_size;
+header.nrecords = nrecords;
+header.index_size = index_size;
+if(stat(catalog_fname, &st) == 0) {
+  header.source_size = st.st_size;
+  header.source_mtime = st.st_mtime;
+  }
+length = (size_t)nrecords * (size_t)record_size;
+index_offset = SNAPSHOT_INDEX_OFFSET(nrecords, record_size);
+memset(padding, 0, 8);
+/* Checksum of the data followed by the indexes: */
+checksum = snapshot_checksum(data, length);
+checksum = snapshot_checksum_update(checksum, padding, index_offset - length);
+header.checksum = snapshot_checksum_update(checksum, index, index_size);
+
+snapshot_fname_from_catalog(catalog_fname, snapshot_fname, 512);
+if((fp_snap = fopen(snapshot_fname, "wb")) == NULL) {
+  fprintf(stderr, "snapshot_write/Fatal error opening %s\n", snapshot_fname);
+  return(-1);
+  }
+
+if(fwrite(&header, sizeof(SNAPSHOT_HEADER), 1, fp_snap) != 1
+   || (length > 0 && fwrite(data, length, 1, fp_snap) != 1)
+   || (index_offset > length
+       && fwrite(padding, index_offset - length, 1, fp_snap) != 1)
+   || (index_size > 0 && fwrite(index, index_size, 1, fp_snap) != 1)) {
+  fprintf(stderr, "snapshot_write/Fatal error writing %s\n", snapshot_fname);
+  fclose(fp_snap);
+  return(-1);
+  }
+
+fclose(fp_snap);
+return(0);
+}
+/*************************************************************************
+* Open and memory-map the snapshot of a catalog (if present and valid)
+*
+* INPUT:
+*  catalog_fname: name of the ASCII catalog
+*  kind: SNAPSHOT_WDS, SNAPSHOT_HIC or SNAPSHOT_HIP
+*  record_size: expected sum of the strides of all the columns
+*
+* OUTPUT:
+*  snap: address of the columns, address and size of the indexes,
+*        and number of records
+*
+* RETURN: 0 if the snapshot can be used, -1 otherwise
+*************************************************************************/
+int snapshot_open(char *catalog_fname, int kind, int record_size,
+                  SNAPSHOT_MAP *snap)
+{
+SNAPSHOT_HEADER *header;
+struct stat st, st_cat;
+char snapshot_fname[512];
+size_t index_offset;
+void *addr;
+int fd;
+
+snap->map_address = NULL;
+snap->map_length = 0;
+snap->data = NULL;
+snap->index = NULL;
+snap->index_size = 0;
+snap->nrecords = 0;
+
+snapshot_fname_from_catalog(catalog_fname, snapshot_fname, 512);
+if((fd = open(snapshot_fname, O_RDONLY)) < 0) return(-1);
+
+if(fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(SNAPSHOT_HEADER)) {
+  close(fd);
+  return(-1);
+  }
+
+addr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+close(fd);
+if(addr == MAP_FAILED) return(-1);
+
+header = (SNAPSHOT_HEADER *)addr;
+index_offset = SNAPSHOT_INDEX_OFFSET(header->nrecords, header->record_size);
+if(memcmp(header->magic, SNAPSHOT_MAGIC, 8)
+   || header->version != SNAPSHOT_VERSION
+   || header->byte_order != SNAPSHOT_BYTE_ORDER
+   || header->kind != (uint32_t)kind
+   || header->record_size != (uint32_t)record_size
+   || (size_t)st.st_size != sizeof(SNAPSHOT_HEADER) + index_offset
+                            + header->index_size) {
+  fprintf(stderr, "snapshot_open/Warning: %s is not a valid snapshot (ignored)\n",
+          snapshot_fname);
+  munmap(addr, st.st_size);
+  return(-1);
+  }
+
+/* The ASCII catalog may be absent, but if present it should not have
+* been modified since the creation of the snapshot: */
+if(stat(catalog_fname, &st_cat) == 0
+   && ((uint64_t)st_cat.st_size != header->source_size
+       || (int64_t)st_cat.st_mtime != header->source_mtime)) {
+  fprintf(stderr, "snapshot_open/Warning: %s is older than %s (ignored)\n",
+          snapshot_fname, catalog_fname);
+  munmap(addr, st.st_size);
+  return(-1);
+  }
+
+snap->data = (char *)addr + sizeof(SNAPSHOT_HEADER);
+snap->index = snap->data + index_offset;
+snap->index_size = header->index_size;
+snap->map_address = addr;
+snap->map_length = st.st_size;
+snap->nrecords = (int)header->nrecords;
+
+#ifdef DEBUG
+printf("snapshot_open: %d records mapped from %s\n", snap->nrecords,
+       snapshot_fname);
+#endif
+
+return(0);
+}
+/*************************************************************************
+* Verify the checksum of the snapshot of a catalog
+* (all the pages of the file are read: not done by snapshot_open())
+*
+* INPUT:
+*  catalog_fname: name of the ASCII catalog
+*
+* RETURN: 0 if the checksum is correct, -1 otherwise
+*************************************************************************/
+int snapshot_check(char *catalog_fname)
+{
+SNAPSHOT_HEADER *header;
+struct stat st;
+char snapshot_fname[512];
+void *addr;
+int fd, status;
+
+snapshot_fname_from_catalog(catalog_fname, snapshot_fname, 512);
+if((fd = open(snapshot_fname, O_RDONLY)) < 0) {
+  fprintf(stderr, "snapshot_check/Error opening %s\n", snapshot_fname);
+  return(-1);
+  }
+
+if(fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(SNAPSHOT_HEADER)) {
+  fprintf(stderr, "snapshot_check/Error: %s is too short\n", snapshot_fname);
+  close(fd);
+  return(-1);
+  }
+
+addr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+close(fd);
+if(addr == MAP_FAILED) return(-1);
+
+header = (SNAPSHOT_HEADER *)addr;
+status = 0;
+if(snapshot_checksum((char *)addr + sizeof(SNAPSHOT_HEADER),
+                     st.st_size - sizeof(SNAPSHOT_HEADER))
+   != header->checksum) {
+  fprintf(stderr, "snapshot_check/Error: bad checksum in %s\n",
+          snapshot_fname);
+  status = -1;
+  }
+
+munmap(addr, st.st_size);
+return(status);
+}
+/*************************************************************************
+* Unmap a snapshot opened by snapshot_open()
+*************************************************************************/
+void snapshot_close(SNAPSHOT_MAP *snap)
+{
+if(snap->map_address != NULL) munmap(snap->map_address, snap->map_length);
+snap->map_address = NULL;
+snap->map_length = 0;
+snap->data = NULL;
+snap->index = NULL;
+snap->index_size = 0;
+snap->nrecords = 0;
+}
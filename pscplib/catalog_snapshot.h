@@ -0,0 +1,80 @@
+/************************************************************************
+* "catalog_snapshot.h"
+* Binary snapshots of the catalogs (WDS, HIC, HIP), created by
+* catalog_compile and memory-mapped by the catalog readers
+*
+* Layout of a snapshot file:
+*  - header (SNAPSHOT_HEADER, 64 bytes)
+*  - nrecords * record_size bytes of data, stored column by column:
+*    each column has a fixed stride (the double precision columns first,
+*    to keep them aligned), padded to a multiple of 8 bytes
+*  - index_size bytes of indexes (hash tables of record numbers,
+*    declination zones, ...), built by the catalog reader before writing
+*    the snapshot, so that they are also memory-mapped when it is opened
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#ifndef __catalog_snapshot_h   /* BOF sentry */
+#define __catalog_snapshot_h
+
+#include <stdint.h>
+
+#define SNAPSHOT_MAGIC      "PSCPSNAP"
+#define SNAPSHOT_VERSION    2
+#define SNAPSHOT_BYTE_ORDER 0x01020304
+/* Extension added to the name of the catalog: */
+#define SNAPSHOT_EXTENSION  ".bin"
+
+/* Kind of catalog: */
+#define SNAPSHOT_WDS   1
+#define SNAPSHOT_HIC   2
+#define SNAPSHOT_HIP   3
+
+typedef struct {
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint32_t kind;
+  uint32_t record_size;
+  uint64_t nrecords;
+  uint64_t source_size;
+  int64_t source_mtime;
+  uint64_t checksum;      /* of the data and of the indexes */
+  uint64_t index_size;
+} SNAPSHOT_HEADER;
+
+typedef struct {
+  void *map_address;
+  size_t map_length;
+  char *data;
+  char *index;
+  size_t index_size;
+  int nrecords;
+} SNAPSHOT_MAP;
+
+/* Offset of the indexes after the start of the data (aligned on 8 bytes): */
+#define SNAPSHOT_INDEX_OFFSET(nrecords, record_size) \
+   ((((size_t)(nrecords) * (size_t)(record_size)) + 7) & ~(size_t)7)
+
+void snapshot_fname_from_catalog(char *catalog_fname, char *snapshot_fname,
+                                 int length);
+uint64_t snapshot_checksum(const char *data, size_t length);
+int snapshot_write(char *catalog_fname, int kind, int record_size,
+                   char *data, int nrecords, char *index, size_t index_size);
+int snapshot_open(char *catalog_fname, int kind, int record_size,
+                  SNAPSHOT_MAP *snap);
+int snapshot_check(char *catalog_fname);
+void snapshot_close(SNAPSHOT_MAP *snap);
+
+/* Open-addressing hash tables of record numbers stored in the indexes
+* (nslots int32_t slots, -1 for the empty slots), whose keys are
+* the strings &keys[irec * key_stride]: */
+int snapshot_hash_nslots(int nrecords);
+void snapshot_hash_init(int32_t *slots, int nslots);
+int snapshot_hash_insert(int32_t *slots, int nslots, const char *keys,
+                         int key_stride, int irec);
+int snapshot_hash_find(const int32_t *slots, int nslots, const char *keys,
+                       int key_stride, const char *key);
+
+#endif   /* EOF sentry */
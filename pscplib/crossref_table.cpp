@@ -0,0 +1,234 @@
+/************************************************************************
+* "crossref_table.cpp"
+* In-memory version of the cross-reference files between catalogs
+* (ADS/WDS and HIP/HDS/WDS), read only once and indexed by name,
+* so that the routines of "astrom_utils_pdb.cpp" and "HIP_catalog_utils.cpp"
+* do not scan the whole file for each object.
+*
+* The fields are extracted from the lines as in the previous versions
+* of those routines.
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "crossref_table.h"
+#include "jlp_string.h"      // jlp_trim_string()
+
+static int key_ADS_number(const char *line, char *key);
+static int key_ADS_field(const char *line, char *key);
+static int key_discov(const char *line, char *key);
+static int key_WDS_HIP_HDS(const char *line, char *key);
+
+static CrossRefTable *cached_ADS_WDS_cross = NULL;
+static CrossRefTable *cached_HIP_HDS_WDS_cross = NULL;
+
+/*************************************************************************
+* Return the process-wide instance of a cross-reference table
+* (the file is loaded only once, or when its name changes)
+*
+* INPUT:
+* crossref_fname: name of the cross-reference file
+* crossref_type: CROSSREF_ADS_WDS or CROSSREF_HIP_HDS_WDS
+*************************************************************************/
+CrossRefTable *CrossRefTable_get_cached(char *crossref_fname,
+                                        int crossref_type)
+{
+CrossRefTable **cached;
+
+if(crossref_type == CROSSREF_ADS_WDS)
+  cached = &cached_ADS_WDS_cross;
+else
+  cached = &cached_HIP_HDS_WDS_cross;
+
+if(*cached != NULL) {
+  if(!strcmp((*cached)->Filename(), crossref_fname)) return(*cached);
+  delete *cached;
+  *cached = NULL;
+  }
+
+*cached = new CrossRefTable(crossref_fname, crossref_type);
+if(!(*cached)->IsLoaded()) {
+  delete *cached;
+  *cached = NULL;
+  }
+
+return(*cached);
+}
+/*************************************************************************
+* Constructor
+*
+* INPUT:
+* crossref_fname0: name of the cross-reference file
+* crossref_type0: CROSSREF_ADS_WDS or CROSSREF_HIP_HDS_WDS
+*************************************************************************/
+CrossRefTable::CrossRefTable(char *crossref_fname0, int crossref_type0)
+{
+strncpy(crossref_fname, crossref_fname0, 255);
+crossref_fname[255] = '\0';
+crossref_type = crossref_type0;
+loaded = 0;
+
+if(LoadFromTextFile() == 0) {
+  if(crossref_type == CROSSREF_ADS_WDS) {
+    AddIndex(key_ADS_number);
+    AddIndex(key_ADS_field);
+    AddIndex(key_discov);
+  } else {
+    AddIndex(key_WDS_HIP_HDS);
+  }
+  loaded = 1;
+  }
+}
+/*************************************************************************
+* Read all the lines of the file (except the comments starting with '%')
+*
+* The lines are truncated as when they were read for each object:
+* 255 characters for the ADS/WDS file, 79 for the HIP/HDS/WDS file.
+*************************************************************************/
+int CrossRefTable::LoadFromTextFile()
+{
+char in_line[512];
+int max_length;
+FILE *fp_in;
+
+if((fp_in = fopen(crossref_fname, "r")) == NULL) {
+  fprintf(stderr, "CrossRefTable/Error opening %s\n", crossref_fname);
+  return(-1);
+  }
+
+max_length = (crossref_type == CROSSREF_ADS_WDS) ? 255 : 79;
+
+while(fgets(in_line, 512, fp_in)) {
+  in_line[max_length] = '\0';
+  if(in_line[0] != '%') lines.push_back(in_line);
+  }
+
+fclose(fp_in);
+
+#ifdef DEBUG
+printf("CrossRefTable: %d lines loaded from %s\n", (int)lines.size(),
+       crossref_fname);
+#endif
+
+return(0);
+}
+/*************************************************************************
+* Build a new index of the rows with the keys given by key_func
+*************************************************************************/
+void CrossRefTable::AddIndex(CROSSREF_KEY_FUNC key_func)
+{
+std::unordered_map<std::string, std::vector<int> > new_index;
+char key[256];
+int irow;
+
+for(irow = 0; irow < (int)lines.size(); irow++) {
+  if(key_func(lines[irow].c_str(), key) == 0) new_index[key].push_back(irow);
+  }
+
+index.push_back(new_index);
+}
+/*************************************************************************
+* Rows whose key is "key" for index #idx (NULL if not found)
+*************************************************************************/
+const std::vector<int> *CrossRefTable::Find(int idx, const char *key)
+{
+std::unordered_map<std::string, std::vector<int> >::iterator it;
+
+if(idx < 0 || idx >= (int)index.size()) return(NULL);
+
+it = index[idx].find(key);
+if(it == index[idx].end()) return(NULL);
+
+return(&(it->second));
+}
+/*************************************************************************
+* First row whose key is "key" for index #idx (-1 if not found)
+*************************************************************************/
+int CrossRefTable::FindFirst(int idx, const char *key)
+{
+const std::vector<int> *rows;
+
+rows = Find(idx, key);
+if(rows == NULL) return(-1);
+
+return((*rows)[0]);
+}
+/*************************************************************************
+* Extract "n" characters starting at column "i0" of a line
+* (or less if the line is shorter)
+*************************************************************************/
+static void crossref_field(const char *line, int i0, int n, char *field)
+{
+int i;
+
+field[0] = '\0';
+for(i = 0; i < i0; i++) if(line[i] == '\0') return;
+strncpy(field, &line[i0], n);
+field[n] = '\0';
+}
+/*************************************************************************
+* ADS/WDS cross-reference
+* Syntax:
+BDS         ADS     Discovr Comp         WDS       Omit?
+
+13663     17158     A  1248           00000+7530
+12704         1     STF3053  AB       00026+6606
+13664     17180     BGH   1  AB-C     00024+1047
+
+ADS numbers in fields 11 to 15
+Discov names in fields 21 to 27
+Components in fields 30 to 36
+WDS numbers in fields 39 to 48
+*
+* Key: ADS number (fields 11 to 15) written with "%d"
+*************************************************************************/
+static int key_ADS_number(const char *line, char *key)
+{
+char buffer[16];
+int ads_nber;
+
+crossref_field(line, 10, 5, buffer);
+if(sscanf(buffer, "%d", &ads_nber) != 1) return(-1);
+sprintf(key, "%d", ads_nber);
+
+return(0);
+}
+/*************************************************************************
+* Key: ADS field (fields 11 to 16) without the blanks
+*************************************************************************/
+static int key_ADS_field(const char *line, char *key)
+{
+crossref_field(line, 10, 6, key);
+jlp_trim_string(key, 20);
+if(key[0] == '\0') return(-1);
+
+return(0);
+}
+/*************************************************************************
+* Key: discoverer's name (fields 21 to 27) without the leading and
+* trailing blanks, only for the lines with an ADS number
+*************************************************************************/
+static int key_discov(const char *line, char *key)
+{
+int ads_nber;
+
+if(line[0] == '\0' || strlen(line) <= 10) return(-1);
+if(sscanf(&line[10], "%d", &ads_nber) != 1) return(-1);
+crossref_field(line, 20, 7, key);
+jlp_trim_string(key, 256);
+
+return(0);
+}
+/*************************************************************************
+* HIP/HDS/WDS cross-reference
+* Key: WDS name (first 10 characters)
+*************************************************************************/
+static int key_WDS_HIP_HDS(const char *line, char *key)
+{
+crossref_field(line, 0, 10, key);
+
+return(0);
+}
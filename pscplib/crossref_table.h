@@ -0,0 +1,74 @@
+/************************************************************************
+* "crossref_table.h"
+* In-memory version of the cross-reference files between catalogs
+* (ADS/WDS and HIP/HDS/WDS files from the WDS website), read only once
+* and indexed by the names that are searched for
+*
+* Examples of lines:
+* ADS/WDS cross-reference:
+* 13664     17180     BGH   1  AB-C     00024+1047
+* HIP/HDS/WDS cross-reference:
+* 00000+7530 HDS   1      117  ...
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#ifndef __crossref_table_h   /* BOF sentry */
+#define __crossref_table_h
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+
+/* Type of cross-reference file: */
+#define CROSSREF_ADS_WDS      1
+#define CROSSREF_HIP_HDS_WDS  2
+
+/* Indexes of an ADS/WDS cross-reference table: */
+#define CROSSREF_IDX_ADS_NUMBER  0    /* ADS number ("17180")         */
+#define CROSSREF_IDX_ADS_FIELD   1    /* ADS field, trimmed           */
+#define CROSSREF_IDX_DISCOV      2    /* discoverer's name ("BGH   1") */
+/* Index of a HIP/HDS/WDS cross-reference table: */
+#define CROSSREF_IDX_WDS         0    /* WDS name ("00024+1047")      */
+
+/* Function extracting the key of a line for an index
+* (returns 0 if the line has a key, -1 otherwise) */
+typedef int (*CROSSREF_KEY_FUNC)(const char *line, char *key);
+
+class CrossRefTable {
+
+public:
+    CrossRefTable(char *crossref_fname0, int crossref_type0);
+    ~CrossRefTable() {};
+
+    int IsLoaded() { return(loaded); }
+    int NRows() { return((int)lines.size()); }
+    int Type() { return(crossref_type); }
+    const char *Filename() { return(crossref_fname); }
+// Line #irow of the file (comment lines are not stored):
+    const char *Line(int irow) { return(lines[irow].c_str()); }
+
+// Rows whose key is "key" for index #idx, in the order of the file
+// (NULL if not found):
+    const std::vector<int> *Find(int idx, const char *key);
+// First of those rows (-1 if not found):
+    int FindFirst(int idx, const char *key);
+
+private:
+    int LoadFromTextFile();
+    void AddIndex(CROSSREF_KEY_FUNC key_func);
+
+    char crossref_fname[256];
+    int crossref_type, loaded;
+    std::vector<std::string> lines;
+
+// One index per type of key: key -> rows (in the order of the file)
+    std::vector< std::unordered_map<std::string, std::vector<int> > > index;
+};
+
+// Process-wide instances, one per type of cross-reference file
+// (reloaded only if the file name changes):
+CrossRefTable *CrossRefTable_get_cached(char *crossref_fname,
+                                        int crossref_type);
+
+#endif   /* EOF sentry */
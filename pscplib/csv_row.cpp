@@ -0,0 +1,71 @@
+/************************************************************************
+* "csv_row.cpp"
+* Fields of a line of a csv file, split only once (see csv_row.h)
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#include <stdio.h>
+#include "csv_row.h"
+
+/*************************************************************
+* Split a csv row into fields, in one pass
+* (the commas between quotes, e.g., "8,04", are not separators)
+* The line is not modified, and can be of any length.
+*
+* INPUT:
+* b_data: csv line (ended by '\0', '\n' or '\r')
+*
+* OUTPUT:
+* row: offsets of the fields in b_data (CSV_NFIELDS_MAX fields at most:
+*      the next ones are ignored, with row->truncated = 1)
+* returns the number of fields
+*************************************************************/
+int csv_split_row(const char *b_data, CSV_ROW *row)
+{
+int i, iquote;
+char c;
+
+row->line = b_data;
+row->nfields = 0;
+row->truncated = 0;
+row->start[0] = 0;
+iquote = 0;
+for(i = 0; ; i++) {
+  c = b_data[i];
+  if(c == '"') {
+    iquote = 1 - iquote;
+  } else if(c == '\0' || c == '\n' || c == '\r' || (c == ',' && !iquote)) {
+    row->end[row->nfields] = i;
+    row->nfields++;
+    if(c != ',') break;
+    if(row->nfields == CSV_NFIELDS_MAX) {
+      row->truncated = 1;
+      break;
+      }
+    row->start[row->nfields] = i + 1;
+  }
+  }
+
+return(row->nfields);
+}
+/*************************************************************
+* Remove the blanks and the quotes at both ends of the fields
+* of a row split by csv_split_row() (only the offsets are changed)
+*************************************************************/
+void csv_trim_fields(CSV_ROW *row)
+{
+const char *line = row->line;
+int k, start, end;
+
+for(k = 0; k < row->nfields; k++) {
+  start = row->start[k];
+  end = row->end[k];
+  while(start < end && (line[start] == ' ' || line[start] == '\t'
+                        || line[start] == '"')) start++;
+  while(end > start && (line[end - 1] == ' ' || line[end - 1] == '\t'
+                        || line[end - 1] == '"')) end--;
+  row->start[k] = start;
+  row->end[k] = end;
+  }
+}
@@ -0,0 +1,40 @@
+/************************************************************************
+* "csv_row.h"
+* Fields of a line of a csv file, split only once: the offsets of the
+* fields in the line are computed by csv_split_row(), and the fields
+* are then accessed without scanning the line again.
+*
+* Used by the csv files of the measurements (csv_utils.h) and by
+* the csv files of the Gaia archive (GaiaCsvReader in gaia_xmatch.h)
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#ifndef __csv_row_h   /* BOF sentry */
+#define __csv_row_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Maximum number of fields decoded in a row: the fields after
+* the first CSV_NFIELDS_MAX ones are ignored (and "truncated" is set) */
+#define CSV_NFIELDS_MAX 256
+
+/* Fields of a csv row: field #i (starting at 0) is
+* line[start[i]] ... line[end[i] - 1]
+* truncated: 1 if the row had more than CSV_NFIELDS_MAX fields, 0 otherwise */
+typedef struct {
+  const char *line;
+  int nfields, truncated;
+  int start[CSV_NFIELDS_MAX], end[CSV_NFIELDS_MAX];
+} CSV_ROW;
+
+int csv_split_row(const char *b_data, CSV_ROW *row);
+void csv_trim_fields(CSV_ROW *row);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   /* EOF sentry */
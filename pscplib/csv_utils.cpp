@@ -1,7 +1,7 @@
 /*************************************************************************
 * csv_utils.c
 * JLP
-* Version 02/03/2020
+* Version 17/10/2026
 *************************************************************************/
 #include <ctype.h>          /* isdigit() */
 #include <string.h>         /* strstr() */
@@ -15,6 +15,11 @@
 #include "latex_utils.h"
 
 #include "csv_utils.h" // prototypes defined here
+
+static int csv_epoch_from_notes_string(char *notes, double *epoch1);
+static int csv_dmag_from_notes_string(char *notes, double *dmag1);
+static int csv_object_from_filename_string(char *out_string,
+                                           char *ObjectName1);
 /*
 #define DEBUG
 #define DEBUG1
@@ -26,6 +31,8 @@
  a830\_a , 04/01/2013 ,  ,1,"4,01","0,1","78,41","1,8"," EP=2013,0129 Q=2 dm=0,01 ",,,"0,295938","168,41","169,4",
  a920\_a , 04/01/2013 ,  ,1,"26,11","0,1","-43,07","0,4"," EP=2013,0125 Q=3? ",,1,"1,926918","226,93","227,92",
 
+*
+* The line is split once into fields (csv_split_row())
 *
 * INPUT:
 * nobj: number of objects already entered into *obj 
@@ -43,8 +50,9 @@ int status = -1, iverbose = 0;
 double epoch1, rho1, theta1, drho1, dtheta1, dmag1, ddmag1, ww, rho1_pixels;
 double scale_arcsec_pixel;
 int eyepiece1, quadrant1, dquadrant1;
-char WDSName1[64], ObjectName1[64], filter1[32], notes1[64];
-char *pc, buffer[256], out_string[64];
+char WDSName1[64], ObjectName1[64], filter1[32], notes1[80];
+char out_string[64];
+CSV_ROW row;
 MEASURE *me;
 
 
@@ -83,20 +91,24 @@ i_WDSName = 1;
 (obj1[*nobj1]).nmeas = 1;
 me = &(obj1[*nobj1]).meas[0];
 
+// Offsets of all the fields:
+csv_split_row(b_data, &row);
+
 #ifdef DEBUG1
 printf("DEBUG1/csv_read_gili_measures_from_line \n");
 printf("in: b_data=%s\n", b_data);
 #endif
 // Decode the object name:
 i_ObjectName = 1;
-status = csv_read_object_from_filename(b_data, i_ObjectName, ObjectName1);
+csv_row_string(&row, i_ObjectName, out_string, 64);
+status = csv_object_from_filename_string(out_string, ObjectName1);
 if(status == 0) {
   strcpy((obj1[*nobj1]).discov_name, ObjectName1);
   }
 
 // Decode the rho measurement:
 i_rho = 12; 
-status = csv_read_dvalue(b_data, i_rho, &rho1);
+status = csv_row_dvalue(&row, i_rho, &rho1);
 if(status == 0) 
   me->rho = rho1;
 else
@@ -105,7 +117,7 @@ else
 // Decode rho in pixels:
 i_rho_pixels = 5; 
 scale_arcsec_pixel = 0.;
-status = csv_read_dvalue(b_data, i_rho_pixels, &rho1_pixels);
+status = csv_row_dvalue(&row, i_rho_pixels, &rho1_pixels);
 if(status == 0) {
   if(rho1_pixels != 0) scale_arcsec_pixel = rho1 / rho1_pixels;
   }
@@ -122,7 +134,7 @@ printf("out: rho1=%f eyepiece=%d \n", rho1, me->eyepiece);
 
 // Decode the drho measurement:
 i_drho = 6; 
-status = csv_read_dvalue(b_data, i_drho, &drho1);
+status = csv_row_dvalue(&row, i_drho, &drho1);
 // Gili scale: should multiply rho_pixels in col 5 
 // by 0.0738 to obtain rho_arcsec in col 12 for autocorrelations (*_a)
 // by 0.455 to obtain rho_arcsec in col 12 for long exposures (*_l)
@@ -132,7 +144,7 @@ if(status == 0)
 
 // Decode the theta measurement:
 i_theta = 14; 
-status = csv_read_dvalue(b_data, i_theta, &theta1);
+status = csv_row_dvalue(&row, i_theta, &theta1);
 if(status == 0) me->theta = theta1;
 #ifdef DEBUG1
 printf("out: theta1=%f status=%d \n", theta1, status);
@@ -140,23 +152,23 @@ printf("out: theta1=%f status=%d \n", theta1, status);
 
 // Decode the dtheta measurement:
 i_dtheta = 8; 
-status = csv_read_dvalue(b_data, i_dtheta, &dtheta1);
+status = csv_row_dvalue(&row, i_dtheta, &dtheta1);
 if(status == 0) me->dtheta = dtheta1;
 
 // Decode the notes:
 i_notes = 9; 
-status = csv_read_string(b_data, i_notes, notes1);
+status = csv_row_string(&row, i_notes, notes1, 80);
 if(status == 0) strcpy((obj1[*nobj1]).notes, notes1);
 
 // Decode the epoch from the notes::
-status = csv_read_epoch_from_notes(b_data, i_notes, &epoch1);
+status = csv_epoch_from_notes_string(notes1, &epoch1);
 if(status == 0) me->bessel_epoch = epoch1;
 #ifdef DEBUG1
 printf("out: epoch1=%f status=%d \n", epoch1, status);
 #endif
 
 // Decode Dmag from the notes::
-status = csv_read_dmag_from_notes(b_data, i_notes, &dmag1);
+status = csv_dmag_from_notes_string(notes1, &dmag1);
 if(status == 0) me->dmag = dmag1;
 #ifdef DEBUG1
 printf("out: dmag1=%f status=%d\n", dmag1, status);
@@ -192,13 +204,26 @@ return(0);
 *************************************************************/
 int csv_read_epoch_from_notes(char *b_data, int i_notes, double *epoch1)
 {
-char buffer[64], *pc, epoch_title[64], *epoch_str;
+char notes[80];
+CSV_ROW row;
+
+// Read the notes:
+csv_split_row(b_data, &row);
+csv_row_string(&row, i_notes, notes, 80);
+
+return(csv_epoch_from_notes_string(notes, epoch1));
+}
+/*************************************************************
+* Decode the epoch from the notes (e.g., " EP=2013,0129 Q=2 dm=0,01 ")
+*************************************************************/
+static int csv_epoch_from_notes_string(char *notes, double *epoch1)
+{
+char buffer[80], *pc, epoch_title[64], *epoch_str;
 int status = -1, nval;
 
 *epoch1 = 0.;
 
-// Read the notes:
-status = csv_read_string(b_data, i_notes, buffer);
+strcpy(buffer, notes);
 
 // First look for "EP=":
 strcpy(epoch_title, "EP=");
@@ -226,13 +251,26 @@ return(status);
 *************************************************************/
 int csv_read_dmag_from_notes(char *b_data, int i_notes, double *dmag1)
 {
-char buffer[64], *pc, dmag_title[64], *dmag_str;
+char notes[80];
+CSV_ROW row;
+
+// Read the notes:
+csv_split_row(b_data, &row);
+csv_row_string(&row, i_notes, notes, 80);
+
+return(csv_dmag_from_notes_string(notes, dmag1));
+}
+/*************************************************************
+* Decode dmag from the notes (e.g., " EP=2013,9244  Dm=3,53+/-0,02")
+*************************************************************/
+static int csv_dmag_from_notes_string(char *notes, double *dmag1)
+{
+char buffer[80], *pc, dmag_title[64], *dmag_str;
 int status = -1, nval;
 
 *dmag1 = 0.;
 
-// Read the notes:
-status = csv_read_string(b_data, i_notes, buffer);
+strcpy(buffer, notes);
 // printf(" dm_buffer=%s\n", buffer);
 
 // From 'd' to 'D':
@@ -267,10 +305,20 @@ return(status);
 *************************************************************/
 int csv_read_object_from_filename(char *b_data, int i_column, char *ObjectName1)
 {
-char buffer[64], *pc, out_string[64];
-int icol, status = -1;
+char out_string[64];
+
+csv_read_string(b_data, i_column, out_string);
 
-status = csv_read_string(b_data, i_column, out_string);
+return(csv_object_from_filename_string(out_string, ObjectName1));
+}
+/*************************************************************
+* Decode the object name from the filename field (e.g., " a120\_a ")
+*************************************************************/
+static int csv_object_from_filename_string(char *out_string,
+                                           char *ObjectName1)
+{
+char buffer[64], *pc;
+int status = -1;
 
 // Example: csv_read_string/out_string: > a120\_a <
 
@@ -309,9 +357,10 @@ return(status);
 int csv_read_gili_measures(char *filein1, OBJECT *obj1, int *nobj1, 
                            int nobj_maxi, double scale_mini)
 {
-char b_in[NMAX], wds_name[40], discov_name[40]; 
+char *b_in = NULL, wds_name[40], discov_name[40]; 
+size_t len_b_in = 0;
 int status, iline;
-char *pc, *pc1;
+char *pc;
 FILE *fp_in;
 
 if((fp_in = fopen(filein1,"r")) == NULL) {
@@ -329,10 +378,9 @@ iline = 0;
 *nobj1 = 0;
 while(!feof(fp_in))
 {
-/* Maximum length for a line will be 170 characters: */
-  if(fgets(b_in,170,fp_in))
+/* No maximum length for the lines: */
+  if(getline(&b_in, &len_b_in, fp_in) != -1)
   {
-  b_in[169] = '\0';
 /* NEW/2009: I remove ^M (Carriage Return) if present: */
   pc = b_in;
   while(*pc) {
@@ -355,110 +403,111 @@ if(*nobj1 > nobj_maxi-2) {
 } /* EOF while loop */
 printf("csv_read_gili_measures/Number of lines: nlines=%d nobj=%d\n", iline, *nobj1);
 
+free(b_in);
 fclose(fp_in);
 return(0);
 }
 /*************************************************************
-* Read a string from the input line 
+* Read a string from a row decoded by csv_split_row()
+* (the quotes at both ends are replaced by blanks, as in csv_read_string)
+*
+* INPUT:
+* i_column: column number (starting at 1)
+* len_string: size of out_string
+*
+* OUTPUT:
+* out_string: string of the field
+* 0 if the field is not empty, -1 otherwise
 *************************************************************/
-int csv_read_string(char *b_data, int i_column, char *out_string)
+int csv_row_string(CSV_ROW *row, int i_column, char *out_string,
+                   int len_string)
 {
-char buffer[256], buf1[256], *pc, *pc0;
-int icol, iquote, status = -1, ilen1;
+const char *field;
+int len, k;
 
-/* DEBUG
-printf("i_column=%d\n", i_column);
-printf("b_data: >%s<\n", b_data);
-*/
+*out_string = '\0';
+if(i_column < 1 || i_column > row->nfields) return(-1);
 
-strcpy(buf1, b_data);
-pc = buf1;
-pc0 = pc;
-// Go to the wright column:
-icol = 0;
-iquote = 0;
- while(*pc) {
-   if(*pc == '"') {
-     if(iquote == 0) iquote = 1; else iquote = 0; 
-   }
-// 
-   if((iquote == 0) && (*pc == ',')) {
-     icol++; 
-     if(i_column == icol) {
-       break;
-       } else {
-       pc0 = pc + 1;
-       }
-     }
-   pc++;
-   }
-strcpy(buffer, pc0);
-/* DEBUG
-printf("csv_read_string/buffer: >%s<\n", buffer);
-*/
+field = &row->line[row->start[i_column - 1]];
+len = row->end[i_column - 1] - row->start[i_column - 1];
+if(len <= 0) return(-1);
 
-// Decode string: stop at ','
-iquote = 0;
-pc = buffer;
- while(*pc) {
-   if(*pc == '"') {
-     if(iquote == 0) iquote = 1; else iquote = 0; 
-   }
-   if((iquote == 0) && (*pc == ',')) {
-       *pc = '\0'; 
-       break;
-     }
-   pc++;
-  }
+for(k = 0; k < len && k < len_string - 1; k++) out_string[k] = field[k];
+out_string[k] = '\0';
 
 // Remove first and last ":
-if(buffer[0] == '"') buffer[0] = ' ';
-ilen1 = strlen(buffer);
-if(buffer[ilen1 - 1] == '"') buffer[ilen1 - 1] = ' ';
-
-strncpy(out_string, buffer, 64);
-if(out_string[0] != '\0') status = 0;
+if(field[0] == '"') out_string[0] = ' ';
+if(field[len - 1] == '"' && len - 1 < len_string - 1) out_string[len - 1] = ' ';
 
 #ifdef DEBUG
-printf("csv_read_string/out_string: >%s<\n", out_string);
+printf("csv_row_string/out_string: >%s<\n", out_string);
 #endif
 
-return(status);
+return(0);
 }
 /*************************************************************
-* Read a double value from the input line 
+* Read a double value from a row decoded by csv_split_row()
+* (with French or English decimal separator: "8,04" or 8.04)
+*
+* OUTPUT:
+* dvalue: value (-1000000. if the field is empty or not a number)
+* 0 if OK, -1 otherwise
 *************************************************************/
-int csv_read_dvalue(char *b_data, int i_column, double *dvalue)
+int csv_row_dvalue(CSV_ROW *row, int i_column, double *dvalue)
 {
-char buffer[64], *pc, out_string[64];
-int nval, status = -1;
+char buffer[64];
+const char *field;
+int len, k, nval;
 
 *dvalue = -1000000.;
-status = csv_read_string(b_data, i_column, out_string);
-if(status != 0) return(status);
+if(i_column < 1 || i_column > row->nfields) return(-1);
+
+field = &row->line[row->start[i_column - 1]];
+len = row->end[i_column - 1] - row->start[i_column - 1];
+if(len <= 0) return(-1);
 
 // Removes the quotes at the beginning if any: 
- if(out_string[0] == '"') strcpy(buffer, &out_string[1]);
-   else strcpy(buffer, out_string);
+if(field[0] == '"') {
+  field++;
+  len--;
+  }
 
- pc = buffer;
- while(*pc && (*pc != '"') ) 
-    {
-// Change the French number separator to the English one:
-    if(*pc == ',') *pc = '.';
-    pc++;
-    }
- *pc = '\0';
+// Stop at the next quote, and change the French number separator
+// to the English one:
+for(k = 0; k < len && k < 63 && field[k] != '"'; k++)
+  buffer[k] = (field[k] == ',') ? '.' : field[k];
+buffer[k] = '\0';
 
 nval = sscanf(buffer, "%lf", dvalue);
-if(nval == 1) status = 0;
- else status = -1;
 
 #ifdef DEBUG1
-printf("dvalue=%f status=%d\n", *dvalue, status);
+printf("dvalue=%f nval=%d\n", *dvalue, nval);
 #endif
 
-return(status);
+return((nval == 1) ? 0 : -1);
+}
+/*************************************************************
+* Read a string from the input line 
+* (out_string: 64 characters at most)
+*************************************************************/
+int csv_read_string(char *b_data, int i_column, char *out_string)
+{
+CSV_ROW row;
+
+csv_split_row(b_data, &row);
+
+return(csv_row_string(&row, i_column, out_string, 64));
+}
+/*************************************************************
+* Read a double value from the input line 
+*************************************************************/
+int csv_read_dvalue(char *b_data, int i_column, double *dvalue)
+{
+CSV_ROW row;
+
+csv_split_row(b_data, &row);
+
+return(csv_row_dvalue(&row, i_column, dvalue));
 }
 /*************************************************************
 * Read a string from the input line 
@@ -1,18 +1,26 @@
 /*************************************************************************
 * Set of routines to read csv files with astrometric measurements
 *
+* The rows are split once into fields with csv_split_row() (csv_row.h),
+* and the fields are then decoded with csv_row_string() and csv_row_dvalue()
+*
 * JLP
-* Version 15/01/2023
+* Version 17/10/2026
 *************************************************************************/
 #ifndef _csv_utils_h  /* BOF sentry */
 #define _csv_utils_h  
 
 #include "astrom_utils1.h"
+#include "csv_row.h"    // CSV_ROW, csv_split_row()
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+int csv_row_string(CSV_ROW *row, int i_column, char *out_string,
+                   int len_string);
+int csv_row_dvalue(CSV_ROW *row, int i_column, double *dvalue);
+
 int csv_read_gili_measures(char *filein1, OBJECT *obj1, int *nobj1,
                            int nobj_maxi, double scale_mini);
 int csv_read_gili_measures_from_line(char *b_data, OBJECT *obj1, int *nobj1,
@@ -0,0 +1,256 @@
+/************************************************************************
+* "fits_epoch_cache.cpp"
+* Cache of the epochs read in the headers of the FITS autocorrelation
+* files (see fits_epoch_cache.h)
+*
+* Format of the cache file (one line per FITS file):
+* mtime size found epoch date path
+* Example:
+* 1262304000 264960 1 2009.03217812 12/01/2009 /data/gen2009/120109_ads684ab_Rd_8_a.fits
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>        // stat()
+#include "fits_epoch_cache.h"
+#include "jlp_threads.h"     // jlp_parallel_for()
+
+/*
+#define DEBUG
+*/
+
+static void fits_prefetch_worker(int k, void *data);
+
+/************************************************************************
+* Constructor
+*
+* INPUT:
+* cache_fname0: name of the cache file
+*************************************************************************/
+FitsEpochCache::FitsEpochCache(char *cache_fname0)
+{
+strncpy(cache_fname, cache_fname0, 255);
+cache_fname[255] = '\0';
+nhits = 0;
+modified = 0;
+}
+/************************************************************************
+* Read the cache file (no entries if it does not exist yet)
+*************************************************************************/
+int FitsEpochCache::Load()
+{
+char in_line[512], date[20], path[400];
+FITS_EPOCH_ENTRY entry;
+int iline;
+FILE *fp_in;
+
+entries.clear();
+if((fp_in = fopen(cache_fname, "r")) == NULL) return(-1);
+
+iline = 0;
+while(fgets(in_line, 512, fp_in)) {
+  iline++;
+  if(iline == 1) {
+    if(strncmp(in_line, FITS_EPOCH_CACHE_MAGIC, strlen(FITS_EPOCH_CACHE_MAGIC))) {
+      fprintf(stderr, "FitsEpochCache/Warning: bad header in %s (cache ignored)\n",
+              cache_fname);
+      break;
+      }
+    continue;
+    }
+  if(in_line[0] == '%') continue;
+  if(sscanf(in_line, "%lld %lld %d %lf %19s %399[^\n]", &entry.mtime,
+            &entry.size, &entry.ep.found, &entry.ep.epoch, date, path) != 6) {
+    fprintf(stderr, "FitsEpochCache/Warning: bad line #%d in %s\n", iline,
+            cache_fname);
+    continue;
+    }
+  if(!strcmp(date, "-")) date[0] = '\0';
+  strcpy(entry.ep.date, date);
+  entries[path] = entry;
+  }
+
+fclose(fp_in);
+
+#ifdef DEBUG
+printf("FitsEpochCache: %d entries read from %s\n", (int)entries.size(),
+       cache_fname);
+#endif
+
+return(0);
+}
+/************************************************************************
+* Write the cache file (if new epochs have been stored)
+*************************************************************************/
+int FitsEpochCache::Save()
+{
+char tmp_fname[300];
+std::unordered_map<std::string, FITS_EPOCH_ENTRY>::iterator it;
+int status = 0;
+FILE *fp_out;
+
+if(!modified) return(0);
+
+sprintf(tmp_fname, "%s.tmp", cache_fname);
+if((fp_out = fopen(tmp_fname, "w")) == NULL) {
+  fprintf(stderr, "FitsEpochCache/Error opening %s\n", tmp_fname);
+  return(-1);
+  }
+
+fprintf(fp_out, "%s\n", FITS_EPOCH_CACHE_MAGIC);
+fprintf(fp_out, "%% mtime size found epoch date path\n");
+for(it = entries.begin(); it != entries.end(); it++) {
+  fprintf(fp_out, "%lld %lld %d %.8f %s %s\n", it->second.mtime,
+          it->second.size, it->second.ep.found, it->second.ep.epoch,
+          (it->second.ep.date[0] != '\0') ? it->second.ep.date : "-",
+          it->first.c_str());
+  }
+
+if(ferror(fp_out)) status = -1;
+if(fclose(fp_out) != 0) status = -1;
+if(status || rename(tmp_fname, cache_fname) != 0) {
+  fprintf(stderr, "FitsEpochCache/Error writing %s\n", cache_fname);
+  remove(tmp_fname);
+  return(-1);
+  }
+
+modified = 0;
+return(0);
+}
+/************************************************************************
+* Look for the epoch of a FITS file
+*
+* INPUT:
+* path: full path of the FITS file
+* mtime, size: modification time and size of the FITS file
+*
+* OUTPUT:
+* ep: epoch read in a previous run
+* 0 if found (with the same mtime and size), -1 otherwise
+*************************************************************************/
+int FitsEpochCache::Lookup(const char *path, long long mtime, long long size,
+                           FITS_EPOCH *ep)
+{
+std::unordered_map<std::string, FITS_EPOCH_ENTRY>::iterator it;
+
+it = entries.find(path);
+if(it == entries.end() || it->second.mtime != mtime
+   || it->second.size != size) return(-1);
+
+*ep = it->second.ep;
+nhits++;
+return(0);
+}
+/************************************************************************
+* Store the epoch of a FITS file
+*************************************************************************/
+void FitsEpochCache::Store(const char *path, long long mtime, long long size,
+                           FITS_EPOCH *ep)
+{
+FITS_EPOCH_ENTRY *entry;
+
+entry = &entries[path];
+entry->mtime = mtime;
+entry->size = size;
+entry->ep = *ep;
+entry->ep.date[19] = '\0';
+modified = 1;
+}
+/************************************************************************
+* Look for a FITS file in a directory (with or without ".fits" extension)
+*
+* INPUT:
+* directory: directory of the file (ending with "/")
+* fits_filename: name of the file (e.g., 120109_ads684ab_Rd_8_a)
+*
+* OUTPUT:
+* path: full path of the file
+* mtime, size: modification time and size of the file
+* 0 if the file was found, -1 otherwise
+*************************************************************************/
+int fits_epoch_find_file(char *directory, char *fits_filename, char *path,
+                         long long *mtime, long long *size)
+{
+const char *extension[2] = {"", ".fits"};
+struct stat st;
+int k;
+
+for(k = 0; k < 2; k++) {
+  sprintf(path, "%s%s%s", directory, fits_filename, extension[k]);
+  if(stat(path, &st) == 0 && S_ISREG(st.st_mode)) {
+    *mtime = (long long)st.st_mtime;
+    *size = (long long)st.st_size;
+    return(0);
+    }
+  }
+
+*path = '\0';
+return(-1);
+}
+/************************************************************************
+* Read the primary header of a FITS file
+* (records of 2880 bytes, until the record containing the END card)
+*
+* OUTPUT:
+* header: the header records
+* 0 if OK, -1 if the file could not be read or if the END card is missing
+*************************************************************************/
+int fits_read_primary_header(const char *path, std::string *header)
+{
+char block[FITS_BLOCK_SIZE];
+int iblock, icard, status = -1;
+FILE *fp_in;
+
+header->clear();
+if((fp_in = fopen(path, "rb")) == NULL) return(-1);
+
+for(iblock = 0; iblock < FITS_HEADER_BLOCKS_MAX && status != 0; iblock++) {
+  if(fread(block, 1, FITS_BLOCK_SIZE, fp_in) != FITS_BLOCK_SIZE) break;
+  header->append(block, FITS_BLOCK_SIZE);
+/* 36 cards of 80 characters per record: */
+  for(icard = 0; icard < FITS_BLOCK_SIZE / 80; icard++) {
+    if(!strncmp(&block[icard * 80], "END     ", 8)) {
+      status = 0;
+      break;
+      }
+    }
+  }
+
+fclose(fp_in);
+return(status);
+}
+/************************************************************************
+* Read the primary headers of a list of FITS files in parallel
+* (to load them from a slow storage before decoding the epochs,
+* only the header records are read)
+* The headers are not decoded here: the epochs are then read serially
+* by get_bessel_epoch_from_fits_file() of jlplib, that finds the header
+* records in the page cache
+*
+* INPUT:
+* paths: full paths of the FITS files
+* nthreads: number of threads
+*************************************************************************/
+int fits_prefetch_headers(std::vector<std::string> *paths, int nthreads)
+{
+if(paths->empty()) return(0);
+
+jlp_parallel_for((int)paths->size(), nthreads, fits_prefetch_worker, paths);
+
+return(0);
+}
+/************************************************************************
+* Read the primary header of file #k (called by the threads of the pool)
+*************************************************************************/
+static void fits_prefetch_worker(int k, void *data)
+{
+std::vector<std::string> *paths = (std::vector<std::string> *)data;
+std::string header;
+
+if(fits_read_primary_header((*paths)[k].c_str(), &header) != 0)
+  fprintf(stderr, "fits_prefetch_headers/Warning: bad FITS header in %s\n",
+          (*paths)[k].c_str());
+}
@@ -0,0 +1,65 @@
+/************************************************************************
+* "fits_epoch_cache.h"
+* Cache of the epochs read in the headers of the FITS autocorrelation
+* files (used by astrom_add_epoch), kept on disk and keyed by the path,
+* the modification time and the size of the FITS files, so that
+* the FITS archive is only read for new or modified files
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#ifndef __fits_epoch_cache_h   /* BOF sentry */
+#define __fits_epoch_cache_h
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+
+#define FITS_EPOCH_CACHE_MAGIC   "% fits_epoch_cache version 1"
+
+/* Size of the FITS records, and maximum number of header records read: */
+#define FITS_BLOCK_SIZE        2880
+#define FITS_HEADER_BLOCKS_MAX 64
+
+/* Epoch read from a FITS file (with get_bessel_epoch_from_fits_file()): */
+typedef struct {
+  double epoch;          /* Besselian epoch */
+  char date[20];         /* Date of the observation */
+  int found;             /* 1 if the epoch was found in the header */
+} FITS_EPOCH;
+
+typedef struct {
+  long long mtime, size;
+  FITS_EPOCH ep;
+} FITS_EPOCH_ENTRY;
+
+class FitsEpochCache {
+
+public:
+    FitsEpochCache(char *cache_fname0);
+    ~FitsEpochCache() {};
+
+    int NEntries() { return((int)entries.size()); }
+    int NHits() { return(nhits); }
+
+    int Load();
+    int Save();
+// Epoch of the file "path" if it has not been modified (returns 0 if found):
+    int Lookup(const char *path, long long mtime, long long size,
+               FITS_EPOCH *ep);
+    void Store(const char *path, long long mtime, long long size,
+               FITS_EPOCH *ep);
+
+private:
+    char cache_fname[256];
+    int nhits, modified;
+    std::unordered_map<std::string, FITS_EPOCH_ENTRY> entries;
+};
+
+/* Accessory routines: */
+int fits_epoch_find_file(char *directory, char *fits_filename, char *path,
+                         long long *mtime, long long *size);
+int fits_read_primary_header(const char *path, std::string *header);
+int fits_prefetch_headers(std::vector<std::string> *paths, int nthreads);
+
+#endif   /* EOF sentry */
@@ -0,0 +1,435 @@
+/************************************************************************
+* "gaia_pairs.cpp"
+* Search for candidate double stars in a list of Gaia sources
+* (see gaia_pairs.h)
+*
+* Grid: declination bands of height rho_max, each band divided
+* into nra cells whose width in RA is larger than rho_max / cos(dec)
+* for all the declinations of the band and of its two neighbours.
+* The partners of a source are thus in the 3 x 3 cells around it.
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>            // isdigit(), tolower()
+#include <math.h>
+#include <algorithm>          // std::sort
+#include <unordered_map>
+#include "gaia_pairs.h"
+#include "gaia_xmatch.h"     // GaiaCsvReader
+
+/*
+#define DEBUG
+*/
+
+#ifndef PI
+#define PI 3.14159265358979323846
+#endif
+#define DEGTORAD (PI / 180.)
+#ifndef MAXI
+#define MAXI(a,b) ((a) < (b) ? (b) : (a))
+#endif
+#ifndef MINI
+#define MINI(a,b) ((a) < (b) ? (a) : (b))
+#endif
+
+static int gaia_columns_from_header(GaiaCsvReader *reader,
+                                    GAIA_COLUMNS *cols);
+static void gaia_get_string(GaiaCsvReader *reader, int icol,
+                            char *out_string, int len_string);
+static void gaia_test_pair(GAIA_SOURCE *s1, GAIA_SOURCE *s2,
+                           GAIA_PAIR_PARAM *par, GAIA_PAIR *pair);
+
+/************************************************************************
+* Default parameters
+*************************************************************************/
+void gaia_pair_param_init(GAIA_PAIR_PARAM *par)
+{
+par->rho_max = GAIA_PAIR_RHO_MAX;
+par->paral_nsigma = GAIA_PAIR_PARAL_NSIGMA;
+par->pm_nsigma = GAIA_PAIR_PM_NSIGMA;
+par->pm_rel_max = GAIA_PAIR_PM_REL_MAX;
+par->keep_optical = 0;
+}
+/************************************************************************
+* Read the Gaia sources of a csv file
+*
+* The columns are found from the names of the header line of the Gaia
+* archive (source_id, ra, dec, parallax, parallax_error, pmra, pmra_error,
+* pmdec, pmdec_error, phot_g_mean_mag, and wds or wds_name).
+* Without header, the columns are those of the former gaia_csv_nd:
+* source_id, ra, dec, parallax, phot_g_mean_mag, WDS name
+*
+* INPUT:
+* in_csv: name of the csv file (no limit on the length of the lines)
+*
+* OUTPUT:
+* sources: sources with valid coordinates
+*************************************************************************/
+int gaia_read_sources(char *in_csv, std::vector<GAIA_SOURCE> *sources)
+{
+GAIA_COLUMNS cols;
+GAIA_SOURCE src;
+GaiaCsvReader reader;
+char first_char;
+
+sources->clear();
+
+if(reader.Open(in_csv) != 0) return(-1);
+
+/* Default columns (without header): */
+memset(&cols, 0, sizeof(GAIA_COLUMNS));
+cols.source_id = 1;
+cols.ra = 2;
+cols.dec = 3;
+cols.paral = 4;
+cols.gmag = 5;
+cols.wds_name = 6;
+
+while(reader.ReadRow() == 0) {
+  if(reader.NFields() == 0) continue;
+  first_char = reader.Field(1)[0];
+  if(first_char == '#' || first_char == '%') continue;
+/* Header line: */
+  if(reader.LineNumber() == 1 && !isdigit(first_char) && first_char != '-') {
+    if(gaia_columns_from_header(&reader, &cols) != 0) {
+      fprintf(stderr, "gaia_read_sources/Error: ra and dec not found in the header of %s\n",
+              in_csv);
+      return(-1);
+      }
+    continue;
+    }
+  gaia_get_string(&reader, cols.source_id, src.source_id, 32);
+  gaia_get_string(&reader, cols.wds_name, src.wds_name, 32);
+  src.ra_deg = reader.DValue(cols.ra);
+  src.dec_deg = reader.DValue(cols.dec);
+  src.paral_mas = reader.DValue(cols.paral);
+  src.err_paral_mas = reader.DValue(cols.err_paral);
+  src.pmra_mas = reader.DValue(cols.pmra);
+  src.err_pmra_mas = reader.DValue(cols.err_pmra);
+  src.pmdec_mas = reader.DValue(cols.pmdec);
+  src.err_pmdec_mas = reader.DValue(cols.err_pmdec);
+  src.gmag = reader.DValue(cols.gmag);
+  if(!GAIA_IS_DATA(src.ra_deg) || !GAIA_IS_DATA(src.dec_deg)
+     || src.dec_deg < -90. || src.dec_deg > 90.) {
+#ifdef DEBUG
+    printf("gaia_read_sources/line #%d ignored (bad coordinates)\n",
+           reader.LineNumber());
+#endif
+    continue;
+    }
+/* RA in [0,360[: */
+  src.ra_deg = fmod(src.ra_deg, 360.);
+  if(src.ra_deg < 0.) src.ra_deg += 360.;
+  sources->push_back(src);
+  }
+
+printf("gaia_read_sources: %d sources read in %s (%d lines)\n",
+       (int)sources->size(), in_csv, reader.LineNumber());
+return(0);
+}
+/************************************************************************
+* Column numbers from the names of the header line
+* (0 if not found, returns -1 if RA or Dec are missing)
+*************************************************************************/
+static int gaia_columns_from_header(GaiaCsvReader *reader,
+                                    GAIA_COLUMNS *cols)
+{
+char name[64];
+int k, i, designation = 0;
+
+memset(cols, 0, sizeof(GAIA_COLUMNS));
+
+for(k = 0; k < reader->NFields(); k++) {
+  for(i = 0; i < 63 && reader->Field(k + 1)[i]; i++)
+    name[i] = tolower(reader->Field(k + 1)[i]);
+  name[i] = '\0';
+  if(!strcmp(name, "source_id")) cols->source_id = k + 1;
+  else if(!strcmp(name, "designation")) designation = k + 1;
+  else if(!strcmp(name, "ra")) cols->ra = k + 1;
+  else if(!strcmp(name, "dec")) cols->dec = k + 1;
+  else if(!strcmp(name, "parallax")) cols->paral = k + 1;
+  else if(!strcmp(name, "parallax_error")) cols->err_paral = k + 1;
+  else if(!strcmp(name, "pmra")) cols->pmra = k + 1;
+  else if(!strcmp(name, "pmra_error")) cols->err_pmra = k + 1;
+  else if(!strcmp(name, "pmdec")) cols->pmdec = k + 1;
+  else if(!strcmp(name, "pmdec_error")) cols->err_pmdec = k + 1;
+  else if(!strcmp(name, "phot_g_mean_mag")) cols->gmag = k + 1;
+  else if(!strcmp(name, "wds") || !strcmp(name, "wds_name")) cols->wds_name = k + 1;
+  }
+
+/* Gaia designation if no source_id: */
+if(cols->source_id == 0) cols->source_id = designation;
+
+if(cols->ra == 0 || cols->dec == 0) return(-1);
+return(0);
+}
+/************************************************************************
+* String of column icol ("" if not present)
+*************************************************************************/
+static void gaia_get_string(GaiaCsvReader *reader, int icol,
+                            char *out_string, int len_string)
+{
+strncpy(out_string, reader->Field(icol), len_string - 1);
+out_string[len_string - 1] = '\0';
+}
+/************************************************************************
+* Find all the pairs closer than par->rho_max
+*
+* INPUT:
+* sources: list of Gaia sources
+* par: maximum separation and parameters of the physical tests
+*
+* OUTPUT:
+* pairs: pairs sorted by RA of the primary (physical and unknown pairs,
+*        and also the optical pairs if par->keep_optical)
+*************************************************************************/
+int gaia_find_pairs(std::vector<GAIA_SOURCE> *sources, GAIA_PAIR_PARAM *par,
+                    std::vector<GAIA_PAIR> *pairs)
+{
+std::unordered_map<long long, std::vector<int> > cells;
+std::unordered_map<long long, std::vector<int> >::iterator it;
+std::vector<int> nra, idec;
+std::vector<int> *cell;
+GAIA_SOURCE *s1, *s2;
+GAIA_PAIR pair;
+double cell_deg, dec_max, cos_max, width, rho, theta;
+int nsrc, ndec, i, j, k, ib, ik, ik0, nk, jcell, nphysical, noptical;
+long long nra_max;
+
+pairs->clear();
+nsrc = sources->size();
+if(nsrc < 2 || par->rho_max <= 0.) return(0);
+
+/* Height of the declination bands (in degrees): */
+cell_deg = par->rho_max / 3600.;
+ndec = (int)ceil(180. / cell_deg);
+
+/* Number of cells in RA of each band: */
+nra.resize(ndec);
+nra_max = 1;
+for(ib = 0; ib < ndec; ib++) {
+  dec_max = MAXI(fabs(-90. + (ib - 1) * cell_deg),
+                fabs(-90. + (ib + 2) * cell_deg));
+  cos_max = (dec_max >= 90.) ? 0. : cos(dec_max * DEGTORAD);
+  nra[ib] = (int)MINI(floor(360. * cos_max / cell_deg), 1.e9);
+  if(nra[ib] < 1) nra[ib] = 1;
+  if(nra[ib] > nra_max) nra_max = nra[ib];
+  }
+
+/* Put the sources in the cells: */
+idec.resize(nsrc);
+for(i = 0; i < nsrc; i++) {
+  s1 = &(*sources)[i];
+  ib = (int)floor((s1->dec_deg + 90.) / cell_deg);
+  if(ib < 0) ib = 0;
+  if(ib >= ndec) ib = ndec - 1;
+  idec[i] = ib;
+  width = 360. / (double)nra[ib];
+  ik = (int)floor(s1->ra_deg / width) % nra[ib];
+  cells[ib * nra_max + ik].push_back(i);
+  }
+
+/* Compare each source with the sources of the 3 x 3 neighbouring cells: */
+nphysical = 0;
+noptical = 0;
+for(i = 0; i < nsrc; i++) {
+  s1 = &(*sources)[i];
+  for(ib = idec[i] - 1; ib <= idec[i] + 1; ib++) {
+    if(ib < 0 || ib >= ndec) continue;
+    width = 360. / (double)nra[ib];
+    ik0 = (int)floor(s1->ra_deg / width);
+    nk = MINI(3, nra[ib]);
+    for(k = 0; k < nk; k++) {
+      ik = (nra[ib] < 3) ? k : ((ik0 - 1 + k) % nra[ib] + nra[ib]) % nra[ib];
+      it = cells.find(ib * nra_max + ik);
+      if(it == cells.end()) continue;
+      cell = &(it->second);
+      for(jcell = 0; jcell < (int)cell->size(); jcell++) {
+        j = (*cell)[jcell];
+/* Each pair only once: */
+        if(j <= i) continue;
+        s2 = &(*sources)[j];
+/* Same source in two fields: */
+        if(s1->source_id[0] != '\0' && !strcmp(s1->source_id, s2->source_id))
+           continue;
+        gaia_rho_theta(s1->ra_deg, s1->dec_deg, s2->ra_deg, s2->dec_deg,
+                       &rho, &theta);
+        if(rho > par->rho_max) continue;
+/* The primary is the brightest star: */
+        if(GAIA_IS_DATA(s2->gmag)
+           && (!GAIA_IS_DATA(s1->gmag) || s2->gmag < s1->gmag)) {
+          pair.i1 = j;
+          pair.i2 = i;
+          theta = fmod(theta + 180., 360.);
+          } else {
+          pair.i1 = i;
+          pair.i2 = j;
+          }
+        pair.rho = rho;
+        pair.theta = theta;
+        gaia_test_pair(&(*sources)[pair.i1], &(*sources)[pair.i2], par, &pair);
+        if(pair.status == GAIA_PAIR_PHYSICAL) nphysical++;
+        if(pair.status == GAIA_PAIR_OPTICAL) {
+          noptical++;
+          if(!par->keep_optical) continue;
+          }
+        pairs->push_back(pair);
+        }
+      }
+    }
+  }
+
+/* Sort the pairs by RA of the primary: */
+std::sort(pairs->begin(), pairs->end(),
+          [sources](const GAIA_PAIR &p1, const GAIA_PAIR &p2) {
+            double ra1 = (*sources)[p1.i1].ra_deg;
+            double ra2 = (*sources)[p2.i1].ra_deg;
+            if(ra1 != ra2) return(ra1 < ra2);
+            if(p1.i1 != p2.i1) return(p1.i1 < p2.i1);
+            return(p1.i2 < p2.i2);
+          });
+
+printf("gaia_find_pairs: %d sources, %d cells, rho_max=%.2f\"\n", nsrc,
+       (int)cells.size(), par->rho_max);
+printf("gaia_find_pairs: %d physical pairs, %d optical pairs, %d unknown\n",
+       nphysical, noptical,
+       (int)pairs->size() - nphysical - (par->keep_optical ? noptical : 0));
+return(0);
+}
+/************************************************************************
+* Tests of the parallaxes and of the proper motions
+*
+* The parallaxes should agree within par->paral_nsigma sigmas,
+* the proper motions within par->pm_nsigma sigmas
+* or within a fraction par->pm_rel_max of the proper motion of the primary
+* (to allow for the orbital motion)
+*************************************************************************/
+static void gaia_test_pair(GAIA_SOURCE *s1, GAIA_SOURCE *s2,
+                           GAIA_PAIR_PARAM *par, GAIA_PAIR *pair)
+{
+double sigma, pm1;
+int ntests = 0, nfailed = 0;
+
+pair->dparal_sigma = -1.;
+pair->dpm_mas = -1.;
+pair->dpm_sigma = -1.;
+
+/* Parallaxes: */
+if(GAIA_IS_DATA(s1->paral_mas) && GAIA_IS_DATA(s2->paral_mas)
+   && GAIA_IS_DATA(s1->err_paral_mas) && GAIA_IS_DATA(s2->err_paral_mas)) {
+  sigma = sqrt(s1->err_paral_mas * s1->err_paral_mas
+               + s2->err_paral_mas * s2->err_paral_mas);
+  if(sigma > 0.) {
+    pair->dparal_sigma = fabs(s1->paral_mas - s2->paral_mas) / sigma;
+    ntests++;
+    if(pair->dparal_sigma > par->paral_nsigma) nfailed++;
+    }
+  }
+
+/* Proper motions: */
+if(GAIA_IS_DATA(s1->pmra_mas) && GAIA_IS_DATA(s2->pmra_mas)
+   && GAIA_IS_DATA(s1->pmdec_mas) && GAIA_IS_DATA(s2->pmdec_mas)) {
+  pair->dpm_mas = sqrt((s1->pmra_mas - s2->pmra_mas)
+                       * (s1->pmra_mas - s2->pmra_mas)
+                       + (s1->pmdec_mas - s2->pmdec_mas)
+                       * (s1->pmdec_mas - s2->pmdec_mas));
+  pm1 = sqrt(s1->pmra_mas * s1->pmra_mas + s1->pmdec_mas * s1->pmdec_mas);
+  sigma = 0.;
+  if(GAIA_IS_DATA(s1->err_pmra_mas) && GAIA_IS_DATA(s2->err_pmra_mas)
+     && GAIA_IS_DATA(s1->err_pmdec_mas) && GAIA_IS_DATA(s2->err_pmdec_mas))
+    sigma = sqrt(s1->err_pmra_mas * s1->err_pmra_mas
+                 + s2->err_pmra_mas * s2->err_pmra_mas
+                 + s1->err_pmdec_mas * s1->err_pmdec_mas
+                 + s2->err_pmdec_mas * s2->err_pmdec_mas);
+  if(sigma > 0.) pair->dpm_sigma = pair->dpm_mas / sigma;
+  ntests++;
+  if((pair->dpm_sigma < 0. || pair->dpm_sigma > par->pm_nsigma)
+     && pair->dpm_mas > par->pm_rel_max * pm1) nfailed++;
+  }
+
+if(nfailed > 0) pair->status = GAIA_PAIR_OPTICAL;
+else if(ntests == 2) pair->status = GAIA_PAIR_PHYSICAL;
+else pair->status = GAIA_PAIR_UNKNOWN;
+}
+/************************************************************************
+* Separation and position angle of the second star relative to the first
+*
+* INPUT:
+* ra1_deg, dec1_deg, ra2_deg, dec2_deg: coordinates in degrees
+*
+* OUTPUT:
+* rho: separation in arcseconds
+* theta: position angle in degrees, in [0,360[
+*        (from North and positive towards East)
+*************************************************************************/
+int gaia_rho_theta(double ra1_deg, double dec1_deg, double ra2_deg,
+                   double dec2_deg, double *rho, double *theta)
+{
+double dra, dec1, dec2, ww;
+
+dra = (ra2_deg - ra1_deg) * DEGTORAD;
+dec1 = dec1_deg * DEGTORAD;
+dec2 = dec2_deg * DEGTORAD;
+
+/* Haversine formula (accurate for small separations): */
+ww = sin((dec2 - dec1) / 2.) * sin((dec2 - dec1) / 2.)
+     + cos(dec1) * cos(dec2) * sin(dra / 2.) * sin(dra / 2.);
+ww = MINI(MAXI(ww, 0.), 1.);
+*rho = 2. * asin(sqrt(ww)) * 3600. / DEGTORAD;
+
+*theta = atan2(sin(dra) * cos(dec2),
+               cos(dec1) * sin(dec2) - sin(dec1) * cos(dec2) * cos(dra));
+*theta /= DEGTORAD;
+if(*theta < 0.) *theta += 360.;
+
+return(0);
+}
+/************************************************************************
+* Write the pairs in a LaTeX table
+*************************************************************************/
+int gaia_pairs_to_latex(FILE *fp_out, std::vector<GAIA_SOURCE> *sources,
+                        std::vector<GAIA_PAIR> *pairs)
+{
+GAIA_SOURCE *s1, *s2;
+GAIA_PAIR *pp;
+char gmag1[32], gmag2[32], paral1[32], paral2[32], dpm[32];
+int k;
+
+fprintf(fp_out, "\\begin{table} \n");
+fprintf(fp_out, "\\begin{tabular}{lllrrrrrrrl} \n");
+fprintf(fp_out, "\\hline \n");
+fprintf(fp_out, "WDS & Gaia primary & Gaia secondary & $G_1$ & $G_2$ & $\\rho$ & $\\theta$ & $\\pi_1$ & $\\pi_2$ & $\\Delta\\mu$ & \\\\ \n");
+fprintf(fp_out, " & & & (mag) & (mag) & (\\arcsec) & ($^\\circ$) & (mas) & (mas) & (mas/yr) & \\\\ \n");
+fprintf(fp_out, "\\hline \n");
+
+for(k = 0; k < (int)pairs->size(); k++) {
+  pp = &(*pairs)[k];
+  s1 = &(*sources)[pp->i1];
+  s2 = &(*sources)[pp->i2];
+  if(GAIA_IS_DATA(s1->gmag)) sprintf(gmag1, "%.2f", s1->gmag);
+   else strcpy(gmag1, "\\nodata");
+  if(GAIA_IS_DATA(s2->gmag)) sprintf(gmag2, "%.2f", s2->gmag);
+   else strcpy(gmag2, "\\nodata");
+  if(GAIA_IS_DATA(s1->paral_mas)) sprintf(paral1, "%.2f", s1->paral_mas);
+   else strcpy(paral1, "\\nodata");
+  if(GAIA_IS_DATA(s2->paral_mas)) sprintf(paral2, "%.2f", s2->paral_mas);
+   else strcpy(paral2, "\\nodata");
+  if(pp->dpm_mas >= 0.) sprintf(dpm, "%.2f", pp->dpm_mas);
+   else strcpy(dpm, "\\nodata");
+  fprintf(fp_out, "%s & %s & %s & %s & %s & %.3f & %.1f & %s & %s & %s & %s \\\\ \n",
+          (s1->wds_name[0] != '\0') ? s1->wds_name : "\\nodata",
+          s1->source_id, s2->source_id, gmag1, gmag2, pp->rho, pp->theta,
+          paral1, paral2, dpm,
+          (pp->status == GAIA_PAIR_PHYSICAL) ? "p"
+          : ((pp->status == GAIA_PAIR_OPTICAL) ? "o" : "?"));
+  }
+
+fprintf(fp_out, "\\hline \n");
+fprintf(fp_out, "\\end{tabular} \n");
+fprintf(fp_out, "\\end{table} \n");
+
+return(0);
+}
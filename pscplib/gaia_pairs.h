@@ -0,0 +1,74 @@
+/************************************************************************
+* "gaia_pairs.h"
+* Search for candidate double stars in a list of Gaia sources
+* (e.g., the csv export of a Gaia archive query)
+*
+* The sources are put in the cells of a RA/Dec grid whose size is
+* the maximum separation, so that each source is only compared with
+* the sources of the neighbouring cells (O(N) instead of O(N^2)).
+* The pairs are then tested for the consistency of the parallaxes
+* and of the proper motions.
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#ifndef __gaia_pairs_h   /* BOF sentry */
+#define __gaia_pairs_h
+
+#include <stdio.h>
+#include <vector>
+#include "gaia_xmatch.h"   // GAIA_NO_DATA
+
+typedef struct {
+  char source_id[32];    /* Gaia source identifier */
+  char wds_name[32];     /* WDS name (if available in the input file) */
+  double ra_deg, dec_deg;
+  double paral_mas, err_paral_mas;
+  double pmra_mas, err_pmra_mas, pmdec_mas, err_pmdec_mas;
+  double gmag;
+} GAIA_SOURCE;
+
+/* Column numbers in the csv file (starting at 1, 0 if not present): */
+typedef struct {
+  int source_id, ra, dec, paral, err_paral, pmra, err_pmra, pmdec, err_pmdec;
+  int gmag, wds_name;
+} GAIA_COLUMNS;
+
+/* Status of a pair: */
+#define GAIA_PAIR_PHYSICAL  1   /* Parallaxes and proper motions consistent */
+#define GAIA_PAIR_UNKNOWN   0   /* Not enough data for the tests */
+#define GAIA_PAIR_OPTICAL  -1   /* One of the tests has failed */
+
+typedef struct {
+  int i1, i2;            /* Indices of the primary (brightest) and secondary */
+  double rho, theta;     /* Separation (arcsec) and position angle (degrees) */
+  double dparal_sigma;   /* |paral1 - paral2| / sigma (-1 if unknown) */
+  double dpm_mas;        /* |pm1 - pm2| (mas/yr, -1 if unknown) */
+  double dpm_sigma;      /* |pm1 - pm2| / sigma (-1 if unknown) */
+  int status;            /* GAIA_PAIR_PHYSICAL, ... */
+} GAIA_PAIR;
+
+typedef struct {
+  double rho_max;        /* Maximum separation (arcsec) */
+  double paral_nsigma;   /* Maximum difference of the parallaxes (in sigma) */
+  double pm_nsigma;      /* Maximum difference of the proper motions (in sigma)*/
+  double pm_rel_max;     /* or relative difference of the proper motions */
+  int keep_optical;      /* 1 if the optical pairs are also kept */
+} GAIA_PAIR_PARAM;
+
+/* Default values: */
+#define GAIA_PAIR_RHO_MAX       10.
+#define GAIA_PAIR_PARAL_NSIGMA  3.
+#define GAIA_PAIR_PM_NSIGMA     3.
+#define GAIA_PAIR_PM_REL_MAX    0.2
+
+void gaia_pair_param_init(GAIA_PAIR_PARAM *par);
+int gaia_read_sources(char *in_csv, std::vector<GAIA_SOURCE> *sources);
+int gaia_find_pairs(std::vector<GAIA_SOURCE> *sources, GAIA_PAIR_PARAM *par,
+                    std::vector<GAIA_PAIR> *pairs);
+int gaia_rho_theta(double ra1_deg, double dec1_deg, double ra2_deg,
+                   double dec2_deg, double *rho, double *theta);
+int gaia_pairs_to_latex(FILE *fp_out, std::vector<GAIA_SOURCE> *sources,
+                        std::vector<GAIA_PAIR> *pairs);
+
+#endif   /* EOF sentry */
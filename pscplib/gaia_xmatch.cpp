@@ -0,0 +1,237 @@
+/************************************************************************
+* "gaia_xmatch.cpp"
+* Cross-match of Gaia data with the objects of a table
+* (see gaia_xmatch.h)
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>           // isdigit(), toupper()
+#include "gaia_xmatch.h"
+
+/*
+#define DEBUG
+*/
+
+/************************************************************************
+* Constructor
+*************************************************************************/
+GaiaCsvReader::GaiaCsvReader()
+{
+fp_in = NULL;
+line = NULL;
+len_line = 0;
+iline = 0;
+nfields = 0;
+ntruncated = 0;
+first_char = '\0';
+}
+/************************************************************************
+* Destructor
+*************************************************************************/
+GaiaCsvReader::~GaiaCsvReader()
+{
+Close();
+free(line);
+}
+/************************************************************************
+* Open a csv file
+*************************************************************************/
+int GaiaCsvReader::Open(char *fname)
+{
+Close();
+if((fp_in = fopen(fname, "r")) == NULL) {
+  fprintf(stderr, "GaiaCsvReader/Error opening %s\n", fname);
+  return(-1);
+  }
+iline = 0;
+ntruncated = 0;
+return(0);
+}
+/************************************************************************
+* Close the csv file
+*************************************************************************/
+void GaiaCsvReader::Close()
+{
+if(fp_in != NULL) fclose(fp_in);
+fp_in = NULL;
+nfields = 0;
+}
+/************************************************************************
+* Read the next row and split it into fields in one pass
+* (with csv_split_row(), so that the commas between quotes are not
+* separators)
+*
+* The quotes and the blanks at both ends of the fields are removed
+* (the fields are terminated in the line buffer).
+* Only the first CSV_NFIELDS_MAX fields are read (with a warning for
+* the first row that has more fields).
+*
+* OUTPUT:
+* 0 if a row was read, -1 at the end of the file
+*************************************************************************/
+int GaiaCsvReader::ReadRow()
+{
+int k;
+
+nfields = 0;
+first_char = '\0';
+if(fp_in == NULL || getline(&line, &len_line, fp_in) == -1) return(-1);
+iline++;
+first_char = line[0];
+
+csv_split_row(line, &row);
+if(row.truncated && ntruncated++ == 0)
+  fprintf(stderr, "GaiaCsvReader/Warning: line #%d has more than %d fields (the next ones are ignored)\n",
+          iline, CSV_NFIELDS_MAX);
+csv_trim_fields(&row);
+nfields = row.nfields;
+for(k = 0; k < nfields; k++) line[row.end[k]] = '\0';
+
+/* Empty line: */
+if(nfields == 1 && row.start[0] == row.end[0]) nfields = 0;
+
+return(0);
+}
+/************************************************************************
+* Field #icol of the current row (starting at 1, "" if not present)
+*************************************************************************/
+const char *GaiaCsvReader::Field(int icol)
+{
+if(icol < 1 || icol > nfields) return("");
+return(&line[row.start[icol - 1]]);
+}
+/************************************************************************
+* Value of field #icol (GAIA_NO_DATA if not present or not a number)
+*************************************************************************/
+double GaiaCsvReader::DValue(int icol)
+{
+const char *field;
+char *pc;
+double value;
+
+field = Field(icol);
+value = strtod(field, &pc);
+if(pc == field) return(GAIA_NO_DATA);
+
+return(value);
+}
+/************************************************************************
+* Constructor
+*
+* INPUT:
+* target_col0: column of the target names (starting at 1)
+* value_cols0[nvalues0]: columns of the values (starting at 1)
+*************************************************************************/
+GaiaTable::GaiaTable(int target_col0, int *value_cols0, int nvalues0)
+{
+int k;
+
+target_col = target_col0;
+nvalues = nvalues0;
+for(k = 0; k < nvalues; k++) value_cols.push_back(value_cols0[k]);
+}
+/************************************************************************
+* Load the data rows of a csv file
+* (the header rows do not start with a digit)
+*
+* INPUT:
+* csv_fname: name of the Gaia csv file
+*************************************************************************/
+int GaiaTable::Load(char *csv_fname)
+{
+GaiaCsvReader reader;
+char key1[64];
+int k, irow;
+
+target.clear();
+key.clear();
+values.clear();
+index.clear();
+
+if(reader.Open(csv_fname) != 0) return(-1);
+
+while(reader.ReadRow() == 0) {
+  if(!isdigit(reader.FirstChar())) continue;
+  irow = target.size();
+  target.push_back(reader.Field(target_col));
+  gaia_xmatch_key(reader.Field(target_col), key1, 64);
+  key.push_back(key1);
+  for(k = 0; k < nvalues; k++)
+    values.push_back(reader.DValue(value_cols[k]));
+/* First row of each target: */
+  if(key1[0] != '\0' && index.find(key1) == index.end()) index[key1] = irow;
+#ifdef DEBUG
+  printf("GaiaTable: irow=%d target=%s key=%s\n", irow, target[irow].c_str(),
+         key1);
+#endif
+  }
+
+printf("GaiaTable: %d rows (%d targets) read in %s\n", (int)target.size(),
+       (int)index.size(), csv_fname);
+return(0);
+}
+/************************************************************************
+* First row of the target "name" (-1 if not found)
+*************************************************************************/
+int GaiaTable::Find(const char *name)
+{
+std::unordered_map<std::string, int>::iterator it;
+char key1[64];
+
+gaia_xmatch_key(name, key1, 64);
+it = index.find(key1);
+if(it == index.end()) return(-1);
+
+return(it->second);
+}
+/************************************************************************
+* Rows of a list of names
+*
+* INPUT:
+* names: list of names (e.g., WDS names of a LaTeX table)
+*
+* OUTPUT:
+* irows: row of each name (-1 if not found)
+* returns the number of names that were found
+*************************************************************************/
+int GaiaTable::Join(std::vector<std::string> *names, std::vector<int> *irows)
+{
+int i, nfound = 0;
+
+irows->resize(names->size());
+for(i = 0; i < (int)names->size(); i++) {
+  (*irows)[i] = Find((*names)[i].c_str());
+  if((*irows)[i] >= 0) nfound++;
+  }
+
+return(nfound);
+}
+/************************************************************************
+* Key of a target name: without blanks, quotes, dollars
+* and "WDS" prefix, truncated to GAIA_XMATCH_KEY_LEN characters
+* Example: "WDS 23167+2959" -> 23167+2959
+*************************************************************************/
+void gaia_xmatch_key(const char *name, char *key, int len_key)
+{
+int i, j, len_max;
+
+len_max = (len_key - 1 < GAIA_XMATCH_KEY_LEN) ? len_key - 1
+                                               : GAIA_XMATCH_KEY_LEN;
+j = 0;
+for(i = 0; name[i] != '\0' && j < len_max; i++) {
+  if(name[i] == ' ' || name[i] == '\t' || name[i] == '"' || name[i] == '$'
+     || name[i] == '\n' || name[i] == '\r') continue;
+/* "WDS" prefix: */
+  if(j == 0 && toupper(name[i]) == 'W' && toupper(name[i + 1]) == 'D'
+     && toupper(name[i + 2]) == 'S') {
+    i += 2;
+    continue;
+    }
+  key[j++] = name[i];
+  }
+key[j] = '\0';
+}
@@ -0,0 +1,92 @@
+/************************************************************************
+* "gaia_xmatch.h"
+* Cross-match of Gaia data (csv files of the Gaia archive) with the
+* objects of a table (e.g., the WDS names of a LaTeX table)
+*
+* GaiaCsvReader: reads a csv file row by row (no limit on the length
+*   of the lines), and splits each row into fields in one pass
+*   (with csv_split_row() of csv_row.h)
+* GaiaTable: target name and selected columns of the rows of a Gaia csv
+*   file, with a hash index on the target names, so that each object of
+*   a table is found in constant time (Find() or Join() for a list)
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#ifndef __gaia_xmatch_h   /* BOF sentry */
+#define __gaia_xmatch_h
+
+#include <stdio.h>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include "csv_row.h"      // CSV_ROW
+
+/* Value of the missing data: */
+#define GAIA_NO_DATA  -1000000.
+#define GAIA_IS_DATA(x) ((x) > GAIA_NO_DATA + 1.)
+
+/* Length of the keys used for the WDS names (e.g., "23167+2959"): */
+#define GAIA_XMATCH_KEY_LEN 10
+
+class GaiaCsvReader {
+
+public:
+    GaiaCsvReader();
+    ~GaiaCsvReader();
+
+    int Open(char *fname);
+    void Close();
+// Read and split the next row (returns -1 at the end of the file):
+    int ReadRow();
+
+    int LineNumber() { return(iline); }
+    int NFields() { return(nfields); }
+// First character of the row (before splitting):
+    char FirstChar() { return(first_char); }
+// Field #icol (starting at 1, "" if not present):
+    const char *Field(int icol);
+// Value of field #icol (GAIA_NO_DATA if not present or not a number):
+    double DValue(int icol);
+
+private:
+    FILE *fp_in;
+    char *line, first_char;
+    size_t len_line;
+    int iline, nfields, ntruncated;
+    CSV_ROW row;
+};
+
+class GaiaTable {
+
+public:
+// target_col: column of the target names (starting at 1)
+// value_cols[nvalues]: columns of the values to be loaded
+    GaiaTable(int target_col0, int *value_cols0, int nvalues0);
+    ~GaiaTable() {};
+
+// Load the data rows of a csv file (rows starting with a digit):
+    int Load(char *csv_fname);
+
+    int NRows() { return((int)target.size()); }
+    const char *Target(int irow) { return(target[irow].c_str()); }
+    const char *Key(int irow) { return(key[irow].c_str()); }
+    double Value(int irow, int k) { return(values[irow * nvalues + k]); }
+
+// First row of the target "name" (-1 if not found):
+    int Find(const char *name);
+// Rows of a list of names (-1 if not found), returns the number found:
+    int Join(std::vector<std::string> *names, std::vector<int> *irows);
+
+private:
+    int target_col, nvalues;
+    std::vector<int> value_cols;
+    std::vector<std::string> target, key;
+    std::vector<double> values;
+    std::unordered_map<std::string, int> index;
+};
+
+/* Accessory routines: */
+void gaia_xmatch_key(const char *name, char *key, int len_key);
+
+#endif   /* EOF sentry */
@@ -2,11 +2,14 @@
 * jlp_calib_table.ccp
 *
 * JLP
-* Version 03/03/2023
+* Version 17/10/2026
 *********************************************************************/
 #include  <stdio.h>
 #include  <ctype.h>   // isdigit()
 #include  <string.h>  // strcpy()
+#include  <vector>
+#include  <string>
+#include  <queue>     // std::priority_queue
 #include "jlp_calib_table.h"
 #include "jlp_string.h"
 #include "latex_utils.h"
@@ -14,11 +17,17 @@
 
 /***********************************************************************
 * Constructor 
+*
+* INPUT:
+* calib_table_fname0: name of the calibrated table
+* calib_format: CALIB_FORMAT_PISCO (epoch in column 4, after the ADS number)
+*               or CALIB_FORMAT_GILI (epoch in column 3)
 ************************************************************************/
-JLP_CalibTab::JLP_CalibTab(char *calib_table_fname0) {
+JLP_CalibTab::JLP_CalibTab(char *calib_table_fname0, int calib_format) {
 
  strcpy(calib1_fname, calib_table_fname0);
  iline1 = 0;
+ epoch_column = (calib_format == CALIB_FORMAT_GILI) ? 3 : 4;
 
  /* Open input calibrated table: */
 if((fp_calib1 = fopen(calib1_fname, "r")) == NULL) {
@@ -66,3 +75,116 @@ while(!feof(fp_calib1)) {
 
 return(status);
 }
+/***********************************************************************
+* Look for next line with double star measurement,
+* and read the epoch of the measurement in column epoch_column
+* (epoch = 0. if not available)
+************************************************************************/
+int JLP_CalibTab::NextLineWithMeasurements(char *full_line, 
+                             double *WDS_alpha, double *WDS_delta,
+                             double *epoch) {
+int status, verbose_if_error = 0;
+
+*epoch = 0.;
+status = NextLineWithMeasurements(full_line, WDS_alpha, WDS_delta);
+if(status == 0) {
+  if(latex_read_dvalue(full_line, epoch, epoch_column, verbose_if_error) != 0) 
+     *epoch = 0.;
+  }
+
+return(status);
+}
+/***********************************************************************
+* Current line of one of the tables to be merged 
+* (ordered by WDS alpha, delta, epoch, and then by rank of the table, 
+* so that the lines with the same key keep the order of the input tables)
+************************************************************************/
+typedef struct {
+  double alpha, delta, epoch;
+  int itable;
+} CALIB_MERGE_HEAD;
+
+struct CalibMergeAfter {
+  bool operator()(const CALIB_MERGE_HEAD &h1, 
+                  const CALIB_MERGE_HEAD &h2) const {
+    if(h1.alpha != h2.alpha) return(h1.alpha > h2.alpha);
+    if(h1.delta != h2.delta) return(h1.delta > h2.delta);
+    if(h1.epoch != h2.epoch) return(h1.epoch > h2.epoch);
+    return(h1.itable > h2.itable);
+  }
+};
+/***********************************************************************
+* Merge N calibrated tables in a single pass
+* Each table should be sorted by WDS name (i.e., by right ascension):
+* only its current line is kept in memory, and the next line to be 
+* written is taken from a heap with the current lines of all the tables.
+* The lines of a given table are written in their input order:
+* WDS alpha, delta and epoch only decide how the tables are interleaved.
+*
+* INPUT:
+* calib_fnames: names of the input calibrated tables
+* ntables: number of input tables
+* calib_format: format of the input tables (CALIB_FORMAT_PISCO 
+*               or CALIB_FORMAT_GILI), for reading the epoch
+* fp_out: pointer to the output Latex file (already opened)
+* nlines_per_page: number of objects between \jlpBeginTable and \jlpEndTable
+*
+* OUTPUT:
+* nlines_out: number of lines with measurements written to fp_out
+************************************************************************/
+int JLP_CalibTab_merge(char **calib_fnames, int ntables, int calib_format,
+                       FILE *fp_out, int nlines_per_page, int *nlines_out)
+{
+std::vector<JLP_CalibTab *> tabs;
+std::vector<std::string> lines;
+std::priority_queue<CALIB_MERGE_HEAD, std::vector<CALIB_MERGE_HEAD>,
+                    CalibMergeAfter> heap;
+CALIB_MERGE_HEAD head;
+char in_line[256];
+int i, status = 0;
+
+*nlines_out = 0;
+if(nlines_per_page <= 0) nlines_per_page = CALIB_MERGE_NLINES_PER_PAGE;
+
+tabs.resize(ntables);
+lines.resize(ntables);
+for(i = 0; i < ntables; i++) {
+  tabs[i] = new JLP_CalibTab(calib_fnames[i], calib_format);
+  if(!tabs[i]->IsOpen()) {
+    fprintf(stderr, "JLP_CalibTab_merge/Fatal error reading %s\n", 
+            calib_fnames[i]);
+    status = -1;
+    break;
+    }
+  head.itable = i;
+  if(tabs[i]->NextLineWithMeasurements(in_line, &head.alpha, &head.delta,
+                                       &head.epoch) == 0) {
+    lines[i] = in_line;
+    heap.push(head);
+    }
+  }
+
+if(status == 0) {
+  fprintf(fp_out, "\\jlpBeginTable0 \n");
+  while(!heap.empty()) {
+    head = heap.top();
+    heap.pop();
+    i = head.itable;
+    if((*nlines_out > 0) && (*nlines_out % nlines_per_page == 0))
+       fprintf(fp_out, "\\jlpEndTable \n\\jlpBeginTable \n");
+    fprintf(fp_out, "%s \n", lines[i].c_str());
+    (*nlines_out)++;
+// Next line of the same table:
+    if(tabs[i]->NextLineWithMeasurements(in_line, &head.alpha, &head.delta,
+                                         &head.epoch) == 0) {
+      lines[i] = in_line;
+      heap.push(head);
+      }
+    }
+  fprintf(fp_out, "\\jlpEndTableE \n");
+  }
+
+for(i = 0; i < ntables; i++) if(tabs[i] != NULL) delete tabs[i];
+
+return(status);
+}
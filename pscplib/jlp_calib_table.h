@@ -2,26 +2,50 @@
 * jlp_calib_table.h
 *
 * JLP
-* Version 03/03/2023
+* Version 17/10/2026
 *********************************************************************/
 #ifndef __jlp_calib_table_h // BOF sentry
 #define  __jlp_calib_table_h
 
+#include <stdio.h>
+
+// Default number of objects per page (between \jlpBeginTable and
+// \jlpEndTable) of the merged tables (60: too many)
+#define CALIB_MERGE_NLINES_PER_PAGE 50
+
+// Formats of the calibrated tables (column of the epoch):
+// PISCO: WDS & Name & ADS & Epoch & ... (epoch in column 4)
+// Gili's and Calern's: WDS & Name & Epoch & ... (epoch in column 3)
+#define CALIB_FORMAT_PISCO 0
+#define CALIB_FORMAT_GILI  1
+
 class JLP_CalibTab {
 
 public:
-    JLP_CalibTab(char *calib_table_fname0); 
-    ~JLP_CalibTab() {}; 
+    JLP_CalibTab(char *calib_table_fname0, 
+                 int calib_format = CALIB_FORMAT_PISCO); 
+    ~JLP_CalibTab() { if(fp_calib1 != NULL) fclose(fp_calib1); }; 
+
+    int IsOpen() { return(fp_calib1 != NULL); }
+    const char *Filename() { return(calib1_fname); }
 
 // Look for next line with double star measurement:
     int NextLineWithMeasurements(char *full_line, 
                                  double *WDS_alpha, double *WDS_delta);
+// Same, with the epoch of the measurement (column 3 or 4, see calib_format):
+    int NextLineWithMeasurements(char *full_line, double *WDS_alpha, 
+                                 double *WDS_delta, double *epoch);
 
 private:
    char calib1_fname[128];
    FILE *fp_calib1;
-   int iline1;
+   int iline1, epoch_column;
 
 };
 
+// Merge N calibrated tables sorted by WDS name into fp_out
+// (the lines of each table keep their order):
+int JLP_CalibTab_merge(char **calib_fnames, int ntables, int calib_format,
+                       FILE *fp_out, int nlines_per_page, int *nlines_out);
+
 #endif //EOF sentry
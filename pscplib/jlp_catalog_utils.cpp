@@ -16,6 +16,7 @@
 */
 #include "jlp_catalog_utils.h"
 #include "latex_utils.h"  // latex_get_column_item()
+#include "RESID_table.h"
 
 /*
 #define DEBUG 
@@ -804,6 +805,8 @@ return(0);
 * rho_o_c (arcsec), theta_o_c (deg): residuals O-C in rho and theta 
 * quadrant_discrep: "\rlap{$^Q}$" when discrepancy between measure and orbit
 * norbits_found: number of orbits found
+*
+* The table is read only once (see RESIDTable in "RESID_table.cpp")
 ***********************************************************************/
 int get_values_from_RESID_table(char *resid_fname, char *object_name,
                                 char *comp_name, double epoch_o, double rho_o,
@@ -812,139 +815,29 @@ int get_values_from_RESID_table(char *resid_fname, char *object_name,
                                 double *theta_o_c, char *quadrant_discrep,
                                 int *norbits_found, int nmax_orbits)
 {
-char in_line[128], object_name0[128], *pc, orbit_grade_str0[128];
-double epoch_o_c, rho_val0, rho0, theta0;
-int status, iline, verbose_if_error = 1, kk, orbit_grade0;
-char orbit_ref0[40], comp_name0[40], comp_name1[40], object_name1[40];
-char old_orbit_ref[40];
-char quadr0[20];
-int comp_is_AB, comp0_is_AB;
-FILE *fp_resid_table;
+RESIDTable *resid_table;
+int kk;
 
 *orbit_grade = 0;
 *rho_o_c = -100.;
 *theta_o_c = -100.;
+*norbits_found = 0;
 for(kk = 0; kk < nmax_orbits; kk++) strcpy(&orbit_ref[kk*ref_slength], "");
 
 strcpy(quadrant_discrep, "");
 
-/* Generate full object name:
-   ADS 123 AB, STF 128 AB
-*/
-/* Remove all blanks: */
-strcpy(object_name1, object_name);
-jlp_compact_string(object_name1, 40);
-strcpy(comp_name1, comp_name);
-jlp_compact_string(comp_name1, 40);
-if(!strcmp(comp_name1, "AB") || *comp_name1 == '\0') comp_is_AB = 1;
- else comp_is_AB = 0;
-
 #ifdef DEBUG
-  printf("get_values: object_name=%s comp=%s\n", object_name1, comp_name1);
+  printf("get_values: object_name=%s comp=%s\n", object_name, comp_name);
 #endif
 
-/* Open LaTeX RESID table: */
-if((fp_resid_table = fopen(resid_fname, "r")) == NULL) {
-  fprintf(stderr, "get_values_from_RESID_table/Error opening %s\n", 
-          resid_fname);
-  return(-1);
- }
-
-/* Scan all the file looking for the object name */ 
-strcpy(old_orbit_ref,"none");
-iline = 0;
-kk = 0;
-while(!feof(fp_resid_table)){
-  if(fgets(in_line, 128, fp_resid_table)) {
-  iline++;
-  if(in_line[0] != '%' && in_line[0] != '\\' && in_line[0] != ' '
-     && in_line[0] != '&') {
-    status = latex_get_column_item(in_line, object_name0, 1, verbose_if_error);
-    if(status) {
-      fprintf(stderr, "Fatal error/Bad syntax of %s in line %d\n",
-              resid_fname, iline); 
-      exit(-1);
-      }
-    jlp_compact_string(object_name0, 40);
-/* Extract the companion and cut the object name: */
-      comp_name[0] = '\0';
-       if(*object_name0) {
-          pc = object_name0;
-          while(*pc  && (isalpha(*pc) || *pc == ' ')) pc++;
-          while(*pc  && (isdigit(*pc) || *pc == ' ')) pc++;
-          strcpy(comp_name0, pc);
-          *pc = '\0';
-        }
-      jlp_compact_string(comp_name0, 40);
-      if(!strcmp(comp_name0, "AB") || *comp_name0 == '\0') comp0_is_AB = 1;
-      else comp0_is_AB = 0;
- 
-/*
-printf("object_name=%s< object_name0=%s<\n", object_name1, object_name0);
-printf("comp_name=%s< comp_name0=%s<\n", comp_name1, comp_name0);
-printf("comp_is_AB=%d< comp0_is_AB=%d<\n", comp_is_AB, comp0_is_AB);
-*/
-/* Process only the meaningful lines (skipping the header...)*/
-      if( 
-       (!strcmp(object_name1, object_name0) && comp0_is_AB && comp_is_AB )
-       || (!strcmp(object_name1, object_name0) && !strcmp(comp_name0, comp_name1))
-        ) {
-         status = read_values_from_RESID_line(in_line, &epoch_o_c, 
-                                             &rho_val0, &rho0, &theta0);
-        if(status) {
-           fprintf(stderr, "Fatal error/Bad syntax of %s in line %d\n",
-                   resid_fname, iline); 
-           exit(-1);
-           }
-// Orbit grade in column 8:
-        latex_get_column_item(in_line, orbit_grade_str0, 8, verbose_if_error);
-        sscanf(orbit_grade_str0, "%d", &orbit_grade0);
-
-// Orbit reference in column 2:
-        latex_get_column_item(in_line, orbit_ref0, 2, verbose_if_error);
-
-#ifdef DEBUG
-        printf("DEBUG/ epoch_o_c=%f rho_val0=%f orbit_grade=%d ref0=%s ref=%s\n", 
-               epoch_o_c, rho_val0, orbit_grade0, orbit_ref0, old_orbit_ref); 
-#endif
-
-/* Truncate to the first word only 
-* Cou1973b - Couteau (1973b)    => Cou1973b
-*/
-        jlp_trim_string(orbit_ref0, 60);
-/* If the epochs are equal, the rho are equal, and orbit_ref is new, 
-*  load the values of this orbit: */
-        if( (ABS(epoch_o_c - epoch_o) < 0.002 ) 
-            && (ABS(rho_o - rho_val0) < 0.002) 
-           && (strcmp(orbit_ref0, old_orbit_ref) != 0)) {
-/* DEBUG
-printf("get_values_from_RESID_table/DEBUG: object=>%s epoch_o=%f epoch_o_c=%f (old_orbit_ref=%s) rho_val0=%f rho_o-c=%f\n", 
-        object_name1, epoch_o, epoch_o_c, old_orbit_ref, rho_val0, rho0);
-*/
-
-          strcpy(old_orbit_ref, orbit_ref0);
-          rho_o_c[kk] = rho0;
-          theta_o_c[kk] = theta0;
-          strcpy(quadr0, "$^Q$");
-          if(is_in_line(in_line, quadr0)){
-            strcpy(quadrant_discrep, "\\rlap{$^Q$}");
-            }
-
-          strcpy(&orbit_ref[kk * ref_slength], orbit_ref0);
-          *orbit_grade = orbit_grade0;
-
-          kk++;
-/*      break; */
-/* JLP2011: read subsequent lines now to allow multiple orbits... */
-        }
-    } /* EOF !strcmp(object_name_0)... */
-  } /* EOF in_line[0] != '%' */
-  } /* EOF fgets() */
-} /* EOF while */
+/* LaTeX RESID table (read only once, when called for the first line): */
+resid_table = RESIDTable_get_cached(resid_fname);
+if(resid_table == NULL) return(-1);
 
-*norbits_found = kk;
+resid_table->GetValues(object_name, comp_name, epoch_o, rho_o, orbit_ref,
+                       orbit_grade, ref_slength, rho_o_c, theta_o_c,
+                       quadrant_discrep, norbits_found, nmax_orbits);
 
-fclose(fp_resid_table);
 return(0);
 }
 /***************************************************************************
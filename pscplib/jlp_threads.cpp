@@ -0,0 +1,130 @@
+/************************************************************************
+* "jlp_threads.cpp"
+* Simple pool of threads used to process independent items
+* in parallel (see jlp_threads.h)
+*
+* Contained here:
+* int jlp_threads_from_args(int *argc, char **argv);
+* int jlp_threads_available(void);
+* int jlp_parallel_for(int nitems, int nthreads, JLP_WORKER worker,
+*                      void *data);
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>    // atoi()
+#include <string.h>    // strcmp()
+#include <vector>
+#include <thread>
+#include <atomic>
+#include "jlp_threads.h"
+
+/*
+#define DEBUG
+*/
+
+/* Arguments of the threads started by jlp_parallel_for(): */
+typedef struct {
+  std::atomic<int> *next_item;
+  int nitems;
+  JLP_WORKER worker;
+  void *data;
+} JLP_POOL;
+
+/*************************************************************************
+* Read the "-j N" (or "-jN") option and remove it from the arguments
+*
+* INPUT/OUTPUT:
+* argc, argv: arguments of the program
+*
+* RETURN: number of threads to be used (1 if no option,
+*         all the available cores if N <= 0)
+*************************************************************************/
+int jlp_threads_from_args(int *argc, char **argv)
+{
+int i, k, nthreads = 1, nargs;
+
+for(i = 1; i < *argc; i++) {
+  nargs = 0;
+  if(!strcmp(argv[i], "-j") && i + 1 < *argc) {
+    nthreads = atoi(argv[i + 1]);
+    nargs = 2;
+  } else if(!strncmp(argv[i], "-j", 2) && argv[i][2] != '\0'
+            && (argv[i][2] == '-' || (argv[i][2] >= '0' && argv[i][2] <= '9'))) {
+    nthreads = atoi(&argv[i][2]);
+    nargs = 1;
+  }
+  if(nargs > 0) {
+    for(k = i; k + nargs < *argc; k++) argv[k] = argv[k + nargs];
+    *argc -= nargs;
+    argv[*argc] = NULL;
+    i--;
+    }
+  }
+
+if(nthreads <= 0) nthreads = jlp_threads_available();
+
+#ifdef DEBUG
+printf("jlp_threads_from_args: nthreads=%d\n", nthreads);
+#endif
+
+return(nthreads);
+}
+/*************************************************************************
+* Number of cores available (1 if unknown)
+*************************************************************************/
+int jlp_threads_available(void)
+{
+int ncores;
+
+ncores = (int)std::thread::hardware_concurrency();
+if(ncores < 1) ncores = 1;
+
+return(ncores);
+}
+/*************************************************************************
+* Loop of a thread: process the next items, until all have been processed
+*************************************************************************/
+static void jlp_pool_loop(JLP_POOL *pool)
+{
+int k;
+
+while((k = (*pool->next_item)++) < pool->nitems) (*pool->worker)(k, pool->data);
+}
+/*************************************************************************
+* Call worker(k, data) for k = 0 to nitems-1, with nthreads threads
+* (the items are distributed one by one to the threads that are free,
+*  in increasing order)
+* With nthreads = 1, the items are processed in the calling thread.
+*
+* RETURN: 0 if OK
+*************************************************************************/
+int jlp_parallel_for(int nitems, int nthreads, JLP_WORKER worker, void *data)
+{
+std::vector<std::thread> threads;
+std::atomic<int> next_item(0);
+JLP_POOL pool;
+int i;
+
+if(nthreads > nitems) nthreads = nitems;
+
+if(nthreads <= 1) {
+  for(i = 0; i < nitems; i++) (*worker)(i, data);
+  return(0);
+  }
+
+pool.next_item = &next_item;
+pool.nitems = nitems;
+pool.worker = worker;
+pool.data = data;
+
+for(i = 0; i < nthreads - 1; i++)
+  threads.push_back(std::thread(jlp_pool_loop, &pool));
+/* The calling thread also processes items: */
+jlp_pool_loop(&pool);
+
+for(i = 0; i < (int)threads.size(); i++) threads[i].join();
+
+return(0);
+}
@@ -0,0 +1,33 @@
+/************************************************************************
+* "jlp_threads.h"
+* Simple pool of threads used to process independent items
+* (objects, orbits, files...) in parallel, from C or C++ programs
+*
+* The programs using these routines have a "-j N" option
+* (number of threads, 1 by default, 0 for all the available cores).
+* The results are stored by the workers in arrays indexed by the item
+* number, and written in the original order by the calling program,
+* so that the output files do not depend on the number of threads.
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#ifndef __jlp_threads_h   /* BOF sentry */
+#define __jlp_threads_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Prototype of the routine processing item #k: */
+typedef void (*JLP_WORKER)(int k, void *data);
+
+int jlp_threads_from_args(int *argc, char **argv);
+int jlp_threads_available(void);
+int jlp_parallel_for(int nitems, int nthreads, JLP_WORKER worker, void *data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   /* EOF sentry */
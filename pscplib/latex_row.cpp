@@ -0,0 +1,273 @@
+/************************************************************************
+* "latex_row.cpp"
+* View of a line of a LaTeX table, tokenized only once (see latex_row.h)
+*
+* latex_read_svalue(), latex_read_dvalue(), latex_get_column_item(), etc.
+* (in "latex_utils.cpp") are now based on this class. When many columns
+* are read from the same line, a LatexRow object should be used directly,
+* so that the line is scanned only once.
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#include <stdio.h>
+#include <string.h>    // strlen()
+#include "latex_row.h"
+#include "astrom_def.h"  // NO_DATA
+
+/*
+#define DEBUG
+*/
+
+/*************************************************************************
+* Tokenize a new line: positions of the '&' separators before "\\",
+* and of the end of the row
+*************************************************************************/
+void LatexRow::Set(const char *line0)
+{
+int i;
+
+line = line0;
+amp_pos.clear();
+icr = -1;
+terminated = 0;
+
+for(i = 0; line[i] != '\0'; i++) {
+  if(line[i] == '&') {
+    amp_pos.push_back(i);
+  } else if(line[i] == '\\') {
+    if(line[i+1] == '\\') {
+      terminated = 1;
+      break;
+      }
+    if(icr < 0 && line[i+1] == 'c' && line[i+2] == 'r') icr = i;
+  }
+}
+iend = i;
+if(icr < 0) icr = iend;
+
+/* Number of columns before "\cr" (amp_pos is sorted): */
+ncols_cr = 1;
+while(ncols_cr <= (int)amp_pos.size() && amp_pos[ncols_cr - 1] < icr)
+  ncols_cr++;
+}
+/*************************************************************************
+* Column #icol as delimited by latex_get_column_item():
+* from the previous '&' (or the beginning of the line) to the next '&',
+* "\cr", "\\" (or the end of the line)
+*
+* OUTPUT:
+* span: start and length of the column in the line
+* RETURN: 0 if OK, -1 if not found
+*************************************************************************/
+int LatexRow::Item(int icol, LATEX_SPAN *span)
+{
+int istart, iend1;
+
+span->ptr = line;
+span->len = 0;
+if(icol < 1 || icol > ncols_cr) return(-1);
+
+istart = (icol == 1) ? 0 : amp_pos[icol - 2] + 1;
+iend1 = (icol < ncols_cr) ? amp_pos[icol - 1] : icr;
+span->ptr = line + istart;
+span->len = iend1 - istart;
+
+return(0);
+}
+/*************************************************************************
+* Column #icol as delimited by latex_read_svalue():
+* the last column should be terminated by "\\", and "\cr" is not
+* considered as the end of the row
+*
+* OUTPUT:
+* span: start and length of the value in the line (empty if status != 0)
+* RETURN: 0 if OK, 1 if empty or not terminated, -1 if not found
+*************************************************************************/
+int LatexRow::Value(int icol, LATEX_SPAN *span)
+{
+int istart, iend1, ncols;
+
+span->ptr = line;
+span->len = 0;
+ncols = NColumns();
+if(icol < 1 || icol > ncols) return(-1);
+
+istart = (icol == 1) ? 0 : amp_pos[icol - 2] + 1;
+/* Nothing after the last '&': */
+if(istart >= iend) return(-1);
+
+if(icol < ncols) {
+  iend1 = amp_pos[icol - 1];
+} else {
+  if(!terminated) return(1);
+  iend1 = iend;
+}
+if(iend1 == istart) return(1);
+
+span->ptr = line + istart;
+span->len = iend1 - istart;
+
+return(0);
+}
+/*************************************************************************
+* Same interface and same output as latex_get_column_item()
+*************************************************************************/
+int LatexRow::GetItem(int icol, char *item, int verbose_if_error)
+{
+LATEX_SPAN span;
+
+if(Item(icol, &span)) {
+  if(verbose_if_error != 0) {
+printf("verbose_if_error=%d\n", verbose_if_error);
+     fprintf(stderr, "latex_get_column_item/Error: column #%d not found in >%s<\n",
+             icol, line);
+     }
+  return(-1);
+  }
+
+memcpy(item, span.ptr, span.len);
+item[span.len] = '\0';
+
+return(0);
+}
+/*************************************************************************
+* Same output as latex_read_svalue()
+*
+* OUTPUT:
+* value: content of the column ('\r' replaced by ' '), or "" if error
+* RETURN: 0 if OK, 1 if empty, 3 if "\nodata", -1 if not found
+*************************************************************************/
+int LatexRow::GetString(int icol, char *value)
+{
+LATEX_SPAN span;
+int i, status;
+
+status = Value(icol, &span);
+
+for(i = 0; i < span.len; i++)
+  value[i] = (span.ptr[i] == '\r') ? ' ' : span.ptr[i];
+value[span.len] = '\0';
+
+// Look for "\nnodata" string:
+if(status == 0 && strstr(value, "nodata") != NULL) status = 3;
+
+return(status);
+}
+/*************************************************************************
+* Column #icol copied to a small buffer, for the numerical values
+*
+* RETURN: same status as GetString()
+*************************************************************************/
+int LatexRow::NumericValue(int icol, char *buff, int buff_len)
+{
+LATEX_SPAN span;
+int i, status;
+
+status = Value(icol, &span);
+if(status == 0) {
+// Look for "\nnodata" string:
+  for(i = 0; i + 6 <= span.len; i++) {
+    if(!strncmp(&span.ptr[i], "nodata", 6)) {
+      status = 3;
+      break;
+      }
+    }
+  if(span.len > buff_len - 1) span.len = buff_len - 1;
+  }
+
+memcpy(buff, span.ptr, span.len);
+buff[span.len] = '\0';
+
+return(status);
+}
+/*************************************************************************
+* Same output as latex_read_dvalue()
+*
+* INPUT:
+* iverbose : (i = 1 verbose if error)
+*           (i > 1 verbose if error and even if no error)
+*************************************************************************/
+int LatexRow::GetDouble(int icol, double *value, int iverbose)
+{
+char buff[64];
+int ival, status;
+
+*value = 0.;
+status = NumericValue(icol, buff, 64);
+if(status == 3) {
+  *value = NO_DATA;
+} else if(status == 0) {
+  ival = sscanf(buff, "%lf", value);
+  if(ival <= 0) {
+    if(iverbose > 1) printf("latex_read_dvalue/buff=>%s< value=%.2f ival=%d\n", buff, *value, ival);
+    status = 1;
+    }
+}
+
+return(status);
+}
+/*************************************************************************
+* Same output as latex_read_fvalue()
+*************************************************************************/
+int LatexRow::GetFloat(int icol, float *value, int iverbose)
+{
+char buff[64];
+int ival, status;
+
+*value = 0.;
+status = NumericValue(icol, buff, 64);
+if(status == 3) {
+  *value = NO_DATA;
+} else if(status == 0) {
+  ival = sscanf(buff, "%f", value);
+  if(ival <= 0) {
+    if(iverbose > 1) printf("latex_read_fvalue/buff=>%s< value=%.2f ival=%d\n", buff, *value, ival);
+    status = 1;
+    }
+}
+
+return(status);
+}
+/*************************************************************************
+* Same output as latex_read_ivalue()
+*************************************************************************/
+int LatexRow::GetInt(int icol, int *value)
+{
+char buff[64];
+int ival, status;
+
+*value = 0;
+status = NumericValue(icol, buff, 64);
+if(status == 3) {
+  *value = NO_DATA;
+} else if(status == 0) {
+  ival = sscanf(buff, "%d", value);
+  if(ival <= 0) status = 1;
+}
+
+return(status);
+}
+/*************************************************************************
+* Read the double values of n columns
+*
+* INPUT:
+* icols[n]: column numbers
+*
+* OUTPUT:
+* values[n]: values (0. if error, NO_DATA if "\nodata")
+* status[n]: status of GetDouble() for each column
+* RETURN: number of columns with status = 0
+*************************************************************************/
+int LatexRow::GetDoubles(const int *icols, double *values, int *status,
+                         int n, int iverbose)
+{
+int k, nvalues = 0;
+
+for(k = 0; k < n; k++) {
+  status[k] = GetDouble(icols[k], &values[k], iverbose);
+  if(status[k] == 0) nvalues++;
+  }
+
+return(nvalues);
+}
@@ -0,0 +1,72 @@
+/************************************************************************
+* "latex_row.h"
+* View of a line of a LaTeX table, tokenized only once:
+* the positions of the '&' separators and of the end of the row
+* ("\\" or "\cr") are computed by the constructor, and the columns
+* are then accessed without scanning or copying the line again.
+*
+* The line is not copied: it should not be modified or freed
+* as long as the LatexRow object is used.
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#ifndef __latex_row_h   /* BOF sentry */
+#define __latex_row_h
+
+#include <vector>
+
+/* Part of a line (not terminated by '\0'): */
+typedef struct {
+  const char *ptr;
+  int len;
+} LATEX_SPAN;
+
+class LatexRow {
+
+public:
+    LatexRow() { Set(""); }
+    LatexRow(const char *line0) { Set(line0); }
+    ~LatexRow() {};
+
+// Tokenize a new line (the memory of the previous line is used again):
+    void Set(const char *line0);
+
+// Number of columns before "\\" (as in latex_read_svalue):
+    int NColumns() { return((int)amp_pos.size() + 1); }
+// Number of columns before "\cr" or "\\" (as in latex_get_column_item):
+    int NItems() { return(ncols_cr); }
+
+// Column #icol (1 for the first column) without copy, as delimited by
+// latex_get_column_item (return -1 if not found):
+    int Item(int icol, LATEX_SPAN *span);
+
+// Same interface and same output as latex_get_column_item():
+    int GetItem(int icol, char *item, int verbose_if_error);
+// Same output as latex_read_svalue()
+// (0 if OK, 1 if empty, 3 if "\nodata", -1 if not found):
+    int GetString(int icol, char *value);
+// Same output as latex_read_dvalue(), latex_read_fvalue(), latex_read_ivalue():
+    int GetDouble(int icol, double *value, int iverbose);
+    int GetFloat(int icol, float *value, int iverbose);
+    int GetInt(int icol, int *value);
+// Batch version of GetDouble() for n columns:
+    int GetDoubles(const int *icols, double *values, int *status, int n,
+                   int iverbose);
+
+private:
+    int Value(int icol, LATEX_SPAN *span);
+    int NumericValue(int icol, char *buff, int buff_len);
+
+    const char *line;
+// Position of the '&' before "\\" (or before the end of the line):
+    std::vector<int> amp_pos;
+// Position of "\\" (or of the end of the line), of "\cr" (or of iend):
+    int iend, icr;
+// Flag set to one if the row is terminated by "\\":
+    int terminated;
+// Number of columns before icr:
+    int ncols_cr;
+};
+
+#endif   /* EOF sentry */
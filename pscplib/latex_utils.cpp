@@ -14,6 +14,7 @@
 /* The prototypes of routines included here
 */
 #include "latex_utils.h"
+#include "latex_row.h"   // LatexRow
 
 /*
 #define DEBUG 
@@ -25,26 +26,9 @@
 **************************************************************************/
 int latex_read_ivalue(char *b_data, int *value, int icol)
 {
-int ival, status;
-char buff[64];
-
-*value = 0.;
-status = latex_read_svalue(b_data, buff, icol);
-if((status == 0) || (status == 3)) {
-// Handle "\nnodata" value:
-   if(status == 3) {
-     *value = NO_DATA;
-     status == 3;
-     } else {
-     ival = sscanf(buff, "%d", value);
-/*
-printf("latex_read_ivalue/buff=>%s< value=%d ival=%d\n", buff, *value, ival);
-*/
-     if(ival <= 0) status = 1;
-     }
-  }
+LatexRow row(b_data);
 
-return(status);
+return(row.GetInt(icol, value));
 }
 /**************************************************************************
 * Read float value in column #icol from b_data string
@@ -55,25 +39,9 @@ return(status);
 **************************************************************************/
 int latex_read_fvalue(char *b_data, float *value, int icol, int iverbose)
 {
-int ival, status;
-char buff[64];
-
-*value = 0.;
-status = latex_read_svalue(b_data, buff, icol);
-if((status == 0) || (status == 3)) {
-// Handle "\nnodata" value:
-   if(status == 3) {
-     *value = NO_DATA;
-     status == 3;
-     } else {
-     ival = sscanf(buff, "%f", value);
-     if(ival <= 0) {
-       if(iverbose > 1) printf("latex_read_fvalue/buff=>%s< value=%.2f ival=%d\n", buff, *value, ival);
-       status = 1;
-       }
-     }
-   }
-return(status);
+LatexRow row(b_data);
+
+return(row.GetFloat(icol, value, iverbose));
 }
 /**************************************************************************
 * Read double value in column #icol from b_data string
@@ -84,88 +52,21 @@ return(status);
 **************************************************************************/
 int latex_read_dvalue(char *b_data, double *value, int icol, int iverbose)
 {
-int ival, status;
-char buff[64];
-
-*value = 0.;
-status = latex_read_svalue(b_data, buff, icol);
-if((status == 0) || (status == 3)) {
-// Handle "\nnodata" value:
-   if(status == 3) {
-     *value = NO_DATA;
-     status == 3;
-     } else {
-     ival = sscanf(buff, "%lf", value);
-     if(ival <= 0) {
-        if(iverbose > 1) printf("latex_read_dvalue/buff=>%s< value=%.2f ival=%d\n", buff, *value, ival);
-      status = 1;
-      }
-    }
-  }
-return(status);
+LatexRow row(b_data);
+
+return(row.GetDouble(icol, value, iverbose));
 }
 /**************************************************************************
 * Read string value in column #icol from b_data string
 *
+* RETURN:
+* 0 if OK, 1 if empty, 3 if "\nodata", -1 if column not found
 **************************************************************************/
 int latex_read_svalue(char *b_data, char *value, int icol)
 {
-int ic, status, column_is_found;
-char buff[NMAX], data[NMAX], *pc, nnodata_str[64];
-
-strcpy(nnodata_str, "nodata");
-
-*value = '\0';
-
-strcpy(data, b_data);
-
-pc = data;
-data[NMAX-1] = '\0';
-column_is_found = 0;
-ic = 1;
-buff[0] = '\0';
-while(*pc && strncmp(pc,"\\\\",2)) {
-  if(ic == icol) {
-    column_is_found = 1;
-    strcpy(buff,pc);
-    break;
-    }
-  if(*pc == '&') {
-    ic++;
-    }
-  pc++;
-  }
-*pc = '\0';
-/* Return if column not found, or empty */
-if(!buff[0]) return(-1);
+LatexRow row(b_data);
 
-/* Otherwise go on analysis: */
-status = 1;
-buff[NMAX-1] = '\0';
-pc = buff;
-while(*pc) {
-  if(*pc == '&' || !strncmp(pc,"\\\\",2)) {
-    *pc = '\0';
-    strcpy(value,buff);
-    if(*value) status = 0;
-    break;
-    }
-  pc++;
-  }
-
-/* Removes '\r' (Carriage Return) if present: */
-if(status == 0) {
-pc = value;
-while(*pc) {
-  if(*pc == '\r') *pc = ' ';
-  pc++;
-  }
-}
-
-// Look for "\nnodata" string:
-if(strstr(value, nnodata_str) != NULL) status = 3;
-
-return(status);
+return(row.GetString(icol, value));
 }
 /**************************************************************************
 * Write a double value in column #icol to b_out string
@@ -249,38 +150,9 @@ return(0);
 int latex_get_column_item(char *in_line, char *item, int icol, 
                           int verbose_if_error)
 {
-int ic;
-char *pc, buffer[512];
- pc = in_line;
+LatexRow row(in_line);
 
-/* Get to the icol th column: */
- ic = 1;
- while(ic != icol) {
-   while(*pc && *pc != '&' && strncmp(pc, "\\cr", 3) 
-        && strncmp(pc, "\\\\", 2)) pc++; 
-    if(*pc == '&') {
-      pc++;
-      ic++;
-     } else {
-     if(verbose_if_error != 0) {
-printf("verbose_if_error=%d\n", verbose_if_error);
-        fprintf(stderr, "latex_get_column_item/Error: column #%d not found in >%s<\n",
-             icol, in_line);
-        }
-     return(-1);
-     }
- }
-
-/* icol has been reached: */
- strcpy(buffer, pc);
- pc = buffer;
-/* Go to the next column or the end of line: */
- while(*pc && *pc != '&' && strncmp(pc, "\\cr", 3)
-        && strncmp(pc, "\\\\", 2)) pc++; 
- *pc = '\0';
- strcpy(item, buffer);
-
-return(0);
+return(row.GetItem(icol, item, verbose_if_error));
 }
 /************************************************************
 * Set character string in the icol th column of a LaTeX table
@@ -0,0 +1,238 @@
+/************************************************************************
+* "meas_match.cpp"
+* Matching of the measurements of a LaTeX calibrated table
+* with a catalog of measurements (OBJECT array)
+*
+* The catalog is indexed once by (WDS name,) object name without the
+* companion, and the entries with the same name are sorted by epoch,
+* so that each measurement is matched in O(log N) instead of the three
+* linear scans of tex_calib_get_meas_from_object().
+*
+* Best match (as in tex_calib_get_meas_from_object()):
+* 1. first entry with the same name (and WDS name) and the same epoch
+*    (within epoch_tol),
+* 2. otherwise first entry with the same name (and WDS name),
+* 3. otherwise first entry with the same WDS name (with_wds = 1 only).
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>           // std::sort, std::lower_bound
+#include "meas_match.h"
+#include "tex_calib_utils.h"   // extract_companion_from_name()
+#include "jlp_string.h"        // jlp_compact_string()
+
+#ifndef MAXI
+#define MAXI(a,b) ((a) < (b)) ? (b) : (a)
+#endif
+
+/*
+#define DEBUG
+*/
+
+/*************************************************************************
+* Constructor: index the catalog
+*
+* INPUT:
+* obj1, nobj1: catalog of measurements (not copied, and should not be
+*              modified while the MeasMatcher is used)
+* with_wds0: 1 if the WDS names should be the same (calib_tex_compare),
+*            0 if only the object names are compared (calib_csv_compare)
+* epoch_tol0: maximum difference between the epochs (in years)
+*************************************************************************/
+MeasMatcher::MeasMatcher(OBJECT *obj1, int nobj1, int with_wds0,
+                         double epoch_tol0)
+{
+char discov_name[64], discov_name1[64], discov_comp1[64];
+std::unordered_map<std::string, MEAS_MATCH_LIST>::iterator it;
+std::string key;
+std::vector<int> *by_epoch;
+int i, len1;
+
+obj = obj1;
+nobj = nobj1;
+with_wds = with_wds0;
+epoch_tol = epoch_tol0;
+
+epoch.resize(nobj);
+for(i = 0; i < nobj; i++) {
+  epoch[i] = (obj[i].meas != NULL) ? (obj[i].meas[0]).bessel_epoch : 1.e+9;
+
+/* Object name without companion (as computed by
+* tex_calib_get_meas_from_object()): */
+  strcpy(discov_name, obj[i].discov_name);
+  if(!with_wds) jlp_compact_string(discov_name, 64);
+  extract_companion_from_name(discov_name, discov_name1, discov_comp1, &len1);
+
+  if(with_wds) {
+    key = obj[i].wds;
+    key += '\n';
+    key += discov_name1;
+    index_wds.emplace(obj[i].wds, i);
+  } else {
+    key = discov_name1;
+  }
+  index_name[key].iobj.push_back(i);
+  }
+
+/* Sort the entries of each name by epoch: */
+for(it = index_name.begin(); it != index_name.end(); it++) {
+  by_epoch = &(it->second.iobj_by_epoch);
+  *by_epoch = it->second.iobj;
+  std::sort(by_epoch->begin(), by_epoch->end(),
+            [this](int i1, int i2) {
+              return((epoch[i1] < epoch[i2])
+                     || (epoch[i1] == epoch[i2] && i1 < i2)); });
+  }
+
+#ifdef DEBUG
+printf("MeasMatcher: %d objects, %d names\n", nobj, (int)index_name.size());
+#endif
+}
+/*************************************************************************
+* Same test on the object names as in tex_calib_get_meas_from_object()
+* (only the first characters are compared, up to the end of the number)
+*************************************************************************/
+int MeasMatcher::NameIsMatching(int i, const char *object_name0, int len0)
+{
+char discov_name[64], discov_name1[64], discov_comp1[64];
+int len1, maxlen0;
+
+strcpy(discov_name, obj[i].discov_name);
+if(!with_wds) jlp_compact_string(discov_name, 64);
+extract_companion_from_name(discov_name, discov_name1, discov_comp1, &len1);
+maxlen0 = MAXI(len0, len1);
+
+return(strncmp(object_name0, discov_name, maxlen0) == 0);
+}
+/*************************************************************************
+* Index in the catalog of the best match (-1 if not found)
+*
+* INPUT:
+* WDSName0: WDS name (not used if with_wds = 0)
+* ObjectName0: object name (with or without companion)
+* epoch0: epoch of the measurement
+*************************************************************************/
+int MeasMatcher::Find(char *WDSName0, char *ObjectName0, double epoch0)
+{
+char object_name0[64], comp_name0[64];
+std::unordered_map<std::string, MEAS_MATCH_LIST>::iterator it;
+std::unordered_map<std::string, int>::iterator it_wds;
+std::vector<int>::iterator ib;
+std::vector<int> *by_epoch;
+std::string key;
+int i, k, len0, ifound = -1;
+
+/* Extract companion name if present: */
+extract_companion_from_name(ObjectName0, object_name0, comp_name0, &len0);
+
+if(with_wds) {
+  key = WDSName0;
+  key += '\n';
+  key += object_name0;
+} else {
+  key = object_name0;
+}
+
+it = index_name.find(key);
+if(it != index_name.end()) {
+/* Same name and same epoch: first entry in the order of the catalog
+* (the window is larger than epoch_tol to be safe with rounding errors) */
+  by_epoch = &(it->second.iobj_by_epoch);
+  ib = std::lower_bound(by_epoch->begin(), by_epoch->end(),
+                        epoch0 - 2. * epoch_tol,
+                        [this](int i1, double e) { return(epoch[i1] < e); });
+  for(; ib != by_epoch->end() && epoch[*ib] <= epoch0 + 2. * epoch_tol;
+      ib++) {
+    i = *ib;
+    if(ABS(epoch[i] - epoch0) < epoch_tol && (ifound < 0 || i < ifound)
+       && NameIsMatching(i, object_name0, len0)) ifound = i;
+    }
+/* Same name: first entry in the order of the catalog */
+  for(k = 0; ifound < 0 && k < (int)it->second.iobj.size(); k++) {
+    i = it->second.iobj[k];
+    if(NameIsMatching(i, object_name0, len0)) ifound = i;
+    }
+  }
+
+/* Same WDS name: */
+if(ifound < 0 && with_wds) {
+  it_wds = index_wds.find(WDSName0);
+  if(it_wds != index_wds.end()) ifound = it_wds->second;
+  }
+
+return(ifound);
+}
+/***************************************************************************
+* Get measures from the catalog
+* (same as tex_calib_get_meas_from_object())
+*
+* INPUT:
+*  WDSName0, ObjectName0, epoch0
+*
+* OUTPUT:
+*  WDSName1, ObjectName1
+*  BesselEpoch1, rho1, drho1, theta1, dtheta1
+***************************************************************************/
+int MeasMatcher::GetMeas(char *WDSName0, char *ObjectName0, double epoch0,
+                         char *WDSName1, char *ObjectName1,
+                         double *BesselEpoch1, char *filt1, int *eyep1,
+                         double *rho1, double *err_rho1, double *theta1,
+                         double *err_theta1)
+{
+MEASURE *me;
+int ifound;
+
+ifound = Find(WDSName0, ObjectName0, epoch0);
+if(ifound < 0) return(-1);
+
+strcpy(WDSName1, obj[ifound].wds);
+strcpy(ObjectName1, obj[ifound].discov_name);
+me = &(obj[ifound]).meas[0];
+*BesselEpoch1 = me->bessel_epoch;
+strcpy(filt1, me->filter);
+*eyep1 = me->eyepiece;
+*rho1 = me->rho;
+*err_rho1 = me->drho;
+*theta1 = me->theta;
+*err_theta1 = me->dtheta;
+
+return(0);
+}
+/***************************************************************************
+* Get measures from a catalog created with Gili's csv file
+* (same as tex_calib_get_meas_from_csv_object())
+*
+* INPUT:
+*  ObjectName0, epoch0
+*
+* OUTPUT:
+*  ObjectName1
+*  BesselEpoch1, rho1, drho1, theta1, dtheta1, dmag1
+***************************************************************************/
+int MeasMatcher::GetCsvMeas(char *ObjectName0, double epoch0,
+                            char *ObjectName1, double *BesselEpoch1,
+                            int *eyep1, double *rho1, double *err_rho1,
+                            double *theta1, double *err_theta1,
+                            double *dmag1)
+{
+MEASURE *me;
+int ifound;
+
+ifound = Find((char *)"", ObjectName0, epoch0);
+if(ifound < 0) return(-1);
+
+strcpy(ObjectName1, obj[ifound].discov_name);
+me = &(obj[ifound]).meas[0];
+*BesselEpoch1 = me->bessel_epoch;
+*eyep1 = me->eyepiece;
+*rho1 = me->rho;
+*err_rho1 = me->drho;
+*theta1 = me->theta;
+*err_theta1 = me->dtheta;
+*dmag1 = me->dmag;
+
+return(0);
+}
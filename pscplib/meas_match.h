@@ -0,0 +1,71 @@
+/************************************************************************
+* "meas_match.h"
+* Matching of the measurements of a LaTeX calibrated table
+* with a catalog of measurements (OBJECT array) loaded from another
+* calibrated table (calib_tex_compare) or from a csv file (calib_csv_compare)
+*
+* The catalog is indexed once by (WDS name,) object name and epoch, and
+* each measurement is then matched with a lookup, with the same result as
+* tex_calib_get_meas_from_object() and tex_calib_get_meas_from_csv_object()
+* (which scan the whole catalog for each measurement)
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#ifndef __meas_match_h   /* BOF sentry */
+#define __meas_match_h
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include "astrom_utils1.h"   // OBJECT
+
+/* Default tolerance on the epochs (in years) */
+#define MEAS_MATCH_EPOCH_TOL 0.01
+
+/* Catalog entries with the same key, in the order of the catalog
+* and sorted by epoch: */
+typedef struct {
+  std::vector<int> iobj;
+  std::vector<int> iobj_by_epoch;
+} MEAS_MATCH_LIST;
+
+class MeasMatcher {
+
+public:
+// with_wds = 1: same matching as tex_calib_get_meas_from_object()
+// with_wds = 0: same matching as tex_calib_get_meas_from_csv_object()
+    MeasMatcher(OBJECT *obj1, int nobj1, int with_wds,
+                double epoch_tol = MEAS_MATCH_EPOCH_TOL);
+    ~MeasMatcher() {};
+
+// Index in the catalog of the best match (-1 if not found):
+    int Find(char *WDSName0, char *ObjectName0, double epoch0);
+
+// Same interface as tex_calib_get_meas_from_object():
+    int GetMeas(char *WDSName0, char *ObjectName0, double epoch0,
+                char *WDSName1, char *ObjectName1, double *BesselEpoch1,
+                char *filt1, int *eyep1, double *rho1, double *err_rho1,
+                double *theta1, double *err_theta1);
+// Same interface as tex_calib_get_meas_from_csv_object():
+    int GetCsvMeas(char *ObjectName0, double epoch0, char *ObjectName1,
+                   double *BesselEpoch1, int *eyep1, double *rho1,
+                   double *err_rho1, double *theta1, double *err_theta1,
+                   double *dmag1);
+
+private:
+    int NameIsMatching(int i, const char *object_name0, int len0);
+
+    OBJECT *obj;
+    int nobj, with_wds;
+    double epoch_tol;
+// Epoch of the first measurement of each object:
+    std::vector<double> epoch;
+
+// (WDS name +) object name without companion -> catalog entries
+    std::unordered_map<std::string, MEAS_MATCH_LIST> index_name;
+// WDS name -> first catalog entry
+    std::unordered_map<std::string, int> index_wds;
+};
+
+#endif   /* EOF sentry */
@@ -0,0 +1,97 @@
+/************************************************************************
+* "orbit_model.cpp"
+* Orbit of a binary (or of the components of a multiple system)
+* with the constants needed by the ephemerids computed once
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#include <stdio.h>
+#include <math.h>
+#include "jlp_catalog_utils.h"  // PI
+#include "orbit_model.h"
+
+/*************************************************************
+* Constructor for a single orbit
+*
+* INPUT:
+*  Omega_node (radians), omega_peri (radians), i_incl (radians),
+*  e_eccent, T_periastron (years), Period (years),
+*  a_smaxis (arcseconds), mean_motion (radians/year)
+**************************************************************/
+OrbitModel::OrbitModel(double Omega_node, double omega_peri, double i_incl,
+                       double e_eccent, double T_periastron, double Period,
+                       double a_smaxis, double mean_motion)
+{
+nber_of_orbits = 1;
+thiele_orbits_init(1, &Omega_node, &omega_peri, &i_incl, &e_eccent,
+                   &T_periastron, &Period, &a_smaxis, &mean_motion, orbits);
+}
+/*************************************************************
+* Constructor for a multiple system (up to ORBIT_MODEL_NMAX orbits,
+* whose positions are summed)
+**************************************************************/
+OrbitModel::OrbitModel(int nber_of_orbits0, double *Omega_node,
+                       double *omega_peri, double *i_incl, double *e_eccent,
+                       double *T_periastron, double *Period, double *a_smaxis,
+                       double *mean_motion)
+{
+nber_of_orbits = nber_of_orbits0;
+if(nber_of_orbits > ORBIT_MODEL_NMAX) {
+  fprintf(stderr, "OrbitModel/Error: nber_of_orbits=%d > %d (truncated)\n",
+          nber_of_orbits, ORBIT_MODEL_NMAX);
+  nber_of_orbits = ORBIT_MODEL_NMAX;
+  }
+thiele_orbits_init(nber_of_orbits, Omega_node, omega_peri, i_incl, e_eccent,
+                   T_periastron, Period, a_smaxis, mean_motion, orbits);
+}
+/*************************************************************
+* Position in the sky plane at epoch "epoch"
+*
+* OUTPUT:
+*  x_c = rho cos(theta), y_c = rho sin(theta) (arcseconds)
+**************************************************************/
+int OrbitModel::Position(double epoch, double *x_c, double *y_c)
+{
+double xx, yy;
+int k;
+
+*x_c = 0.;
+*y_c = 0.;
+for(k = 0; k < nber_of_orbits; k++) {
+  thiele_orbit_position(&orbits[k], epoch, &xx, &yy);
+  *x_c += xx;
+  *y_c += yy;
+  }
+
+return(0);
+}
+/*************************************************************
+* Ephemerid at epoch "epoch"
+* (same output as compute_ephemerid_of_multiple_system())
+*
+* OUTPUT:
+*  theta_c = computed position angle (degrees, in [0,360])
+*  rho_c = computed separation (arcseconds)
+**************************************************************/
+int OrbitModel::Ephemerid(double epoch, double *theta_c, double *rho_c)
+{
+double xx, yy;
+
+Position(epoch, &xx, &yy);
+*rho_c = sqrt(xx * xx + yy * yy);
+*theta_c = atan2(yy, xx) * (180./PI);
+if(*theta_c < 0.0) *theta_c += 360.0;
+
+return(0);
+}
+/*************************************************************
+* Ephemerids at n epochs
+* (see compute_multiple_system_ephemerides())
+**************************************************************/
+int OrbitModel::Ephemerides(const double *epochs, int n, double *x_c,
+                            double *y_c, double *theta_c, double *rho_c)
+{
+return(compute_multiple_system_ephemerides(orbits, nber_of_orbits, epochs, n,
+                                           x_c, y_c, theta_c, rho_c));
+}
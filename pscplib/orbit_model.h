@@ -0,0 +1,56 @@
+/************************************************************************
+* "orbit_model.h"
+* Orbit of a binary (or of the components of a multiple system)
+* with the constants needed by the ephemerids computed once:
+* Thiele-Innes constants A, B, F, G, sqrt(1 - e^2), mean motion and
+* number of iterations for Kepler's equation (see THIELE_ORBIT
+* in residuals_utils.h)
+*
+* The positions are computed directly from the eccentric anomaly E:
+*   X = cos(E) - e,  Y = sqrt(1 - e^2) sin(E)
+*   x = A X + F Y,   y = B X + G Y
+* without computing the true anomaly.
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#ifndef __orbit_model_h   /* BOF sentry */
+#define __orbit_model_h
+
+#include "residuals_utils.h"   // THIELE_ORBIT
+
+/* Maximum number of orbits of a multiple system: */
+#define ORBIT_MODEL_NMAX 3
+
+class OrbitModel {
+
+public:
+// Empty model (to be assigned later, e.g., in a table of orbits):
+    OrbitModel() { nber_of_orbits = 0; };
+// Single orbit (angles in radians, see compute_ephemerid()):
+    OrbitModel(double Omega_node, double omega_peri, double i_incl,
+               double e_eccent, double T_periastron, double Period,
+               double a_smaxis, double mean_motion);
+// Multiple system (orbit #k with Omega_node[k], ...):
+    OrbitModel(int nber_of_orbits0, double *Omega_node, double *omega_peri,
+               double *i_incl, double *e_eccent, double *T_periastron,
+               double *Period, double *a_smaxis, double *mean_motion);
+    ~OrbitModel() {};
+
+    int NOrbits() { return(nber_of_orbits); }
+    const THIELE_ORBIT *Orbits() { return(orbits); }
+
+// Position in the sky plane (x towards North, y towards East, arcsec):
+    int Position(double epoch, double *x_c, double *y_c);
+// Position angle (degrees, in [0,360]) and separation (arcsec):
+    int Ephemerid(double epoch, double *theta_c, double *rho_c);
+// Both, for n epochs (outputs not computed if NULL):
+    int Ephemerides(const double *epochs, int n, double *x_c, double *y_c,
+                    double *theta_c, double *rho_c);
+
+private:
+    int nber_of_orbits;
+    THIELE_ORBIT orbits[ORBIT_MODEL_NMAX];
+};
+
+#endif   /* EOF sentry */
@@ -0,0 +1,293 @@
+/************************************************************************
+* "orbit_montecarlo.cpp"
+* Monte-Carlo propagation of the errors of the orbital elements
+* and of the parallax (see orbit_montecarlo.h)
+*
+* Contained here:
+* int orbit_montecarlo(const ORBIT_ELEMENTS *orbit,
+*                      const ORBIT_ELEMENTS *err_orbit, double parallax,
+*                      double err_parallax, const double *epochs, int nepochs,
+*                      int nsamples, unsigned long long seed, int nthreads,
+*                      ORBIT_MC_RESULTS *results);
+* double orbit_mc_gaussian(unsigned long long seed, unsigned long long isample,
+*                          int ivar);
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#include <stdio.h>
+#include <math.h>
+#include <vector>
+#include <algorithm>          // std::nth_element
+#include "jlp_catalog_utils.h"  // PI, DEGTORAD
+#include "jlp_threads.h"        // jlp_parallel_for()
+#include "orbit_montecarlo.h"
+
+/*
+#define DEBUG
+*/
+
+/* Number of samples processed by a call to the worker: */
+#define ORBIT_MC_CHUNK 4096
+/* Random variables of a sample: */
+#define ORBIT_MC_OMEGA_NODE 0
+#define ORBIT_MC_OMEGA_PERI 1
+#define ORBIT_MC_I_INCL     2
+#define ORBIT_MC_E_ECCENT   3
+#define ORBIT_MC_T_PERI     4
+#define ORBIT_MC_PERIOD     5
+#define ORBIT_MC_A_SMAXIS   6
+#define ORBIT_MC_PARALLAX   7
+#define ORBIT_MC_NVAR       8
+/* Maximum number of draws for a sample with e >= 1 or
+* a negative period, semi-major axis or parallax: */
+#define ORBIT_MC_NDRAWS_MAX 16
+
+/* Data shared by the threads: */
+typedef struct {
+const ORBIT_ELEMENTS *orbit, *err_orbit;
+double parallax, err_parallax;
+const double *epochs;
+int nepochs, nsamples;
+unsigned long long seed;
+double *a_AU, *sum_masses;
+double *rho_c, *theta_c;    /* nepochs * nsamples (epoch by epoch) */
+} ORBIT_MC_DATA;
+
+static void orbit_mc_worker(int ichunk, void *data0);
+static int orbit_mc_draw(ORBIT_MC_DATA *data, unsigned long long isample,
+                         ORBIT_ELEMENTS *elem, double *parallax);
+static void orbit_mc_percentiles(double *values, int nvalues,
+                                 double *percentiles);
+
+/*************************************************************************
+* Hash function of SplitMix64, used as a counter-based generator
+*************************************************************************/
+static unsigned long long orbit_mc_hash(unsigned long long x)
+{
+x += 0x9E3779B97F4A7C15ULL;
+x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+return(x ^ (x >> 31));
+}
+/*************************************************************************
+* Uniform random number in ]0,1[, function of (seed, isample, iword) only
+*************************************************************************/
+static double orbit_mc_uniform(unsigned long long seed,
+                               unsigned long long isample, int iword)
+{
+unsigned long long hh;
+
+hh = orbit_mc_hash(orbit_mc_hash(seed) + isample * 256ULL
+                   + (unsigned long long)iword);
+return(((double)(hh >> 11) + 0.5) * (1.0 / 9007199254740992.0));
+}
+/*************************************************************************
+* Normal random number (mean 0, sigma 1) for variable #ivar of
+* sample #isample (Box-Muller transform of two uniform numbers)
+*
+* INPUT:
+*  ivar: from 0 to 127
+*************************************************************************/
+double orbit_mc_gaussian(unsigned long long seed, unsigned long long isample,
+                         int ivar)
+{
+double u1, u2;
+
+u1 = orbit_mc_uniform(seed, isample, 2 * ivar);
+u2 = orbit_mc_uniform(seed, isample, 2 * ivar + 1);
+
+return(sqrt(-2.0 * log(u1)) * cos(2.0 * PI * u2));
+}
+/*************************************************************************
+* Compute the distributions of the semi-major axis in AU, of the sum
+* of the masses and of the ephemerids at the epochs epochs[nepochs],
+* from nsamples draws of the orbital elements and of the parallax
+*
+* INPUT:
+*  orbit: orbital elements (angles in radians, see compute_ephemerid())
+*  err_orbit: their errors (1 sigma, angles in radians)
+*  parallax, err_parallax: parallax and its error (mas)
+*  epochs[nepochs]: epochs of the ephemerids (nepochs <= ORBIT_MC_NEPOCHS_MAX)
+*  nsamples: number of samples
+*  seed: seed of the random number generator
+*  nthreads: number of threads
+*
+* OUTPUT:
+*  results: percentiles (see ORBIT_MC_PERCENTS) of the distributions
+*
+* RETURN: 0 if OK
+*************************************************************************/
+int orbit_montecarlo(const ORBIT_ELEMENTS *orbit,
+                     const ORBIT_ELEMENTS *err_orbit, double parallax,
+                     double err_parallax, const double *epochs, int nepochs,
+                     int nsamples, unsigned long long seed, int nthreads,
+                     ORBIT_MC_RESULTS *results)
+{
+ORBIT_MC_DATA data;
+THIELE_ORBIT nominal;
+ORBIT_ELEMENTS elem;
+std::vector<double> a_AU, sum_masses, rho_c, theta_c;
+double theta0, dtheta, pc[ORBIT_MC_NPERCENT];
+int nchunks, i, j, k;
+
+if(nsamples < 1 || nepochs < 0 || nepochs > ORBIT_MC_NEPOCHS_MAX
+   || parallax <= 0.) {
+  fprintf(stderr, "orbit_montecarlo/Error: nsamples=%d nepochs=%d (max=%d) parallax=%f\n",
+          nsamples, nepochs, ORBIT_MC_NEPOCHS_MAX, parallax);
+  return(-1);
+  }
+
+a_AU.resize(nsamples);
+sum_masses.resize(nsamples);
+rho_c.resize((size_t)nepochs * nsamples);
+theta_c.resize((size_t)nepochs * nsamples);
+
+data.orbit = orbit;
+data.err_orbit = err_orbit;
+data.parallax = parallax;
+data.err_parallax = err_parallax;
+data.epochs = epochs;
+data.nepochs = nepochs;
+data.nsamples = nsamples;
+data.seed = seed;
+data.a_AU = &a_AU[0];
+data.sum_masses = &sum_masses[0];
+data.rho_c = (nepochs > 0) ? &rho_c[0] : NULL;
+data.theta_c = (nepochs > 0) ? &theta_c[0] : NULL;
+
+nchunks = (nsamples + ORBIT_MC_CHUNK - 1) / ORBIT_MC_CHUNK;
+jlp_parallel_for(nchunks, nthreads, orbit_mc_worker, &data);
+
+results->nsamples = nsamples;
+orbit_mc_percentiles(&a_AU[0], nsamples, results->a_AU);
+orbit_mc_percentiles(&sum_masses[0], nsamples, results->sum_masses);
+
+/* Ephemerids: the position angles are taken relative to the ephemerid
+* of the nominal orbit, in [-180,180[, to avoid the discontinuity at 360: */
+elem = *orbit;
+thiele_orbits_init(1, &elem.Omega_node, &elem.omega_peri, &elem.i_incl,
+                   &elem.e_eccent, &elem.T_periastron, &elem.Period,
+                   &elem.a_smaxis, &elem.mean_motion, &nominal);
+results->nepochs = nepochs;
+for(j = 0; j < nepochs; j++) {
+  results->epochs[j] = epochs[j];
+  compute_multiple_system_ephemerides(&nominal, 1, &epochs[j], 1, NULL, NULL,
+                                      &theta0, NULL);
+  for(i = 0; i < nsamples; i++) {
+    dtheta = theta_c[(size_t)j * nsamples + i] - theta0;
+    dtheta -= 360. * floor((dtheta + 180.) / 360.);
+    theta_c[(size_t)j * nsamples + i] = dtheta;
+    }
+  orbit_mc_percentiles(&rho_c[(size_t)j * nsamples], nsamples,
+                       results->rho_c[j]);
+  orbit_mc_percentiles(&theta_c[(size_t)j * nsamples], nsamples, pc);
+  for(k = 0; k < ORBIT_MC_NPERCENT; k++) {
+    results->theta_c[j][k] = theta0 + pc[k];
+    if(results->theta_c[j][k] < 0.) results->theta_c[j][k] += 360.;
+    if(results->theta_c[j][k] >= 360.) results->theta_c[j][k] -= 360.;
+    }
+  }
+
+return(0);
+}
+/*************************************************************************
+* Process the samples of chunk #ichunk
+*************************************************************************/
+static void orbit_mc_worker(int ichunk, void *data0)
+{
+ORBIT_MC_DATA *data = (ORBIT_MC_DATA *)data0;
+ORBIT_ELEMENTS elem;
+THIELE_ORBIT thiele;
+double parallax, theta[ORBIT_MC_NEPOCHS_MAX], rho[ORBIT_MC_NEPOCHS_MAX];
+int i, i1, i2, j;
+
+i1 = ichunk * ORBIT_MC_CHUNK;
+i2 = i1 + ORBIT_MC_CHUNK;
+if(i2 > data->nsamples) i2 = data->nsamples;
+
+for(i = i1; i < i2; i++) {
+  orbit_mc_draw(data, (unsigned long long)i, &elem, &parallax);
+
+/* Semi-major axis in AU and sum of the masses (Kepler's third law): */
+  data->a_AU[i] = elem.a_smaxis / (parallax / 1000.);
+  data->sum_masses[i] = pow(data->a_AU[i], 3) / (elem.Period * elem.Period);
+
+/* Ephemerids, with the Thiele-Innes constants of this sample: */
+  if(data->nepochs > 0) {
+    thiele_orbits_init(1, &elem.Omega_node, &elem.omega_peri, &elem.i_incl,
+                       &elem.e_eccent, &elem.T_periastron, &elem.Period,
+                       &elem.a_smaxis, &elem.mean_motion, &thiele);
+    compute_multiple_system_ephemerides(&thiele, 1, data->epochs,
+                                        data->nepochs, NULL, NULL, theta, rho);
+    for(j = 0; j < data->nepochs; j++) {
+      data->rho_c[(size_t)j * data->nsamples + i] = rho[j];
+      data->theta_c[(size_t)j * data->nsamples + i] = theta[j];
+      }
+    }
+  }
+}
+/*************************************************************************
+* Draw the orbital elements and the parallax of sample #isample
+* New draws are made (with other random numbers of the same sample)
+* if e is not in [0,1[ or if the period, the semi-major axis or the parallax
+* are not positive. After ORBIT_MC_NDRAWS_MAX draws, the values are clipped.
+*
+* RETURN: number of draws
+*************************************************************************/
+static int orbit_mc_draw(ORBIT_MC_DATA *data, unsigned long long isample,
+                         ORBIT_ELEMENTS *elem, double *parallax)
+{
+const ORBIT_ELEMENTS *orb = data->orbit, *err = data->err_orbit;
+int idraw, ivar0;
+
+for(idraw = 0; idraw < ORBIT_MC_NDRAWS_MAX; idraw++) {
+  ivar0 = idraw * ORBIT_MC_NVAR;
+  elem->Omega_node = orb->Omega_node + err->Omega_node
+       * orbit_mc_gaussian(data->seed, isample, ivar0 + ORBIT_MC_OMEGA_NODE);
+  elem->omega_peri = orb->omega_peri + err->omega_peri
+       * orbit_mc_gaussian(data->seed, isample, ivar0 + ORBIT_MC_OMEGA_PERI);
+  elem->i_incl = orb->i_incl + err->i_incl
+       * orbit_mc_gaussian(data->seed, isample, ivar0 + ORBIT_MC_I_INCL);
+  elem->e_eccent = orb->e_eccent + err->e_eccent
+       * orbit_mc_gaussian(data->seed, isample, ivar0 + ORBIT_MC_E_ECCENT);
+  elem->T_periastron = orb->T_periastron + err->T_periastron
+       * orbit_mc_gaussian(data->seed, isample, ivar0 + ORBIT_MC_T_PERI);
+  elem->Period = orb->Period + err->Period
+       * orbit_mc_gaussian(data->seed, isample, ivar0 + ORBIT_MC_PERIOD);
+  elem->a_smaxis = orb->a_smaxis + err->a_smaxis
+       * orbit_mc_gaussian(data->seed, isample, ivar0 + ORBIT_MC_A_SMAXIS);
+  *parallax = data->parallax + data->err_parallax
+       * orbit_mc_gaussian(data->seed, isample, ivar0 + ORBIT_MC_PARALLAX);
+  if(elem->e_eccent >= 0. && elem->e_eccent < 1. && elem->Period > 0.
+     && elem->a_smaxis > 0. && *parallax > 0.) break;
+  }
+
+if(idraw == ORBIT_MC_NDRAWS_MAX) {
+  *elem = *orb;
+  *parallax = data->parallax;
+  }
+
+elem->mean_motion = (360.0 / elem->Period) * DEGTORAD;
+
+return(idraw + 1);
+}
+/*************************************************************************
+* Percentiles ORBIT_MC_PERCENTS of values[nvalues]
+* (nearest rank, values[] is reordered)
+* Since the percents are in increasing order, each search is done
+* above the rank of the previous one.
+*************************************************************************/
+static void orbit_mc_percentiles(double *values, int nvalues,
+                                 double *percentiles)
+{
+double percents[ORBIT_MC_NPERCENT] = ORBIT_MC_PERCENTS;
+int k, irank, irank0 = 0;
+
+for(k = 0; k < ORBIT_MC_NPERCENT; k++) {
+  irank = (int)(percents[k] / 100. * (double)(nvalues - 1) + 0.5);
+  std::nth_element(values + irank0, values + irank, values + nvalues);
+  percentiles[k] = values[irank];
+  irank0 = irank;
+  }
+}
@@ -0,0 +1,49 @@
+/************************************************************************
+* "orbit_montecarlo.h"
+* Monte-Carlo propagation of the errors of the orbital elements
+* and of the parallax to the semi-major axis in AU, to the sum of the masses
+* and to the ephemerids at some epochs
+*
+* The samples are drawn from normal distributions with a counter-based
+* random number generator: the random numbers of sample #i only depend
+* on (seed, i), so that the results do not depend on the number
+* of threads.
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#ifndef __orbit_montecarlo_h   /* BOF sentry */
+#define __orbit_montecarlo_h
+
+#include "residuals_utils.h"   // ORBIT_ELEMENTS
+
+/* Percentiles given in the results (2.5, 16, 50, 84, 97.5 %),
+* i.e. median and 1-sigma and 2-sigma intervals of a normal distribution: */
+#define ORBIT_MC_NPERCENT 5
+#define ORBIT_MC_PERCENTS {2.5, 15.865, 50., 84.135, 97.5}
+
+/* Maximum number of epochs for the ephemerids: */
+#define ORBIT_MC_NEPOCHS_MAX 32
+
+/* Default number of samples: */
+#define ORBIT_MC_NSAMPLES 100000
+
+typedef struct {
+int nsamples;           /* Number of samples actually used */
+double a_AU[ORBIT_MC_NPERCENT];         /* Semi-major axis (AU) */
+double sum_masses[ORBIT_MC_NPERCENT];   /* M1 + M2 (solar masses) */
+int nepochs;
+double epochs[ORBIT_MC_NEPOCHS_MAX];
+double rho_c[ORBIT_MC_NEPOCHS_MAX][ORBIT_MC_NPERCENT];    /* arcsec */
+double theta_c[ORBIT_MC_NEPOCHS_MAX][ORBIT_MC_NPERCENT];  /* degrees */
+} ORBIT_MC_RESULTS;
+
+int orbit_montecarlo(const ORBIT_ELEMENTS *orbit,
+                     const ORBIT_ELEMENTS *err_orbit, double parallax,
+                     double err_parallax, const double *epochs, int nepochs,
+                     int nsamples, unsigned long long seed, int nthreads,
+                     ORBIT_MC_RESULTS *results);
+double orbit_mc_gaussian(unsigned long long seed, unsigned long long isample,
+                         int ivar);
+
+#endif   /* EOF sentry */
@@ -45,12 +45,9 @@ int orbit_plot_rho(char *measures_infile, char *comments, char *orbit_infile,
 {
 float *xplot, *yplot;
 int grid, jlp_axes, icol_x, icol_y, status, ncurves, isize; 
-int npts[2], orbit_format;
+int npts[2];
 char xlabel[41], ylabel[41], title[81], plotdev[128];
-double Omega_node[3], omega_peri[3], i_incl[3], e_eccent[3], T_periastron[3]; 
-double Period[3], a_smaxis[3], mean_motion[3], orbit_equinox[3];
-double c_tolerance[3], rho_c, theta_c, epoch, epoch1, epoch2;
-register int i, k;
+double epoch1, epoch2;
 
 if(iformat < 1 || iformat > 4) {
   fprintf(stderr, "orbit_plot_rho/Error: iformat=%d not alllowed here!\n", 
@@ -98,34 +95,18 @@ if(iformat == 3) {
   else ncurves = 2;
 /* Compute rho_C from orbital elements: */
   } else if(iformat == 4) {
-/* Marco's format: */
-   orbit_format = 1;
-   status = read_orbital_elements_from_file(orbit_infile, orbit_format,
-                           Omega_node, omega_peri, i_incl, e_eccent, 
-                           T_periastron, Period, a_smaxis, mean_motion, 
-                           orbit_equinox, nber_of_orbits);
-/*  c_tolerance = smallest increment allowed in the iterative process
-*                used for solving Kepler's equation
-*/
-   for(k = 0; k < nber_of_orbits; k++) 
-   c_tolerance[k] = ABS(1.5E-5 * cos(i_incl[k])
-                      / sqrt((1.0 + e_eccent[k])/(1.0 - e_eccent[k])));
-
-  epoch1 = xplot[0];
-  epoch2 = xplot[npts[0]-1];
-  for(i = 0; i < npts_max; i++) {
 /* Compute rho_C from orbital elements at equally spaced
 * epochs along the range of epochs: */
-    epoch = epoch1 + i * (epoch2 - epoch1)/(double)(npts_max-1);
-    compute_ephemerid_of_multiple_system(nber_of_orbits, Omega_node, 
-                      omega_peri, i_incl, e_eccent, T_periastron,
-                      Period, a_smaxis, mean_motion, epoch, c_tolerance,
-                      &theta_c, &rho_c);
-    xplot[npts_max + i] = epoch; 
-    yplot[npts_max + i] = rho_c; 
-    }
+  epoch1 = xplot[0];
+  epoch2 = xplot[npts[0]-1];
+  status = orbit_compute_ephemerid_curve(orbit_infile, nber_of_orbits, 0,
+                                         epoch1, epoch2, npts_max,
+                                         &xplot[npts_max], &yplot[npts_max],
+                                         NULL, NULL, NULL);
+  if(status == 0) {
     npts[1] = npts_max;
     ncurves = 2;
+    }
   }
 strcpy(xlabel, "epoch [year]");
 strcpy(ylabel, "rho [arcsec]");
@@ -145,6 +126,82 @@ free(yplot);
 return(0);
 }
 /*************************************************************************
+* orbit_compute_ephemerid_curve
+* Compute the ephemerids of a (possibly multiple) system at npts equally
+* spaced epochs, with a single call to compute_multiple_system_ephemerides()
+*
+* INPUT:
+* orbit_infile: file with orbital elements (Marco's format)
+* full_orbit: if 1, epochs along the period of the first orbit
+*             (epoch1 and epoch2 are then not used)
+* epoch1, epoch2: range of epochs (if full_orbit == 0)
+* npts: number of points
+*
+* OUTPUT (not computed if NULL):
+* epoch_plot[npts], rho_plot[npts], theta_plot[npts] (degrees),
+* x_plot[npts], y_plot[npts] (sky plane, arcseconds)
+*************************************************************************/
+int orbit_compute_ephemerid_curve(char *orbit_infile, int nber_of_orbits,
+                                  int full_orbit, double epoch1, double epoch2,
+                                  int npts, float *epoch_plot, float *rho_plot,
+                                  float *theta_plot, float *x_plot,
+                                  float *y_plot)
+{
+double Omega_node[3], omega_peri[3], i_incl[3], e_eccent[3], T_periastron[3];
+double Period[3], a_smaxis[3], mean_motion[3], orbit_equinox[3];
+double *epochs, *rho_c, *theta_c, *x_c, *y_c;
+THIELE_ORBIT orbits[3];
+int status, orbit_format;
+register int i;
+
+if(npts < 2 || nber_of_orbits < 1 || nber_of_orbits > 3) {
+  fprintf(stderr, "orbit_compute_ephemerid_curve/Error: npts=%d nber_of_orbits=%d\n",
+          npts, nber_of_orbits);
+  return(-1);
+  }
+
+/* Marco's format: */
+orbit_format = 1;
+status = read_orbital_elements_from_file(orbit_infile, orbit_format,
+                           Omega_node, omega_peri, i_incl, e_eccent, 
+                           T_periastron, Period, a_smaxis, mean_motion, 
+                           orbit_equinox, nber_of_orbits);
+if(status != 0) {
+  fprintf(stderr, "orbit_compute_ephemerid_curve/Error reading >%s<\n",
+          orbit_infile);
+  return(-1);
+  }
+thiele_orbits_init(nber_of_orbits, Omega_node, omega_peri, i_incl, e_eccent,
+                   T_periastron, Period, a_smaxis, mean_motion, orbits);
+
+if(full_orbit) {
+  epoch1 = T_periastron[0];
+  epoch2 = T_periastron[0] + Period[0];
+  }
+
+epochs = (double *)malloc(5 * npts * sizeof(double));
+rho_c = &epochs[npts];
+theta_c = &epochs[2 * npts];
+x_c = &epochs[3 * npts];
+y_c = &epochs[4 * npts];
+for(i = 0; i < npts; i++) 
+  epochs[i] = epoch1 + i * (epoch2 - epoch1)/(double)(npts-1);
+
+compute_multiple_system_ephemerides(orbits, nber_of_orbits, epochs, npts,
+                                    x_c, y_c, theta_c, rho_c);
+
+for(i = 0; i < npts; i++) {
+  if(epoch_plot != NULL) epoch_plot[i] = epochs[i];
+  if(rho_plot != NULL) rho_plot[i] = rho_c[i];
+  if(theta_plot != NULL) theta_plot[i] = theta_c[i];
+  if(x_plot != NULL) x_plot[i] = x_c[i];
+  if(y_plot != NULL) y_plot[i] = y_c[i];
+  }
+
+free(epochs);
+return(0);
+}
+/*************************************************************************
 * orbit_plot_theta
 * To plot theta versus epoch
 *
@@ -164,12 +221,9 @@ int orbit_plot_theta(char *measures_infile, char *comments, char *orbit_infile,
 {
 float *xplot, *yplot;
 int grid, jlp_axes, icol_x, icol_y, status, isize; 
-int ncurves, npts[2], orbit_format;
+int ncurves, npts[2];
 char xlabel[41], ylabel[41], title[81], plotdev[128], outfile[128];
-double Omega_node[3], omega_peri[3], i_incl[3], e_eccent[3], T_periastron[3];
-double Period[3], a_smaxis[3], mean_motion[3], orbit_equinox[3];
-double c_tolerance[3], rho_c, theta_c, epoch, epoch1, epoch2;
-register int i, k;
+double epoch1, epoch2;
 
 if(iformat < 1 || iformat > 4) {
   fprintf(stderr, "orbit_plot_theta/Error: iformat=%d not alllowed here!\n", 
@@ -216,35 +270,18 @@ if(iformat == 3) {
   else ncurves = 2;
 /* Compute theta_C from orbital elements: */
   } else if(iformat == 4) {
-/* Marco's format: */
-   orbit_format = 1;
-   status = read_orbital_elements_from_file(orbit_infile, orbit_format,
-                           Omega_node, omega_peri, i_incl, e_eccent, 
-                           T_periastron, Period, a_smaxis, mean_motion, 
-                           orbit_equinox, nber_of_orbits);
-/*  c_tolerance = smallest increment allowed in the iterative process
-*                used for solving Kepler's equation
-*/
-   for(k = 0; k < nber_of_orbits; k++) 
-   c_tolerance[k] = ABS(1.5E-5 * cos(i_incl[k])
-                      / sqrt((1.0 + e_eccent[k])/(1.0 - e_eccent[k])));
-
+/* Compute theta_C from orbital elements at equally spaced
+* epochs along the range of epochs: */
   epoch1 = xplot[0];
   epoch2 = xplot[npts[0]-1];
-  for(i = 0; i < npts_max; i++) {
-/* Compute rho_C from orbital elements at equally spaced
-* epochs along the range of epochs: */
-    epoch = epoch1 + i * (epoch2 - epoch1)/(double)(npts_max-1);
-/* Compute the ephemerids corresponding to the observation epoch: */
-    compute_ephemerid_of_multiple_system(nber_of_orbits, Omega_node, 
-                      omega_peri, i_incl, e_eccent, T_periastron,
-                      Period, a_smaxis, mean_motion, epoch, c_tolerance,
-                      &theta_c, &rho_c);
-    xplot[npts_max + i] = epoch;
-    yplot[npts_max + i] = theta_c;
-    }
+  status = orbit_compute_ephemerid_curve(orbit_infile, nber_of_orbits, 0,
+                                         epoch1, epoch2, npts_max,
+                                         &xplot[npts_max], NULL,
+                                         &yplot[npts_max], NULL, NULL);
+  if(status == 0) {
     npts[1] = npts_max;
     ncurves = 2;
+    }
   }
 
 strcpy(xlabel, "epoch [year]");
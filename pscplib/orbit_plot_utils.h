@@ -34,6 +34,11 @@ int orbit_plot_rho(char *measures_infile, char *comments,
 int orbit_plot_theta(char *measures_infile, char *comments, 
                      char *orbit_file, int nber_of_orbits, int npts_max, 
                      int iformat, char *plotfile);
+int orbit_compute_ephemerid_curve(char *orbit_infile, int nber_of_orbits,
+                                  int full_orbit, double epoch1, double epoch2,
+                                  int npts, float *epoch_plot, float *rho_plot,
+                                  float *theta_plot, float *x_plot,
+                                  float *y_plot);
 int orbit_plot_curves(float *xplot, float *yplot, int npts_max, int *npts, 
                       int ncurves, int jlp_axes, int grid, char *xlabel, 
                       char *ylabel, char *title, char *measures_infile, 
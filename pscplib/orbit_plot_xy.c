@@ -52,14 +52,11 @@ int orbit_plot_skyplane(char *measures_infile, char *comments,
                         int iformat, int iplot, int resid_vectors, 
                         char *plotfile, char *plot_title)
 {
-float *xplot, *yplot, rho, theta, epoch;
+float *xplot, *yplot, rho, theta;
 float *rho_resid, *theta_resid, *xstart, *ystart, *xend, *yend;
 int icol_x, icol_y, status, k, npts[3], ncurves, isize, npts0, nresid;
-int orbit_format, ncur_max, draw_apsids, npts_pisco;
+int ncur_max, draw_apsids, npts_pisco;
 char xlabel[41], ylabel[41], title[81], plotdev[128];
-double Omega_node[3], omega_peri[3], i_incl[3], e_eccent[3], T_periastron[3];
-double Period[3], a_smaxis[3], mean_motion[3], orbit_equinox[3];
-double c_tolerance[3], rho_c, theta_c;
 register int i, ic;
 
 isize = npts_max * sizeof(float);
@@ -94,33 +91,14 @@ ncurves = 1;
 /* Compute rho_C and theta_C from orbital elements at equally spaced
 * epochs along the period (full orbit): */
   } else if(iplot == 3) {
-/* Marco's format: */
-   orbit_format = 1;
-   status = read_orbital_elements_from_file(orbit_infile, orbit_format,
-                           Omega_node, omega_peri, i_incl, e_eccent, 
-                           T_periastron, Period, a_smaxis, mean_motion, 
-                           orbit_equinox, nber_of_orbits);
-/*  c_tolerance = smallest increment allowed in the iterative process
-*                used for solving Kepler's equation
-*/
-   for(k = 0; k < nber_of_orbits; k++) 
-   c_tolerance[k] = ABS(1.5E-5 * cos(i_incl[k])
-                      / sqrt((1.0 + e_eccent[k])/(1.0 - e_eccent[k])));
-
-   for(i = 0; i < npts_max; i++) {
-/* Compute rho_C from orbital elements at equally spaced
-* epochs along the period: */
-    epoch = T_periastron[0] + i * Period[0]/(double)(npts_max-1);
-/* Compute the ephemerids corresponding to the observation epoch: */
-    compute_ephemerid_of_multiple_system(nber_of_orbits, Omega_node, 
-                      omega_peri, i_incl, e_eccent, T_periastron,
-                      Period, a_smaxis, mean_motion, epoch, c_tolerance,
-                      &theta_c, &rho_c);
-    xplot[i + npts_max] = rho_c;
-    yplot[i + npts_max] = theta_c;
-    }
-   npts[1] = npts_max;
-   ncurves++;
+   status = orbit_compute_ephemerid_curve(orbit_infile, nber_of_orbits, 1,
+                                          0., 0., npts_max, NULL,
+                                          &xplot[npts_max], &yplot[npts_max],
+                                          NULL, NULL);
+   if(status == 0) {
+     npts[1] = npts_max;
+     ncurves++;
+     }
 }
 
 // Load PISCO measures:
@@ -639,11 +617,11 @@ static int draw_line_of_apsids(char *orbit_infile, int *north_to_east,
 {
 int status, orbit_format, nber_of_orbits, rr, gg, bb;
 int lwidth, ltype;
-float x1, x2, y1, y2, epoch;
+float x1, x2, y1, y2;
 double Omega_node[3], omega_peri[3], i_incl[3], e_eccent[3], T_periastron[3];
 double Period[3], a_smaxis[3], mean_motion[3], orbit_equinox[3];
-double c_tolerance[3], rho_c1, theta_c1, rho_c2, theta_c2;
-double rho_c1b, theta_c1b;
+double epochs[3], rho_c[3], theta_c[3], rho_c1, theta_c1, rho_c2, theta_c2;
+THIELE_ORBIT orbits[1];
 
 orbit_format = 1;
 
@@ -654,37 +632,26 @@ status = read_orbital_elements_from_file(orbit_infile, orbit_format,
                            T_periastron, Period, a_smaxis, mean_motion, 
                            orbit_equinox, nber_of_orbits);
 
-/* c_tolerance = smallest increment allowed in the iterative process
-*                used for solving Kepler's equation
-*/
- c_tolerance[0] = ABS(1.5E-5 * cos(i_incl[0])
-                      / sqrt((1.0 + e_eccent[0])/(1.0 - e_eccent[0])));
-
-/* Look for the position of the companion at Periastron: 
-*/
- epoch = T_periastron[0];
- compute_ephemerid_of_multiple_system(nber_of_orbits, Omega_node, 
-                      omega_peri, i_incl, e_eccent, T_periastron,
-                      Period, a_smaxis, mean_motion, epoch, c_tolerance,
-                      &theta_c1, &rho_c1);
-// Small difference of epochs to have a small difference in the angles too..
- epoch = T_periastron[0] + 0.1;
- compute_ephemerid_of_multiple_system(nber_of_orbits, Omega_node, 
-                      omega_peri, i_incl, e_eccent, T_periastron,
-                      Period, a_smaxis, mean_motion, epoch, c_tolerance,
-                      &theta_c1b, &rho_c1b);
+/* Positions of the companion at Periastron, a little later
+* (small difference of epochs to have a small difference in the angles too)
+* and at Apoastron: */
+ thiele_orbits_init(nber_of_orbits, Omega_node, omega_peri, i_incl, e_eccent,
+                    T_periastron, Period, a_smaxis, mean_motion, orbits);
+ epochs[0] = T_periastron[0];
+ epochs[1] = T_periastron[0] + 0.1;
+ epochs[2] = T_periastron[0] + Period[0]/2.;
+ compute_multiple_system_ephemerides(orbits, nber_of_orbits, epochs, 3,
+                                     NULL, NULL, theta_c, rho_c);
+ rho_c1 = rho_c[0];
+ theta_c1 = theta_c[0];
+ rho_c2 = rho_c[2];
+ theta_c2 = theta_c[2];
 // Look for the sense of motion of the companion:
- if(theta_c1b - theta_c1 > 0) 
+ if(theta_c[1] - theta_c1 > 0) 
    *north_to_east = 1;
  else 
    *north_to_east = 0;
 
- epoch = T_periastron[0] + Period[0]/2.;
- compute_ephemerid_of_multiple_system(nber_of_orbits, Omega_node, 
-                      omega_peri, i_incl, e_eccent, T_periastron,
-                      Period, a_smaxis, mean_motion, epoch, c_tolerance,
-                      &theta_c2, &rho_c2);
-
 /* Transformation with a change of origin for theta (zero at the bottom of the 
 * plot)
 */
@@ -0,0 +1,242 @@
+/************************************************************************
+* "resid_cache.cpp"
+* Sidecar cache of the O-C residuals (see resid_cache.h)
+*
+* Layout of a cache file:
+*  - first line: magic, version, length of the context and context
+*  - one header line per entry ("@ hash key_length field_lengths")
+*    followed by the key and the fields (raw bytes)
+*
+* The file is written to a temporary file first, and renamed at the end,
+* so that an interrupted run does not leave a truncated cache.
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "resid_cache.h"
+#include "catalog_snapshot.h" // snapshot_checksum()
+
+/*
+#define DEBUG
+*/
+
+/************************************************************************
+* Constructor
+*
+* INPUT:
+* cache_fname0: name of the cache file (e.g., "resid_cache.dat")
+* context0: program name and options that were used to create
+*           the entries (one line of text)
+*************************************************************************/
+ResidCache::ResidCache(char *cache_fname0, const char *context0)
+{
+strncpy(cache_fname, cache_fname0, 255);
+cache_fname[255] = '\0';
+context = context0;
+nhits = 0;
+nmisses = 0;
+}
+/************************************************************************
+* Read the entries of the cache file
+* (nothing is read if the file was created with another context)
+*
+* OUTPUT:
+* 0 if the entries were read, -1 otherwise
+*************************************************************************/
+int ResidCache::Load()
+{
+char magic[16], buffer[512];
+std::string key, file_context;
+RESID_CACHE_ENTRY entry;
+unsigned long long hash;
+size_t length[RESID_CACHE_NFIELDS + 1], context_length;
+int version, i, status = 0;
+FILE *fp_in;
+
+entries.clear();
+
+if((fp_in = fopen(cache_fname, "rb")) == NULL) return(-1);
+
+if(fscanf(fp_in, "%8s %d %zu", magic, &version, &context_length) != 3
+   || strcmp(magic, RESID_CACHE_MAGIC) || version != RESID_CACHE_VERSION
+   || fgetc(fp_in) != ' ') {
+  fprintf(stderr, "ResidCache/Warning: bad header in %s (cache ignored)\n",
+          cache_fname);
+  fclose(fp_in);
+  return(-1);
+  }
+file_context.resize(context_length);
+if(context_length > 0
+   && fread(&file_context[0], 1, context_length, fp_in) != context_length)
+   status = -1;
+fgetc(fp_in);
+if(status || file_context != context) {
+  printf("ResidCache: %s was created with other options (cache ignored)\n",
+         cache_fname);
+  fclose(fp_in);
+  return(-1);
+  }
+
+while(fgets(buffer, 512, fp_in)) {
+  if(sscanf(buffer, "@ %llx %zu %zu %zu %zu %zu %zu %zu", &hash, &length[0],
+            &length[1], &length[2], &length[3], &length[4], &length[5],
+            &length[6])
+     != RESID_CACHE_NFIELDS + 2) {
+    status = -1;
+    break;
+    }
+  key.resize(length[0]);
+  if(length[0] > 0 && fread(&key[0], 1, length[0], fp_in) != length[0]) {
+    status = -1;
+    break;
+    }
+  for(i = 0; i < RESID_CACHE_NFIELDS; i++) {
+    entry.field[i].resize(length[i + 1]);
+    if(length[i + 1] > 0
+       && fread(&entry.field[i][0], 1, length[i + 1], fp_in) != length[i + 1])
+      status = -1;
+    }
+  if(status) break;
+  entry.hash = hash;
+  entry.used = 0;
+  entries[key] = entry;
+  }
+fclose(fp_in);
+
+if(status) {
+  fprintf(stderr, "ResidCache/Warning: %s is corrupted (cache ignored)\n",
+          cache_fname);
+  entries.clear();
+  return(-1);
+  }
+
+#ifdef DEBUG
+printf("ResidCache: %d entries read from %s\n", (int)entries.size(),
+       cache_fname);
+#endif
+
+return(0);
+}
+/************************************************************************
+* Write the entries used or stored during this run
+* (the entries of objects that are no longer processed are dropped)
+*************************************************************************/
+int ResidCache::Save()
+{
+char tmp_fname[300];
+std::unordered_map<std::string, RESID_CACHE_ENTRY>::iterator it;
+int i, status = 0;
+FILE *fp_out;
+
+sprintf(tmp_fname, "%s.tmp", cache_fname);
+if((fp_out = fopen(tmp_fname, "wb")) == NULL) {
+  fprintf(stderr, "ResidCache/Error opening %s\n", tmp_fname);
+  return(-1);
+  }
+
+fprintf(fp_out, "%s %d %zu ", RESID_CACHE_MAGIC, RESID_CACHE_VERSION,
+        context.size());
+fwrite(context.c_str(), 1, context.size(), fp_out);
+fprintf(fp_out, "\n");
+
+for(it = entries.begin(); it != entries.end(); it++) {
+  if(!it->second.used) continue;
+  fprintf(fp_out, "@ %016llx %zu", (unsigned long long)it->second.hash,
+          it->first.size());
+  for(i = 0; i < RESID_CACHE_NFIELDS; i++)
+    fprintf(fp_out, " %zu", it->second.field[i].size());
+  fprintf(fp_out, "\n");
+  fwrite(it->first.c_str(), 1, it->first.size(), fp_out);
+  for(i = 0; i < RESID_CACHE_NFIELDS; i++)
+    fwrite(it->second.field[i].c_str(), 1, it->second.field[i].size(), fp_out);
+  }
+
+if(ferror(fp_out)) status = -1;
+if(fclose(fp_out) != 0) status = -1;
+if(status || rename(tmp_fname, cache_fname) != 0) {
+  fprintf(stderr, "ResidCache/Error writing %s\n", cache_fname);
+  remove(tmp_fname);
+  return(-1);
+  }
+
+return(0);
+}
+/************************************************************************
+* Look for the entry "key"
+*
+* INPUT:
+* key: key of the entry
+* hash: content hash of the current inputs of the entry
+*
+* OUTPUT:
+* entry: pointer to the entry (if found)
+* 0 if the entry was found with the same hash, -1 otherwise
+*************************************************************************/
+int ResidCache::Lookup(const char *key, uint64_t hash,
+                       RESID_CACHE_ENTRY **entry)
+{
+std::unordered_map<std::string, RESID_CACHE_ENTRY>::iterator it;
+
+it = entries.find(key);
+if(it == entries.end() || it->second.hash != hash) {
+  nmisses++;
+  return(-1);
+  }
+
+it->second.used = 1;
+*entry = &(it->second);
+nhits++;
+
+return(0);
+}
+/************************************************************************
+* Store (or replace) the entry "key"
+*
+* INPUT:
+* key: key of the entry
+* hash: content hash of the inputs of the entry
+* fields[RESID_CACHE_NFIELDS]: text written in the output files
+*************************************************************************/
+void ResidCache::Store(const char *key, uint64_t hash, std::string *fields)
+{
+RESID_CACHE_ENTRY *entry;
+int i;
+
+entry = &entries[key];
+entry->hash = hash;
+entry->used = 1;
+for(i = 0; i < RESID_CACHE_NFIELDS; i++) entry->field[i] = fields[i];
+}
+/************************************************************************
+* Content hash of two strings (e.g., measurement line and orbit line)
+*************************************************************************/
+uint64_t resid_cache_hash(const char *str1, const char *str2)
+{
+std::string buffer;
+
+buffer = str1;
+buffer += '\n';
+buffer += str2;
+
+return(snapshot_checksum(buffer.c_str(), buffer.size()));
+}
+/************************************************************************
+* Content hash of a file (0 if the file cannot be read)
+*************************************************************************/
+uint64_t resid_cache_hash_file(char *fname)
+{
+std::vector<char> data;
+size_t nread;
+char buffer[65536];
+FILE *fp_in;
+
+if((fp_in = fopen(fname, "rb")) == NULL) return(0);
+while((nread = fread(buffer, 1, sizeof(buffer), fp_in)) > 0)
+  data.insert(data.end(), buffer, buffer + nread);
+fclose(fp_in);
+
+return(snapshot_checksum(data.empty() ? "" : &data[0], data.size()));
+}
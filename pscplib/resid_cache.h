@@ -0,0 +1,72 @@
+/************************************************************************
+* "resid_cache.h"
+* Sidecar cache of the O-C residuals, to update the output files
+* of the residual programs without recomputing the entries
+* whose inputs have not changed
+*
+* Each entry is identified by a key (e.g., object name and hash of the
+* measurement line) and contains the content hash of its inputs
+* (measurement line, orbit line, ...) and the text written
+* in the output files (RESID_CACHE_NFIELDS fields).
+* The cache is discarded if the context (program, options, reference file)
+* has changed.
+*
+* JLP
+* Version 17/10/2026
+*************************************************************************/
+#ifndef __resid_cache_h   /* BOF sentry */
+#define __resid_cache_h
+
+#include <stdint.h>
+#include <vector>
+#include <string>
+#include <unordered_map>
+
+#define RESID_CACHE_MAGIC   "PSCPRESC"
+#define RESID_CACHE_VERSION 1
+
+/* Fields of an entry: */
+#define RESID_CACHE_TXT      0    /* Lines of the .txt file */
+#define RESID_CACHE_LATEX    1    /* Lines of the .tex file */
+#define RESID_CACHE_CURVE    2    /* Lines of the _curve.dat file */
+#define RESID_CACHE_AUTHOR   3    /* Author of the orbit */
+#define RESID_CACHE_REFER0   4    /* Compacted reference */
+#define RESID_CACHE_REFER1   5    /* Full reference */
+#define RESID_CACHE_NFIELDS  6
+
+typedef struct {
+  uint64_t hash;
+  int used;
+  std::string field[RESID_CACHE_NFIELDS];
+} RESID_CACHE_ENTRY;
+
+class ResidCache {
+
+public:
+    ResidCache(char *cache_fname0, const char *context0);
+    ~ResidCache() {};
+
+    int NEntries() { return((int)entries.size()); }
+    int NHits() { return(nhits); }
+    int NMisses() { return(nmisses); }
+
+// Read the cache file (no entries if not found or other context):
+    int Load();
+// Write the entries used or stored during this run:
+    int Save();
+// Fields of the entry "key" if its hash is "hash" (returns 0 if found):
+    int Lookup(const char *key, uint64_t hash, RESID_CACHE_ENTRY **entry);
+    void Store(const char *key, uint64_t hash, std::string *fields);
+
+private:
+    char cache_fname[256];
+    std::string context;
+    int nhits, nmisses;
+    std::unordered_map<std::string, RESID_CACHE_ENTRY> entries;
+};
+
+/* Accessory routines: */
+uint64_t resid_cache_hash(const char *str1, const char *str2);
+uint64_t resid_cache_hash_file(char *fname);
+
+#endif   /* EOF sentry */
@@ -19,6 +19,14 @@
 #define DEBUG_1
 */
 
+/* Number of epochs processed together by compute_ephemerides(): */
+#define KEPLER_BLOCK 8
+/* Maximum number of additional Newton's iterations (e_eccent > 0.999): */
+#define KEPLER_NITER_MAX 50
+#define KEPLER_TOLERANCE 1.e-14
+/* (PI is only defined with 9 digits in jlp_catalog_utils.h) */
+#define KEPLER_TWOPI 6.28318530717958647692
+
 /*************************************************************
 * Compute the ephemerids corresponding to the observation epoch
 * of a multiple system
@@ -149,6 +157,292 @@ printf("pp=%f ee=%f e_ccent=%f a_smaxis=%f rho_c=%f\n", pp, ee, e_eccent,
        a_smaxis, *rho_c);
 */
 
+return(0);
+}
+/*************************************************************
+* Number of Halley's iterations needed by compute_ephemerides()
+* to solve Kepler's equation to machine precision
+* (for a mean anomaly in [-PI,PI])
+*************************************************************/
+static int kepler_niter(double e_eccent)
+{
+int niter;
+
+if(e_eccent < 0.1) niter = 1;
+else if(e_eccent < 0.75) niter = 2;
+else if(e_eccent < 0.95) niter = 3;
+else if(e_eccent < 0.99) niter = 4;
+else niter = 5;
+
+return(niter);
+}
+/*************************************************************
+* Mean anomaly (as in compute_ephemerid()) of nb epochs,
+* reduced to [-PI,PI]
+*************************************************************/
+static void kepler_mean_anomaly_block(const ORBIT_ELEMENTS *orbit,
+                                      const double *epochs,
+                                      double *mean_anomaly, int nb)
+{
+double daa;
+int j;
+
+for(j = 0; j < nb; j++) {
+  daa = epochs[j] - orbit->T_periastron;
+  daa = daa - orbit->Period * (double)((int)(daa / orbit->Period));
+  mean_anomaly[j] = orbit->mean_motion * daa;
+  mean_anomaly[j] -= KEPLER_TWOPI
+                     * floor(mean_anomaly[j] / KEPLER_TWOPI + 0.5);
+  }
+}
+/*************************************************************
+* Solve Kepler's equation for nb mean anomalies (nb <= KEPLER_BLOCK)
+* with the same starter as in compute_ephemerid() and niter Halley's
+* iterations (see kepler_niter())
+*
+* OUTPUT:
+*  ee[nb] = eccentric anomalies
+*************************************************************/
+static void kepler_solve_block(double ecc, int niter,
+                               const double *mean_anomaly, double *ee, int nb)
+{
+double ff, fp, sin_ee, cos_ee;
+int j, iter;
+
+/* Initialize ee: */
+for(j = 0; j < nb; j++)
+  ee[j] = mean_anomaly[j] + ecc * sin(mean_anomaly[j])
+     / sqrt(1.0 + ecc * (ecc - 2.0 * cos(mean_anomaly[j])));
+
+/* Halley's iterations: */
+for(iter = 0; iter < niter; iter++) {
+  for(j = 0; j < nb; j++) {
+    sin_ee = sin(ee[j]);
+    cos_ee = cos(ee[j]);
+    ff = ee[j] - ecc * sin_ee - mean_anomaly[j];
+    fp = 1.0 - ecc * cos_ee;
+    ee[j] -= ff / (fp - 0.5 * ff * ecc * sin_ee / fp);
+    }
+  }
+
+/* Newton's iterations if not converged (only for e_eccent > 0.999): */
+if(ecc > 0.999) {
+ for(j = 0; j < nb; j++) {
+   for(iter = 0; iter < KEPLER_NITER_MAX; iter++) {
+     ff = ee[j] - ecc * sin(ee[j]) - mean_anomaly[j];
+     if(ABS(ff) < KEPLER_TOLERANCE) break;
+     ee[j] -= ff / (1.0 - ecc * cos(ee[j]));
+     }
+   }
+ }
+}
+/*************************************************************
+* Compute the ephemerids of an orbit for n epochs
+* (same output as compute_ephemerid() for each epoch, with Kepler's
+*  equation solved to machine precision)
+*
+* Kepler's equation is solved for KEPLER_BLOCK epochs at a time,
+* with the same starter as in compute_ephemerid() and a fixed number
+* of Halley's iterations (depending on the eccentricity only),
+* without any test on the convergence inside the loops.
+* The mean anomaly is first reduced to [-PI,PI]. For e_eccent > 0.999,
+* Newton's iterations are added for the epochs that have not converged.
+*
+* The true anomaly, the position angle and the separation are then
+* computed from sin(ee) and cos(ee) with a single call to atan2().
+* The separation is a * r * sqrt(cos(pp)^2 + (cos(i) sin(pp))^2),
+* which is well conditioned, whereas cos(pp)/cos(theta) in
+* compute_ephemerid() is 0/0 when theta is close to 90 or 270 degrees.
+*
+* Accuracy: see bench/check_ephemerides.cpp (comparison with
+* an extended precision reference).
+*
+* INPUT:
+*  orbit = orbital elements (see compute_ephemerid())
+*  epochs[n] = epochs of the ephemerids
+*
+* OUTPUT:
+*  theta_c[n] = computed position angles (degrees)
+*  rho_c[n] = computed separation angles (arcseconds)
+*
+**************************************************************/
+int compute_ephemerides(const ORBIT_ELEMENTS *orbit, const double *epochs,
+                        int n, double *theta_c, double *rho_c)
+{
+double mean_anomaly[KEPLER_BLOCK], ee[KEPLER_BLOCK];
+double sin_ee, cos_ee, ecc, sqrt_1_e2, cos_i;
+double cos_omega, sin_omega, rr, cos_nu, sin_nu, cos_pp, sin_pp, ab, theta;
+int i0, nb, j, niter;
+
+ecc = orbit->e_eccent;
+sqrt_1_e2 = sqrt(1.0 - ecc * ecc);
+cos_i = cos(orbit->i_incl);
+cos_omega = cos(orbit->omega_peri);
+sin_omega = sin(orbit->omega_peri);
+niter = kepler_niter(ecc);
+
+for(i0 = 0; i0 < n; i0 += KEPLER_BLOCK) {
+  nb = (n - i0 < KEPLER_BLOCK) ? n - i0 : KEPLER_BLOCK;
+
+  kepler_mean_anomaly_block(orbit, &epochs[i0], mean_anomaly, nb);
+  kepler_solve_block(ecc, niter, mean_anomaly, ee, nb);
+
+  for(j = 0; j < nb; j++) {
+    sin_ee = sin(ee[j]);
+    cos_ee = cos(ee[j]);
+/* True anomaly nu, and pp = nu + omega_peri: */
+    rr = 1.0 - ecc * cos_ee;
+    cos_nu = (cos_ee - ecc) / rr;
+    sin_nu = sqrt_1_e2 * sin_ee / rr;
+    cos_pp = cos_nu * cos_omega - sin_nu * sin_omega;
+    sin_pp = sin_nu * cos_omega + cos_nu * sin_omega;
+    ab = cos_i * sin_pp;
+    theta = atan2(ab, cos_pp);
+    if(theta < 0.0) theta += 2.*PI;
+
+/* Computed position angle (in degrees, in the interval [0,360]): */
+    theta_c[i0 + j] = (theta + orbit->Omega_node) * (180./PI);
+    if(theta_c[i0 + j] < 0.0) theta_c[i0 + j] += 360.0;
+    if(theta_c[i0 + j] > 360.0) theta_c[i0 + j] -= 360.0;
+
+/* Computed separation angle
+* (cos(pp) / cos(theta) = sqrt(cos(pp)^2 + ab^2)): */
+    rho_c[i0 + j] = orbit->a_smaxis * rr * sqrt(cos_pp * cos_pp + ab * ab);
+    }
+  }
+
+return(0);
+}
+/*************************************************************
+* Load the orbital elements of the orbits of a multiple system
+* and compute their Thiele-Innes constants once, for
+* compute_multiple_system_ephemerides()
+*
+* INPUT:
+*  Omega_node[k], ..., mean_motion[k]: orbital elements (radians, years,
+*                   arcseconds, see compute_ephemerid()) of orbit #k
+*
+* OUTPUT:
+*  orbits[nber_of_orbits]
+**************************************************************/
+int thiele_orbits_init(int nber_of_orbits, double *Omega_node,
+                       double *omega_peri, double *i_incl, double *e_eccent,
+                       double *T_periastron, double *Period, double *a_smaxis,
+                       double *mean_motion, THIELE_ORBIT *orbits)
+{
+ORBIT_ELEMENTS *elem;
+int k;
+
+for(k = 0; k < nber_of_orbits; k++) {
+  elem = &orbits[k].elem;
+  elem->Omega_node = Omega_node[k];
+  elem->omega_peri = omega_peri[k];
+  elem->i_incl = i_incl[k];
+  elem->e_eccent = e_eccent[k];
+  elem->T_periastron = T_periastron[k];
+  elem->Period = Period[k];
+  elem->a_smaxis = a_smaxis[k];
+  elem->mean_motion = mean_motion[k];
+  compute_Thiele_elements(Omega_node[k], omega_peri[k], i_incl[k],
+                          e_eccent[k], T_periastron[k], Period[k], a_smaxis[k],
+                          mean_motion[k], 0., &orbits[k].AA, &orbits[k].BB,
+                          &orbits[k].FF, &orbits[k].GG);
+  orbits[k].sqrt_1_e2 = sqrt(1.0 - e_eccent[k] * e_eccent[k]);
+  orbits[k].niter = kepler_niter(e_eccent[k]);
+  }
+
+return(0);
+}
+/*************************************************************
+* Position of the companion of a single orbit in the sky plane
+* at epoch "epoch" (scalar version of compute_multiple_system_ephemerides())
+*
+* INPUT:
+*  orbit = orbit initialized with thiele_orbits_init()
+*
+* OUTPUT:
+*  x_c, y_c = position (arcseconds, x = rho cos(theta), y = rho sin(theta))
+**************************************************************/
+int thiele_orbit_position(const THIELE_ORBIT *orbit, double epoch,
+                          double *x_c, double *y_c)
+{
+double mean_anomaly, ee, XX, YY;
+
+kepler_mean_anomaly_block(&orbit->elem, &epoch, &mean_anomaly, 1);
+kepler_solve_block(orbit->elem.e_eccent, orbit->niter, &mean_anomaly, &ee, 1);
+XX = cos(ee) - orbit->elem.e_eccent;
+YY = orbit->sqrt_1_e2 * sin(ee);
+*x_c = orbit->AA * XX + orbit->FF * YY;
+*y_c = orbit->BB * XX + orbit->GG * YY;
+
+return(0);
+}
+/*************************************************************
+* Compute the ephemerids of a multiple system for n epochs
+* (same output as compute_ephemerid_of_multiple_system() for each epoch,
+*  with Kepler's equation solved to machine precision)
+*
+* For each orbit, the position of the companion in the sky plane
+* is obtained from the Thiele-Innes constants:
+*   x = A X + F Y,  y = B X + G Y
+* with X = cos(E) - e and Y = sqrt(1 - e^2) sin(E)
+* (x towards the North, y towards the East, i.e., x = rho cos(theta),
+*  y = rho sin(theta)). The positions of all the orbits are summed
+* before computing rho and theta.
+*
+* INPUT:
+*  orbits[nber_of_orbits] = orbits (initialized with thiele_orbits_init())
+*  epochs[n] = epochs of the ephemerids
+*
+* OUTPUT (not computed if NULL):
+*  x_c[n], y_c[n] = computed positions in the sky plane (arcseconds)
+*  theta_c[n] = computed position angles (degrees)
+*  rho_c[n] = computed separation angles (arcseconds)
+*
+**************************************************************/
+int compute_multiple_system_ephemerides(const THIELE_ORBIT *orbits,
+                                        int nber_of_orbits,
+                                        const double *epochs, int n,
+                                        double *x_c, double *y_c,
+                                        double *theta_c, double *rho_c)
+{
+double mean_anomaly[KEPLER_BLOCK], ee[KEPLER_BLOCK];
+double wx[KEPLER_BLOCK], wy[KEPLER_BLOCK], XX, YY;
+const THIELE_ORBIT *orb;
+int i0, nb, j, k;
+
+for(i0 = 0; i0 < n; i0 += KEPLER_BLOCK) {
+  nb = (n - i0 < KEPLER_BLOCK) ? n - i0 : KEPLER_BLOCK;
+
+  for(j = 0; j < nb; j++) {
+    wx[j] = 0.;
+    wy[j] = 0.;
+    }
+
+  for(k = 0; k < nber_of_orbits; k++) {
+    orb = &orbits[k];
+    kepler_mean_anomaly_block(&orb->elem, &epochs[i0], mean_anomaly, nb);
+    kepler_solve_block(orb->elem.e_eccent, orb->niter, mean_anomaly, ee, nb);
+    for(j = 0; j < nb; j++) {
+      XX = cos(ee[j]) - orb->elem.e_eccent;
+      YY = orb->sqrt_1_e2 * sin(ee[j]);
+      wx[j] += orb->AA * XX + orb->FF * YY;
+      wy[j] += orb->BB * XX + orb->GG * YY;
+      }
+    }
+
+  for(j = 0; j < nb; j++) {
+    if(x_c != NULL) x_c[i0 + j] = wx[j];
+    if(y_c != NULL) y_c[i0 + j] = wy[j];
+    if(rho_c != NULL) rho_c[i0 + j] = sqrt(wx[j] * wx[j] + wy[j] * wy[j]);
+    if(theta_c != NULL) {
+/* Conversion to degrees, in the interval [0,360]: */
+      theta_c[i0 + j] = atan2(wy[j], wx[j]) * (180./PI);
+      if(theta_c[i0 + j] < 0.0) theta_c[i0 + j] += 360.0;
+      }
+    }
+  }
+
 return(0);
 }
 /************************************************************
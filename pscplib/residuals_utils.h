@@ -11,6 +11,21 @@
 /* Declaring linkage specification to have "correct names"
 * that can be linked with C programs */
 
+/* Orbital elements of an orbit (see compute_ephemerid()) */
+typedef struct {
+double Omega_node, omega_peri, i_incl;  /* radians */
+double e_eccent, T_periastron, Period;  /* Period, T_periastron in years */
+double a_smaxis, mean_motion;           /* a_smaxis in arcseconds */
+} ORBIT_ELEMENTS;
+
+/* Orbit with its Thiele-Innes constants (see thiele_orbits_init()) */
+typedef struct {
+ORBIT_ELEMENTS elem;
+double AA, BB, FF, GG;                  /* arcseconds */
+double sqrt_1_e2;
+int niter;                              /* Halley's iterations for Kepler */
+} THIELE_ORBIT;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -24,6 +39,19 @@ int compute_ephemerid(double Omega_node, double omega_peri, double i_incl,
                       double e_eccent, double T_periastron, double Period, 
                       double a_smaxis, double mean_motion, double epoch_o, 
                       double c_tolerance, double *theta_c, double *rho_c);
+int compute_ephemerides(const ORBIT_ELEMENTS *orbit, const double *epochs,
+                        int n, double *theta_c, double *rho_c);
+int thiele_orbits_init(int nber_of_orbits, double *Omega_node,
+                       double *omega_peri, double *i_incl, double *e_eccent,
+                       double *T_periastron, double *Period, double *a_smaxis,
+                       double *mean_motion, THIELE_ORBIT *orbits);
+int thiele_orbit_position(const THIELE_ORBIT *orbit, double epoch,
+                          double *x_c, double *y_c);
+int compute_multiple_system_ephemerides(const THIELE_ORBIT *orbits,
+                                        int nber_of_orbits,
+                                        const double *epochs, int n,
+                                        double *x_c, double *y_c,
+                                        double *theta_c, double *rho_c);
 int precession_correction(double *dtheta_precess, double alpha, double delta, 
                           double epoch_o, double orbit_equinox);
 int read_orbital_elements_from_file(char *orbit_infile, int iformat,
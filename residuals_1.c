@@ -35,20 +35,59 @@
 #include "jlp_catalog_utils.h"
 #include "residuals_utils.h"
 #include "OC6_catalog_utils.h"
+#include "PISCO_catalog_utils.h" // get_coordinates_from_PISCO_catalog()
+#include "jlp_trim.h"           // trim_string() (in jlplib/jlp_fits)
+#include "jlp_threads.h"      // jlp_parallel_for()
 
 /*
 #define DEBUG
 #define DEBUG_1
 */
 
+/* Number of objects read before being processed in parallel: */
+#define NOBJ_BATCH 256
+
+/* Object read by compute_residuals(), with its orbit, its measurements
+* and the lines to be written in the output files: */
+typedef struct {
+  int iline, orbit_status, meas_status, status, nmeas;
+  char object_name[60], author[60], refer0[130], refer1[130];
+/* (40 characters for comp_name, as assumed by jlp_really_compact_companion) */
+  char discov_name[40], comp_name[40];
+  double Omega_node, omega_peri, i_incl, e_eccent, T_periastron, Period;
+  double a_smaxis, mean_motion, orbit_equinox;
+  int orbit_grade;
+  double epoch_o[50], rho_o[50], theta_o[50], err_rho_o[50], err_theta_o[50];
+  char *out_txt, *out_latex, *out_curve;
+  size_t len_txt, len_latex, len_curve;
+} RESID1_OBJECT;
+
+/* Batch of objects processed in parallel by process_object(): */
+typedef struct {
+  RESID1_OBJECT *obj;
+  char *calib_fname, *PISCO_catalog_name, *OC6_references_fname;
+  int iformat;
+} RESID1_BATCH;
+
 static int residuals1_main(char* input_filename, char *output_ext, 
                            char *calib_fname, char *PISCO_catalog_name,
-                           char *OC6_references_fname, int iformat);
+                           char *OC6_references_fname, int iformat,
+                           int nthreads);
 static int compute_residuals(FILE *fp_in, FILE *fp_out_txt, FILE *fp_out_latex, 
                              FILE *fp_out_curve, FILE *fp_out_ref1,
                              FILE *fp_out_ref2, char *calib_fname, 
                              char *PISCO_catalog_name, 
-                             char *OC6_references_fname, int iformat);
+                             char *OC6_references_fname, int iformat,
+                             int nthreads);
+static void process_batch(RESID1_BATCH *batch, int nobj, int nthreads, 
+                          FILE *fp_out_txt, FILE *fp_out_latex, 
+                          FILE *fp_out_curve, char *object_name, 
+                          char *author, char *refer0, char *refer1, int *kk);
+static void process_object(int k, void *data);
+static void write_object(RESID1_OBJECT *ob, FILE *fp_out_txt, 
+                         FILE *fp_out_latex, FILE *fp_out_curve, 
+                         char *object_name, char *author, char *refer0,
+                         char *refer1, int *kk);
 static int get_orbit_from_Marco_list(char *in_line1, char *in_line2, 
               char *calib_fname, int iline, 
               char *object_name, char *WDS_name, char *ADS_name, 
@@ -79,7 +118,10 @@ int main(int argc, char *argv[])
 char input_filename[80], output_ext[40], calib_fname[80];
 /* Can be long: e.g., "/home/text/tex/pisco_dbase/zeiss_doppie_new.cat" */
 char PISCO_catalog_name[100], OC6_references_fname[100];
-int iformat;
+int iformat, nthreads;
+
+/* Number of threads (option "-j N"): */
+nthreads = jlp_threads_from_args(&argc, argv);
 
 if(argc == 7) {
   if(*argv[6]) argc = 7;
@@ -91,10 +133,11 @@ if(argc == 7) {
   else argc = 1;
 }
 if(argc != 5 && argc != 6 && argc != 7) {
-  printf("Syntax: residuals_1 input_list input_format output_ext PISCO_catalog [calibrated_latex_table] [reference_list] \n");
+  printf("Syntax: residuals_1 [-j nthreads] input_list input_format output_ext PISCO_catalog [calibrated_latex_table] [reference_list] \n");
   printf("Format: -1 if Marco's format (Omega=node, omep=longitude of periastron, i, e, T, P, a, [equinox]) with measures\n");
   printf("        1 if Marco's format without measures\n");
   printf("        2 if OC6 format (P, a, i, Omega, T, e, omep, [equinox] )\n");
+  printf("nthreads: number of threads (1 by default, 0 for all the cores)\n");
   return(-1);
 }
 strcpy(input_filename, argv[1]);
@@ -132,7 +175,7 @@ printf("OK: OC6_references_fname=>%s<\n", OC6_references_fname);
 
 /* Call residuals1_main that does the main job: */
 residuals1_main(input_filename, output_ext, calib_fname, PISCO_catalog_name,
-                OC6_references_fname, iformat);
+                OC6_references_fname, iformat, nthreads);
 
 return(0);
 }
@@ -152,11 +195,13 @@ return(0);
 * OC6_references_fname: name of the file containing the OC6 biblio. references
 * iformat: format of the input file (-1=Marco with measures, 
 *          1=Marco without measures, 2=OC6 without measures)
+* nthreads: number of threads used for processing the objects
 *
 *************************************************************************/
 static int residuals1_main(char* input_filename, char *output_ext, 
                            char *calib_fname, char *PISCO_catalog_name,
-                           char *OC6_references_fname, int iformat)
+                           char *OC6_references_fname, int iformat,
+                           int nthreads)
 {
 char out_filename[100];
 FILE *fp_in, *fp_out_txt, *fp_out_latex, *fp_out_curve; 
@@ -269,7 +314,7 @@ fprintf(fp_out_curve, "%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%\
 */
 compute_residuals(fp_in, fp_out_txt, fp_out_latex, fp_out_curve, 
                   fp_out_ref1, fp_out_ref2, calib_fname, PISCO_catalog_name, 
-                  OC6_references_fname, iformat);
+                  OC6_references_fname, iformat, nthreads);
 
 /* Epilog for Latex file: */
 fprintf(fp_out_latex, " & & & & & \\\\ \n \\hline \n \\end{tabular} \n\
@@ -441,6 +486,11 @@ return(0);
 * look for the measures in the tab_calib.tex 
 * and compute the residuals 
 *
+* The objects are read (reader stage) by batches of NOBJ_BATCH objects,
+* that are processed in parallel by nthreads threads (process_object()),
+* and then written in the original order (write_object()), 
+* so that the output files do not depend on the number of threads.
+*
 * INPUT:
 * fp_in: pointer to the input file containing the measurements and the
 *        orbital elements
@@ -452,25 +502,37 @@ return(0);
 * fp_out_ref2: pointer to the file with full references
 * iformat: format of the input file (-1=Marco with measures, 
 *          1=Marco without measures, 2=OC6 without measures)
+* nthreads: number of threads used for processing the objects
 *
 *************************************************************************/
 static int compute_residuals(FILE *fp_in, FILE *fp_out_txt, 
                               FILE *fp_out_latex, FILE *fp_out_curve, 
                               FILE *fp_out_ref1, FILE *fp_out_ref2, 
                               char *calib_fname, char *PISCO_catalog_name, 
-                              char *OC6_references_fname, int iformat)
+                              char *OC6_references_fname, int iformat,
+                              int nthreads)
 {
 #define NMAX 1024
-double Omega_node, omega_peri, i_incl, e_eccent, T_periastron, orbit_equinox;
-double mean_motion, a_smaxis, Period; 
-double epoch_o[50], rho_o[50], theta_o[50], err_rho_o[50], err_theta_o[50];
-int nmeas, iline, status, is_master_file, line_length, n_names, kk;
-char object_name[NMAX*60], discov_name[40], comp_name[10], WDS_name[40]; 
-char ADS_name[40], author[NMAX*60], refer0[NMAX*130], refer1[NMAX*130];
+RESID1_BATCH batch;
+RESID1_OBJECT *ob;
+int iline, status, is_master_file, line_length, n_names, kk, nobj;
+char WDS_name[40], ADS_name[40];
+char object_name[NMAX*60], author[NMAX*60], refer0[NMAX*130], refer1[NMAX*130];
 /* Maximum line seems to be 265 for OC6 catalog... */
 char in_line1[300], in_line2[300];
 
+batch.obj = (RESID1_OBJECT *)malloc(NOBJ_BATCH * sizeof(RESID1_OBJECT));
+if(batch.obj == NULL) {
+  fprintf(stderr, "compute_residuals/Fatal error allocating memory\n");
+  exit(-1);
+  }
+batch.calib_fname = calib_fname;
+batch.PISCO_catalog_name = PISCO_catalog_name;
+batch.OC6_references_fname = OC6_references_fname;
+batch.iformat = iformat;
+
 kk = 0;
+nobj = 0;
 iline = 0;
 
 while(!feof(fp_in)) {
@@ -487,9 +549,24 @@ while(!feof(fp_in)) {
 * program
 */
     if(line_length < 10) {
+/* Objects read before this line are written first: */
+      process_batch(&batch, nobj, nthreads, fp_out_txt, fp_out_latex, 
+                    fp_out_curve, object_name, author, refer0, refer1, &kk);
+      nobj = 0;
       printf("WARNING line #%d is very short (length=%d): >%s<\n", 
               iline, line_length, in_line1);
     } else {
+    ob = &batch.obj[nobj];
+    ob->object_name[0] = '\0';
+    ob->author[0] = '\0';
+    ob->refer0[0] = '\0';
+    ob->refer1[0] = '\0';
+    ob->nmeas = 0;
+    ob->meas_status = 0;
+    ob->status = 0;
+    ob->out_txt = NULL;
+    ob->out_latex = NULL;
+    ob->out_curve = NULL;
 /* Read input line and retrieve the orbital parameters and the
 *  measurements
 */
@@ -504,90 +581,58 @@ while(!feof(fp_in)) {
         }
 
      status = get_orbit_from_Marco_list(in_line1, in_line2, 
-                               calib_fname, iline, &object_name[kk * 60], 
-                               WDS_name, ADS_name, discov_name, comp_name, 
-                               &author[kk * 60], &Omega_node, 
-                               &omega_peri, &i_incl, 
-                               &e_eccent, &T_periastron, &Period, &a_smaxis, 
-                               &mean_motion, &orbit_equinox);
-     object_name[(kk+1)*60 -1] = '\0';
-     author[(kk+1)*60 -1] = '\0';
+                               calib_fname, iline, ob->object_name, 
+                               WDS_name, ADS_name, ob->discov_name, 
+                               ob->comp_name, ob->author, &ob->Omega_node, 
+                               &ob->omega_peri, &ob->i_incl, 
+                               &ob->e_eccent, &ob->T_periastron, &ob->Period,
+                               &ob->a_smaxis, &ob->mean_motion, 
+                               &ob->orbit_equinox);
+     ob->object_name[59] = '\0';
+     ob->author[59] = '\0';
 /* OC6 format: */
      } else {
      status = get_orbit_from_OC6_list(in_line1, iline, 
                                  is_master_file, WDS_name, ADS_name, 
-                                 discov_name, comp_name, &object_name[kk * 60],
-                                 &author[kk * 60], &Omega_node, 
-                                 &omega_peri, &i_incl, 
-                                 &e_eccent, &T_periastron, &Period, &a_smaxis, 
-                                 &mean_motion, &orbit_equinox);
-     object_name[(kk+1)*60 -1] = '\0';
-     author[(kk+1)*60 -1] = '\0';
+                                 ob->discov_name, ob->comp_name, 
+                                 ob->object_name, ob->author, 
+                                 &ob->Omega_node, &ob->omega_peri, 
+                                 &ob->i_incl, &ob->e_eccent, 
+                                 &ob->T_periastron, &ob->Period, 
+                                 &ob->a_smaxis, &ob->mean_motion, 
+                                 &ob->orbit_equinox, 
+                                 &ob->orbit_grade);
+     ob->object_name[59] = '\0';
+     ob->author[59] = '\0';
      if(!status && *OC6_references_fname) 
-          get_OC6_full_reference(&object_name[kk * 60], &author[kk * 60], 
-                                 OC6_references_fname, &refer0[kk * 130], 
-                                 &refer1[kk * 130]); 
-        refer0[(kk+1)*130 -1] = '\0';
-        refer1[(kk+1)*130 -1] = '\0';
-/* DEBUG:
-printf("object=%s author=%s refer0=%s refer1=%s\n", &object_name[kk * 60], 
-         &author[kk*60], &refer0[kk * 130], &refer1[kk * 130]);
-*/
-
+          get_OC6_full_reference(ob->object_name, ob->author, 
+                                 OC6_references_fname, ob->refer0, 
+                                 ob->refer1); 
+        ob->refer0[129] = '\0';
+        ob->refer1[129] = '\0';
      }
-     if(status) {
-     fprintf(stderr, "compute_residuals/WARNING: error reading orbital parameters in line #%d (status=%d)\n", iline, status); 
-     } else {
-/* Retrieve the measurements from the input files
- and compute the corresponding residuals */
-    
+     ob->orbit_status = status;
 /* Retrieve the measurements from the input file (if iformat < 0)
-* or retrieve the measurements from the calibrated table.
+* (the measurements from the calibrated table are read by process_object())
 */
-     if(iformat > 0) {
-/* Read the measurements from the calibrated file if iformat > 0: */
-      status = get_measures_from_CALIB_table(calib_fname, 
-                       &object_name[kk * 60], comp_name, epoch_o, rho_o, 
-                       theta_o, err_rho_o, err_theta_o, &nmeas); 
-/* Otherwise read the measurements from the input file fp_in: */
-     } else {
-       status = get_measures_from_file(fp_in, &iline, epoch_o, 
-                       rho_o, theta_o, err_rho_o, err_theta_o, &nmeas);
+     if(!status && iformat < 0) {
+       ob->meas_status = get_measures_from_file(fp_in, &iline, ob->epoch_o, 
+                       ob->rho_o, ob->theta_o, ob->err_rho_o, 
+                       ob->err_theta_o, &ob->nmeas);
      }
-/* Process all measurements */
-     if(status < 0) {
-     fprintf(stderr, "\ncompute_residuals/Error processing line #%d\n", 
-             iline); 
-     } else if (status > 0 || nmeas == 0) {
-     fprintf(stderr, "compute_residuals/Warning missing measurements in line #%d\n", 
-             iline); 
-     } else {
-/* Process all nmeas measurements relative to a given object:
-* correct the measurements from precession, compute the ephemerides,
-* and derive the O-C residuals
-*/
-       status = process_measurements(fp_out_txt, fp_out_latex, fp_out_curve, 
-                                     PISCO_catalog_name, OC6_references_fname, 
-                                     &object_name[kk * 60], 
-                                     discov_name, comp_name, &author[kk * 60], 
-                                     Omega_node, omega_peri, i_incl, e_eccent, 
-                                     T_periastron, Period, a_smaxis, 
-                                     mean_motion, orbit_equinox, epoch_o, 
-                                     rho_o, theta_o, err_rho_o, 
-                                     err_theta_o, nmeas);
-       if(status) {
-       fprintf(stderr, 
-               "compute_residuals/Error processing measurements in line #%d\n",
-               iline); 
-       } else {
-/* Update kk the orbit counter: */
-       kk++;
-       }
-     } /* EOF !status (from get_measures_from... */
-     } /* EOF !status (succes reading orbital parameters of the current line */
+     ob->iline = iline;
+     nobj++;
     } /* EOF line is not short (i.e., i > 10) */
     } /* EOF if in_line1 != % */
   } /* EOF if fgets */ 
+
+/* Process the objects of the batch in parallel,
+* and write the results in the original order: */
+  if(nobj == NOBJ_BATCH || feof(fp_in)) {
+    process_batch(&batch, nobj, nthreads, fp_out_txt, fp_out_latex, 
+                  fp_out_curve, object_name, author, refer0, refer1, &kk);
+    nobj = 0;
+    }
  }
 
 n_names = kk;
@@ -599,9 +644,139 @@ printf("Compute_residuals: %d lines sucessfully read (n_names=%d)\n",
 if(fp_out_ref1 != NULL && fp_out_ref2 != NULL) 
             sort_references(fp_out_ref1, fp_out_ref2, object_name, author, 
                             refer0, refer1, n_names);
+free(batch.obj);
 return(0);
 }
 /************************************************************************
+* Process the nobj objects of the batch in parallel,
+* and write the results in the original order
+*
+* INPUT/OUTPUT:
+* object_name, author, refer0, refer1: names and references of
+*              the objects processed successfully
+* kk: orbit counter
+************************************************************************/
+static void process_batch(RESID1_BATCH *batch, int nobj, int nthreads, 
+                          FILE *fp_out_txt, FILE *fp_out_latex, 
+                          FILE *fp_out_curve, char *object_name, 
+                          char *author, char *refer0, char *refer1, int *kk)
+{
+int i;
+
+if(nobj <= 0) return;
+
+jlp_parallel_for(nobj, nthreads, process_object, batch);
+
+for(i = 0; i < nobj; i++) 
+  write_object(&batch->obj[i], fp_out_txt, fp_out_latex, fp_out_curve, 
+               &object_name[*kk * 60], &author[*kk * 60], 
+               &refer0[*kk * 130], &refer1[*kk * 130], kk);
+}
+/************************************************************************
+* Process an object of the batch read by compute_residuals()
+* (called by the threads of the pool, with k = index of the object):
+* read the measurements from the calibrated table (if iformat > 0), 
+* correct the measurements from precession, compute the ephemerides,
+* and derive the O-C residuals
+*
+* The output lines are stored in memory (ob->out_txt, ob->out_latex,
+* ob->out_curve), to be written by write_object()
+************************************************************************/
+static void process_object(int k, void *data)
+{
+RESID1_BATCH *batch = (RESID1_BATCH *)data;
+RESID1_OBJECT *ob = &batch->obj[k];
+FILE *fp_txt, *fp_latex, *fp_curve;
+
+if(ob->orbit_status) return;
+
+/* Read the measurements from the calibrated file if iformat > 0: */
+if(batch->iformat > 0) {
+  ob->meas_status = get_measures_from_CALIB_table(batch->calib_fname, 
+                       ob->object_name, ob->comp_name, ob->epoch_o, ob->rho_o, 
+                       ob->theta_o, ob->err_rho_o, ob->err_theta_o, 
+                       &ob->nmeas); 
+  }
+if(ob->meas_status != 0 || ob->nmeas == 0) return;
+
+fp_txt = open_memstream(&ob->out_txt, &ob->len_txt);
+fp_latex = open_memstream(&ob->out_latex, &ob->len_latex);
+fp_curve = open_memstream(&ob->out_curve, &ob->len_curve);
+if(fp_txt == NULL || fp_latex == NULL || fp_curve == NULL) {
+  fprintf(stderr, "process_object/Fatal error allocating memory\n");
+  exit(-1);
+  }
+
+/* Process all nmeas measurements relative to a given object:
+* correct the measurements from precession, compute the ephemerides,
+* and derive the O-C residuals
+*/
+ob->status = process_measurements(fp_txt, fp_latex, fp_curve, 
+                                  batch->PISCO_catalog_name, 
+                                  batch->OC6_references_fname, 
+                                  ob->object_name, ob->discov_name, 
+                                  ob->comp_name, ob->author, 
+                                  ob->Omega_node, ob->omega_peri, ob->i_incl, 
+                                  ob->e_eccent, ob->T_periastron, ob->Period,
+                                  ob->a_smaxis, ob->mean_motion, 
+                                  ob->orbit_equinox, ob->epoch_o, ob->rho_o, 
+                                  ob->theta_o, ob->err_rho_o, 
+                                  ob->err_theta_o, ob->nmeas);
+fclose(fp_txt);
+fclose(fp_latex);
+fclose(fp_curve);
+}
+/************************************************************************
+* Write the results of an object processed by process_object()
+* to the output files, with the same messages as in the former serial
+* version of compute_residuals()
+*
+* OUTPUT:
+* object_name, author, refer0, refer1: names and references of
+*              the object, if processed successfully
+* kk: orbit counter (incremented if the object was processed successfully)
+************************************************************************/
+static void write_object(RESID1_OBJECT *ob, FILE *fp_out_txt, 
+                         FILE *fp_out_latex, FILE *fp_out_curve, 
+                         char *object_name, char *author, char *refer0,
+                         char *refer1, int *kk)
+{
+
+if(ob->orbit_status) {
+  fprintf(stderr, "compute_residuals/WARNING: error reading orbital parameters in line #%d (status=%d)\n", ob->iline, ob->orbit_status); 
+  return;
+  }
+
+/* Process all measurements */
+if(ob->meas_status < 0) {
+  fprintf(stderr, "\ncompute_residuals/Error processing line #%d\n", 
+          ob->iline); 
+} else if (ob->meas_status > 0 || ob->nmeas == 0) {
+  fprintf(stderr, "compute_residuals/Warning missing measurements in line #%d\n", 
+          ob->iline); 
+} else {
+  fwrite(ob->out_txt, 1, ob->len_txt, fp_out_txt);
+  fwrite(ob->out_latex, 1, ob->len_latex, fp_out_latex);
+  fwrite(ob->out_curve, 1, ob->len_curve, fp_out_curve);
+  if(ob->status) {
+    fprintf(stderr, 
+            "compute_residuals/Error processing measurements in line #%d\n",
+            ob->iline); 
+  } else {
+/* Update kk the orbit counter: */
+    strcpy(object_name, ob->object_name);
+    strcpy(author, ob->author);
+    strcpy(refer0, ob->refer0);
+    strcpy(refer1, ob->refer1);
+    (*kk)++;
+  }
+}
+
+free(ob->out_txt);
+free(ob->out_latex);
+free(ob->out_curve);
+}
+/************************************************************************
 * Process all measurements relative to a given object:
 * correct the measurements from precession, compute the ephemerides,
 * and derive the O-C residuals
@@ -630,7 +805,7 @@ static int process_measurements(FILE *fp_out_txt, FILE *fp_out_latex,
 char my_name[60], quadrant_discrep[20];
 double alpha, delta, dtheta_precess, coord_equinox, c_tolerance;
 double rho_c, theta_c, Drho, Dtheta;
-int status, has_an_orbit;
+int status, coord_found;
 register int i;
 
 /*  c_tolerance = smallest increment allowed in the iterative process
@@ -641,6 +816,7 @@ c_tolerance = ABS(1.5E-5 * cos(i_incl)
 
 /* Main loop on all the measures 
 */
+coord_found = 0;
 for(i = 0; i < nmeas; i++) {
 
 /* Conversion to radians: */
@@ -650,12 +826,15 @@ for(i = 0; i < nmeas; i++) {
 /* DEBUGGG */
 if(ABS(epoch_o[i] - orbit_equinox) > 10.){
 /* Look for object_name in file PISCO_catalog_name ("zeiss_doppie.cat"), 
-* and determine values of: alpha, delat, coord_equinox,
-*                          has_an_orbit
+* and determine values of: alpha, delat, coord_equinox
+* (only once for all the measures of this object)
 */
-status = get_coordinates_from_PISCO_catalog(PISCO_catalog_name, object_name, 
-                                            &alpha, &delta, &coord_equinox, 
-                                            &has_an_orbit);
+status = 0;
+if(!coord_found) {
+  status = get_coordinates_from_PISCO_catalog(PISCO_catalog_name, object_name, 
+                                              &alpha, &delta, &coord_equinox);
+  if(!status) coord_found = 1;
+  }
 /* Compute dtheta_precess, the precession correction:
 */
 if(!status) {
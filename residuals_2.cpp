@@ -13,6 +13,7 @@
 #include "jlp_catalog_utils.h"
 #include "jlp_string.h"  // jlp_trim_string
 #include "residuals_utils.h"
+#include "orbit_model.h"    // OrbitModel
 
 #define SQUARE(a) ((a)*(a))
 #define DEBUG0
@@ -311,17 +312,14 @@ static int scan_input_file(FILE *fp_in, FILE *fp_Drho_Dtheta,
               double *sigma_theta) 
 {
 double epoch, rho_o, theta_o, weight, rho_c, theta_c, Drho, Dtheta; 
-double c_tolerance[3], Drho_err, Dtheta_err, x_O, y_O, x_C, y_C;
+double Drho_err, Dtheta_err, x_O, y_O, x_C, y_C;
 double Drho_sum, Drho_sumsq, Dtheta_sum, Dtheta_sumsq, Dx, Dy;
-int n_nights, iaperture, n_observations, iline, nval, n_Drho, n_Dtheta, k;
+int n_nights, iaperture, n_observations, iline, nval, n_Drho, n_Dtheta;
 char buffer[80], author[10];
+/* Thiele-Innes constants of the orbits, computed once for all the epochs: */
+OrbitModel model(nber_of_orbits, Omega_node, omega_peri, i_incl, e_eccent,
+                 T_periastron, Period, a_smaxis, mean_motion);
 
-/*  c_tolerance = smallest increment allowed in the iterative process
-*                used for solving Kepler's equation
-*/
-for(k = 0; k < nber_of_orbits; k++) 
-c_tolerance[k] = ABS(1.5E-5 * cos(i_incl[k]) 
-                   / sqrt((1.0 + e_eccent[k])/(1.0 - e_eccent[k])));
 
 n_observations = 0;
 iline = 0;
@@ -366,10 +364,7 @@ while(!feof(fp_in)) {
 #endif
 
 /* Compute the ephemerids corresponding to the observation epoch: */
-compute_ephemerid_of_multiple_system(nber_of_orbits,
-                      Omega_node, omega_peri, i_incl, e_eccent, T_periastron, 
-                      Period, a_smaxis, mean_motion, epoch, c_tolerance, 
-                      &theta_c, &rho_c);
+model.Ephemerides(&epoch, 1, &x_C, &y_C, &theta_c, &rho_c);
 
  Dtheta = theta_o - theta_c;
  if(Dtheta < -300.0) Dtheta += 360.0;
@@ -403,11 +398,10 @@ compute_ephemerid_of_multiple_system(nber_of_orbits,
 /* Output the residuals as (Dx,Dy) */
  if(Drho != -100) {
 /* DEGTORAD = (PI/180.00) */
+/* (x_C, y_C given by the orbit model) */
     x_O = rho_o * cos(theta_o * DEGTORAD);
-    x_C = rho_c * cos(theta_c * DEGTORAD);
     Dx = x_O - x_C;
     y_O = rho_o * sin(theta_o * DEGTORAD);
-    y_C = rho_c * sin(theta_c * DEGTORAD);
     Dy = y_O - y_C;
 // orbit_data : x_O, y_O, x_C, y_C
     fprintf(fp_orbit_data, " %8.3f %8.3f %8.3f %8.3f\n",
@@ -469,9 +463,11 @@ static int remove_bad_values(FILE *fp_in, FILE *fp_selection,
               double sigma_theta_max) 
 {
 double epoch, rho_o, theta_o, weight, rho_c, theta_c, Drho, Dtheta; 
-double c_tolerance[3];
+/* Thiele-Innes constants of the orbits, computed once for all the epochs: */
+OrbitModel model(nber_of_orbits, Omega_node, omega_peri, i_incl, e_eccent,
+                 T_periastron, Period, a_smaxis, mean_motion);
 int n_nights, iaperture, n_full_observations, n_observations; 
-int iline, nval, k, code_selection;
+int iline, nval, code_selection;
 char buffer[80], author[10], code[2];
 double sumsq_dtheta, sumsq_drho;
 
@@ -479,12 +475,6 @@ double sumsq_dtheta, sumsq_drho;
 */
 code_selection = (sigma_rho_max == -1 || sigma_theta_max == -1) ? 1 : 0;
 
-/*  c_tolerance = smallest increment allowed in the iterative process
-*                used for solving Kepler's equation
-*/
-for(k = 0; k < nber_of_orbits; k++) 
-c_tolerance[k] = ABS(1.5E-5 * cos(i_incl[k]) 
-                   / sqrt((1.0 + e_eccent[k])/(1.0 - e_eccent[k])));
 
 n_observations = 0;
 sumsq_drho = 0.;
@@ -546,10 +536,7 @@ if(code_selection) {
      }
 } else {
 /* Compute the ephemerids corresponding to the observation epoch: */
-compute_ephemerid_of_multiple_system(nber_of_orbits,
-                      Omega_node, omega_peri, i_incl, e_eccent, T_periastron, 
-                      Period, a_smaxis, mean_motion, epoch, c_tolerance, 
-                      &theta_c, &rho_c);
+model.Ephemerid(epoch, &theta_c, &rho_c);
 
  Drho = rho_o - rho_c;
 /* When rho is negative, rho values are not taken into account 
@@ -32,20 +32,60 @@
 #include "jlp_catalog_utils.h"
 #include "residuals_utils.h"
 #include "OC6_catalog_utils.h"
+#include "jlp_trim.h"           // trim_string() (in jlplib/jlp_fits)
+#include "jlp_threads.h"      // jlp_parallel_for()
 
 /*
 #define DEBUG
 #define DEBUG_1
 */
 
+/* Number of objects read before being processed in parallel: */
+#define NOBJ_BATCH 256
+
+/* Object read by compute_residuals_gili(), with its orbit, its measurements
+* and the lines to be written in the output files: */
+typedef struct {
+  int iline, orbit_status, meas_status, status, nmeas;
+  char in_line1[300];
+  char object_name[60], author[60], refer0[130], refer1[130];
+/* (40 characters for comp_name, as assumed by jlp_really_compact_companion) */
+  char discov_name[40], comp_name[40];
+  double Omega_node, omega_peri, i_incl, e_eccent, T_periastron, Period;
+  double a_smaxis, mean_motion, orbit_equinox;
+  int orbit_grade;
+  double epoch_o[50], rho_o[50], theta_o[50], err_rho_o[50], err_theta_o[50];
+  char *out_txt, *out_latex, *out_curve;
+  size_t len_txt, len_latex, len_curve;
+} RESIDG1_OBJECT;
+
+/* Batch of objects processed in parallel by process_object_gili(): */
+typedef struct {
+  RESIDG1_OBJECT *obj;
+  char *calib_fname, *OC6_references_fname;
+  int iformat, gili_format;
+} RESIDG1_BATCH;
+
 static int residuals_gili_1_main(char* input_filename, char *output_ext, 
                                  char *calib_fname, 
-                                 char *OC6_references_fname, int iformat);
+                                 char *OC6_references_fname, int iformat,
+                                 int gili_format, int nthreads);
 static int compute_residuals_gili(FILE *fp_in, FILE *fp_out_txt, 
                                   FILE *fp_out_latex, FILE *fp_out_curve, 
                                   FILE *fp_out_ref1, FILE *fp_out_ref2, 
                                   char *calib_fname, 
-                                  char *OC6_references_fname, int iformat);
+                                  char *OC6_references_fname, int iformat,
+                                  int gili_format, int nthreads);
+static void process_batch_gili(RESIDG1_BATCH *batch, int nobj, int nthreads, 
+                               FILE *fp_out_txt, FILE *fp_out_latex, 
+                               FILE *fp_out_curve, char *object_name, 
+                               char *author, char *refer0, char *refer1, int *kk);
+static void process_object_gili(int k, void *data);
+static void write_object_gili(RESIDG1_OBJECT *ob, int iformat, 
+                              FILE *fp_out_txt, FILE *fp_out_latex, 
+                              FILE *fp_out_curve, char *object_name, 
+                              char *author, char *refer0, char *refer1, 
+                              int *kk);
 static int get_orbit_from_Marco_list(char *in_line1, char *in_line2, 
               int iline, 
               char *object_name, char *WDS_name, char *ADS_name, 
@@ -74,7 +114,10 @@ int main(int argc, char *argv[])
 {
 char input_filename[80], output_ext[40], calib_fname[80];
 char OC6_references_fname[128];
-int iformat;
+int iformat, gili_format, nthreads;
+
+/* Number of threads (option "-j N"): */
+nthreads = jlp_threads_from_args(&argc, argv);
 
 if(argc == 7) {
   if(*argv[6]) argc = 7;
@@ -85,22 +128,27 @@ if(argc == 7) {
   else if(*argv[1]) argc = 2;
   else argc = 1;
 }
-if(argc != 4 && argc != 5 && argc != 6) {
-  printf("Syntax: residuals_1 input_list input_format output_ext [calibrated_latex_table] [reference_list] \n");
+if(argc < 4 || argc > 7) {
+  printf("Syntax: residuals_gili_1 [-j nthreads] input_list input_format output_ext [calibrated_latex_table] [gili_format] [reference_list] \n");
   printf("Format: -1 if Marco's format (Omega=node, omep=longitude of periastron, i, e, T, P, a, [equinox]) with measures\n");
   printf("        1 if Marco's format without measures\n");
   printf("        2 if OC6 format (P, a, i, Omega, T, e, omep, [equinox] )\n");
+  printf("gili_format: 1 if Gili's calibrated table (default), 0 otherwise\n");
+  printf("nthreads: number of threads (1 by default, 0 for all the cores)\n");
   return(-1);
 }
 strcpy(input_filename, argv[1]);
 sscanf(argv[2], "%d", &iformat);
 strcpy(output_ext, argv[3]);
 /* Calibrated latex table (not necessary if iformat < 0) */
-if(argc >= 6) {
+if(argc >= 5) {
 strcpy(calib_fname, argv[4]);
 } else {
 calib_fname[0] = '\0';
 }
+/* Format of the calibrated table (Gili's format by default): */
+gili_format = 1;
+if(argc >= 6) sscanf(argv[5], "%d", &gili_format);
 /* Error messages: */
 if((iformat > 0) && (calib_fname[0] == '\0')) {
   fprintf(stderr, "Fatal error\n");
@@ -109,23 +157,19 @@ if((iformat > 0) && (calib_fname[0] == '\0')) {
   return(-1);
   }
 /* File with full references (not necessary if iformat != 2) */
-if(iformat == 2) {
- if(argc == 7) {
-   strcpy(OC6_references_fname, argv[6]);
- } else {
- OC6_references_fname[0] = '\0';
- }
-}
+OC6_references_fname[0] = '\0';
+if(iformat == 2 && argc == 7) strcpy(OC6_references_fname, argv[6]);
 
 #ifdef DEBUG
 printf("OK: input=%s iformat=%d output_ext=%s calib_fname=%s\n", 
        input_filename, iformat, output_ext, calib_fname);
-printf("OK: OC6_references_fname=>%s<\n", OC6_references_fname);
+printf("OK: OC6_references_fname=>%s< gili_format=%d\n", 
+        OC6_references_fname, gili_format);
 #endif
 
 /* Call residuals1_main that does the main job: */
 residuals_gili_1_main(input_filename, output_ext, calib_fname, 
-                      OC6_references_fname, iformat);
+                      OC6_references_fname, iformat, gili_format, nthreads);
 
 return(0);
 }
@@ -144,11 +188,14 @@ return(0);
 * OC6_references_fname: name of the file containing the OC6 biblio. references
 * iformat: format of the input file (-1=Marco with measures, 
 *          1=Marco without measures, 2=OC6 without measures)
+* gili_format: format of the calibrated table (1 if Gili's format)
+* nthreads: number of threads used for processing the objects
 *
 *************************************************************************/
 static int residuals_gili_1_main(char* input_filename, char *output_ext, 
                                  char *calib_fname, 
-                                 char *OC6_references_fname, int iformat)
+                                 char *OC6_references_fname, int iformat,
+                                 int gili_format, int nthreads)
 {
 char out_filename[100];
 FILE *fp_in, *fp_out_txt, *fp_out_latex, *fp_out_curve; 
@@ -261,7 +308,7 @@ fprintf(fp_out_curve, "%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%\
 */
 compute_residuals_gili(fp_in, fp_out_txt, fp_out_latex, fp_out_curve, 
                        fp_out_ref1, fp_out_ref2, calib_fname, 
-                       OC6_references_fname, iformat);
+                       OC6_references_fname, iformat, gili_format, nthreads);
 
 /* Epilog for Latex file: */
 fprintf(fp_out_latex, " & & & & & \\\\ \n \\hline \n \\end{tabular} \n\
@@ -432,6 +479,11 @@ return(0);
 * look for the measures in the tab_calib.tex 
 * and compute the residuals 
 *
+* The objects are read (reader stage) by batches of NOBJ_BATCH objects,
+* that are processed in parallel by nthreads threads (process_object_gili()),
+* and then written in the original order (write_object_gili()), 
+* so that the output files do not depend on the number of threads.
+*
 * INPUT:
 * fp_in: pointer to the input file containing the measurements and the
 *        orbital elements
@@ -443,25 +495,38 @@ return(0);
 * fp_out_ref2: pointer to the file with full references
 * iformat: format of the input file (-1=Marco with measures, 
 *          1=Marco without measures, 2=OC6 without measures)
+* gili_format: format of the calibrated table (1 if Gili's format)
+* nthreads: number of threads used for processing the objects
 *
 *************************************************************************/
 static int compute_residuals_gili(FILE *fp_in, FILE *fp_out_txt, 
                               FILE *fp_out_latex, FILE *fp_out_curve, 
                               FILE *fp_out_ref1, FILE *fp_out_ref2, 
                               char *calib_fname, 
-                              char *OC6_references_fname, int iformat)
+                              char *OC6_references_fname, int iformat,
+                              int gili_format, int nthreads)
 {
 #define NMAX 1024
-double Omega_node, omega_peri, i_incl, e_eccent, T_periastron, orbit_equinox;
-double mean_motion, a_smaxis, Period; 
-double epoch_o[50], rho_o[50], theta_o[50], err_rho_o[50], err_theta_o[50];
-int nmeas, iline, status, is_master_file, line_length, n_names, kk;
-char object_name[NMAX*60], discov_name[40], comp_name[10], WDS_name[40]; 
-char ADS_name[40], author[NMAX*60], refer0[NMAX*130], refer1[NMAX*130];
+RESIDG1_BATCH batch;
+RESIDG1_OBJECT *ob;
+int iline, status, is_master_file, line_length, n_names, kk, nobj;
+char WDS_name[40], ADS_name[40];
+char object_name[NMAX*60], author[NMAX*60], refer0[NMAX*130], refer1[NMAX*130];
 /* Maximum line seems to be 265 for OC6 catalog... */
 char in_line1[300], in_line2[300];
 
+batch.obj = (RESIDG1_OBJECT *)malloc(NOBJ_BATCH * sizeof(RESIDG1_OBJECT));
+if(batch.obj == NULL) {
+  fprintf(stderr, "compute_residuals_gili/Fatal error allocating memory\n");
+  exit(-1);
+  }
+batch.calib_fname = calib_fname;
+batch.OC6_references_fname = OC6_references_fname;
+batch.iformat = iformat;
+batch.gili_format = gili_format;
+
 kk = 0;
+nobj = 0;
 iline = 0;
 
 while(!feof(fp_in)) {
@@ -478,9 +543,24 @@ while(!feof(fp_in)) {
 * program
 */
     if(line_length < 10) {
+/* Objects read before this line are written first: */
+      process_batch_gili(&batch, nobj, nthreads, fp_out_txt, fp_out_latex, 
+                         fp_out_curve, object_name, author, refer0, refer1, &kk);
+      nobj = 0;
       printf("WARNING line #%d is very short (length=%d): >%s<\n", 
               iline, line_length, in_line1);
     } else {
+    ob = &batch.obj[nobj];
+    ob->object_name[0] = '\0';
+    ob->author[0] = '\0';
+    ob->refer0[0] = '\0';
+    ob->refer1[0] = '\0';
+    ob->nmeas = 0;
+    ob->meas_status = 0;
+    ob->status = 0;
+    ob->out_txt = NULL;
+    ob->out_latex = NULL;
+    ob->out_curve = NULL;
 /* Read input line and retrieve the orbital parameters and the
 *  measurements
 */
@@ -495,94 +575,59 @@ while(!feof(fp_in)) {
         }
 
      status = get_orbit_from_Marco_list(in_line1, in_line2, 
-                               iline, &object_name[kk * 60], 
-                               WDS_name, ADS_name, discov_name, comp_name, 
-                               &author[kk * 60], &Omega_node, 
-                               &omega_peri, &i_incl, 
-                               &e_eccent, &T_periastron, &Period, &a_smaxis, 
-                               &mean_motion, &orbit_equinox);
-     object_name[(kk+1)*60 -1] = '\0';
-     author[(kk+1)*60 -1] = '\0';
+                               iline, ob->object_name, 
+                               WDS_name, ADS_name, ob->discov_name, 
+                               ob->comp_name, ob->author, &ob->Omega_node, 
+                               &ob->omega_peri, &ob->i_incl, 
+                               &ob->e_eccent, &ob->T_periastron, &ob->Period,
+                               &ob->a_smaxis, &ob->mean_motion, 
+                               &ob->orbit_equinox);
+     ob->object_name[59] = '\0';
+     ob->author[59] = '\0';
 /* OC6 format: */
      } else {
      status = get_orbit_from_OC6_list_gili(in_line1, iline, 
                                  is_master_file, WDS_name, 
-                                 discov_name, comp_name, &object_name[kk * 60],
-                                 &author[kk * 60], &Omega_node, 
-                                 &omega_peri, &i_incl, 
-                                 &e_eccent, &T_periastron, &Period, &a_smaxis, 
-                                 &mean_motion, &orbit_equinox);
-     object_name[(kk+1)*60 -1] = '\0';
-     author[(kk+1)*60 -1] = '\0';
+                                 ob->discov_name, ob->comp_name, 
+                                 ob->object_name, ob->author, 
+                                 &ob->Omega_node, &ob->omega_peri, 
+                                 &ob->i_incl, &ob->e_eccent, 
+                                 &ob->T_periastron, &ob->Period, 
+                                 &ob->a_smaxis, &ob->mean_motion, 
+                                 &ob->orbit_equinox, 
+                                 &ob->orbit_grade);
+     ob->object_name[59] = '\0';
+     ob->author[59] = '\0';
      if(!status && *OC6_references_fname) 
-          get_OC6_full_reference(&object_name[kk * 60], &author[kk * 60], 
-                                 OC6_references_fname, &refer0[kk * 130], 
-                                 &refer1[kk * 130]); 
-        refer0[(kk+1)*130 -1] = '\0';
-        refer1[(kk+1)*130 -1] = '\0';
-/* DEBUG:
-printf("object=%s author=%s refer0=%s refer1=%s\n", &object_name[kk * 60], 
-         &author[kk*60], &refer0[kk * 130], &refer1[kk * 130]);
-*/
-
+          get_OC6_full_reference(ob->object_name, ob->author, 
+                                 OC6_references_fname, ob->refer0, 
+                                 ob->refer1); 
+        ob->refer0[129] = '\0';
+        ob->refer1[129] = '\0';
      }
-     if(status) {
-     fprintf(stderr, "compute_residuals_gili/WARNING: error reading orbital parameters in line #%d (status=%d)\n", iline, status); 
-     } else {
-/* Retrieve the measurements from the input files
- and compute the corresponding residuals */
-    
+     ob->orbit_status = status;
 /* Retrieve the measurements from the input file (if iformat < 0)
-* or retrieve the measurements from the calibrated table.
+* (the measurements from the calibrated table are read by process_object_gili())
 */
-     if(iformat > 0) {
-      printf("UUUTR:From OC6 catalog: iformat=%d object=%s discov=%s comp=>%s<\n", 
-              iformat, &object_name[kk * 60], discov_name, comp_name);
-/* Read the measurements from the calibrated file if iformat > 0: */
-      status = get_measures_from_CALIB_table_gili(calib_fname, 
-                       &object_name[kk * 60], comp_name, epoch_o, rho_o, 
-                       theta_o, err_rho_o, err_theta_o, &nmeas); 
-      printf("UUUTR:From calib table: status=%d epoch_o=%f rho_o=%f theta_o=%f (nmeas=%d)\n", 
-             status, epoch_o[0], rho_o[0], theta_o[0], nmeas);
-/* Otherwise read the measurements from the input file fp_in: */
-     } else {
-       status = get_measures_from_file(fp_in, &iline, epoch_o, 
-                       rho_o, theta_o, err_rho_o, err_theta_o, &nmeas);
+     if(!status && iformat < 0) {
+       ob->meas_status = get_measures_from_file(fp_in, &iline, ob->epoch_o, 
+                       ob->rho_o, ob->theta_o, ob->err_rho_o, 
+                       ob->err_theta_o, &ob->nmeas);
      }
-/* Process all measurements */
-     if(status < 0) {
-     fprintf(stderr, "\ncompute_residuals_gili/Error processing line #%d (%s)\n", 
-             iline, in_line1); 
-     } else if (status > 0 || nmeas == 0) {
-     fprintf(stderr, "compute_residuals_gili/Warning missing measurements in line #%d\n", 
-             iline); 
-     } else {
-/* Process all nmeas measurements relative to a given object:
-* correct the measurements from precession, compute the ephemerides,
-* and derive the O-C residuals
-*/
-       status = process_measurements_gili(fp_out_txt, fp_out_latex, 
-                                     fp_out_curve, OC6_references_fname, 
-                                     &object_name[kk * 60], 
-                                     discov_name, comp_name, &author[kk * 60], 
-                                     Omega_node, omega_peri, i_incl, e_eccent, 
-                                     T_periastron, Period, a_smaxis, 
-                                     mean_motion, orbit_equinox, epoch_o, 
-                                     rho_o, theta_o, err_rho_o, 
-                                     err_theta_o, nmeas);
-       if(status) {
-       fprintf(stderr, 
-               "compute_residuals_gili/Error processing measurements in line #%d\n",
-               iline); 
-       } else {
-/* Update kk the orbit counter: */
-       kk++;
-       }
-     } /* EOF !status (from get_measures_from... */
-     } /* EOF !status (succes reading orbital parameters of the current line */
+     ob->iline = iline;
+     strcpy(ob->in_line1, in_line1);
+     nobj++;
     } /* EOF line is not short (i.e., i > 10) */
     } /* EOF if in_line1 != % */
   } /* EOF if fgets */ 
+
+/* Process the objects of the batch in parallel,
+* and write the results in the original order: */
+  if(nobj == NOBJ_BATCH || feof(fp_in)) {
+    process_batch_gili(&batch, nobj, nthreads, fp_out_txt, fp_out_latex, 
+                       fp_out_curve, object_name, author, refer0, refer1, &kk);
+    nobj = 0;
+    }
  }
 
 n_names = kk;
@@ -594,9 +639,149 @@ printf("Compute_residuals: %d lines sucessfully read (n_names=%d)\n",
 if(fp_out_ref1 != NULL && fp_out_ref2 != NULL) 
             sort_references(fp_out_ref1, fp_out_ref2, object_name, author, 
                             refer0, refer1, n_names);
+free(batch.obj);
 return(0);
 }
 /************************************************************************
+* Process the nobj objects of the batch in parallel,
+* and write the results in the original order
+*
+* INPUT/OUTPUT:
+* object_name, author, refer0, refer1: names and references of
+*              the objects processed successfully
+* kk: orbit counter
+************************************************************************/
+static void process_batch_gili(RESIDG1_BATCH *batch, int nobj, int nthreads, 
+                               FILE *fp_out_txt, FILE *fp_out_latex, 
+                               FILE *fp_out_curve, char *object_name, 
+                               char *author, char *refer0, char *refer1, int *kk)
+{
+int i;
+
+if(nobj <= 0) return;
+
+jlp_parallel_for(nobj, nthreads, process_object_gili, batch);
+
+for(i = 0; i < nobj; i++) 
+  write_object_gili(&batch->obj[i], batch->iformat, fp_out_txt, fp_out_latex, 
+                    fp_out_curve, &object_name[*kk * 60], &author[*kk * 60], 
+                    &refer0[*kk * 130], &refer1[*kk * 130], kk);
+}
+/************************************************************************
+* Process an object of the batch read by compute_residuals_gili()
+* (called by the threads of the pool, with k = index of the object):
+* read the measurements from the calibrated table (if iformat > 0), 
+* compute the ephemerides, and derive the O-C residuals
+*
+* The output lines are stored in memory (ob->out_txt, ob->out_latex,
+* ob->out_curve), to be written by write_object_gili()
+************************************************************************/
+static void process_object_gili(int k, void *data)
+{
+RESIDG1_BATCH *batch = (RESIDG1_BATCH *)data;
+RESIDG1_OBJECT *ob = &batch->obj[k];
+FILE *fp_txt, *fp_latex, *fp_curve;
+
+if(ob->orbit_status) return;
+
+/* Read the measurements from the calibrated file if iformat > 0: */
+if(batch->iformat > 0) {
+  ob->meas_status = get_measures_from_CALIB_table_gili(batch->calib_fname, 
+                       ob->object_name, ob->comp_name, ob->epoch_o, ob->rho_o, 
+                       ob->theta_o, ob->err_rho_o, ob->err_theta_o, 
+                       &ob->nmeas, batch->gili_format); 
+  }
+if(ob->meas_status != 0 || ob->nmeas == 0) return;
+
+fp_txt = open_memstream(&ob->out_txt, &ob->len_txt);
+fp_latex = open_memstream(&ob->out_latex, &ob->len_latex);
+fp_curve = open_memstream(&ob->out_curve, &ob->len_curve);
+if(fp_txt == NULL || fp_latex == NULL || fp_curve == NULL) {
+  fprintf(stderr, "process_object_gili/Fatal error allocating memory\n");
+  exit(-1);
+  }
+
+/* Process all nmeas measurements relative to a given object:
+* correct the measurements from precession, compute the ephemerides,
+* and derive the O-C residuals
+*/
+ob->status = process_measurements_gili(fp_txt, fp_latex, fp_curve, 
+                                  batch->OC6_references_fname, 
+                                  ob->object_name, ob->discov_name, 
+                                  ob->comp_name, ob->author, 
+                                  ob->Omega_node, ob->omega_peri, ob->i_incl, 
+                                  ob->e_eccent, ob->T_periastron, ob->Period,
+                                  ob->a_smaxis, ob->mean_motion, 
+                                  ob->orbit_equinox, ob->epoch_o, ob->rho_o, 
+                                  ob->theta_o, ob->err_rho_o, 
+                                  ob->err_theta_o, ob->nmeas);
+fclose(fp_txt);
+fclose(fp_latex);
+fclose(fp_curve);
+}
+/************************************************************************
+* Write the results of an object processed by process_object_gili()
+* to the output files (and the "UUUTR" debug lines to stdout), with the same messages as in the former serial
+* version of compute_residuals_gili()
+*
+* OUTPUT:
+* object_name, author, refer0, refer1: names and references of
+*              the object, if processed successfully
+* kk: orbit counter (incremented if the object was processed successfully)
+************************************************************************/
+static void write_object_gili(RESIDG1_OBJECT *ob, int iformat, 
+                              FILE *fp_out_txt, FILE *fp_out_latex, 
+                              FILE *fp_out_curve, char *object_name, 
+                              char *author, char *refer0, char *refer1, 
+                              int *kk)
+{
+
+if(ob->orbit_status) {
+  fprintf(stderr, "compute_residuals_gili/WARNING: error reading orbital parameters in line #%d (status=%d)\n", ob->iline, ob->orbit_status); 
+  return;
+  }
+
+if(iformat > 0) {
+  printf("UUUTR:From OC6 catalog: iformat=%d object=%s discov=%s comp=>%s<\n", 
+          iformat, ob->object_name, ob->discov_name, ob->comp_name);
+  printf("UUUTR:From calib table: status=%d epoch_o=%f rho_o=%f theta_o=%f (nmeas=%d)\n", 
+         ob->meas_status, ob->epoch_o[0], ob->rho_o[0], ob->theta_o[0], 
+         ob->nmeas);
+  }
+
+/* Process all measurements */
+if(ob->meas_status < 0) {
+  fprintf(stderr, "\ncompute_residuals_gili/Error processing line #%d (%s)\n", 
+          ob->iline, ob->in_line1); 
+} else if (ob->meas_status > 0 || ob->nmeas == 0) {
+  fprintf(stderr, "compute_residuals_gili/Warning missing measurements in line #%d\n", 
+          ob->iline); 
+} else {
+/* Debug line of process_measurements_gili(): */
+  printf("UUTR/process_measurements/ object=%s nmeas=%d\n ", 
+         ob->object_name, ob->nmeas);
+  fwrite(ob->out_txt, 1, ob->len_txt, fp_out_txt);
+  fwrite(ob->out_latex, 1, ob->len_latex, fp_out_latex);
+  fwrite(ob->out_curve, 1, ob->len_curve, fp_out_curve);
+  if(ob->status) {
+    fprintf(stderr, 
+            "compute_residuals_gili/Error processing measurements in line #%d\n",
+            ob->iline); 
+  } else {
+/* Update kk the orbit counter: */
+    strcpy(object_name, ob->object_name);
+    strcpy(author, ob->author);
+    strcpy(refer0, ob->refer0);
+    strcpy(refer1, ob->refer1);
+    (*kk)++;
+  }
+}
+
+free(ob->out_txt);
+free(ob->out_latex);
+free(ob->out_curve);
+}
+/************************************************************************
 * Process all measurements relative to a given object:
 * correct the measurements from precession, compute the ephemerides,
 * and derive the O-C residuals
@@ -631,8 +816,6 @@ register int i;
 c_tolerance = ABS(1.5E-5 * cos(i_incl) 
                    / sqrt((1.0 + e_eccent)/(1.0 - e_eccent)));
 
- printf("UUTR/process_measurements/ object=%s nmeas=%d\n ", object_name, nmeas);
-
 /* Main loop on all the measures 
 */
 for(i = 0; i < nmeas; i++) {
@@ -17,6 +17,10 @@
 * - It can retrieve PISCO measurements from the output LaTeX table 
 *   created by latex_calib or any other LaTeX table in this format
 * - It can read orbits from a subset of the OC6 catalog.
+* - Incremental mode (option "--incremental"): the output lines of each
+*   measurement are kept in a sidecar cache (*_cache.dat) with the content
+*   hash of the measurement line and of the orbit line, and only the
+*   measurements whose inputs have changed are recomputed.
 *
 *
 * OUTPUT:
@@ -25,50 +29,63 @@
 *    *.tex : LaTeX ASCII table with O-C
 *    *_ref1.tex : Latex ASCII file with compacted references
 *    *_ref2.tex : Latex ASCII file with full references
+*    *_cache.dat : cache of the output lines (with "--incremental" only)
 *
 * JLP 
-* Version 13/05/2021
+* Version 17/10/2026
 *************************************************************************/
 #include "jlp_catalog_utils.h"
 #include "residuals_utils.h"
+#include "orbit_model.h"    // OrbitModel
 #include "OC6_catalog_utils.h"
 #include "jlp_string.h"  // jlp_compact_string
+#include "resid_cache.h"  // ResidCache
+#include <vector>
+#include <string>
+#include <unordered_map>
 
 /*
 #define DEBUG
 #define DEBUG_1
 */
 
+/* Orbit of the input orbit list (the list is read only once), with its
+* model (built once per orbit) and its references (read when needed,
+* refer_status = 1 when available): */
+typedef struct {
+  std::string line;
+  char object_name[60], discov_name[64], comp_name[64], WDS_name[64];
+  char author[60], refer0[130], refer1[130];
+  double Omega_node, omega_peri, i_incl, e_eccent, T_periastron;
+  double orbit_equinox, mean_motion, a_smaxis, Period;
+  int orbit_grade, refer_status;
+  OrbitModel model;
+} RESID2_ORBIT;
+
 static int residuals_gili_2_main(char *input_orbit_list, char *output_ext, 
                                  char *calib_fname, char *OC6_references_fname,
-                                 int orbit_grade_max, int gili_format);
+                                 int orbit_grade_max, int gili_format,
+                                 int incremental);
 static int compute_residuals_from_calib_gili(FILE *fp_out_txt, 
                                FILE *fp_out_latex, FILE *fp_out_curve, 
                                FILE *fp_out_ref1, FILE *fp_out_ref2, 
                                char *calib_fname, char *input_orbit_list, 
                                char *OC6_references_fname, int orbit_grade_max,
-                               int gili_format);
+                               int gili_format, ResidCache *cache);
 static int get_orbit_from_OC6catalog(char *input_orbit_list, 
-                                     char *OC6_references_fname,
                                      char *object_name1, char *comp_name1, 
-                                     int comp1_is_AB, char *object_name2,
-                                     char *discov_name2, char *comp_name2,
-                                     char *WDS_name2,
-                                     double *Omega_node, double *omega_peri, 
-                                     double *i_incl, double *e_eccent, 
-                                     double *T_periastron, 
-                                     double *orbit_equinox,
-                                     double *mean_motion, double *a_smaxis, 
-                                     double *Period, int *orbit_grade,
-                                     char *author2, char *refer0, char *refer1);
+                                     RESID2_ORBIT **orbit);
+static int load_orbit_list(char *input_orbit_list,
+                           std::vector<RESID2_ORBIT> *orbits,
+                           std::unordered_map<std::string, int> *index);
+static void get_orbit_references(RESID2_ORBIT *orb,
+                                 char *OC6_references_fname, char *author2,
+                                 char *refer0, char *refer1);
 static int process_measurement_gili(FILE *fp_out_txt, FILE *fp_out_latex,
               FILE *fp_out_curve, char *OC6_references_fname,
               char *object_name, char *discov_name, char *comp_name, 
-              char *author, int orbit_grade,
-              double Omega_node, double omega_peri, 
-              double i_incl, double e_eccent,
-              double T_periastron, double Period, double a_smaxis, 
-              double mean_motion, double orbit_equinox, double epoch_o, 
+              char *author, int orbit_grade, OrbitModel *model,
+              double orbit_equinox, double epoch_o, 
               double rho_o, double theta_o, double err_rho_o, 
               double err_theta_o);
 
@@ -76,7 +93,13 @@ int main(int argc, char *argv[])
 {
 char input_orbit_list[80], output_ext[40], calib_fname[80];
 char OC6_references_fname[128];
-int orbit_grade_max, gili_format;
+int orbit_grade_max, gili_format, incremental = 0;
+
+/* Option "--incremental" (only the modified entries are recomputed): */
+if(argc > 1 && !strcmp(argv[argc - 1], "--incremental")) {
+  incremental = 1;
+  argc--;
+  }
 
 if(argc == 7) {
   if(*argv[6]) argc = 7;
@@ -88,7 +111,7 @@ if(argc == 7) {
   else argc = 1;
 }
 if(argc != 6 && argc != 7) {
-  printf("Syntax: residuals_gili_2 input_orbit_list output_ext calibrated_latex_table grade_max gili_format [reference_list] \n");
+  printf("Syntax: residuals_gili_2 input_orbit_list output_ext calibrated_latex_table grade_max gili_format [reference_list] [--incremental]\n");
   printf(" Assume OC6 format (P, a, i, Omega, T, e, omep, [equinox] )\n");
   printf(" Test that is used: orbit_grade less or equal to orbit_grade_max\n");
   return(-1);
@@ -120,7 +143,8 @@ printf("OK: OC6_references_fname=>%s< gili_format=%d\n",
 
 /* Call residuals1_main that does the main job: */
 residuals_gili_2_main(input_orbit_list, output_ext, calib_fname, 
-                      OC6_references_fname, orbit_grade_max, gili_format);
+                      OC6_references_fname, orbit_grade_max, gili_format,
+                      incremental);
 
 return(0);
 }
@@ -136,17 +160,32 @@ return(0);
 * calib_fname: name of the file containing the Latex calibrated table
 *              (final version, ready for publication)
 * OC6_references_fname: name of the file containing the OC6 biblio. references
+* incremental: if 1, use the cache of the previous run (output_ext_cache.dat)
 *
 *************************************************************************/
 static int residuals_gili_2_main(char* input_orbit_list, char *output_ext, 
                                  char *calib_fname, char *OC6_references_fname,
-                                 int orbit_grade_max, int gili_format)
+                                 int orbit_grade_max, int gili_format,
+                                 int incremental)
 {
-char out_filename[100];
+char out_filename[100], context[256];
 FILE *fp_out_txt, *fp_out_latex, *fp_out_curve; 
 FILE *fp_out_ref1, *fp_out_ref2;
+ResidCache *cache = NULL;
 time_t t = time(NULL);
 
+/* Cache of the previous run (discarded if the options 
+* or the references have changed): */
+if(incremental) {
+  sprintf(out_filename, "%s_cache.dat", output_ext);
+  sprintf(context, "residuals_gili_2 grade_max=%d gili_format=%d refer=%016llx",
+          orbit_grade_max, gili_format, 
+          (unsigned long long)(*OC6_references_fname ? 
+                         resid_cache_hash_file(OC6_references_fname) : 0));
+  cache = new ResidCache(out_filename, context);
+  cache->Load();
+  }
+
 fp_out_ref1 = NULL;
 fp_out_ref2 = NULL;
 fp_out_curve = NULL;
@@ -248,7 +287,14 @@ compute_residuals_from_calib_gili(fp_out_txt, fp_out_latex,
                                   fp_out_curve, fp_out_ref1, fp_out_ref2, 
                                   calib_fname, input_orbit_list, 
                                   OC6_references_fname, orbit_grade_max,
-                                  gili_format);
+                                  gili_format, cache);
+
+if(cache != NULL) {
+  printf("residuals_gili_2: %d entries from the cache, %d recomputed\n",
+         cache->NHits(), cache->NMisses());
+  cache->Save();
+  delete cache;
+  }
 
 /* Epilog for Latex file: */
 fprintf(fp_out_latex, " & & & & & & & \\\\ \n \\hline \n \\end{tabular} \n\
@@ -276,6 +322,7 @@ return(0);
 * fp_out_curve: pointer to the file containing the O-C curve
 * fp_out_ref1: pointer to the file with compacted references
 * fp_out_ref2: pointer to the file with full references
+* cache: cache of the output lines (NULL if not incremental mode)
 *
 *************************************************************************/
 static int compute_residuals_from_calib_gili(FILE *fp_out_txt, 
@@ -283,18 +330,21 @@ static int compute_residuals_from_calib_gili(FILE *fp_out_txt,
                               FILE *fp_out_ref1, FILE *fp_out_ref2, 
                               char *calib_fname, char *input_orbit_list, 
                               char *OC6_references_fname, int orbit_grade_max,
-                              int gili_format)
+                              int gili_format, ResidCache *cache)
 {
 #define NMAX 1024
 char author[NMAX*60], refer0[NMAX*130], refer1[NMAX*130], object_name[NMAX*60]; 
-char author2[60], refer20[130], refer21[130], object_name2[60];
-char discov_name2[64], comp_name2[64], WDS_name2[64];
-double Omega_node, omega_peri, i_incl, e_eccent, T_periastron, orbit_equinox;
-double mean_motion, a_smaxis, Period; 
+char author2[60], refer20[130], refer21[130];
 double epoch_o, rho_o, theta_o, err_rho_o, err_theta_o;
-char in_line[300], object_name1[40], comp_name1[40];
-int iline, comp1_is_AB, kk, orbit_grade = -1, status, status1;
-FILE *fp_in_latex;
+char in_line[300], object_name1[40], comp_name1[40], cache_key[128];
+char *out_buffer[3];
+size_t out_length[3];
+std::string fields[RESID_CACHE_NFIELDS];
+int iline, comp1_is_AB, kk, status, status1, i;
+uint64_t hash = 0;
+RESID2_ORBIT *orb;
+RESID_CACHE_ENTRY *entry;
+FILE *fp_in_latex, *fp_out[3];
 
 /* Open input file containing the input Latex table: */
 if((fp_in_latex = fopen(calib_fname, "r")) == NULL) {
@@ -335,41 +385,80 @@ printf("ZZZZ: rho_o=%f \n", rho_o);
      } else {
        jlp_compact_string(object_name1, 40);
        jlp_compact_string(comp_name1, 40);
-       status1 = get_orbit_from_OC6catalog(input_orbit_list, 
-                                          OC6_references_fname,
-                                          object_name1, comp_name1, comp1_is_AB,
-                                          object_name2, discov_name2,
-                                          comp_name2, WDS_name2, &Omega_node, 
-                                          &omega_peri, &i_incl, &e_eccent, 
-                                          &T_periastron, &orbit_equinox,
-                                          &mean_motion, &a_smaxis, &Period,
-                                          &orbit_grade, author2, refer20, 
-                                          refer21); 
+       status1 = get_orbit_from_OC6catalog(input_orbit_list, object_name1,
+                                           comp_name1, &orb);
       if(status1 != 0) {
         fprintf(stderr, 
           "compute_residuals_gili/Error in get_orbit_from_OC6catalog object=%s comp=%s status1%d\n",
                object_name1, comp_name1, status1); 
 // Case when an orbit has been found with a good grade for that object: 
-       } else if((orbit_grade > 0) 
-                && (orbit_grade <= orbit_grade_max)) {
-         strcpy(&object_name[kk * 60], object_name2); 
-         strcpy(&author[kk * 60], author2); 
-         strcpy(&refer0[kk * 130], refer20); 
-         strcpy(&refer1[kk * 130], refer21); 
+       } else if((orb->orbit_grade > 0) 
+                && (orb->orbit_grade <= orbit_grade_max)) {
+         status = 0;
+/* Key of the measurement and content hash of the measurement and the orbit: */
+         if(cache != NULL) {
+           sprintf(cache_key, "%s %s %016llx", object_name1, comp_name1,
+                   (unsigned long long)resid_cache_hash(in_line, ""));
+           hash = resid_cache_hash(in_line, orb->line.c_str());
+           }
+/* Unchanged inputs: same output lines as in the previous run */
+         if(cache != NULL && cache->Lookup(cache_key, hash, &entry) == 0) {
+           fwrite(entry->field[RESID_CACHE_TXT].c_str(), 1, 
+                  entry->field[RESID_CACHE_TXT].size(), fp_out_txt);
+           fwrite(entry->field[RESID_CACHE_LATEX].c_str(), 1, 
+                  entry->field[RESID_CACHE_LATEX].size(), fp_out_latex);
+           fwrite(entry->field[RESID_CACHE_CURVE].c_str(), 1, 
+                  entry->field[RESID_CACHE_CURVE].size(), fp_out_curve);
+           strcpy(author2, entry->field[RESID_CACHE_AUTHOR].c_str());
+           strcpy(refer20, entry->field[RESID_CACHE_REFER0].c_str());
+           strcpy(refer21, entry->field[RESID_CACHE_REFER1].c_str());
+         } else {
+           get_orbit_references(orb, OC6_references_fname, author2, refer20,
+                                refer21);
+/* The output lines are written in memory first, to be stored in the cache: */
+           fp_out[0] = fp_out_txt;
+           fp_out[1] = fp_out_latex;
+           fp_out[2] = fp_out_curve;
+           if(cache != NULL) {
+             for(i = 0; i < 3; i++) {
+               fp_out[i] = open_memstream(&out_buffer[i], &out_length[i]);
+               if(fp_out[i] == NULL) {
+                 fprintf(stderr, "compute_residuals_gili/Fatal error allocating memory\n");
+                 exit(-1);
+                 }
+               }
+             }
 /**********************
 /* Process this measurement
 * correct the measurement from precession, compute the ephemerides,
 * and derive the O-C residuals
 */
-         status = process_measurement_gili(fp_out_txt, fp_out_latex, 
-                                     fp_out_curve, OC6_references_fname, 
-                                     object_name2, discov_name2, comp_name2, 
-                                     author2, orbit_grade,  
-                                     Omega_node, omega_peri, i_incl, e_eccent, 
-                                     T_periastron, Period, a_smaxis, 
-                                     mean_motion, orbit_equinox, epoch_o, 
+           status = process_measurement_gili(fp_out[0], fp_out[1], fp_out[2],
+                                     OC6_references_fname, orb->object_name,
+                                     orb->discov_name, orb->comp_name, 
+                                     author2, orb->orbit_grade,  
+                                     &orb->model, orb->orbit_equinox, epoch_o, 
                                      rho_o, theta_o, err_rho_o, 
                                      err_theta_o);
+           if(cache != NULL) {
+             for(i = 0; i < 3; i++) {
+               fclose(fp_out[i]);
+               fields[i].assign(out_buffer[i], out_length[i]);
+               free(out_buffer[i]);
+               }
+             fwrite(fields[0].c_str(), 1, fields[0].size(), fp_out_txt);
+             fwrite(fields[1].c_str(), 1, fields[1].size(), fp_out_latex);
+             fwrite(fields[2].c_str(), 1, fields[2].size(), fp_out_curve);
+             fields[RESID_CACHE_AUTHOR] = author2;
+             fields[RESID_CACHE_REFER0] = refer20;
+             fields[RESID_CACHE_REFER1] = refer21;
+             if(status == 0) cache->Store(cache_key, hash, fields);
+             }
+         }
+         strcpy(&object_name[kk * 60], orb->object_name); 
+         strcpy(&author[kk * 60], author2); 
+         strcpy(&refer0[kk * 130], refer20); 
+         strcpy(&refer1[kk * 130], refer21); 
          if(status) {
            fprintf(stderr, 
                "compute_residuals_gili/Error processing measurement in line #%d\n",
@@ -406,6 +495,7 @@ return(0);
 *             in plain ASCII format 
 * fp_out_latex: pointer to the output Latex file with the residuals
 * fp_out_curve: pointer to the output file containing the O-C curve 
+* model: model of the orbit (built once when the orbit list is read)
 *
 * OUTPUT:
 * O-C residuals in "fp_out_txt" and "fp_out_latex" files
@@ -414,33 +504,22 @@ static int process_measurement_gili(FILE *fp_out_txt, FILE *fp_out_latex,
               FILE *fp_out_curve, 
               char *OC6_references_fname, char *object_name, char *discov_name,
               char *comp_name, char *author, int orbit_grade, 
-              double Omega_node, 
-              double omega_peri, double i_incl, double e_eccent,
-              double T_periastron, double Period, double a_smaxis, 
-              double mean_motion, double orbit_equinox, double epoch_o, 
+              OrbitModel *model, double orbit_equinox, double epoch_o, 
               double rho_o, double theta_o, double err_rho_o, 
               double err_theta_o)
 {
 char my_name[60], quadrant_discrep[20];
-double c_tolerance, rho_c, theta_c, Drho, Dtheta;
+double rho_c, theta_c, Drho, Dtheta;
 int status;
 register int i;
 
-/*  c_tolerance = smallest increment allowed in the iterative process
-*                used for solving Kepler's equation
-*/
-c_tolerance = ABS(1.5E-5 * cos(i_incl) 
-                   / sqrt((1.0 + e_eccent)/(1.0 - e_eccent)));
-
  printf("process_measurement/Using orbit for object=%s\n ", object_name);
 
 /* Conversion to radians: */
  theta_o *= DEGTORAD;
 
 /* Compute the ephemerids corresponding to the observation epoch: */
-compute_ephemerid(Omega_node, omega_peri, i_incl, e_eccent, T_periastron, 
-                  Period, a_smaxis, mean_motion, epoch_o, c_tolerance, 
-                  &theta_c, &rho_c);
+model->Ephemerid(epoch_o, &theta_c, &rho_c);
 
 /* Conversion to degrees: */
  theta_o /= DEGTORAD;
@@ -475,31 +554,63 @@ compute_ephemerid(Omega_node, omega_peri, i_incl, e_eccent, T_periastron,
 return(0);
 }
 /********************************************************************
+* Look for the orbit of an object in the input orbit list
+* (the list is read and decoded only once)
 *
+* INPUT:
+* input_orbit_list: name of the file containing the orbital elements
+* object_name1, comp_name1: name of the object and companion
+*
+* OUTPUT:
+* orbit: pointer to the first orbit of the list with the same names
+* 0 if found, -1 if the list could not be read, -2 if not found
 ********************************************************************/
 static int get_orbit_from_OC6catalog(char *input_orbit_list, 
-                                     char *OC6_references_fname,
                                      char *object_name1, char *comp_name1, 
-                                     int comp1_is_AB, char *object_name2,
-                                     char *discov_name2, char *comp_name2,
-                                     char *WDS_name2,
-                                     double *Omega_node, double *omega_peri, 
-                                     double *i_incl, double *e_eccent, 
-                                     double *T_periastron, 
-                                     double *orbit_equinox,
-                                     double *mean_motion, double *a_smaxis, 
-                                     double *Period, int *orbit_grade,
-                                     char *author2, char *refer0, char *refer1)
+                                     RESID2_ORBIT **orbit)
 {
-double Omega_node2, omega_peri2, i_incl2, e_eccent2, T_periastron2; 
-double orbit_equinox2, mean_motion2, a_smaxis2, Period2; 
-char comp1_really_compacted[32], comp2_really_compacted[32]; 
+static std::vector<RESID2_ORBIT> orbits;
+static std::unordered_map<std::string, int> index;
+static std::string list_fname;
+std::unordered_map<std::string, int>::iterator it;
+char comp1_really_compacted[32]; 
+int status;
+
+if(list_fname != input_orbit_list) {
+  status = load_orbit_list(input_orbit_list, &orbits, &index);
+  if(status) return(-1);
+  list_fname = input_orbit_list;
+  }
+
+jlp_really_compact_companion(comp_name1, comp1_really_compacted, 40);
+it = index.find(std::string(object_name1) + "|" + comp1_really_compacted);
+// Return -2 if object was not found 
+if(it == index.end()) return(-2);
+
+*orbit = &orbits[it->second];
+// Return 0 if object was found 
+return(0);
+}
+/********************************************************************
+* Read and decode all the orbits of the input orbit list
+*
+* OUTPUT:
+* orbits: decoded orbits (in the order of the list)
+* index: "object_name|compacted companion" -> first orbit with those names
+********************************************************************/
+static int load_orbit_list(char *input_orbit_list,
+                           std::vector<RESID2_ORBIT> *orbits,
+                           std::unordered_map<std::string, int> *index)
+{
+RESID2_ORBIT orb;
+char comp2_really_compacted[32]; 
 FILE *fp_in;
 /* Maximum line seems to be 265 for OC6 catalog... */
 char in_line1[300];
-int iline, is_master_file, line_length, status, comp2_is_AB;
+int iline, is_master_file, line_length, status;
 
-jlp_really_compact_companion(comp_name1, comp1_really_compacted, 40);
+orbits->clear();
+index->clear();
 
 /* Open input file containing the orbital parameters: */
 if((fp_in = fopen(input_orbit_list, "r")) == NULL) {
@@ -532,50 +643,29 @@ while(!feof(fp_in)){
 
 /* OC6 format: */
      status = get_orbit_from_OC6_list_gili(in_line1, iline, 
-                                 is_master_file, WDS_name2, discov_name2, 
-                                 comp_name2, object_name2, author2, 
-                                 &Omega_node2, &omega_peri2, &i_incl2, 
-                                 &e_eccent2, &T_periastron2, &Period2, 
-                                 &a_smaxis2, &mean_motion2, &orbit_equinox2,
-                                 orbit_grade);
+                                 is_master_file, orb.WDS_name,
+                                 orb.discov_name, orb.comp_name,
+                                 orb.object_name, orb.author, 
+                                 &orb.Omega_node, &orb.omega_peri,
+                                 &orb.i_incl, &orb.e_eccent,
+                                 &orb.T_periastron, &orb.Period, 
+                                 &orb.a_smaxis, &orb.mean_motion,
+                                 &orb.orbit_equinox, &orb.orbit_grade);
      if(status) {
       fprintf(stderr, "get_orbit_from_OC6catalog/WARNING: error reading orbital parameters in line #%d (status=%d)\n", iline, status); 
       } else {
-      jlp_compact_string(object_name2, 60);
-/* Check if AB companion (default) or something else */
-      comp2_is_AB = 0;
-      if((comp_name2[0] == '\0') || !strcmp(comp_name2,"AB")
-         || !strncmp(comp_name1,"Aa-B",4)) comp1_is_AB = 1;
-// JLP2020: reduce the name if comp_is_AB is true:
-      if(comp2_is_AB == 1) remove_AB_from_object_name(object_name2);
-      jlp_really_compact_companion(comp_name2, comp2_really_compacted, 40);
-      if(!strcmp(object_name1, object_name2)
-         && !strcmp(comp1_really_compacted, comp2_really_compacted)) {
-        *Omega_node = Omega_node2;
-        *omega_peri = omega_peri2; 
-        *i_incl = i_incl2;
-        *e_eccent = e_eccent2; 
-        *T_periastron = T_periastron2;
-        *orbit_equinox = orbit_equinox2; 
-        *mean_motion = mean_motion2;
-        *a_smaxis = a_smaxis2; 
-        *Period = Period2;
-        fclose(fp_in);
-        if(*OC6_references_fname) { 
-          get_OC6_full_reference(object_name2, author2, OC6_references_fname, 
-                                 refer0, refer1); 
-/* DEBUG:
-printf("object=%s author=%s refer0=%s refer1=%s\n", object_name2, 
-         author2, refer0, refer1);
-*/
-        } else {
-          strcpy(author2, "");
-          strcpy(refer0, "");
-          strcpy(refer1, "");
-        }
-// Return 0 if object was found 
-        return(0);
-       } // EOF !strncmp(object_name1, object_name2);
+      jlp_compact_string(orb.object_name, 60);
+      jlp_really_compact_companion(orb.comp_name, comp2_really_compacted, 40);
+      orb.line = in_line1;
+      orb.refer_status = 0;
+      orb.model = OrbitModel(orb.Omega_node, orb.omega_peri, orb.i_incl,
+                             orb.e_eccent, orb.T_periastron, orb.Period,
+                             orb.a_smaxis, orb.mean_motion);
+/* The first orbit of an object is used: */
+      index->insert(std::make_pair(std::string(orb.object_name) + "|"
+                                   + comp2_really_compacted,
+                                   (int)orbits->size()));
+      orbits->push_back(orb);
       } // EOF if status == 0
      } // EOF if long line 
    } // EOF not commented line
@@ -583,6 +673,39 @@ printf("object=%s author=%s refer0=%s refer1=%s\n", object_name2,
 } // EOF while
 
 fclose(fp_in);
-// Return -2 if object was not found 
-return(-2);
+return(0);
+}
+/********************************************************************
+* Author and references of an orbit
+* (read only once from the reference file)
+*
+* OUTPUT:
+* author2: compacted author ("" if no reference file)
+* refer0, refer1: compacted and full references ("" if no reference file)
+********************************************************************/
+static void get_orbit_references(RESID2_ORBIT *orb,
+                                 char *OC6_references_fname, char *author2,
+                                 char *refer0, char *refer1)
+{
+
+if(*OC6_references_fname == '\0') {
+  strcpy(author2, "");
+  strcpy(refer0, "");
+  strcpy(refer1, "");
+  return;
+  }
+
+if(orb->refer_status == 0) {
+  get_OC6_full_reference(orb->object_name, orb->author, OC6_references_fname,
+                         orb->refer0, orb->refer1); 
+/* DEBUG:
+printf("object=%s author=%s refer0=%s refer1=%s\n", orb->object_name, 
+         orb->author, orb->refer0, orb->refer1);
+*/
+  orb->refer_status = 1;
+  }
+
+strcpy(author2, orb->author);
+strcpy(refer0, orb->refer0);
+strcpy(refer1, orb->refer1);
 }